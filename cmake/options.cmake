@@ -8,6 +8,7 @@ option(OT_NXP_LWIP_ETH "Enable lwIP port over ethernet" OFF)
 option(OT_NXP_LWIP_WIFI "Enable lwIP port over wifi" OFF)
 option(OT_NXP_EXPORT_TO_BIN "Convert all executables to raw binary" OFF)
 option(OT_NXP_EXPORT_TO_SREC "Convert all executables to srec" OFF)
+option(OT_NXP_ALARM_HW_COUNTER "Run the OpenThread alarms on a hardware counter instead of the FreeRTOS tick" OFF)
 
 if(OT_APP_CLI_FREERTOS_IPERF OR OT_APP_BR_FREERTOS)
     set(OT_NXP_LWIP ON CACHE BOOL "" FORCE)
@@ -26,3 +27,4 @@ message(STATUS OT_NXP_LWIP_ETH=${OT_NXP_LWIP_ETH})
 message(STATUS OT_NXP_LWIP_WIFI=${OT_NXP_LWIP_WIFI})
 message(STATUS OT_NXP_EXPORT_TO_BIN=${OT_NXP_EXPORT_TO_BIN})
 message(STATUS OT_NXP_EXPORT_TO_SREC=${OT_NXP_EXPORT_TO_SREC})
+message(STATUS OT_NXP_ALARM_HW_COUNTER=${OT_NXP_ALARM_HW_COUNTER})
@@ -32,6 +32,7 @@ set(OT_EXTERNAL_MBEDTLS "nxp-rt1170-mbedtls" CACHE STRING "")
 set(OT_NXP_BOARD "rt1170" CACHE STRING "")
 
 set(MULTICORE_LOGGING OFF CACHE BOOL "")
+set(MULTICORE_LOGGING_RING_SIZE 4096 CACHE STRING "Size in bytes of the log ring drained into the RPMsg log batches when MULTICORE_LOGGING is set, a multiple of 4")
 
 # ot-nxp host name config
 set(EVK_RT1170_BOARD "evkbmimxrt1170" CACHE STRING "")
@@ -477,9 +477,14 @@ static void appBrExternalIpv6InterfaceInit()
 
 static void appBrInit()
 {
+    otError error;
+
     otPlatLwipSetOtInstance(sInstance);
     otPlatLwipAddThreadInterface();
-    otSetStateChangedCallback(sInstance, otPlatLwipUpdateState, NULL);
+    /* Also refreshes the lwIP forwarding hooks, the OpenThread state changed handlers are limited */
+    error = otSetStateChangedCallback(sInstance, otPlatLwipUpdateState, NULL);
+    assert(error == OT_ERROR_NONE);
+    OT_UNUSED_VARIABLE(error);
 
     BrInitPlatform(sInstance, sExtNetifPtr, otPlatLwipGetOtNetif());
     BrInitMdnsHost(CreateBaseName(sInstance, sHostName, false));
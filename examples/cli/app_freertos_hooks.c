@@ -161,8 +161,11 @@ void vPortSuppressTicksAndSleep(TickType_t xExpectedIdleTime)
 
     uint32_t irqMask = DisableGlobalIRQ();
 
+    /* Wake up for the next OpenThread alarm too */
+    xExpectedIdleTime = (TickType_t)otPlatAlarmGetIdleTicks((uint32_t)xExpectedIdleTime);
+
     /* Disable and prepare systicks for low power */
-    abortIdle = PWR_SysticksPreProcess((uint32_t)xExpectedIdleTime, &expectedIdleTimeUs);
+    abortIdle = (xExpectedIdleTime == 0U) || PWR_SysticksPreProcess((uint32_t)xExpectedIdleTime, &expectedIdleTimeUs);
 
     if (abortIdle == false)
     {
@@ -34,6 +34,10 @@
 #include <openthread/cli.h>
 #include "common/logging.hpp"
 
+#ifdef OT_APP_CLI_DEBUG_MCAST
+#include "lwip_mcast.h"
+#endif
+
 /* -------------------------------------------------------------------------- */
 /*                             Private definitions                            */
 /* -------------------------------------------------------------------------- */
@@ -42,14 +46,26 @@
 /*                             Private prototypes                             */
 /* -------------------------------------------------------------------------- */
 
+static otError ProcessEventsCmd(void *aContext, uint8_t aArgsLength, char *aArgs[]);
 static otError ProcessSpiCmd(void *aContext, uint8_t aArgsLength, char *aArgs[]);
+static otError ProcessHdlcCmd(void *aContext, uint8_t aArgsLength, char *aArgs[]);
+static otError ProcessSettingsCmd(void *aContext, uint8_t aArgsLength, char *aArgs[]);
+#ifdef OT_APP_CLI_DEBUG_MCAST
+static otError ProcessMcastCmd(void *aContext, uint8_t aArgsLength, char *aArgs[]);
+#endif
 
 /* -------------------------------------------------------------------------- */
 /*                               Private memory                               */
 /* -------------------------------------------------------------------------- */
 
 static const otCliCommand debugCommands[] = {
-    {"spi", ProcessSpiCmd}, //
+    {"events", ProcessEventsCmd},     //
+    {"hdlc", ProcessHdlcCmd},         //
+#ifdef OT_APP_CLI_DEBUG_MCAST
+    {"mcast", ProcessMcastCmd},       //
+#endif
+    {"settings", ProcessSettingsCmd}, //
+    {"spi", ProcessSpiCmd},           //
 };
 
 /* -------------------------------------------------------------------------- */
@@ -91,6 +107,19 @@ otError ProcessDebug(void *aContext, uint8_t aArgsLength, char *aArgs[])
 /*                              Private functions                             */
 /* -------------------------------------------------------------------------- */
 
+static otError ProcessEventsCmd(void *aContext, uint8_t aArgsLength, char *aArgs[])
+{
+    OT_UNUSED_VARIABLE(aContext);
+    OT_UNUSED_VARIABLE(aArgsLength);
+    OT_UNUSED_VARIABLE(aArgs);
+    otError error = OT_ERROR_NONE;
+
+    otLogInfoPlat("ProcessEventsCmd");
+    error = otSysEventDiag();
+
+    return error;
+}
+
 static otError ProcessSpiCmd(void *aContext, uint8_t aArgsLength, char *aArgs[])
 {
     OT_UNUSED_VARIABLE(aContext);
@@ -103,3 +132,51 @@ static otError ProcessSpiCmd(void *aContext, uint8_t aArgsLength, char *aArgs[])
 
     return error;
 }
+
+static otError ProcessHdlcCmd(void *aContext, uint8_t aArgsLength, char *aArgs[])
+{
+    OT_UNUSED_VARIABLE(aContext);
+    OT_UNUSED_VARIABLE(aArgsLength);
+    OT_UNUSED_VARIABLE(aArgs);
+    otError error = OT_ERROR_NONE;
+
+    otLogInfoPlat("ProcessHdlcCmd");
+    error = otPlatRadioHdlcDiag();
+
+    return error;
+}
+
+static otError ProcessSettingsCmd(void *aContext, uint8_t aArgsLength, char *aArgs[])
+{
+    OT_UNUSED_VARIABLE(aContext);
+    OT_UNUSED_VARIABLE(aArgsLength);
+    OT_UNUSED_VARIABLE(aArgs);
+    otError error = OT_ERROR_NONE;
+
+    otLogInfoPlat("ProcessSettingsCmd");
+    error = otPlatSettingsDiag();
+
+    return error;
+}
+
+#ifdef OT_APP_CLI_DEBUG_MCAST
+static otError ProcessMcastCmd(void *aContext, uint8_t aArgsLength, char *aArgs[])
+{
+    OT_UNUSED_VARIABLE(aContext);
+    OT_UNUSED_VARIABLE(aArgsLength);
+    OT_UNUSED_VARIABLE(aArgs);
+    size_t       iterator = 0;
+    otIp6Address addr;
+    uint32_t     hits;
+    char         addrString[OT_IP6_ADDRESS_STRING_SIZE];
+
+    otLogInfoPlat("ProcessMcastCmd");
+    while (lwipMcastGetNextGroup(&iterator, &addr, &hits))
+    {
+        otIp6AddressToString(&addr, addrString, sizeof(addrString));
+        otCliOutputFormat("%s: %lu packets forwarded\r\n", addrString, (unsigned long)hits);
+    }
+
+    return OT_ERROR_NONE;
+}
+#endif
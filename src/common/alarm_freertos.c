@@ -52,6 +52,7 @@ static void alarmTimerCallback(TimerHandle_t pxTimer)
     alarmFired = true;
     xSemaphoreGive(mutexHandle);
     /* notify the main loop if rtos */
+    otSysEventSetPending(OT_SYS_EVENT_ALARM);
     otTaskletsSignalPending(NULL);
     OT_PLAT_DBG("alarmFired = true");
 }
@@ -171,3 +172,9 @@ uint32_t otPlatAlarmMilliGetNow(void)
     /* Return the value in ms */
     return ALARM_TIMER_TICKS_2_MS(ticks);
 }
+
+uint32_t otPlatAlarmGetIdleTicks(uint32_t aExpectedIdleTicks)
+{
+    /* The alarm is a FreeRTOS timer, already taken into account in the expected idle time */
+    return aExpectedIdleTicks;
+}
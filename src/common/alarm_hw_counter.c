@@ -0,0 +1,520 @@
+/*
+ *  Copyright (c) 2025, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the OpenThread platform abstraction for the alarm on a free running hardware counter.
+ *
+ *   The 32-bit counter is extended to 64 bits and a single compare interrupt serves the millisecond and microsecond
+ *   alarms, so the alarms do not depend on the RTOS tick and the system can stay in tickless idle until the next one.
+ *   The compare is armed at most a quarter of the counter period ahead, so that no wrap of the counter is missed.
+ */
+
+#ifndef ALARM_COUNTER_USE_SIMULATED
+#define ALARM_COUNTER_USE_SIMULATED 0
+#endif
+
+#if !ALARM_COUNTER_USE_SIMULATED
+#include "fsl_device_registers.h"
+#endif
+
+#ifndef ALARM_COUNTER_USE_GPT
+#if !ALARM_COUNTER_USE_SIMULATED && defined(FSL_FEATURE_SOC_GPT_COUNT) && FSL_FEATURE_SOC_GPT_COUNT
+#define ALARM_COUNTER_USE_GPT 1
+#else
+#define ALARM_COUNTER_USE_GPT 0
+#endif
+#endif
+
+#ifndef ALARM_COUNTER_USE_CTIMER
+#define ALARM_COUNTER_USE_CTIMER (!ALARM_COUNTER_USE_SIMULATED && !ALARM_COUNTER_USE_GPT)
+#endif
+
+#include "ot_platform_common.h"
+
+#include <openthread/tasklet.h>
+#include <openthread/platform/alarm-micro.h>
+#include <openthread/platform/alarm-milli.h>
+#include <openthread/platform/diag.h>
+#include <openthread/platform/time.h>
+
+#if ALARM_COUNTER_USE_SIMULATED
+/* Counter provided by the host test, which calls alarmCounterIsr when the compare value is reached */
+extern void     alarmSimCounterInit(void);
+extern void     alarmSimCounterDeinit(void);
+extern uint32_t alarmSimCounterRead(void);
+extern void     alarmSimCounterSetCompare(uint32_t aCompare);
+
+#define ALARM_ENTER_CRITICAL() uint32_t alarmCriticalMask = 0
+#define ALARM_EXIT_CRITICAL() (void)alarmCriticalMask
+#define ALARM_TICK_PERIOD_US 1000U
+#else
+#include <FreeRTOS.h>
+#include <assert.h>
+#include <task.h>
+
+/* Usable from tasks and interrupts, the counter interrupt must not be above configMAX_SYSCALL_INTERRUPT_PRIORITY */
+#define ALARM_ENTER_CRITICAL() UBaseType_t alarmCriticalMask = taskENTER_CRITICAL_FROM_ISR()
+#define ALARM_EXIT_CRITICAL() taskEXIT_CRITICAL_FROM_ISR(alarmCriticalMask)
+#define ALARM_TICK_PERIOD_US (1000000U / configTICK_RATE_HZ)
+#endif
+
+/* Frequency of the counter, 1 MHz gives a microsecond resolution */
+#ifndef ALARM_COUNTER_FREQ_HZ
+#define ALARM_COUNTER_FREQ_HZ 1000000U
+#endif
+
+#define ALARM_US_PER_S 1000000ULL
+#define ALARM_US_PER_MS 1000U
+/* The compare is armed at most this far ahead, so that the counter is read several times per period */
+#define ALARM_COUNTER_MAX_DELTA 0x40000000ULL
+
+typedef struct
+{
+    uint64_t      deadline; /* In counter ticks */
+    bool          armed;
+    volatile bool fired;
+} alarmTimer_t;
+
+static alarmTimer_t sMilliTimer;
+#if OPENTHREAD_CONFIG_PLATFORM_USEC_TIMER_ENABLE
+static alarmTimer_t sMicroTimer;
+#endif
+
+static uint64_t sCounterHigh;
+static uint32_t sCounterLast;
+static bool     is_initialized = false;
+
+void alarmCounterIsr(void);
+
+#if ALARM_COUNTER_USE_GPT
+#include "fsl_gpt.h"
+
+#ifndef ALARM_GPT
+#define ALARM_GPT GPT1
+#define ALARM_GPT_IRQn GPT1_IRQn
+#define ALARM_GPT_IRQHandler GPT1_IRQHandler
+#endif
+
+#ifndef ALARM_GPT_CLOCK_FREQ
+#if defined(MIMXRT1176_cm7_SERIES) || defined(MIMXRT1176_cm4_SERIES)
+#define ALARM_GPT_CLOCK_FREQ CLOCK_GetRootClockFreq(kCLOCK_Root_Gpt1)
+#else
+#define ALARM_GPT_CLOCK_FREQ CLOCK_GetFreq(kCLOCK_PerClk)
+#endif
+#endif
+
+static void alarmCounterInit(void)
+{
+    gpt_config_t gptConfig;
+    uint32_t     clockFreq = ALARM_GPT_CLOCK_FREQ;
+
+    /* A clock slower than the counter frequency would give a null divider */
+    assert(clockFreq >= ALARM_COUNTER_FREQ_HZ);
+
+    GPT_GetDefaultConfig(&gptConfig);
+    gptConfig.clockSource     = kGPT_ClockSource_Periph;
+    gptConfig.divider         = clockFreq / ALARM_COUNTER_FREQ_HZ;
+    gptConfig.enableFreeRun   = true;
+    gptConfig.enableRunInWait = true;
+    gptConfig.enableRunInStop = true;
+    gptConfig.enableRunInDoze = true;
+    GPT_Init(ALARM_GPT, &gptConfig);
+    GPT_EnableInterrupts(ALARM_GPT, kGPT_OutputCompare1InterruptEnable);
+    NVIC_SetPriority(ALARM_GPT_IRQn, configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY);
+    (void)EnableIRQ(ALARM_GPT_IRQn);
+    GPT_StartTimer(ALARM_GPT);
+}
+
+static void alarmCounterDeinit(void)
+{
+    (void)DisableIRQ(ALARM_GPT_IRQn);
+    GPT_Deinit(ALARM_GPT);
+}
+
+static uint32_t alarmCounterRead(void)
+{
+    return GPT_GetCurrentTimerCount(ALARM_GPT);
+}
+
+static void alarmCounterSetCompare(uint32_t aCompare)
+{
+    GPT_SetOutputCompareValue(ALARM_GPT, kGPT_OutputCompare_Channel1, aCompare);
+}
+
+void ALARM_GPT_IRQHandler(void)
+{
+    GPT_ClearStatusFlags(ALARM_GPT, kGPT_OutputCompare1Flag);
+    alarmCounterIsr();
+    SDK_ISR_EXIT_BARRIER;
+}
+
+#elif ALARM_COUNTER_USE_CTIMER
+#include "fsl_ctimer.h"
+
+#ifndef ALARM_CTIMER
+#define ALARM_CTIMER CTIMER3
+#define ALARM_CTIMER_INSTANCE 3U
+#define ALARM_CTIMER_IRQn CTIMER3_IRQn
+#define ALARM_CTIMER_IRQHandler CTIMER3_IRQHandler
+#endif
+
+/* The boards do not attach a clock to this CTIMER, use the 16 MHz SFRO divided down to the counter frequency */
+#ifndef ALARM_CTIMER_CLOCK_ATTACH
+#define ALARM_CTIMER_CLOCK_ATTACH kSFRO_to_CTIMER3
+#endif
+
+#ifndef ALARM_CTIMER_CLOCK_FREQ
+#define ALARM_CTIMER_CLOCK_FREQ CLOCK_GetCTimerClkFreq(ALARM_CTIMER_INSTANCE)
+#endif
+
+static void alarmCounterInit(void)
+{
+    ctimer_config_t ctimerConfig;
+    uint32_t        clockFreq;
+
+    CLOCK_AttachClk(ALARM_CTIMER_CLOCK_ATTACH);
+    clockFreq = ALARM_CTIMER_CLOCK_FREQ;
+    /* A clock slower than the counter frequency would underflow the prescaler */
+    assert(clockFreq >= ALARM_COUNTER_FREQ_HZ);
+
+    CTIMER_GetDefaultConfig(&ctimerConfig);
+    ctimerConfig.prescale = (clockFreq / ALARM_COUNTER_FREQ_HZ) - 1U;
+    CTIMER_Init(ALARM_CTIMER, &ctimerConfig);
+    ALARM_CTIMER->MCR |= CTIMER_MCR_MR0I_MASK;
+    NVIC_SetPriority(ALARM_CTIMER_IRQn, configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY);
+    (void)EnableIRQ(ALARM_CTIMER_IRQn);
+    CTIMER_StartTimer(ALARM_CTIMER);
+}
+
+static void alarmCounterDeinit(void)
+{
+    (void)DisableIRQ(ALARM_CTIMER_IRQn);
+    CTIMER_Deinit(ALARM_CTIMER);
+}
+
+static uint32_t alarmCounterRead(void)
+{
+    return CTIMER_GetTimerCountValue(ALARM_CTIMER);
+}
+
+static void alarmCounterSetCompare(uint32_t aCompare)
+{
+    ALARM_CTIMER->MR[kCTIMER_Match_0] = aCompare;
+}
+
+void ALARM_CTIMER_IRQHandler(void)
+{
+    CTIMER_ClearStatusFlags(ALARM_CTIMER, kCTIMER_Match0Flag);
+    alarmCounterIsr();
+    SDK_ISR_EXIT_BARRIER;
+}
+
+#else
+#define alarmCounterInit alarmSimCounterInit
+#define alarmCounterDeinit alarmSimCounterDeinit
+#define alarmCounterRead alarmSimCounterRead
+#define alarmCounterSetCompare alarmSimCounterSetCompare
+#endif
+
+static uint64_t alarmTicksToUs(uint64_t aTicks)
+{
+    return (aTicks / ALARM_COUNTER_FREQ_HZ) * ALARM_US_PER_S +
+           ((aTicks % ALARM_COUNTER_FREQ_HZ) * ALARM_US_PER_S) / ALARM_COUNTER_FREQ_HZ;
+}
+
+/* Rounded up, so that an alarm never fires before its time */
+static uint64_t alarmUsToTicks(uint64_t aUs)
+{
+    return (aUs / ALARM_US_PER_S) * ALARM_COUNTER_FREQ_HZ +
+           ((aUs % ALARM_US_PER_S) * ALARM_COUNTER_FREQ_HZ + ALARM_US_PER_S - 1U) / ALARM_US_PER_S;
+}
+
+/* Must be called at least once per counter period, with the critical section held */
+static uint64_t alarmCounterNow(void)
+{
+    uint32_t count = alarmCounterRead();
+
+    if (count < sCounterLast)
+    {
+        sCounterHigh += 1ULL << 32;
+    }
+    sCounterLast = count;
+
+    return sCounterHigh | count;
+}
+
+static bool alarmCheckTimer(alarmTimer_t *aTimer, uint64_t aNow, uint64_t *aNext)
+{
+    bool fired = false;
+
+    if (aTimer->armed)
+    {
+        if (aTimer->deadline <= aNow)
+        {
+            aTimer->armed = false;
+            aTimer->fired = true;
+            fired         = true;
+        }
+        else if (aTimer->deadline < *aNext)
+        {
+            *aNext = aTimer->deadline;
+        }
+    }
+
+    return fired;
+}
+
+/*
+ * Mark the expired alarms as fired and program the compare for the next one, with the critical section held.
+ * Return true if an alarm fired and the OpenThread task must be signaled.
+ */
+static bool alarmUpdate(void)
+{
+    bool     fired = false;
+    uint64_t now;
+    uint64_t next;
+    uint32_t compare;
+
+    do
+    {
+        now  = alarmCounterNow();
+        next = now + ALARM_COUNTER_MAX_DELTA;
+
+        fired |= alarmCheckTimer(&sMilliTimer, now, &next);
+#if OPENTHREAD_CONFIG_PLATFORM_USEC_TIMER_ENABLE
+        fired |= alarmCheckTimer(&sMicroTimer, now, &next);
+#endif
+
+        compare = (uint32_t)next;
+        alarmCounterSetCompare(compare);
+
+        /* The counter may have passed the compare value while it was written, check the alarms again */
+    } while ((int32_t)(compare - alarmCounterRead()) <= 0);
+
+    return fired;
+}
+
+void alarmCounterIsr(void)
+{
+    bool fired;
+
+    ALARM_ENTER_CRITICAL();
+    fired = alarmUpdate();
+    ALARM_EXIT_CRITICAL();
+
+    if (fired)
+    {
+        otSysEventSetPending(OT_SYS_EVENT_ALARM);
+        otSysEventSignalPending();
+    }
+}
+
+static void alarmStartAt(alarmTimer_t *aTimer, uint32_t aT0, uint32_t aDt, uint32_t aUnitUs)
+{
+    uint64_t nowUs;
+    uint32_t nowUnits;
+    uint32_t elapsed;
+    uint32_t remaining;
+    bool     fired;
+
+    if (!is_initialized)
+    {
+        otPlatAlarmInit();
+    }
+
+    ALARM_ENTER_CRITICAL();
+
+    nowUs    = alarmTicksToUs(alarmCounterNow());
+    nowUnits = (uint32_t)(nowUs / aUnitUs);
+    elapsed  = nowUnits - aT0;
+
+    if ((int32_t)elapsed < 0)
+    {
+        /* aT0 is in the future */
+        remaining = aDt - elapsed;
+    }
+    else
+    {
+        remaining = (elapsed < aDt) ? aDt - elapsed : 0;
+    }
+
+    aTimer->deadline = alarmUsToTicks(((nowUs / aUnitUs) + remaining) * aUnitUs);
+    aTimer->armed    = true;
+    aTimer->fired    = false;
+    fired            = alarmUpdate();
+
+    ALARM_EXIT_CRITICAL();
+
+    if (fired)
+    {
+        otSysEventSetPending(OT_SYS_EVENT_ALARM);
+        otTaskletsSignalPending(NULL);
+    }
+}
+
+static void alarmStop(alarmTimer_t *aTimer)
+{
+    ALARM_ENTER_CRITICAL();
+    aTimer->armed = false;
+    aTimer->fired = false;
+    ALARM_EXIT_CRITICAL();
+}
+
+static bool alarmTakeFired(alarmTimer_t *aTimer)
+{
+    bool fired;
+
+    ALARM_ENTER_CRITICAL();
+    fired         = aTimer->fired;
+    aTimer->fired = false;
+    ALARM_EXIT_CRITICAL();
+
+    return fired;
+}
+
+void otPlatAlarmInit(void)
+{
+    if (!is_initialized)
+    {
+        sMilliTimer.armed = false;
+        sMilliTimer.fired = false;
+#if OPENTHREAD_CONFIG_PLATFORM_USEC_TIMER_ENABLE
+        sMicroTimer.armed = false;
+        sMicroTimer.fired = false;
+#endif
+        sCounterHigh = 0;
+        sCounterLast = 0;
+        alarmCounterInit();
+        is_initialized = true;
+
+        ALARM_ENTER_CRITICAL();
+        (void)alarmUpdate();
+        ALARM_EXIT_CRITICAL();
+    }
+}
+
+void otPlatAlarmDeinit(void)
+{
+    if (is_initialized)
+    {
+        alarmCounterDeinit();
+        is_initialized = false;
+    }
+}
+
+void otPlatAlarmProcess(otInstance *aInstance)
+{
+    if (alarmTakeFired(&sMilliTimer))
+    {
+#if OPENTHREAD_CONFIG_DIAG_ENABLE
+        if (otPlatDiagModeGet())
+        {
+            otPlatDiagAlarmFired(aInstance);
+        }
+        else
+#endif
+        {
+            otPlatAlarmMilliFired(aInstance);
+        }
+    }
+
+#if OPENTHREAD_CONFIG_PLATFORM_USEC_TIMER_ENABLE
+    if (alarmTakeFired(&sMicroTimer))
+    {
+        otPlatAlarmMicroFired(aInstance);
+    }
+#endif
+}
+
+uint64_t otPlatTimeGet(void)
+{
+    uint64_t now;
+
+    ALARM_ENTER_CRITICAL();
+    now = alarmCounterNow();
+    ALARM_EXIT_CRITICAL();
+
+    return alarmTicksToUs(now);
+}
+
+void otPlatAlarmMilliStartAt(otInstance *aInstance, uint32_t aT0, uint32_t aDt)
+{
+    OT_UNUSED_VARIABLE(aInstance);
+    alarmStartAt(&sMilliTimer, aT0, aDt, ALARM_US_PER_MS);
+}
+
+void otPlatAlarmMilliStop(otInstance *aInstance)
+{
+    OT_UNUSED_VARIABLE(aInstance);
+    alarmStop(&sMilliTimer);
+}
+
+uint32_t otPlatAlarmMilliGetNow(void)
+{
+    return (uint32_t)(otPlatTimeGet() / ALARM_US_PER_MS);
+}
+
+#if OPENTHREAD_CONFIG_PLATFORM_USEC_TIMER_ENABLE
+void otPlatAlarmMicroStartAt(otInstance *aInstance, uint32_t aT0, uint32_t aDt)
+{
+    OT_UNUSED_VARIABLE(aInstance);
+    alarmStartAt(&sMicroTimer, aT0, aDt, 1U);
+}
+
+void otPlatAlarmMicroStop(otInstance *aInstance)
+{
+    OT_UNUSED_VARIABLE(aInstance);
+    alarmStop(&sMicroTimer);
+}
+
+uint32_t otPlatAlarmMicroGetNow(void)
+{
+    return (uint32_t)otPlatTimeGet();
+}
+#endif /* OPENTHREAD_CONFIG_PLATFORM_USEC_TIMER_ENABLE */
+
+uint32_t otPlatAlarmGetIdleTicks(uint32_t aExpectedIdleTicks)
+{
+    uint64_t now;
+    uint64_t next;
+    uint64_t idleTicks;
+
+    ALARM_ENTER_CRITICAL();
+    now  = alarmCounterNow();
+    next = now + ALARM_COUNTER_MAX_DELTA;
+    next = (sMilliTimer.armed && (sMilliTimer.deadline < next)) ? sMilliTimer.deadline : next;
+#if OPENTHREAD_CONFIG_PLATFORM_USEC_TIMER_ENABLE
+    next = (sMicroTimer.armed && (sMicroTimer.deadline < next)) ? sMicroTimer.deadline : next;
+#endif
+    ALARM_EXIT_CRITICAL();
+
+    idleTicks = (next > now) ? alarmTicksToUs(next - now) / ALARM_TICK_PERIOD_US : 0;
+
+    return (idleTicks < aExpectedIdleTicks) ? (uint32_t)idleTicks : aExpectedIdleTicks;
+}
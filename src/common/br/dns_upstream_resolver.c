@@ -44,14 +44,131 @@
 #include <openthread/platform/udp.h>
 #include "common/code_utils.hpp"
 #include "lwip/dns.h"
+#include "lwip/sys.h"
+#include "lwip/tcpip.h"
 #include "lwip/udp.h"
 
 /* -------------------------------------------------------------------------- */
 /*                                 Definitions                                */
 /* -------------------------------------------------------------------------- */
 
-#define MAX_CONCURRENT_TRANSACTIONS 8
-#define DNS_MSG_MAX_SIZE 512
+/* Number of queries forwarded at the same time, each one owns a UDP socket kept open for reuse */
+#ifndef OT_DNS_UPSTREAM_MAX_TRANSACTIONS
+#define OT_DNS_UPSTREAM_MAX_TRANSACTIONS 8
+#endif
+
+/* Largest query forwarded, 1232 bytes is the EDNS(0) payload size which avoids IP fragmentation */
+#ifndef OT_DNS_UPSTREAM_MAX_MSG_SIZE
+#define OT_DNS_UPSTREAM_MAX_MSG_SIZE 1232
+#endif
+
+/* Number of cached answers, set to 0 to disable the cache */
+#ifndef OT_DNS_UPSTREAM_CACHE_SIZE
+#define OT_DNS_UPSTREAM_CACHE_SIZE 8
+#endif
+
+/* Largest response stored in the cache */
+#ifndef OT_DNS_UPSTREAM_CACHE_MSG_SIZE
+#define OT_DNS_UPSTREAM_CACHE_MSG_SIZE 512
+#endif
+
+/* Upper bounds of the time answers are cached, in seconds, whatever the TTL of the records */
+#ifndef OT_DNS_UPSTREAM_CACHE_MAX_TTL
+#define OT_DNS_UPSTREAM_CACHE_MAX_TTL 3600
+#endif
+
+#ifndef OT_DNS_UPSTREAM_NEGATIVE_CACHE_MAX_TTL
+#define OT_DNS_UPSTREAM_NEGATIVE_CACHE_MAX_TTL 300
+#endif
+
+/* Period at which the list of upstream servers is read again from LwIP, in milliseconds */
+#ifndef OT_DNS_UPSTREAM_SERVER_REFRESH_INTERVAL
+#define OT_DNS_UPSTREAM_SERVER_REFRESH_INTERVAL 10000
+#endif
+
+/* Round trip time assumed for a server which has not answered yet, in milliseconds */
+#ifndef OT_DNS_UPSTREAM_INITIAL_RTT
+#define OT_DNS_UPSTREAM_INITIAL_RTT 200
+#endif
+
+#ifndef OT_DNS_UPSTREAM_MAX_RTT
+#define OT_DNS_UPSTREAM_MAX_RTT 5000
+#endif
+
+/* Bounds of the time waited for the fastest server before the query is sent to all the others, in milliseconds */
+#ifndef OT_DNS_UPSTREAM_FANOUT_MIN_TIMEOUT
+#define OT_DNS_UPSTREAM_FANOUT_MIN_TIMEOUT 100
+#endif
+
+#ifndef OT_DNS_UPSTREAM_FANOUT_MAX_TIMEOUT
+#define OT_DNS_UPSTREAM_FANOUT_MAX_TIMEOUT 1000
+#endif
+
+#define DNS_PORT 53
+#define DNS_HEADER_SIZE 12
+#define DNS_RR_FIXED_SIZE 10
+#define DNS_MSG_MAX_SIZE_NO_EDNS 512
+
+#define DNS_FLAGS1_QR 0x80
+#define DNS_FLAGS1_OPCODE 0x78
+#define DNS_FLAGS1_TC 0x02
+#define DNS_FLAGS1_RD 0x01
+#define DNS_FLAGS2_CD 0x10
+#define DNS_FLAGS2_RCODE 0x0F
+
+#define DNS_RCODE_NOERROR 0
+#define DNS_RCODE_NXDOMAIN 3
+
+#define DNS_TYPE_SOA 6
+#define DNS_TYPE_OPT 41
+#define DNS_OPT_FLAG_DO 0x8000
+
+struct dnsServer
+{
+    ip_addr_t    lwipAddr; ///< Address as configured in LwIP, IPv4 servers are kept as IPv4 to send queries.
+    otIp6Address otAddr;   ///< Address as reported by OpenThread for the responses, IPv4 mapped for IPv4 servers.
+    uint32_t     srtt;     ///< Smoothed round trip time in milliseconds, 0 if the server never answered.
+};
+
+struct dnsTransaction
+{
+    otUdpSocket             socket; ///< Kept open while the resolver runs, its context points to the transaction.
+    otPlatDnsUpstreamQuery *query;  ///< OpenThread transaction, NULL if this slot is free.
+    struct pbuf            *queryPbuf;
+    uint16_t                id;
+    uint16_t                questionLength;
+    uint16_t                maxResponseSize;
+    uint8_t                 flagsKey;
+    bool                    cacheable;
+    uint8_t                 serverCount;
+    struct dnsServer        servers[DNS_MAX_SERVERS]; ///< Servers sorted by round trip time when the query started.
+    /* Written by FanoutTimeout in the LwIP thread, only accessed with the TCPIP core locked */
+    uint32_t                sentTime[DNS_MAX_SERVERS];  ///< Time the query was last sent to each server.
+    uint8_t                 sendCount[DNS_MAX_SERVERS]; ///< Number of times the query was sent to each server.
+};
+
+struct dnsCacheEntry
+{
+    uint32_t storedAt;
+    uint32_t expireAt;
+    uint16_t length;
+    uint16_t questionLength;
+    uint8_t  flagsKey;
+    bool     valid;
+    bool     negative;
+    uint8_t  msg[OT_DNS_UPSTREAM_CACHE_MSG_SIZE];
+};
+
+/* What is learnt from walking the records of a DNS message */
+struct dnsMsgInfo
+{
+    uint16_t questionLength; ///< Length of the question section, only valid if the message has one question.
+    uint16_t udpPayloadSize; ///< Requester's UDP payload size from the OPT record, 512 without one.
+    bool     dnssecOk;
+    bool     hasSoa;
+    uint32_t minTtl; ///< Smallest TTL of the records, OPT excluded.
+    uint32_t soaTtl; ///< Negative caching TTL from the SOA record, RFC 2308.
+};
 
 /* -------------------------------------------------------------------------- */
 /*                               Private memory                               */
@@ -60,26 +177,43 @@
 static otInstance   *sInstance;
 static struct netif *sBackboneNetif;
 
-static ip_addr_t sUpstreamDnsServers[DNS_MAX_SERVERS];
-static uint8_t   mUpstreamDnsServerCount;
+static struct dnsServer sUpstreamDnsServers[DNS_MAX_SERVERS];
+static uint8_t          mUpstreamDnsServerCount;
+static uint32_t         sServerListTime;
+static bool             sServerListValid = false;
+
+static struct dnsTransaction mTransactions[OT_DNS_UPSTREAM_MAX_TRANSACTIONS];
+
+#if OT_DNS_UPSTREAM_CACHE_SIZE
+static struct dnsCacheEntry sCache[OT_DNS_UPSTREAM_CACHE_SIZE];
+static uint8_t              sResponseBuffer[OT_DNS_UPSTREAM_CACHE_MSG_SIZE];
+#endif
 
-static otUdpSocket mTransactions[MAX_CONCURRENT_TRANSACTIONS];
+static dnsUpstreamStats sStats;
 
-static const otIp6Address kAnyAddress = {
-    .mFields.m8 = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}};
 /* -------------------------------------------------------------------------- */
 /*                             Private prototypes                             */
 /* -------------------------------------------------------------------------- */
 
-static void            GetDnsServerList(void);
-static void            SendQuery(otPlatDnsUpstreamQuery *aTxn, const otMessage *aMessage);
-static void            SendResponse(otPlatDnsUpstreamQuery *aTxn, otMessage *aMessage);
-static otUdpSocket    *CreateTransaction(otPlatDnsUpstreamQuery *aTxn);
-static void            CloseTransaction(otPlatDnsUpstreamQuery *aTxn);
-static void            CancelTransaction(otPlatDnsUpstreamQuery *aTxn);
-static struct udp_pcb *CreateUdpSocket(otUdpSocket *aUdpSocket);
-static otUdpSocket    *GetTransactionSocket(otPlatDnsUpstreamQuery *aTxn);
-static void            OnUdpReceive(void *aContext, otMessage *aMessage, const otMessageInfo *aMessageInfo);
+static void                   GetDnsServerList(void);
+static void                   SendQuery(otPlatDnsUpstreamQuery *aTxn, const otMessage *aMessage);
+static void                   SendResponse(struct dnsTransaction *aTxn, otMessage *aMessage, uint8_t aServer);
+static struct dnsTransaction *CreateTransaction(otPlatDnsUpstreamQuery *aTxn);
+static void                   CloseTransaction(struct dnsTransaction *aTxn);
+static void                   CancelTransaction(otPlatDnsUpstreamQuery *aTxn);
+static struct udp_pcb        *CreateUdpSocket(otUdpSocket *aUdpSocket);
+static struct dnsTransaction *GetTransaction(otPlatDnsUpstreamQuery *aTxn);
+static void                   OnUdpReceive(void *aContext, otMessage *aMessage, const otMessageInfo *aMessageInfo);
+static void                   SendToServer(struct dnsTransaction *aTxn, uint8_t aServer);
+static void                   FanoutTimeout(void *aArg);
+static void                   UpdateServerRtt(const otIp6Address *aAddress, uint32_t aSample, bool aTimedOut);
+static void                   CountStat(uint32_t *aCounter);
+static bool    WalkMessage(uint8_t *aMsg, uint16_t aLength, uint32_t aElapsed, struct dnsMsgInfo *aInfo);
+static uint8_t GetFlagsKey(const uint8_t *aMsg);
+#if OT_DNS_UPSTREAM_CACHE_SIZE
+static bool AnswerFromCache(otPlatDnsUpstreamQuery *aTxn, const uint8_t *aQuery, const struct dnsMsgInfo *aInfo);
+static void AddToCache(struct dnsTransaction *aTxn, const otMessage *aResponse);
+#endif
 
 /* -------------------------------------------------------------------------- */
 /*                              Public functions                              */
@@ -91,6 +225,13 @@ void DnsResolverInit(otInstance *aInstance, struct netif *aBackboneNetif)
     sBackboneNetif = aBackboneNetif;
 }
 
+void DnsResolverGetStats(dnsUpstreamStats *aStats)
+{
+    LOCK_TCPIP_CORE();
+    *aStats = sStats;
+    UNLOCK_TCPIP_CORE();
+}
+
 void otPlatDnsStartUpstreamQuery(otInstance *aInstance, otPlatDnsUpstreamQuery *aTxn, const otMessage *aQuery)
 {
     OT_UNUSED_VARIABLE(aInstance);
@@ -109,94 +250,263 @@ void otPlatDnsCancelUpstreamQuery(otInstance *aInstance, otPlatDnsUpstreamQuery
 
 void GetDnsServerList()
 {
-    mUpstreamDnsServerCount = 0;
+    struct dnsServer servers[DNS_MAX_SERVERS];
+    uint8_t          count = 0;
+
+    VerifyOrExit(!sServerListValid || (mUpstreamDnsServerCount == 0) ||
+                 ((uint32_t)(sys_now() - sServerListTime) >= OT_DNS_UPSTREAM_SERVER_REFRESH_INTERVAL));
+
+    LOCK_TCPIP_CORE();
     for (uint8_t i = 0; i < DNS_MAX_SERVERS; i++)
     {
         if (!ip_addr_isany(dns_getserver(i)))
         {
-            sUpstreamDnsServers[i] = *dns_getserver(i);
-            if (IP_IS_V4_VAL(sUpstreamDnsServers[i]))
+            ip_addr_t mapped = *dns_getserver(i);
+
+            servers[count].lwipAddr = mapped;
+            if (IP_IS_V4_VAL(mapped))
             {
-                ip4_2_ipv4_mapped_ipv6(ip_2_ip6(&sUpstreamDnsServers[i]), ip_2_ip4(&sUpstreamDnsServers[i]));
-                sUpstreamDnsServers[i].type = IPADDR_TYPE_V6;
+                ip4_2_ipv4_mapped_ipv6(ip_2_ip6(&mapped), ip_2_ip4(&mapped));
             }
-            mUpstreamDnsServerCount++;
+            memcpy(servers[count].otAddr.mFields.m8, ip_2_ip6(&mapped)->addr, sizeof(servers[count].otAddr));
+            servers[count].srtt = 0;
+
+            /* Keep what was learnt about the servers which are still configured */
+            for (uint8_t j = 0; j < mUpstreamDnsServerCount; j++)
+            {
+                if (memcmp(&sUpstreamDnsServers[j].otAddr, &servers[count].otAddr, sizeof(otIp6Address)) == 0)
+                {
+                    servers[count].srtt = sUpstreamDnsServers[j].srtt;
+                }
+            }
+            count++;
         }
     }
+    UNLOCK_TCPIP_CORE();
+
+    memcpy(sUpstreamDnsServers, servers, count * sizeof(struct dnsServer));
+    mUpstreamDnsServerCount = count;
+    sServerListTime         = sys_now();
+    sServerListValid        = true;
+
+exit:
+    return;
+}
+
+/* The counters are also updated from the LwIP thread, they are only updated and read with the TCPIP core locked */
+static void CountStat(uint32_t *aCounter)
+{
+    LOCK_TCPIP_CORE();
+    (*aCounter)++;
+    UNLOCK_TCPIP_CORE();
+}
+
+static uint32_t GetServerRtt(const struct dnsServer *aServer)
+{
+    return (aServer->srtt != 0) ? aServer->srtt : OT_DNS_UPSTREAM_INITIAL_RTT;
 }
 
 static void SendQuery(otPlatDnsUpstreamQuery *aTxn, const otMessage *aQuery)
 {
-    otError      error   = OT_ERROR_NONE;
-    otUdpSocket *txn     = NULL;
-    otMessage   *message = NULL;
+    struct dnsTransaction *txn    = NULL;
+    struct pbuf           *pbuf   = NULL;
+    uint16_t               length = otMessageGetLength(aQuery);
+    struct dnsMsgInfo      info;
+    uint32_t               timeout;
 
-    otMessageInfo     messageInfo;
-    otMessageSettings msgSettings = {.mLinkSecurityEnabled = false, .mPriority = OT_MESSAGE_PRIORITY_NORMAL};
+    VerifyOrExit((length >= DNS_HEADER_SIZE) && (length <= OT_DNS_UPSTREAM_MAX_MSG_SIZE));
+    VerifyOrExit(GetTransaction(aTxn) == NULL);
 
-    char     packet[DNS_MSG_MAX_SIZE];
-    uint16_t length = otMessageGetLength(aQuery);
+    pbuf = pbuf_alloc(PBUF_TRANSPORT, length, PBUF_RAM);
+    VerifyOrExit(pbuf != NULL);
+    VerifyOrExit(otMessageRead(aQuery, 0, pbuf->payload, length) == length);
 
-    VerifyOrExit(otMessageRead(aQuery, 0, &packet, sizeof(packet)) == length, error = OT_ERROR_NO_BUFS);
+    CountStat(&sStats.mQueries);
 
-    memset(&messageInfo, 0, sizeof(otMessageInfo));
+    /* Queries asking for DNSSEC records, or with several questions, are forwarded without using the cache */
+    if (!WalkMessage(pbuf->payload, length, 0, &info))
+    {
+        info.questionLength = 0;
+        info.dnssecOk       = true;
+        info.udpPayloadSize = DNS_MSG_MAX_SIZE_NO_EDNS;
+    }
 
-    GetDnsServerList();
-    txn = CreateTransaction(aTxn);
-    VerifyOrExit(txn != NULL, error = OT_ERROR_NO_BUFS);
+#if OT_DNS_UPSTREAM_CACHE_SIZE
+    if ((info.questionLength != 0) && !info.dnssecOk && AnswerFromCache(aTxn, pbuf->payload, &info))
+    {
+        ExitNow();
+    }
+#endif
 
-    messageInfo.mPeerPort = 53;
-    messageInfo.mSockPort = txn->mSockName.mPort;
-    messageInfo.mSockAddr = kAnyAddress;
+    GetDnsServerList();
+    VerifyOrExit(mUpstreamDnsServerCount != 0);
 
+    txn = CreateTransaction(aTxn);
+    VerifyOrExit(txn != NULL, CountStat(&sStats.mNoTransaction));
+
+    txn->queryPbuf       = pbuf;
+    txn->id              = ((uint8_t *)pbuf->payload)[0] << 8 | ((uint8_t *)pbuf->payload)[1];
+    txn->questionLength  = info.questionLength;
+    txn->maxResponseSize = info.udpPayloadSize;
+    txn->flagsKey        = GetFlagsKey(pbuf->payload);
+    txn->cacheable       = (info.questionLength != 0) && !info.dnssecOk;
+    pbuf                 = NULL;
+
+    /* Servers are tried from the one which answered the fastest so far */
+    txn->serverCount = 0;
     for (uint8_t i = 0; i < mUpstreamDnsServerCount; i++)
     {
-        memcpy(&messageInfo.mPeerAddr, ip_2_ip6(&sUpstreamDnsServers[i])->addr, sizeof(messageInfo.mPeerAddr));
+        uint8_t pos = txn->serverCount++;
 
-        message = otUdpNewMessage(sInstance, &msgSettings);
-        VerifyOrExit(message != NULL, error = OT_ERROR_NO_BUFS);
+        while ((pos > 0) && (GetServerRtt(&txn->servers[pos - 1]) > GetServerRtt(&sUpstreamDnsServers[i])))
+        {
+            txn->servers[pos] = txn->servers[pos - 1];
+            pos--;
+        }
+        txn->servers[pos] = sUpstreamDnsServers[i];
+    }
+    memset(txn->sendCount, 0, sizeof(txn->sendCount));
 
-        VerifyOrExit(otMessageAppend(message, &packet, length) == OT_ERROR_NONE, error = OT_ERROR_FAILED);
+    timeout = LWIP_MIN(LWIP_MAX(2 * GetServerRtt(&txn->servers[0]), OT_DNS_UPSTREAM_FANOUT_MIN_TIMEOUT),
+                       OT_DNS_UPSTREAM_FANOUT_MAX_TIMEOUT);
 
-        error = otPlatUdpSend(txn, message, &messageInfo);
+    LOCK_TCPIP_CORE();
+    SendToServer(txn, 0);
+    sys_timeout(timeout, FanoutTimeout, txn);
+    UNLOCK_TCPIP_CORE();
+
+exit:
+    if (pbuf != NULL)
+    {
+        pbuf_free(pbuf);
     }
+    return;
+}
+
+/* Must be called with the TCPIP core locked */
+static void SendToServer(struct dnsTransaction *aTxn, uint8_t aServer)
+{
+    struct pbuf *pbuf = pbuf_clone(PBUF_TRANSPORT, PBUF_RAM, aTxn->queryPbuf);
+
+    VerifyOrExit(pbuf != NULL);
+
+    aTxn->sentTime[aServer] = sys_now();
+    aTxn->sendCount[aServer]++;
+    (void)udp_sendto((struct udp_pcb *)aTxn->socket.mHandle, pbuf, &aTxn->servers[aServer].lwipAddr, DNS_PORT);
+    pbuf_free(pbuf);
+
 exit:
-    if (error != OT_ERROR_NONE)
+    return;
+}
+
+/* Runs in the LwIP thread when the fastest server did not answer in time, asks all the other servers */
+static void FanoutTimeout(void *aArg)
+{
+    struct dnsTransaction *txn  = (struct dnsTransaction *)aArg;
+    bool                   sent = false;
+
+    VerifyOrExit(txn->queryPbuf != NULL);
+
+    /* The LwIP thread runs its timeouts with the TCPIP core locked */
+    sStats.mFanouts++;
+    for (uint8_t i = 1; i < txn->serverCount; i++)
     {
-        if (message)
-        {
-            otMessageFree(message);
-        }
+        SendToServer(txn, i);
+        sent = true;
     }
+
+    /* With a single server, retransmit the query once */
+    if (!sent)
+    {
+        SendToServer(txn, 0);
+    }
+
+exit:
     return;
 }
 
-static void SendResponse(otPlatDnsUpstreamQuery *aTxn, otMessage *aMessage)
+static void SendResponse(struct dnsTransaction *aTxn, otMessage *aMessage, uint8_t aServer)
 {
-    otPlatDnsUpstreamQueryDone(sInstance, aTxn, aMessage);
+    otPlatDnsUpstreamQuery *query = aTxn->query;
+    uint32_t                sample;
+    uint8_t                 sendCount;
+    bool                    fastestAsked;
+
+    LOCK_TCPIP_CORE();
+    sample       = sys_now() - aTxn->sentTime[aServer];
+    sendCount    = aTxn->sendCount[aServer];
+    fastestAsked = (aTxn->sendCount[0] != 0);
+    UNLOCK_TCPIP_CORE();
+
+    /* Karn's algorithm: the answer to a retransmitted query may be for any of the copies, the RTT is not sampled */
+    if (sendCount == 1)
+    {
+        UpdateServerRtt(&aTxn->servers[aServer].otAddr, sample, false);
+    }
+    if ((aServer != 0) && fastestAsked)
+    {
+        /* The fastest server known did not answer in time */
+        UpdateServerRtt(&aTxn->servers[0].otAddr, 0, true);
+    }
+
+#if OT_DNS_UPSTREAM_CACHE_SIZE
+    if (aTxn->cacheable)
+    {
+        AddToCache(aTxn, aMessage);
+    }
+#endif
+
     CloseTransaction(aTxn);
+    otPlatDnsUpstreamQueryDone(sInstance, query, aMessage);
 }
 
-static otUdpSocket *CreateTransaction(otPlatDnsUpstreamQuery *aTxn)
+static void UpdateServerRtt(const otIp6Address *aAddress, uint32_t aSample, bool aTimedOut)
 {
-    otUdpSocket *txn = NULL;
-
-    for (uint8_t i = 0; i < MAX_CONCURRENT_TRANSACTIONS; i++)
+    for (uint8_t i = 0; i < mUpstreamDnsServerCount; i++)
     {
-        if (mTransactions[i].mContext == aTxn)
+        struct dnsServer *server = &sUpstreamDnsServers[i];
+
+        if (memcmp(&server->otAddr, aAddress, sizeof(otIp6Address)) != 0)
         {
-            return NULL;
+            continue;
         }
-        if (mTransactions[i].mContext == NULL)
+
+        if (aTimedOut)
+        {
+            server->srtt = 2 * GetServerRtt(server);
+        }
+        else if (server->srtt == 0)
+        {
+            server->srtt = LWIP_MAX(aSample, 1);
+        }
+        else
+        {
+            server->srtt = LWIP_MAX((7 * server->srtt + aSample) / 8, 1);
+        }
+        server->srtt = LWIP_MIN(server->srtt, OT_DNS_UPSTREAM_MAX_RTT);
+    }
+}
+
+static struct dnsTransaction *CreateTransaction(otPlatDnsUpstreamQuery *aTxn)
+{
+    struct dnsTransaction *txn = NULL;
+
+    for (uint8_t i = 0; i < OT_DNS_UPSTREAM_MAX_TRANSACTIONS; i++)
+    {
+        if (mTransactions[i].query == NULL)
         {
-            struct udp_pcb *pcb = CreateUdpSocket(&mTransactions[i]);
-            if (pcb == NULL)
+            /* Sockets are created once and reused by the following transactions */
+            if (mTransactions[i].socket.mHandle == NULL)
             {
-                break;
+                mTransactions[i].socket.mContext = &mTransactions[i];
+                if (CreateUdpSocket(&mTransactions[i].socket) == NULL)
+                {
+                    break;
+                }
             }
 
-            txn                       = &mTransactions[i];
-            mTransactions[i].mContext = aTxn;
+            txn        = &mTransactions[i];
+            txn->query = aTxn;
             break;
         }
     }
@@ -204,31 +514,48 @@ static otUdpSocket *CreateTransaction(otPlatDnsUpstreamQuery *aTxn)
     return txn;
 }
 
-static void CloseTransaction(otPlatDnsUpstreamQuery *aTxn)
+static void CloseTransaction(struct dnsTransaction *aTxn)
 {
-    otUdpSocket *sock = NULL;
-
-    sock = GetTransactionSocket(aTxn);
-
-    if (sock)
+    LOCK_TCPIP_CORE();
+    sys_untimeout(FanoutTimeout, aTxn);
+    if (aTxn->queryPbuf != NULL)
     {
-        otPlatUdpClose(sock);
-        sock->mContext        = NULL;
-        sock->mSockName.mPort = 0;
+        pbuf_free(aTxn->queryPbuf);
+        aTxn->queryPbuf = NULL;
     }
+    UNLOCK_TCPIP_CORE();
+
+    aTxn->query = NULL;
 }
 
 static void CancelTransaction(otPlatDnsUpstreamQuery *aTxn)
 {
-    CloseTransaction(aTxn);
+    struct dnsTransaction *txn = GetTransaction(aTxn);
+    uint8_t                sendCount[DNS_MAX_SERVERS];
+
+    if (txn)
+    {
+        LOCK_TCPIP_CORE();
+        memcpy(sendCount, txn->sendCount, sizeof(sendCount));
+        UNLOCK_TCPIP_CORE();
+
+        for (uint8_t i = 0; i < txn->serverCount; i++)
+        {
+            if (sendCount[i] != 0)
+            {
+                UpdateServerRtt(&txn->servers[i].otAddr, 0, true);
+            }
+        }
+        CloseTransaction(txn);
+    }
     otPlatDnsUpstreamQueryDone(sInstance, aTxn, NULL);
 }
 
-static otUdpSocket *GetTransactionSocket(otPlatDnsUpstreamQuery *aTxn)
+static struct dnsTransaction *GetTransaction(otPlatDnsUpstreamQuery *aTxn)
 {
-    for (uint8_t i = 0; i < MAX_CONCURRENT_TRANSACTIONS; i++)
+    for (uint8_t i = 0; i < OT_DNS_UPSTREAM_MAX_TRANSACTIONS; i++)
     {
-        if (mTransactions[i].mContext == aTxn)
+        if (mTransactions[i].query == aTxn)
         {
             return &mTransactions[i];
         }
@@ -243,20 +570,318 @@ static struct udp_pcb *CreateUdpSocket(otUdpSocket *aUdpSocket)
 
     aUdpSocket->mHandler = OnUdpReceive;
     VerifyOrExit(otPlatUdpSocket(aUdpSocket) == OT_ERROR_NONE);
-    VerifyOrExit(otPlatUdpBind(aUdpSocket) == OT_ERROR_NONE);
-    VerifyOrExit(otPlatUdpBindToNetif(aUdpSocket, OT_NETIF_BACKBONE) == OT_ERROR_NONE);
+    VerifyOrExit(otPlatUdpBind(aUdpSocket) == OT_ERROR_NONE, otPlatUdpClose(aUdpSocket));
+    VerifyOrExit(otPlatUdpBindToNetif(aUdpSocket, OT_NETIF_BACKBONE) == OT_ERROR_NONE, otPlatUdpClose(aUdpSocket));
 
     pcb = (struct udp_pcb *)aUdpSocket->mHandle;
 
     aUdpSocket->mSockName.mPort = pcb->local_port;
 
+    /* Queries are sent directly with LwIP, accept both IPv4 and IPv6 servers */
+    LOCK_TCPIP_CORE();
+    if (ip_addr_isany(&pcb->local_ip))
+    {
+        pcb->local_ip.type = IPADDR_TYPE_ANY;
+    }
+    UNLOCK_TCPIP_CORE();
+
     return pcb;
 exit:
+    aUdpSocket->mHandle = NULL;
     return NULL;
 }
 
 static void OnUdpReceive(void *aContext, otMessage *aMessage, const otMessageInfo *aMessageInfo)
 {
-    OT_UNUSED_VARIABLE(aMessageInfo);
-    SendResponse(aContext, aMessage);
+    struct dnsTransaction *txn = (struct dnsTransaction *)aContext;
+    uint8_t                header[2];
+    uint8_t                server;
+
+    /* The socket is reused: drop late answers to a previous transaction and answers from unknown peers */
+    VerifyOrExit(txn->query != NULL);
+    VerifyOrExit(otMessageRead(aMessage, 0, header, sizeof(header)) == sizeof(header));
+    VerifyOrExit((header[0] << 8 | header[1]) == txn->id);
+
+    LOCK_TCPIP_CORE();
+    for (server = 0; server < txn->serverCount; server++)
+    {
+        if ((txn->sendCount[server] != 0) &&
+            (memcmp(&txn->servers[server].otAddr, &aMessageInfo->mPeerAddr, sizeof(otIp6Address)) == 0))
+        {
+            break;
+        }
+    }
+    UNLOCK_TCPIP_CORE();
+    VerifyOrExit(server < txn->serverCount);
+
+    SendResponse(txn, aMessage, server);
+    aMessage = NULL;
+
+exit:
+    if (aMessage != NULL)
+    {
+        CountStat(&sStats.mUnmatchedResponses);
+        otMessageFree(aMessage);
+    }
+}
+
+static uint16_t ReadUint16(const uint8_t *aBuffer)
+{
+    return (uint16_t)(aBuffer[0] << 8 | aBuffer[1]);
+}
+
+static uint32_t ReadUint32(const uint8_t *aBuffer)
+{
+    return (uint32_t)aBuffer[0] << 24 | (uint32_t)aBuffer[1] << 16 | (uint32_t)aBuffer[2] << 8 | aBuffer[3];
+}
+
+static bool SkipName(const uint8_t *aMsg, uint16_t aLength, uint16_t *aOffset)
+{
+    while (*aOffset < aLength)
+    {
+        uint8_t label = aMsg[*aOffset];
+
+        if ((label & 0xC0) == 0xC0)
+        {
+            *aOffset += 2;
+            return (*aOffset <= aLength);
+        }
+        if ((label & 0xC0) != 0)
+        {
+            break;
+        }
+
+        *aOffset += 1 + label;
+        if (label == 0)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static uint8_t GetFlagsKey(const uint8_t *aMsg)
+{
+    /* Answers only depend on the recursion desired and checking disabled bits of the query */
+    return (aMsg[2] & DNS_FLAGS1_RD) | (aMsg[3] & DNS_FLAGS2_CD);
+}
+
+/**
+ * Walks the records of a DNS message. TTLs are reduced by aElapsed seconds when it is not 0.
+ *
+ * Returns false if the message is malformed or does not hold a single question.
+ */
+static bool WalkMessage(uint8_t *aMsg, uint16_t aLength, uint32_t aElapsed, struct dnsMsgInfo *aInfo)
+{
+    uint16_t offset = DNS_HEADER_SIZE;
+    uint32_t records;
+
+    memset(aInfo, 0, sizeof(*aInfo));
+    aInfo->udpPayloadSize = DNS_MSG_MAX_SIZE_NO_EDNS;
+    aInfo->minTtl         = UINT32_MAX;
+
+    VerifyOrExit(aLength >= DNS_HEADER_SIZE);
+    VerifyOrExit((aMsg[2] & DNS_FLAGS1_OPCODE) == 0);
+    VerifyOrExit(ReadUint16(&aMsg[4]) == 1);
+
+    VerifyOrExit(SkipName(aMsg, aLength, &offset));
+    offset += 4;
+    VerifyOrExit(offset <= aLength);
+    aInfo->questionLength = offset - DNS_HEADER_SIZE;
+
+    records = (uint32_t)ReadUint16(&aMsg[6]) + ReadUint16(&aMsg[8]) + ReadUint16(&aMsg[10]);
+    for (uint32_t i = 0; i < records; i++)
+    {
+        uint16_t type;
+        uint32_t ttl;
+        uint16_t rdataLength;
+        uint16_t ttlOffset;
+
+        VerifyOrExit(SkipName(aMsg, aLength, &offset));
+        VerifyOrExit(offset + DNS_RR_FIXED_SIZE <= aLength);
+
+        type        = ReadUint16(&aMsg[offset]);
+        ttlOffset   = offset + 4;
+        ttl         = ReadUint32(&aMsg[ttlOffset]);
+        rdataLength = ReadUint16(&aMsg[offset + 8]);
+        offset += DNS_RR_FIXED_SIZE;
+        VerifyOrExit(offset + rdataLength <= aLength);
+
+        if (type == DNS_TYPE_OPT)
+        {
+            /* The class of the OPT record is the UDP payload size, its TTL holds the extended flags */
+            aInfo->udpPayloadSize = LWIP_MAX(ReadUint16(&aMsg[ttlOffset - 2]), DNS_MSG_MAX_SIZE_NO_EDNS);
+            aInfo->dnssecOk       = (ttl & DNS_OPT_FLAG_DO) != 0;
+        }
+        else
+        {
+            aInfo->minTtl = LWIP_MIN(aInfo->minTtl, ttl);
+
+            if ((type == DNS_TYPE_SOA) && (i >= ReadUint16(&aMsg[6])))
+            {
+                uint16_t soaOffset = offset;
+
+                if (SkipName(aMsg, offset + rdataLength, &soaOffset) &&
+                    SkipName(aMsg, offset + rdataLength, &soaOffset) && (soaOffset + 20 <= offset + rdataLength))
+                {
+                    aInfo->soaTtl = LWIP_MIN(ttl, ReadUint32(&aMsg[soaOffset + 16]));
+                    aInfo->hasSoa = true;
+                }
+            }
+
+            if (aElapsed != 0)
+            {
+                ttl = (ttl > aElapsed) ? (ttl - aElapsed) : 0;
+                aMsg[ttlOffset]     = (uint8_t)(ttl >> 24);
+                aMsg[ttlOffset + 1] = (uint8_t)(ttl >> 16);
+                aMsg[ttlOffset + 2] = (uint8_t)(ttl >> 8);
+                aMsg[ttlOffset + 3] = (uint8_t)ttl;
+            }
+        }
+
+        offset += rdataLength;
+    }
+
+    return true;
+
+exit:
+    aInfo->questionLength = 0;
+    return false;
+}
+
+#if OT_DNS_UPSTREAM_CACHE_SIZE
+static bool AnswerFromCache(otPlatDnsUpstreamQuery *aTxn, const uint8_t *aQuery, const struct dnsMsgInfo *aInfo)
+{
+    bool                  answered = false;
+    uint32_t              now      = sys_now();
+    uint8_t               flagsKey = GetFlagsKey(aQuery);
+    struct dnsCacheEntry *entry    = NULL;
+    otMessage            *message  = NULL;
+    struct dnsMsgInfo     info;
+
+    for (uint8_t i = 0; i < OT_DNS_UPSTREAM_CACHE_SIZE; i++)
+    {
+        if (!sCache[i].valid)
+        {
+            continue;
+        }
+        if ((int32_t)(now - sCache[i].expireAt) >= 0)
+        {
+            sCache[i].valid = false;
+            continue;
+        }
+        if ((sCache[i].flagsKey == flagsKey) && (sCache[i].questionLength == aInfo->questionLength) &&
+            (memcmp(&sCache[i].msg[DNS_HEADER_SIZE], &aQuery[DNS_HEADER_SIZE], aInfo->questionLength) == 0))
+        {
+            entry = &sCache[i];
+            break;
+        }
+    }
+
+    VerifyOrExit(entry != NULL);
+    VerifyOrExit(entry->length <= aInfo->udpPayloadSize);
+
+    /* Answer with the ID of the query and the TTLs reduced by the time spent in the cache */
+    memcpy(sResponseBuffer, entry->msg, entry->length);
+    sResponseBuffer[0] = aQuery[0];
+    sResponseBuffer[1] = aQuery[1];
+    (void)WalkMessage(sResponseBuffer, entry->length, (now - entry->storedAt) / 1000, &info);
+
+    message = otUdpNewMessage(sInstance, NULL);
+    VerifyOrExit(message != NULL);
+    VerifyOrExit(otMessageAppend(message, sResponseBuffer, entry->length) == OT_ERROR_NONE, otMessageFree(message));
+
+    if (entry->negative)
+    {
+        CountStat(&sStats.mNegativeCacheHits);
+    }
+    else
+    {
+        CountStat(&sStats.mCacheHits);
+    }
+
+    otPlatDnsUpstreamQueryDone(sInstance, aTxn, message);
+    answered = true;
+
+exit:
+    return answered;
+}
+
+static void AddToCache(struct dnsTransaction *aTxn, const otMessage *aResponse)
+{
+    uint16_t              length    = otMessageGetLength(aResponse);
+    uint32_t              now       = sys_now();
+    struct dnsCacheEntry *entry     = NULL;
+    struct dnsCacheEntry *freeEntry = NULL;
+    struct dnsCacheEntry *oldest    = NULL;
+    uint8_t               rcode;
+    bool                  negative;
+    uint32_t              ttl;
+    struct dnsMsgInfo     info;
+
+    VerifyOrExit(length <= sizeof(sResponseBuffer));
+    VerifyOrExit(otMessageRead(aResponse, 0, sResponseBuffer, length) == length);
+    VerifyOrExit(WalkMessage(sResponseBuffer, length, 0, &info));
+    VerifyOrExit((sResponseBuffer[2] & DNS_FLAGS1_QR) && !(sResponseBuffer[2] & DNS_FLAGS1_TC));
+    VerifyOrExit((info.questionLength == aTxn->questionLength) &&
+                 (memcmp(&sResponseBuffer[DNS_HEADER_SIZE], (uint8_t *)aTxn->queryPbuf->payload + DNS_HEADER_SIZE,
+                         info.questionLength) == 0));
+
+    rcode    = sResponseBuffer[3] & DNS_FLAGS2_RCODE;
+    negative = (rcode == DNS_RCODE_NXDOMAIN) ||
+               ((rcode == DNS_RCODE_NOERROR) && (ReadUint16(&sResponseBuffer[6]) == 0));
+
+    if (negative)
+    {
+        /* Negative answers can only be cached if the SOA record of the zone tells for how long */
+        VerifyOrExit(info.hasSoa);
+        ttl = LWIP_MIN(info.soaTtl, OT_DNS_UPSTREAM_NEGATIVE_CACHE_MAX_TTL);
+    }
+    else
+    {
+        VerifyOrExit(rcode == DNS_RCODE_NOERROR);
+        ttl = LWIP_MIN(info.minTtl, OT_DNS_UPSTREAM_CACHE_MAX_TTL);
+    }
+    VerifyOrExit(ttl != 0);
+
+    /* Replace the same question, else a free or expired entry, else the entry expiring first */
+    for (uint8_t i = 0; i < OT_DNS_UPSTREAM_CACHE_SIZE; i++)
+    {
+        struct dnsCacheEntry *candidate = &sCache[i];
+
+        if (candidate->valid && (candidate->flagsKey == aTxn->flagsKey) &&
+            (candidate->questionLength == info.questionLength) &&
+            (memcmp(&candidate->msg[DNS_HEADER_SIZE], &sResponseBuffer[DNS_HEADER_SIZE], info.questionLength) == 0))
+        {
+            entry = candidate;
+            break;
+        }
+        if (!candidate->valid || ((int32_t)(now - candidate->expireAt) >= 0))
+        {
+            freeEntry = (freeEntry != NULL) ? freeEntry : candidate;
+        }
+        else if ((oldest == NULL) || ((int32_t)(candidate->expireAt - oldest->expireAt) < 0))
+        {
+            oldest = candidate;
+        }
+    }
+
+    if (entry == NULL)
+    {
+        entry = (freeEntry != NULL) ? freeEntry : oldest;
+    }
+
+    memcpy(entry->msg, sResponseBuffer, length);
+    entry->length         = length;
+    entry->questionLength = info.questionLength;
+    entry->flagsKey       = aTxn->flagsKey;
+    entry->negative       = negative;
+    entry->storedAt       = now;
+    entry->expireAt       = now + ttl * 1000;
+    entry->valid          = true;
+
+exit:
+    return;
 }
+#endif /* OT_DNS_UPSTREAM_CACHE_SIZE */
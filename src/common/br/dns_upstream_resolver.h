@@ -36,8 +36,21 @@
 extern "C" {
 #endif
 
+/* Counters of the upstream DNS resolver */
+typedef struct dnsUpstreamStats
+{
+    uint32_t mQueries;            ///< Queries received from OpenThread.
+    uint32_t mCacheHits;          ///< Queries answered from a cached answer.
+    uint32_t mNegativeCacheHits;  ///< Queries answered from a cached NXDOMAIN or empty answer.
+    uint32_t mFanouts;            ///< Queries sent to all the servers because the fastest one did not answer in time.
+    uint32_t mNoTransaction;      ///< Queries dropped because all the transactions were in use.
+    uint32_t mUnmatchedResponses; ///< Responses dropped because they did not match a pending query.
+} dnsUpstreamStats;
+
 void DnsResolverInit(otInstance *aInstance, struct netif *aBackboneNetif);
 
+void DnsResolverGetStats(dnsUpstreamStats *aStats);
+
 #ifdef __cplusplus
 }
 #endif
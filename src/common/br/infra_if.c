@@ -38,6 +38,7 @@
 
 #include "infra_if.h"
 #include "assert.h"
+#include "lwip_tx_batch.h"
 #if OPENTHREAD_CONFIG_NAT64_TRANSLATOR_ENABLE
 #include "ot_lwip.h"
 #endif
@@ -69,10 +70,11 @@
 
 struct ndSendContext
 {
-    ip_addr_t    dstIp;
-    ip_addr_t    srcIp;
-    struct pbuf *pktBuffer;
-    uint32_t     infraIfIndex;
+    lwipTxBatchEntry link;
+    ip_addr_t        dstIp;
+    ip_addr_t        srcIp;
+    struct pbuf     *pktBuffer;
+    uint32_t         infraIfIndex;
 };
 
 /* -------------------------------------------------------------------------- */
@@ -98,7 +100,7 @@ static const uint8_t      sValidNat64PrefixLength[]  = {96, 64, 56, 48, 40, 32};
 /* -------------------------------------------------------------------------- */
 /*                             Private prototypes                             */
 /* -------------------------------------------------------------------------- */
-static void    LwipTaskCb(void *context);
+static void    LwipTaskCb(lwipTxBatchEntry *aEntry, bool aSend);
 static bool    GetAddrFromRa(const uint8_t *aBuffer,
                              uint16_t       aBufferLength,
                              ip6_addr_t    *addr,
@@ -131,6 +133,9 @@ void InfraIfInit(otInstance *aInstance, struct netif *netif)
 
     sInfraIfIndex = netif_get_index(sNetifPtr);
 
+    /* On failure, the allocation is retried by the next lwipTxBatchPost */
+    (void)lwipTxBatchInit();
+
     LOCK_TCPIP_CORE();
 
     sIcmp6RawPcb = raw_new_ip_type(IPADDR_TYPE_V6, IP6_NEXTH_ICMP6);
@@ -235,14 +240,18 @@ otError otPlatInfraIfSendIcmp6Nd(uint32_t            aInfraIfIndex,
 
     ndSendContexPtr->infraIfIndex = aInfraIfIndex;
 
-    if (ERR_OK != tcpip_callback(LwipTaskCb, (void *)ndSendContexPtr))
+    // The context is released by LwipTaskCb, even if the batch could not be posted
+    if (ERR_OK != lwipTxBatchPost(&ndSendContexPtr->link, LwipTaskCb))
     {
-        pbuf_free(ndSendContexPtr->pktBuffer);
-        otPlatFree(ndSendContexPtr);
         retError = OT_ERROR_FAILED;
     }
+    ndSendContexPtr = NULL;
 
 exit:
+    if (ndSendContexPtr != NULL)
+    {
+        otPlatFree(ndSendContexPtr);
+    }
     return retError;
 }
 
@@ -313,9 +322,11 @@ exit:
 /*                              Private functions                             */
 /* -------------------------------------------------------------------------- */
 
-static void LwipTaskCb(void *context)
+static void LwipTaskCb(lwipTxBatchEntry *aEntry, bool aSend)
 {
-    struct ndSendContext *ndSendContexPtr = (struct ndSendContext *)context;
+    struct ndSendContext *ndSendContexPtr = (struct ndSendContext *)aEntry;
+
+    VerifyOrExit(aSend);
 
     /* Parse RA and extract prefix form PIO to allow LWIP to configure IP from announced prefix. */
     /* This must be executed before raw_sendto_if_src because the payload from pktBuffer is modified
@@ -325,8 +336,9 @@ static void LwipTaskCb(void *context)
     raw_sendto_if_src(sIcmp6RawPcb, ndSendContexPtr->pktBuffer, &ndSendContexPtr->dstIp, sNetifPtr,
                       &ndSendContexPtr->srcIp);
 
+exit:
     pbuf_free(ndSendContexPtr->pktBuffer);
-    otPlatFree(context);
+    otPlatFree(ndSendContexPtr);
 }
 
 /**
@@ -28,6 +28,7 @@
 
 #include "lwip_hooks.h"
 #include "lwip_mcast.h"
+#include "ot_lwip.h"
 
 #include <assert.h>
 #include <string.h>
@@ -41,6 +42,45 @@
 #include "lwip/ip.h"
 #include "lwip/ip6.h"
 #include "lwip/stats.h"
+#include "lwip/sys.h"
+
+/* Number of slots of the OMR prefix hash table, must be a power of two */
+#ifndef OT_LWIP_HOOKS_PREFIX_TABLE_SIZE
+#define OT_LWIP_HOOKS_PREFIX_TABLE_SIZE 16
+#endif
+
+/* Number of different OMR prefix lengths held by the table, one hash lookup is done per length */
+#ifndef OT_LWIP_HOOKS_PREFIX_LENGTHS
+#define OT_LWIP_HOOKS_PREFIX_LENGTHS 2
+#endif
+
+/* Keep the table at most half full so that probe sequences stay short */
+#define PREFIX_TABLE_MAX_ENTRIES (OT_LWIP_HOOKS_PREFIX_TABLE_SIZE / 2)
+
+struct prefixKey
+{
+    uint64_t mHigh;
+    uint64_t mLow;
+};
+
+struct prefixEntry
+{
+    struct prefixKey mKey;
+    uint8_t          mLength;
+    bool             mUsed;
+};
+
+/* Copy of the network data on-mesh prefixes and mesh-local prefix used by the per-packet hooks */
+struct prefixTable
+{
+    struct prefixEntry mEntries[OT_LWIP_HOOKS_PREFIX_TABLE_SIZE];
+    struct prefixKey   mMasks[OT_LWIP_HOOKS_PREFIX_LENGTHS];
+    uint8_t            mLengths[OT_LWIP_HOOKS_PREFIX_LENGTHS];
+    uint8_t            mLengthCount;
+    bool               mOverflow; ///< Too many prefixes to be cached, the network data must be walked.
+    bool               mHasMeshLocalPrefix;
+    otMeshLocalPrefix  mMeshLocalPrefix;
+};
 
 static otInstance   *sInstance = NULL;
 static struct netif *sInfraIf  = NULL;
@@ -48,6 +88,9 @@ static struct netif *sThreadIf = NULL;
 
 static bool sLwipHooksInit = false;
 
+/* Rebuilt by the OpenThread task, read by the LwIP thread under SYS_ARCH_PROTECT */
+static struct prefixTable sPrefixTable;
+
 /**
  * @brief Checks if lwIP address matches given prefix.
  */
@@ -73,6 +116,229 @@ static int lwipAddressMatchesPrefix(const ip6_addr_t *address, const uint8_t *pr
     return ((addr[bytes] & mask) == (prefix[bytes] & mask));
 }
 
+/**
+ * @brief Returns the bits of an IPv6 address selected by a prefix mask as a table key.
+ */
+static struct prefixKey prefixKeyFromBytes(const uint8_t *bytes, const struct prefixKey *mask)
+{
+    struct prefixKey key;
+
+    memcpy(&key, bytes, sizeof(key));
+    key.mHigh &= mask->mHigh;
+    key.mLow &= mask->mLow;
+
+    return key;
+}
+
+static struct prefixKey prefixMask(uint8_t prefix_len)
+{
+    uint8_t          bytes[sizeof(struct prefixKey)] = {0};
+    struct prefixKey mask;
+
+    memset(bytes, 0xFF, prefix_len / 8U);
+    if ((prefix_len % 8U) != 0)
+    {
+        bytes[prefix_len / 8U] = (0xFFU << (8U - (prefix_len % 8U))) & 0xFFU;
+    }
+    memcpy(&mask, bytes, sizeof(mask));
+
+    return mask;
+}
+
+static uint32_t prefixHash(const struct prefixKey *key, uint8_t prefix_len)
+{
+    uint64_t hash = (key->mHigh ^ (key->mLow * 0x9E3779B97F4A7C15ULL) ^ prefix_len) * 0x9E3779B97F4A7C15ULL;
+
+    return (uint32_t)(hash >> 32) & (OT_LWIP_HOOKS_PREFIX_TABLE_SIZE - 1);
+}
+
+/**
+ * @brief Adds an on-mesh prefix to the table, returns false if the table cannot hold it.
+ */
+static bool prefixTableAdd(struct prefixTable *table, uint8_t *count, const otIp6Prefix *prefix)
+{
+    bool             added = false;
+    uint8_t          lengthIndex;
+    struct prefixKey key;
+    uint32_t         slot;
+
+    for (lengthIndex = 0; lengthIndex < table->mLengthCount; lengthIndex++)
+    {
+        if (table->mLengths[lengthIndex] == prefix->mLength)
+        {
+            break;
+        }
+    }
+
+    if (lengthIndex == table->mLengthCount)
+    {
+        VerifyOrExit(table->mLengthCount < OT_LWIP_HOOKS_PREFIX_LENGTHS);
+        table->mLengths[lengthIndex] = prefix->mLength;
+        table->mMasks[lengthIndex]   = prefixMask(prefix->mLength);
+        table->mLengthCount++;
+    }
+
+    key  = prefixKeyFromBytes(prefix->mPrefix.mFields.m8, &table->mMasks[lengthIndex]);
+    slot = prefixHash(&key, prefix->mLength);
+
+    while (table->mEntries[slot].mUsed)
+    {
+        if ((table->mEntries[slot].mLength == prefix->mLength) &&
+            (memcmp(&table->mEntries[slot].mKey, &key, sizeof(key)) == 0))
+        {
+            /* Same prefix published by several border routers */
+            ExitNow(added = true);
+        }
+        slot = (slot + 1) & (OT_LWIP_HOOKS_PREFIX_TABLE_SIZE - 1);
+    }
+
+    VerifyOrExit(*count < PREFIX_TABLE_MAX_ENTRIES);
+    table->mEntries[slot].mKey    = key;
+    table->mEntries[slot].mLength = prefix->mLength;
+    table->mEntries[slot].mUsed   = true;
+    (*count)++;
+    added = true;
+
+exit:
+    return added;
+}
+
+/**
+ * @brief Rebuilds the prefix table from the network data. Must be called from the OpenThread task.
+ */
+static void prefixTableUpdate(void)
+{
+    otNetworkDataIterator    iterator = OT_NETWORK_DATA_ITERATOR_INIT;
+    otBorderRouterConfig     config;
+    const otMeshLocalPrefix *meshLocalPrefix;
+    struct prefixTable       table;
+    uint8_t                  count = 0;
+
+    SYS_ARCH_DECL_PROTECT(lev);
+
+    memset(&table, 0, sizeof(table));
+
+    while (otNetDataGetNextOnMeshPrefix(sInstance, &iterator, &config) == OT_ERROR_NONE)
+    {
+        if (config.mDp)
+        {
+            continue;
+        }
+        if (!prefixTableAdd(&table, &count, &config.mPrefix))
+        {
+            table.mOverflow = true;
+            break;
+        }
+    }
+
+    meshLocalPrefix = otThreadGetMeshLocalPrefix(sInstance);
+    if (meshLocalPrefix != NULL)
+    {
+        table.mMeshLocalPrefix    = *meshLocalPrefix;
+        table.mHasMeshLocalPrefix = true;
+    }
+
+    SYS_ARCH_PROTECT(lev);
+    sPrefixTable = table;
+    SYS_ARCH_UNPROTECT(lev);
+}
+
+/**
+ * @brief Checks if an address is within a Thread Network OMR prefix by walking the network data.
+ */
+static int netDataHasOmrPrefix(const ip6_addr_t *address)
+{
+    otNetworkDataIterator iterator = OT_NETWORK_DATA_ITERATOR_INIT;
+    otBorderRouterConfig  config;
+
+    while (otNetDataGetNextOnMeshPrefix(sInstance, &iterator, &config) == OT_ERROR_NONE)
+    {
+        if (config.mDp)
+        {
+            continue;
+        }
+        if (lwipAddressMatchesPrefix(address, config.mPrefix.mPrefix.mFields.m8, config.mPrefix.mLength))
+        {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Checks if an address is within a Thread Network OMR prefix, one hash lookup per cached prefix length.
+ */
+static int hasOmrPrefix(const ip6_addr_t *address)
+{
+    int              found    = 0;
+    bool             overflow = false;
+    struct prefixKey key;
+    uint32_t         slot;
+
+    SYS_ARCH_DECL_PROTECT(lev);
+    SYS_ARCH_PROTECT(lev);
+
+    overflow = sPrefixTable.mOverflow;
+
+    for (uint8_t i = 0; (i < sPrefixTable.mLengthCount) && !found && !overflow; i++)
+    {
+        key  = prefixKeyFromBytes((const uint8_t *)address->addr, &sPrefixTable.mMasks[i]);
+        slot = prefixHash(&key, sPrefixTable.mLengths[i]);
+
+        while (sPrefixTable.mEntries[slot].mUsed)
+        {
+            if ((sPrefixTable.mEntries[slot].mLength == sPrefixTable.mLengths[i]) &&
+                (memcmp(&sPrefixTable.mEntries[slot].mKey, &key, sizeof(key)) == 0))
+            {
+                found = 1;
+                break;
+            }
+            slot = (slot + 1) & (OT_LWIP_HOOKS_PREFIX_TABLE_SIZE - 1);
+        }
+    }
+
+    SYS_ARCH_UNPROTECT(lev);
+
+    if (overflow)
+    {
+        found = netDataHasOmrPrefix(address);
+    }
+
+    return found;
+}
+
+/**
+ * @brief Checks if an address is within the cached mesh-local prefix.
+ */
+static int hasMeshLocalPrefix(const ip6_addr_t *address)
+{
+    int found = 0;
+
+    SYS_ARCH_DECL_PROTECT(lev);
+    SYS_ARCH_PROTECT(lev);
+    if (sPrefixTable.mHasMeshLocalPrefix)
+    {
+        found = (memcmp(address->addr, sPrefixTable.mMeshLocalPrefix.m8, OT_IP6_PREFIX_SIZE) == 0);
+    }
+    SYS_ARCH_UNPROTECT(lev);
+
+    return found;
+}
+
+void otPlatLwipHooksUpdateState(otChangedFlags flags)
+{
+    VerifyOrExit(sLwipHooksInit);
+
+    if (flags & (OT_CHANGED_THREAD_NETDATA | OT_CHANGED_THREAD_ML_ADDR | OT_CHANGED_ACTIVE_DATASET))
+    {
+        prefixTableUpdate();
+    }
+
+exit:
+    return;
+}
+
 /**
  * @brief Facilitates multicast forwarding.
  */
@@ -132,37 +398,18 @@ static int forwardMulticast(ip6_addr_t *src, ip6_addr_t *dest, struct pbuf *p, s
  */
 static int isLegalToForward(ip6_addr_t *src, ip6_addr_t *dest, struct pbuf *p, struct netif *netif)
 {
-    otNetworkDataIterator    iterator = OT_NETWORK_DATA_ITERATOR_INIT;
-    otBorderRouterConfig     config;
-    const otMeshLocalPrefix *meshLocalPrefix;
-
-    if (netif == sThreadIf)
+    if ((netif == sThreadIf) && hasOmrPrefix(dest))
     {
-        while (otNetDataGetNextOnMeshPrefix(sInstance, &iterator, &config) == OT_ERROR_NONE)
-        {
-            if (config.mDp)
-            {
-                continue;
-            }
-            if (lwipAddressMatchesPrefix(dest, config.mPrefix.mPrefix.mFields.m8, config.mPrefix.mLength))
-            {
-                /* An IPv6 packet with a destination address within the Thread Network OMR prefix is
-                 * never forwarded from the Thread Network to outside the Thread Network. */
-                return 0;
-            }
-        }
+        /* An IPv6 packet with a destination address within the Thread Network OMR prefix is
+         * never forwarded from the Thread Network to outside the Thread Network. */
+        return 0;
     }
 
-    meshLocalPrefix = otThreadGetMeshLocalPrefix(sInstance);
-    if (meshLocalPrefix != NULL)
+    if (hasMeshLocalPrefix(src) || hasMeshLocalPrefix(dest))
     {
-        if (lwipAddressMatchesPrefix(src, meshLocalPrefix->m8, OT_IP6_PREFIX_SIZE * 8U) ||
-            lwipAddressMatchesPrefix(dest, meshLocalPrefix->m8, OT_IP6_PREFIX_SIZE * 8U))
-        {
-            /* An IPv6 packet with a mesh-local source address or a mesh-local destination address
-             * is never forwarded between the Thread Network and the Adjacent Infrastructure Link. */
-            return 0;
-        }
+        /* An IPv6 packet with a mesh-local source address or a mesh-local destination address
+         * is never forwarded between the Thread Network and the Adjacent Infrastructure Link. */
+        return 0;
     }
 
     /* Otherwise - let packet be processed by lwIP forwarding rules. */
@@ -178,6 +425,9 @@ void lwipHooksInit(otInstance *aInstance, struct netif *infra, struct netif *thr
     sInfraIf  = infra;
     sThreadIf = thread;
 
+    /* The forwarding hooks only use the copy of the network data prefixes, refreshed by otPlatLwipUpdateState */
+    prefixTableUpdate();
+
     sLwipHooksInit = true;
 exit:
     return;
@@ -204,10 +454,8 @@ exit:
 
 int lwipInputHook(struct pbuf *pbuf, struct netif *input_netif)
 {
-    otNetworkDataIterator iterator = OT_NETWORK_DATA_ITERATOR_INIT;
-    otBorderRouterConfig  config;
-    struct ip6_hdr       *ip6hdr;
-    ip_addr_t             src;
+    struct ip6_hdr *ip6hdr;
+    ip_addr_t       src;
 
     if ((sThreadIf == NULL) || (sInfraIf == NULL))
         return 0;
@@ -228,20 +476,13 @@ int lwipInputHook(struct pbuf *pbuf, struct netif *input_netif)
         ip_addr_copy_from_ip6_packed(src, ip6hdr->src);
 
         /* Compare source address with OMR prefix. */
-        while (otNetDataGetNextOnMeshPrefix(sInstance, &iterator, &config) == OT_ERROR_NONE)
+        if (hasOmrPrefix(ip_2_ip6(&src)))
         {
-            if (config.mDp)
-            {
-                continue;
-            }
-            if (lwipAddressMatchesPrefix(ip_2_ip6(&src), config.mPrefix.mPrefix.mFields.m8, config.mPrefix.mLength))
-            {
-                /* Packet with source address within Thread Network OMR prefix received on a non-Thread interface. Drop
-                 * it. */
-                pbuf_free(pbuf);
-                IP6_STATS_INC(ip6.drop);
-                return 1;
-            }
+            /* Packet with source address within Thread Network OMR prefix received on a non-Thread interface. Drop
+             * it. */
+            pbuf_free(pbuf);
+            IP6_STATS_INC(ip6.drop);
+            return 1;
         }
     }
 
@@ -30,50 +30,157 @@
 
 #include <string.h>
 
-static ip6_addr_t mcastFilterAddrs[MEMP_NUM_MLD6_GROUP] = {0};
+#include "lwip/tcpip.h"
 
-bool lwipMcastFilterHas(ip6_addr_t *addr)
+/* Number of multicast groups that can be forwarded, set in lwipopts.h along with MEMP_NUM_MLD6_GROUP */
+#ifndef OT_LWIP_MCAST_MAX_GROUPS
+#define OT_LWIP_MCAST_MAX_GROUPS MEMP_NUM_MLD6_GROUP
+#endif
+
+#if OT_LWIP_MCAST_MAX_GROUPS > MEMP_NUM_MLD6_GROUP
+#error "Each forwarded multicast group needs an MLD group, MEMP_NUM_MLD6_GROUP is smaller than OT_LWIP_MCAST_MAX_GROUPS"
+#endif
+
+/*
+    Number of slots of the filter hash set, must be a power of two larger than OT_LWIP_MCAST_MAX_GROUPS.
+    By default, the smallest one keeping the set at most two thirds full, so that the probe sequences stay short.
+*/
+#ifndef OT_LWIP_MCAST_FILTER_SIZE
+#if OT_LWIP_MCAST_MAX_GROUPS * 3 / 2 < 64
+#define OT_LWIP_MCAST_FILTER_SIZE 64
+#elif OT_LWIP_MCAST_MAX_GROUPS * 3 / 2 < 128
+#define OT_LWIP_MCAST_FILTER_SIZE 128
+#elif OT_LWIP_MCAST_MAX_GROUPS * 3 / 2 < 256
+#define OT_LWIP_MCAST_FILTER_SIZE 256
+#elif OT_LWIP_MCAST_MAX_GROUPS * 3 / 2 < 512
+#define OT_LWIP_MCAST_FILTER_SIZE 512
+#else
+#define OT_LWIP_MCAST_FILTER_SIZE 1024
+#endif
+#endif
+
+#if (OT_LWIP_MCAST_FILTER_SIZE & (OT_LWIP_MCAST_FILTER_SIZE - 1)) != 0
+#error "OT_LWIP_MCAST_FILTER_SIZE must be a power of two"
+#endif
+
+#if OT_LWIP_MCAST_FILTER_SIZE <= OT_LWIP_MCAST_MAX_GROUPS
+#error "OT_LWIP_MCAST_FILTER_SIZE must be larger than OT_LWIP_MCAST_MAX_GROUPS"
+#endif
+
+struct mcastFilterEntry
 {
-    for (size_t i = 0; i < MEMP_NUM_MLD6_GROUP; i++)
+    u32_t addr[4];
+    u32_t hits; /* Packets from the infrastructure link forwarded for the group */
+    bool  used;
+};
+
+/*
+    Open addressing hash set of the groups to forward, with linear probing. Entries are only modified
+    with the TCPIP core lock held, which the LwIP thread also holds while running the forwarding hook.
+*/
+static struct mcastFilterEntry mcastFilter[OT_LWIP_MCAST_FILTER_SIZE];
+static size_t                  mcastFilterCount = 0;
+
+static size_t filterSlot(const u32_t *addr)
+{
+    u32_t hash = 2166136261U;
+
+    for (size_t i = 0; i < 4; i++)
     {
-        /*
-            Because of the bogus zone assignment in lwipMcastSubscribe,
-            only the address itself (excluding its zone) is compared.
-        */
-        if (memcmp(addr->addr, mcastFilterAddrs[i].addr, sizeof(addr->addr)) == 0)
-            return true;
+        hash = (hash ^ addr[i]) * 16777619U;
     }
 
-    return false;
+    return (hash ^ (hash >> 16)) & (OT_LWIP_MCAST_FILTER_SIZE - 1);
 }
 
-static err_t filterAdd(ip6_addr_t *addr)
+/*
+    Because of the bogus zone assignment in lwipMcastSubscribe,
+    only the address itself (excluding its zone) is compared.
+*/
+static struct mcastFilterEntry *filterFind(const u32_t *addr)
 {
-    for (size_t i = 0; i < MEMP_NUM_MLD6_GROUP; i++)
+    size_t slot = filterSlot(addr);
+
+    while (mcastFilter[slot].used)
     {
-        if (ip6_addr_eq(addr, &mcastFilterAddrs[i]))
-            return ERR_OK;
+        if (memcmp(mcastFilter[slot].addr, addr, sizeof(mcastFilter[slot].addr)) == 0)
+            return &mcastFilter[slot];
 
-        if (ip6_addr_eq(IP6_ADDR_ANY6, &mcastFilterAddrs[i]))
-        {
-            mcastFilterAddrs[i] = *addr;
+        slot = (slot + 1) & (OT_LWIP_MCAST_FILTER_SIZE - 1);
+    }
+
+    return NULL;
+}
+
+bool lwipMcastFilterHas(ip6_addr_t *addr)
+{
+    struct mcastFilterEntry *entry = filterFind(addr->addr);
+
+    if (entry == NULL)
+        return false;
+
+    /* Only a statistic, a relaxed increment is enough */
+    __atomic_fetch_add(&entry->hits, 1, __ATOMIC_RELAXED);
+    return true;
+}
+
+static err_t filterAdd(ip6_addr_t *addr, bool *added)
+{
+    size_t slot = filterSlot(addr->addr);
+
+    *added = false;
+
+    while (mcastFilter[slot].used)
+    {
+        if (memcmp(mcastFilter[slot].addr, addr->addr, sizeof(mcastFilter[slot].addr)) == 0)
             return ERR_OK;
-        }
+
+        slot = (slot + 1) & (OT_LWIP_MCAST_FILTER_SIZE - 1);
     }
 
-    return ERR_MEM;
+    if (mcastFilterCount >= OT_LWIP_MCAST_MAX_GROUPS)
+        return ERR_MEM;
+
+    memcpy(mcastFilter[slot].addr, addr->addr, sizeof(mcastFilter[slot].addr));
+    mcastFilter[slot].hits = 0;
+    mcastFilter[slot].used = true;
+    mcastFilterCount++;
+    *added = true;
+
+    return ERR_OK;
 }
 
 static void filterRemove(ip6_addr_t *addr)
 {
-    for (size_t i = 0; i < MEMP_NUM_MLD6_GROUP; i++)
+    struct mcastFilterEntry *entry = filterFind(addr->addr);
+    size_t                   hole;
+    size_t                   slot;
+
+    if (entry == NULL)
+        return;
+
+    hole = (size_t)(entry - mcastFilter);
+    slot = hole;
+
+    /* Move back the following entries of the probe sequence so that lookups never need tombstones */
+    for (;;)
     {
-        if (ip6_addr_eq(addr, &mcastFilterAddrs[i]))
+        size_t home;
+
+        slot = (slot + 1) & (OT_LWIP_MCAST_FILTER_SIZE - 1);
+        if (!mcastFilter[slot].used)
+            break;
+
+        home = filterSlot(mcastFilter[slot].addr);
+        if (((slot - home) & (OT_LWIP_MCAST_FILTER_SIZE - 1)) >= ((slot - hole) & (OT_LWIP_MCAST_FILTER_SIZE - 1)))
         {
-            ip6_addr_set_any(&mcastFilterAddrs[i]);
-            return;
+            mcastFilter[hole] = mcastFilter[slot];
+            hole              = slot;
         }
     }
+
+    mcastFilter[hole].used = false;
+    mcastFilterCount--;
 }
 
 err_t lwipMcastSubscribe(otIp6Address *addr, struct netif *ifInfra)
@@ -95,12 +202,23 @@ err_t lwipMcastSubscribe(otIp6Address *addr, struct netif *ifInfra)
                                     [2] = addr->mFields.m32[2],
                                     [3] = addr->mFields.m32[3]},
                            .zone = 255};
+    bool       added;
+
+    LOCK_TCPIP_CORE();
+
+    err_t status = filterAdd(&lwipAddr, &added);
+    if (status == ERR_OK)
+    {
+        status = mld6_joingroup_netif(ifInfra, &lwipAddr);
+
+        /* Do not forward a group whose MLD membership could not be allocated */
+        if ((status != ERR_OK) && added)
+            filterRemove(&lwipAddr);
+    }
 
-    err_t status = filterAdd(&lwipAddr);
-    if (status != ERR_OK)
-        return status;
+    UNLOCK_TCPIP_CORE();
 
-    return mld6_joingroup_netif(ifInfra, &lwipAddr);
+    return status;
 }
 
 err_t lwipMcastUnsubscribe(otIp6Address *addr, struct netif *ifInfra)
@@ -111,10 +229,36 @@ err_t lwipMcastUnsubscribe(otIp6Address *addr, struct netif *ifInfra)
                                     [3] = addr->mFields.m32[3]},
                            .zone = 255};
 
+    LOCK_TCPIP_CORE();
+
     err_t status = mld6_leavegroup_netif(ifInfra, &lwipAddr);
-    if (status != ERR_OK)
-        return status;
+    if (status == ERR_OK)
+        filterRemove(&lwipAddr);
 
-    filterRemove(&lwipAddr);
-    return ERR_OK;
+    UNLOCK_TCPIP_CORE();
+
+    return status;
+}
+
+bool lwipMcastGetNextGroup(size_t *iterator, otIp6Address *addr, uint32_t *hits)
+{
+    bool found = false;
+
+    LOCK_TCPIP_CORE();
+
+    for (; *iterator < OT_LWIP_MCAST_FILTER_SIZE; (*iterator)++)
+    {
+        if (mcastFilter[*iterator].used)
+        {
+            memcpy(addr->mFields.m32, mcastFilter[*iterator].addr, sizeof(addr->mFields.m32));
+            *hits = __atomic_load_n(&mcastFilter[*iterator].hits, __ATOMIC_RELAXED);
+            (*iterator)++;
+            found = true;
+            break;
+        }
+    }
+
+    UNLOCK_TCPIP_CORE();
+
+    return found;
 }
@@ -45,6 +45,16 @@ err_t lwipMcastUnsubscribe(otIp6Address *addr, struct netif *ifInfra);
 
 bool lwipMcastFilterHas(ip6_addr_t *addr);
 
+/**
+ * @brief Gets the next forwarded multicast group and the number of packets forwarded for it.
+ *
+ * @param[inout] iterator Iterator, set to 0 to get the first group.
+ * @param[out] addr Address of the group.
+ * @param[out] hits Number of packets from the infrastructure link which matched the group.
+ * @return true if a group was returned, false if there are no more groups.
+ */
+bool lwipMcastGetNextGroup(size_t *iterator, otIp6Address *addr, uint32_t *hits);
+
 #ifdef __cplusplus
 }
 #endif
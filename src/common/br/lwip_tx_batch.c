@@ -0,0 +1,187 @@
+/*
+ *  Copyright (c) 2024, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the batching of the border router transmits into a single LwIP callback.
+ *
+ *   Every otPlatUdpSend or otPlatInfraIfSendIcmp6Nd call used to post its own tcpip_callback, costing a
+ *   mailbox slot, a TCPIP_MSG_API allocation and a context switch per packet. The senders now push their
+ *   contexts to a lock-free list and only the first entry of a batch posts the preallocated callback message,
+ *   which sends everything queued until the LwIP thread runs it.
+ *
+ */
+
+/* -------------------------------------------------------------------------- */
+/*                                  Includes                                  */
+/* -------------------------------------------------------------------------- */
+
+#include "lwip_tx_batch.h"
+
+#include <stddef.h>
+
+#include "lwip/tcpip.h"
+
+#include "common/code_utils.hpp"
+
+/* -------------------------------------------------------------------------- */
+/*                               Private memory                               */
+/* -------------------------------------------------------------------------- */
+
+static struct tcpip_callback_msg *sCallbackMsg = NULL;
+
+/* Entries waiting for the LwIP thread, most recent first */
+static lwipTxBatchEntry *sPending = NULL;
+
+/* Set while the callback message is posted and did not start draining sPending yet */
+static bool sScheduled = false;
+
+static lwipTxBatchStats sStats;
+
+/* -------------------------------------------------------------------------- */
+/*                             Private prototypes                             */
+/* -------------------------------------------------------------------------- */
+
+static lwipTxBatchEntry *takePending(void);
+static void              lwipTaskCb(void *context);
+
+/* -------------------------------------------------------------------------- */
+/*                              Public functions                              */
+/* -------------------------------------------------------------------------- */
+
+err_t lwipTxBatchInit(void)
+{
+    err_t error = ERR_OK;
+
+    VerifyOrExit(sCallbackMsg == NULL);
+
+    sCallbackMsg = tcpip_callbackmsg_new(lwipTaskCb, NULL);
+    VerifyOrExit(sCallbackMsg != NULL, error = ERR_MEM);
+
+exit:
+    return error;
+}
+
+err_t lwipTxBatchPost(lwipTxBatchEntry *aEntry, lwipTxBatchHandler aHandler)
+{
+    err_t             error = ERR_OK;
+    lwipTxBatchEntry *entry;
+
+    aEntry->handler = aHandler;
+    aEntry->next    = __atomic_load_n(&sPending, __ATOMIC_RELAXED);
+    while (!__atomic_compare_exchange_n(&sPending, &aEntry->next, aEntry, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+    {
+    }
+    __atomic_fetch_add(&sStats.mPosted, 1, __ATOMIC_RELAXED);
+
+    /* Only the first entry after the LwIP thread started draining posts the callback again */
+    VerifyOrExit(!__atomic_exchange_n(&sScheduled, true, __ATOMIC_SEQ_CST));
+
+    /* Only one poster gets here at a time, retry the allocation if it failed in lwipTxBatchInit */
+    if (sCallbackMsg == NULL)
+    {
+        (void)lwipTxBatchInit();
+    }
+
+    error = (sCallbackMsg != NULL) ? tcpip_callbackmsg_trycallback(sCallbackMsg) : ERR_MEM;
+    VerifyOrExit(error != ERR_OK);
+
+    /* Nothing will drain the list, release what is pending so the next post can try again */
+    __atomic_fetch_add(&sStats.mPostFailed, 1, __ATOMIC_RELAXED);
+    __atomic_store_n(&sScheduled, false, __ATOMIC_SEQ_CST);
+
+    entry = takePending();
+    while (entry != NULL)
+    {
+        lwipTxBatchEntry *next = entry->next;
+
+        __atomic_fetch_add(&sStats.mDropped, 1, __ATOMIC_RELAXED);
+        entry->handler(entry, false);
+        entry = next;
+    }
+
+exit:
+    return error;
+}
+
+void lwipTxBatchGetStats(lwipTxBatchStats *aStats)
+{
+    aStats->mPosted     = __atomic_load_n(&sStats.mPosted, __ATOMIC_RELAXED);
+    aStats->mBatches    = sStats.mBatches;
+    aStats->mMaxBatch   = sStats.mMaxBatch;
+    aStats->mPostFailed = __atomic_load_n(&sStats.mPostFailed, __ATOMIC_RELAXED);
+    aStats->mDropped    = __atomic_load_n(&sStats.mDropped, __ATOMIC_RELAXED);
+}
+
+/* -------------------------------------------------------------------------- */
+/*                              Private functions                             */
+/* -------------------------------------------------------------------------- */
+
+/* Detaches the pending entries and returns them in the order they were posted */
+static lwipTxBatchEntry *takePending(void)
+{
+    lwipTxBatchEntry *entry    = __atomic_exchange_n(&sPending, NULL, __ATOMIC_ACQUIRE);
+    lwipTxBatchEntry *reversed = NULL;
+
+    while (entry != NULL)
+    {
+        lwipTxBatchEntry *next = entry->next;
+
+        entry->next = reversed;
+        reversed    = entry;
+        entry       = next;
+    }
+
+    return reversed;
+}
+
+static void lwipTaskCb(void *context)
+{
+    (void)context;
+    lwipTxBatchEntry *entry;
+    uint32_t          count = 0;
+
+    /* Cleared before taking the list: an entry posted from now on either is taken below or posts a new callback */
+    __atomic_store_n(&sScheduled, false, __ATOMIC_SEQ_CST);
+
+    entry = takePending();
+    while (entry != NULL)
+    {
+        lwipTxBatchEntry *next = entry->next;
+
+        entry->handler(entry, true);
+        entry = next;
+        count++;
+    }
+
+    sStats.mBatches++;
+    if (count > sStats.mMaxBatch)
+    {
+        sStats.mMaxBatch = count;
+    }
+}
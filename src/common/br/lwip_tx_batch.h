@@ -0,0 +1,95 @@
+/*
+ *  Copyright (c) 2024, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __LWIP_TX_BATCH_H__
+#define __LWIP_TX_BATCH_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "lwip/err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct lwipTxBatchEntry;
+
+/**
+ * Called from the LwIP thread for each queued entry.
+ *
+ * @param[in] aEntry  The entry to transmit and release.
+ * @param[in] aSend   False if the batch could not be posted to the LwIP thread and the entry must only be released.
+ */
+typedef void (*lwipTxBatchHandler)(struct lwipTxBatchEntry *aEntry, bool aSend);
+
+/* Link to embed as the first member of a send context queued with lwipTxBatchPost */
+typedef struct lwipTxBatchEntry
+{
+    struct lwipTxBatchEntry *next;
+    lwipTxBatchHandler       handler;
+} lwipTxBatchEntry;
+
+/* Counters of the transmits batched into one LwIP callback */
+typedef struct lwipTxBatchStats
+{
+    uint32_t mPosted;     ///< Entries queued.
+    uint32_t mBatches;    ///< Callbacks run by the LwIP thread.
+    uint32_t mMaxBatch;   ///< Largest number of entries handled by one callback.
+    uint32_t mPostFailed; ///< Callbacks that could not be posted to the LwIP mailbox.
+    uint32_t mDropped;    ///< Entries released without being sent because the callback could not be posted.
+} lwipTxBatchStats;
+
+/**
+ * Allocates the LwIP callback message used to run the batches, should be called before lwipTxBatchPost.
+ * If the allocation fails, lwipTxBatchPost tries again.
+ *
+ * @return ERR_OK on success, ERR_MEM otherwise.
+ */
+err_t lwipTxBatchInit(void);
+
+/**
+ * Queues a send context for the LwIP thread. Entries posted before the LwIP thread runs the pending
+ * batch are handled by the same callback, in the order they were posted.
+ *
+ * The entry is owned by the batch once posted: if the callback cannot be posted to the LwIP mailbox, all the
+ * pending entries are released by calling their handler with aSend set to false.
+ *
+ * @param[in] aEntry    The entry to queue, it must stay valid until the handler is called.
+ * @param[in] aHandler  The function transmitting and releasing the entry.
+ *
+ * @return ERR_OK if the entry was queued, an error if the pending entries were dropped.
+ */
+err_t lwipTxBatchPost(lwipTxBatchEntry *aEntry, lwipTxBatchHandler aHandler);
+
+void lwipTxBatchGetStats(lwipTxBatchStats *aStats);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* __LWIP_TX_BATCH_H__ */
@@ -41,7 +41,9 @@
 #include "br_rtos_manager.h"
 #include "udp_plat.h"
 #include "utils.h"
+#include <stddef.h>
 #include <string.h>
+#include <openthread/dns.h>
 #include <openthread/ip6.h>
 #include <openthread/link.h>
 #include <openthread/mdns.h>
@@ -73,15 +75,29 @@
 
 #define TXT_DATA_SIZE 24
 
+/* Number of buckets of each peer index, must be a power of two */
+#ifndef OT_TREL_PEER_HASH_SIZE
+#define OT_TREL_PEER_HASH_SIZE 32
+#endif
+
+#if (OT_TREL_PEER_HASH_SIZE & (OT_TREL_PEER_HASH_SIZE - 1)) != 0
+#error "OT_TREL_PEER_HASH_SIZE must be a power of two"
+#endif
+
 struct Peer
 {
     list_element_t        link;
-    const char           *mPeerServiceInstance;
-    const char           *mPeerHostName;
+    struct Peer          *mNextByServiceInstance; ///< Next peer in the same sPeersByServiceInstance bucket.
+    struct Peer          *mNextByHostName;        ///< Next peer in the same sPeersByHostName bucket.
+    struct Peer          *mNextBySockAddr;        ///< Next peer in the same sPeersBySockAddr bucket.
+    char                  mPeerServiceInstance[OT_DNS_MAX_LABEL_SIZE];
+    char                  mPeerHostName[OT_DNS_MAX_LABEL_SIZE]; ///< Empty until the SRV record is resolved.
     uint8_t               mTxtData[TXT_DATA_SIZE];
     uint8_t               mTxtLength;
     uint16_t              mPort;
+    bool                  mHasSockAddr;
     otSockAddr            mSockAddr;
+    trelPlatPeerCounters  mCounters;
     otMdnsSrvResolver     mSrvResolver;
     otMdnsTxtResolver     mTxtResolver;
     otMdnsAddressResolver mAddrResolver;
@@ -101,13 +117,15 @@ static otMdnsBrowser      trelBrowser;
 static const char         sTrelServiceLabel[] = "_trel._udp";
 static uint8_t            sTrelTxtData[TXT_DATA_SIZE];
 static otPlatTrelCounters sCounters;
-static uint8_t            sPeerNumber;
+static uint32_t           sPeerNumber;
 
 static list_label_t sPeerList;
 static OSA_MUTEX_HANDLE_DEFINE(sMutexHandle);
 
-static const otIp6Address kAnyAddress = {
-    .mFields.m8 = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}};
+/* Indexes of the peers of sPeerList, chained through the mNextBy* members */
+static struct Peer *sPeersByServiceInstance[OT_TREL_PEER_HASH_SIZE];
+static struct Peer *sPeersByHostName[OT_TREL_PEER_HASH_SIZE];
+static struct Peer *sPeersBySockAddr[OT_TREL_PEER_HASH_SIZE];
 
 /* -------------------------------------------------------------------------- */
 /*                             Private prototypes                             */
@@ -122,9 +140,12 @@ static bool TrelStartBrowser();
 static void TrelSocketReceive(void *aContext, otMessage *aMessage, const otMessageInfo *aMessageInfo);
 
 static void         removeAndFreeInternalPeerListEntry(list_element_handle_t aListElement);
-static otError      createAndAppendPeerListEntry(struct Peer aPeer);
+static struct Peer *createAndAppendPeerListEntry(const char *aServiceInstanceName);
 static struct Peer *findPeerByServiceInstance(const char *aServiceInstanceName);
 static struct Peer *findPeerByHostName(const char *aHostName);
+static struct Peer *findPeerBySockAddr(const otSockAddr *aSockAddr);
+static void         setPeerHostName(struct Peer *aPeer, const char *aHostName);
+static void         setPeerSockAddr(struct Peer *aPeer, const otSockAddr *aSockAddr);
 static void         RemoveAllPeersAndNotify();
 static void         RemoveTrelServiceInstance(struct Peer *aElement);
 static void         AddTrelServiceInstance(const char *aServiceInstanceName);
@@ -241,35 +262,47 @@ void otPlatTrelSend(otInstance       *aInstance,
 {
     OT_UNUSED_VARIABLE(aInstance);
 
-    otMessage    *message;
-    otMessageInfo messageInfo;
-    memset(&messageInfo, 0, sizeof(otMessageInfo));
-    otMessageSettings msgSettings = {.mLinkSecurityEnabled = false, .mPriority = OT_MESSAGE_PRIORITY_NORMAL};
+    struct Peer    *peer;
+    struct pbuf    *pbuf;
+    struct udp_pcb *pcb = (struct udp_pcb *)sTrelSocket.mHandle;
+    ip_addr_t       destAddr;
+    err_t           err = ERR_MEM;
 
     VerifyOrExit(sTrelEnabled);
 
-    message = otUdpNewMessage(sInstance, &msgSettings);
-    VerifyOrExit(message != NULL);
-    if (otMessageAppend(message, aUdpPayload, aUdpPayloadLen) != OT_ERROR_NONE)
+    peer = findPeerBySockAddr(aDestSockAddr);
+
+    ip_addr_copy_from_ip6_packed(destAddr, *(const ip6_addr_p_t *)aDestSockAddr->mAddress.mFields.m8);
+    ip6_addr_assign_zone(ip_2_ip6(&destAddr), IP6_UNICAST, sBackboneNetifPtr);
+
+    /* Send the frame directly from a pbuf, with the TCPIP core lock instead of an otMessage and a LwIP callback */
+    LOCK_TCPIP_CORE();
+    pbuf = pbuf_alloc(PBUF_TRANSPORT, aUdpPayloadLen, PBUF_RAM);
+    if (pbuf != NULL)
     {
-        otMessageFree(message);
-        ++sCounters.mTxFailure;
-        return;
+        memcpy(pbuf->payload, aUdpPayload, aUdpPayloadLen);
+        err = udp_sendto(pcb, pbuf, &destAddr, aDestSockAddr->mPort);
+        pbuf_free(pbuf);
     }
+    UNLOCK_TCPIP_CORE();
 
-    messageInfo.mPeerAddr = aDestSockAddr->mAddress;
-    messageInfo.mPeerPort = aDestSockAddr->mPort;
-    messageInfo.mSockPort = sTrelSocket.mSockName.mPort;
-    messageInfo.mSockAddr = kAnyAddress;
-
-    if (otPlatUdpSend(&sTrelSocket, message, &messageInfo) == OT_ERROR_NONE)
+    if (err == ERR_OK)
     {
         ++sCounters.mTxPackets;
         sCounters.mTxBytes += aUdpPayloadLen;
+        if (peer != NULL)
+        {
+            ++peer->mCounters.mTxPackets;
+            peer->mCounters.mTxBytes += aUdpPayloadLen;
+        }
     }
     else
     {
         ++sCounters.mTxFailure;
+        if (peer != NULL)
+        {
+            ++peer->mCounters.mTxFailure;
+        }
     }
 
 exit:
@@ -301,6 +334,30 @@ void otPlatTrelResetCounters(otInstance *aInstance)
 {
     OT_UNUSED_VARIABLE(aInstance);
     memset(&sCounters, 0, sizeof(sCounters));
+
+    for (list_element_handle_t element = LIST_GetHead(&sPeerList); element != NULL; element = LIST_GetNext(element))
+    {
+        memset(&((struct Peer *)element)->mCounters, 0, sizeof(trelPlatPeerCounters));
+    }
+}
+
+bool TrelPlatGetNextPeer(const void **aIterator, trelPlatPeerInfo *aPeerInfo)
+{
+    list_element_handle_t element;
+    struct Peer          *peer;
+
+    element = (*aIterator == NULL) ? LIST_GetHead(&sPeerList) : LIST_GetNext((list_element_handle_t)*aIterator);
+    VerifyOrExit(element != NULL);
+
+    peer                        = (struct Peer *)element;
+    aPeerInfo->mServiceInstance = peer->mPeerServiceInstance;
+    aPeerInfo->mSockAddr        = peer->mSockAddr;
+    aPeerInfo->mHasSockAddr     = peer->mHasSockAddr;
+    aPeerInfo->mCounters        = peer->mCounters;
+
+exit:
+    *aIterator = element;
+    return element != NULL;
 }
 
 /* -------------------------------------------------------------------------- */
@@ -322,12 +379,20 @@ static void TrelSocketReceive(void *aContext, otMessage *aMessage, const otMessa
 {
     OT_UNUSED_VARIABLE(aContext);
 
-    uint16_t messageLen     = otMessageGetLength(aMessage);
-    uint8_t *rxPacketBuffer = (uint8_t *)otPlatCAlloc(1, messageLen);
+    uint16_t     messageLen     = otMessageGetLength(aMessage);
+    uint8_t     *rxPacketBuffer = (uint8_t *)otPlatCAlloc(1, messageLen);
+    otSockAddr   sockAddr       = {.mAddress = aMessageInfo->mPeerAddr, .mPort = aMessageInfo->mPeerPort};
+    struct Peer *peer           = findPeerBySockAddr(&sockAddr);
+
     otMessageRead(aMessage, 0, rxPacketBuffer, messageLen);
     otMessageFree(aMessage);
     ++sCounters.mRxPackets;
     sCounters.mRxBytes += messageLen;
+    if (peer != NULL)
+    {
+        ++peer->mCounters.mRxPackets;
+        peer->mCounters.mRxBytes += messageLen;
+    }
     otPlatTrelHandleReceived(sInstance, rxPacketBuffer, messageLen);
     otPlatFree(rxPacketBuffer);
 }
@@ -359,10 +424,10 @@ static void HandleServiceResolveResult(otInstance *aInstance, const otMdnsSrvRes
 {
     VerifyOrExit(sTrelEnabled);
     struct Peer *element = findPeerByServiceInstance(aResult->mServiceInstance);
-    if (element)
+    if (element && (aResult->mHostName != NULL))
     {
-        element->mPeerHostName           = aResult->mHostName;
-        element->mAddrResolver.mHostName = aResult->mHostName;
+        setPeerHostName(element, aResult->mHostName);
+        element->mAddrResolver.mHostName = element->mPeerHostName;
         element->mPort                   = aResult->mPort;
         otMdnsStartTxtResolver(sInstance, &element->mTxtResolver);
     }
@@ -376,9 +441,12 @@ static void HandleServiceTxtResolveResult(otInstance *aInstance, const otMdnsTxt
     struct Peer *element = findPeerByServiceInstance(aResult->mServiceInstance);
     if (element)
     {
+        uint16_t txtLength = (aResult->mTxtDataLength < sizeof(element->mTxtData)) ? aResult->mTxtDataLength
+                                                                                    : sizeof(element->mTxtData);
+
         memset(element->mTxtData, 0, sizeof(element->mTxtData));
-        memcpy(element->mTxtData, aResult->mTxtData, aResult->mTxtDataLength);
-        element->mTxtLength = aResult->mTxtDataLength;
+        memcpy(element->mTxtData, aResult->mTxtData, txtLength);
+        element->mTxtLength = (uint8_t)txtLength;
         otMdnsStartIp6AddressResolver(sInstance, &element->mAddrResolver);
     }
 exit:
@@ -390,6 +458,7 @@ static void HandleIp6AddressResolver(otInstance *aInstance, const otMdnsAddressR
     VerifyOrExit(sTrelEnabled);
     struct Peer       *element         = findPeerByHostName(aResult->mHostName);
     otIp6Address       selectedAddress = {.mFields = 0};
+    otSockAddr         sockAddr;
     otPlatTrelPeerInfo peer;
 
     if (element)
@@ -406,7 +475,9 @@ static void HandleIp6AddressResolver(otInstance *aInstance, const otMdnsAddressR
                 selectedAddress = aResult->mAddresses[i].mAddress;
             }
         }
-        memcpy(&element->mSockAddr, &selectedAddress, sizeof(peer.mSockAddr.mAddress));
+        sockAddr.mAddress = selectedAddress;
+        sockAddr.mPort    = element->mPort;
+        setPeerSockAddr(element, &sockAddr);
 
         peer.mRemoved        = false;
         peer.mSockAddr.mPort = element->mPort;
@@ -420,57 +491,169 @@ exit:
     return;
 }
 
-static otError createAndAppendPeerListEntry(struct Peer aPeer)
+static uint32_t hashBytes(uint32_t aHash, const void *aData, size_t aLength)
+{
+    const uint8_t *data = (const uint8_t *)aData;
+
+    for (size_t i = 0; i < aLength; i++)
+    {
+        aHash = (aHash ^ data[i]) * 16777619U;
+    }
+
+    return aHash;
+}
+
+static struct Peer **serviceInstanceBucket(const char *aServiceInstanceName)
+{
+    return &sPeersByServiceInstance[hashBytes(2166136261U, aServiceInstanceName, strlen(aServiceInstanceName)) &
+                                    (OT_TREL_PEER_HASH_SIZE - 1)];
+}
+
+static struct Peer **hostNameBucket(const char *aHostName)
+{
+    return &sPeersByHostName[hashBytes(2166136261U, aHostName, strlen(aHostName)) & (OT_TREL_PEER_HASH_SIZE - 1)];
+}
+
+static struct Peer **sockAddrBucket(const otSockAddr *aSockAddr)
+{
+    uint32_t hash = hashBytes(2166136261U, aSockAddr->mAddress.mFields.m8, sizeof(aSockAddr->mAddress));
+
+    hash = hashBytes(hash, &aSockAddr->mPort, sizeof(aSockAddr->mPort));
+    return &sPeersBySockAddr[hash & (OT_TREL_PEER_HASH_SIZE - 1)];
+}
+
+/* Removes a peer from an index bucket, aNextOffset is the offset of the member chaining the bucket */
+static void unlinkPeer(struct Peer **aBucket, struct Peer *aPeer, size_t aNextOffset)
+{
+    while (*aBucket != NULL)
+    {
+        struct Peer **next = (struct Peer **)((uint8_t *)*aBucket + aNextOffset);
+
+        if (*aBucket == aPeer)
+        {
+            *aBucket = *next;
+            *next    = NULL;
+            break;
+        }
+        aBucket = next;
+    }
+}
+
+static void setPeerHostName(struct Peer *aPeer, const char *aHostName)
+{
+    VerifyOrExit(strcmp(aPeer->mPeerHostName, aHostName) != 0);
+
+    if (aPeer->mPeerHostName[0] != '\0')
+    {
+        unlinkPeer(hostNameBucket(aPeer->mPeerHostName), aPeer, offsetof(struct Peer, mNextByHostName));
+    }
+
+    /* A host name which does not fit is left empty, its addresses are then not resolved */
+    aPeer->mPeerHostName[0] = '\0';
+    VerifyOrExit(strlen(aHostName) < sizeof(aPeer->mPeerHostName));
+    strcpy(aPeer->mPeerHostName, aHostName);
+
+    aPeer->mNextByHostName                = *hostNameBucket(aPeer->mPeerHostName);
+    *hostNameBucket(aPeer->mPeerHostName) = aPeer;
+
+exit:
+    return;
+}
+
+static void setPeerSockAddr(struct Peer *aPeer, const otSockAddr *aSockAddr)
+{
+    if (aPeer->mHasSockAddr)
+    {
+        unlinkPeer(sockAddrBucket(&aPeer->mSockAddr), aPeer, offsetof(struct Peer, mNextBySockAddr));
+    }
+
+    aPeer->mSockAddr           = *aSockAddr;
+    aPeer->mHasSockAddr        = true;
+    aPeer->mNextBySockAddr     = *sockAddrBucket(aSockAddr);
+    *sockAddrBucket(aSockAddr) = aPeer;
+}
+
+static struct Peer *createAndAppendPeerListEntry(const char *aServiceInstanceName)
 {
-    list_status_t result  = kLIST_Ok;
-    struct Peer  *newPeer = (struct Peer *)otPlatCAlloc(1, sizeof(struct Peer));
+    list_status_t result  = kLIST_Full;
+    struct Peer  *newPeer = NULL;
+
+    VerifyOrExit(strlen(aServiceInstanceName) < sizeof(newPeer->mPeerServiceInstance));
+
+    newPeer = (struct Peer *)otPlatCAlloc(1, sizeof(struct Peer));
     VerifyOrExit(newPeer != NULL);
 
-    memcpy(newPeer, &aPeer, sizeof(aPeer));
+    /* Keep a copy of the name, the mDNS result only lives during the callback */
+    strcpy(newPeer->mPeerServiceInstance, aServiceInstanceName);
 
     (void)OSA_MutexLock((osa_mutex_handle_t)sMutexHandle, osaWaitForever_c);
     result = LIST_AddTail(&sPeerList, (list_element_handle_t)newPeer);
     (void)OSA_MutexUnlock((osa_mutex_handle_t)sMutexHandle);
 
+    VerifyOrExit(result == kLIST_Ok);
+
+    newPeer->mNextByServiceInstance              = *serviceInstanceBucket(aServiceInstanceName);
+    *serviceInstanceBucket(aServiceInstanceName) = newPeer;
+
     sPeerNumber++;
 
 exit:
-    return (result == kLIST_Ok) ? OT_ERROR_NONE : OT_ERROR_FAILED;
+    if ((result != kLIST_Ok) && (newPeer != NULL))
+    {
+        otPlatFree(newPeer);
+        newPeer = NULL;
+    }
+    return newPeer;
 }
 
 static struct Peer *findPeerByServiceInstance(const char *aServiceInstanceName)
 {
-    list_element_handle_t element = LIST_GetHead(&sPeerList);
-    while (element != NULL)
+    struct Peer *peer = *serviceInstanceBucket(aServiceInstanceName);
+
+    while ((peer != NULL) && strcmp(peer->mPeerServiceInstance, aServiceInstanceName))
     {
-        struct Peer *peer = (struct Peer *)element;
-        if (!strcmp(peer->mPeerServiceInstance, aServiceInstanceName))
-        {
-            return peer;
-        }
-        element = LIST_GetNext(element);
+        peer = peer->mNextByServiceInstance;
     }
-    return NULL;
+    return peer;
 }
 
 static struct Peer *findPeerByHostName(const char *aHostName)
 {
-    list_element_handle_t element = LIST_GetHead(&sPeerList);
+    struct Peer *peer = *hostNameBucket(aHostName);
 
-    while (element != NULL)
+    while ((peer != NULL) && strcmp(peer->mPeerHostName, aHostName))
     {
-        struct Peer *peer = (struct Peer *)element;
-        if (!strcmp(peer->mPeerHostName, aHostName))
-        {
-            return peer;
-        }
-        element = LIST_GetNext(element);
+        peer = peer->mNextByHostName;
+    }
+    return peer;
+}
+
+static struct Peer *findPeerBySockAddr(const otSockAddr *aSockAddr)
+{
+    struct Peer *peer = *sockAddrBucket(aSockAddr);
+
+    while ((peer != NULL) && ((peer->mSockAddr.mPort != aSockAddr->mPort) ||
+                              memcmp(&peer->mSockAddr.mAddress, &aSockAddr->mAddress, sizeof(otIp6Address))))
+    {
+        peer = peer->mNextBySockAddr;
     }
-    return NULL;
+    return peer;
 }
 
 static void removeAndFreeInternalPeerListEntry(list_element_handle_t aListElement)
 {
+    struct Peer *peer = (struct Peer *)aListElement;
+
+    unlinkPeer(serviceInstanceBucket(peer->mPeerServiceInstance), peer, offsetof(struct Peer, mNextByServiceInstance));
+    if (peer->mPeerHostName[0] != '\0')
+    {
+        unlinkPeer(hostNameBucket(peer->mPeerHostName), peer, offsetof(struct Peer, mNextByHostName));
+    }
+    if (peer->mHasSockAddr)
+    {
+        unlinkPeer(sockAddrBucket(&peer->mSockAddr), peer, offsetof(struct Peer, mNextBySockAddr));
+    }
+
     if (sTrelEnabled)
     {
         (void)OSA_MutexLock((osa_mutex_handle_t)sMutexHandle, osaWaitForever_c);
@@ -529,27 +712,27 @@ static void RemoveTrelServiceInstance(struct Peer *aElement)
 
 static void AddTrelServiceInstance(const char *aServiceInstanceName)
 {
-    struct Peer peer;
-    memset(&peer, 0, sizeof(peer));
-    peer.mPeerServiceInstance = aServiceInstanceName;
+    struct Peer *peer = createAndAppendPeerListEntry(aServiceInstanceName);
 
-    peer.mSrvResolver.mServiceInstance = aServiceInstanceName;
-    peer.mSrvResolver.mServiceType     = sTrelServiceLabel;
-    peer.mSrvResolver.mInfraIfIndex    = netif_get_index(sBackboneNetifPtr);
-    peer.mSrvResolver.mCallback        = HandleServiceResolveResult;
+    VerifyOrExit(peer != NULL);
 
-    peer.mTxtResolver.mServiceInstance = aServiceInstanceName;
-    peer.mTxtResolver.mServiceType     = sTrelServiceLabel;
-    peer.mTxtResolver.mInfraIfIndex    = netif_get_index(sBackboneNetifPtr);
-    peer.mTxtResolver.mCallback        = HandleServiceTxtResolveResult;
+    peer->mSrvResolver.mServiceInstance = peer->mPeerServiceInstance;
+    peer->mSrvResolver.mServiceType     = sTrelServiceLabel;
+    peer->mSrvResolver.mInfraIfIndex    = netif_get_index(sBackboneNetifPtr);
+    peer->mSrvResolver.mCallback        = HandleServiceResolveResult;
 
-    peer.mAddrResolver.mCallback     = HandleIp6AddressResolver;
-    peer.mAddrResolver.mInfraIfIndex = netif_get_index(sBackboneNetifPtr);
+    peer->mTxtResolver.mServiceInstance = peer->mPeerServiceInstance;
+    peer->mTxtResolver.mServiceType     = sTrelServiceLabel;
+    peer->mTxtResolver.mInfraIfIndex    = netif_get_index(sBackboneNetifPtr);
+    peer->mTxtResolver.mCallback        = HandleServiceTxtResolveResult;
 
-    if (createAndAppendPeerListEntry(peer) == OT_ERROR_NONE)
-    {
-        otMdnsStartSrvResolver(sInstance, &peer.mSrvResolver);
-    }
+    peer->mAddrResolver.mCallback     = HandleIp6AddressResolver;
+    peer->mAddrResolver.mInfraIfIndex = netif_get_index(sBackboneNetifPtr);
+
+    otMdnsStartSrvResolver(sInstance, &peer->mSrvResolver);
+
+exit:
+    return;
 }
 
 static void CheckTrelPeerStorage()
@@ -29,20 +29,59 @@
 #ifndef __OT_TREL_PLAT_H__
 #define __OT_TREL_PLAT_H__
 
+#include <stdbool.h>
+#include <stdint.h>
 #include <openthread/instance.h>
+#include <openthread/ip6.h>
 #include "lwip/netif.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+#ifndef ADDITIONAL_PEER_NUMBER
 #define ADDITIONAL_PEER_NUMBER 32
-#define MAX_PEER_NUMBER OPENTHREAD_CONFIG_MLE_MAX_ROUTERS + OPENTHREAD_CONFIG_MLE_MAX_CHILDREN + ADDITIONAL_PEER_NUMBER
+#endif
+
+/* Maximum number of TREL peers, peers are looked up through hash indexes so it can be raised for large links */
+#ifndef MAX_PEER_NUMBER
+#define MAX_PEER_NUMBER \
+    (OPENTHREAD_CONFIG_MLE_MAX_ROUTERS + OPENTHREAD_CONFIG_MLE_MAX_CHILDREN + ADDITIONAL_PEER_NUMBER)
+#endif
+
+/* Traffic exchanged with one TREL peer */
+typedef struct trelPlatPeerCounters
+{
+    uint64_t mTxPackets; ///< Number of packets sent to the peer.
+    uint64_t mTxBytes;   ///< Number of bytes sent to the peer.
+    uint64_t mTxFailure; ///< Number of packets which could not be sent to the peer.
+    uint64_t mRxPackets; ///< Number of packets received from the peer.
+    uint64_t mRxBytes;   ///< Number of bytes received from the peer.
+} trelPlatPeerCounters;
+
+typedef struct trelPlatPeerInfo
+{
+    const char          *mServiceInstance; ///< Service instance name of the peer.
+    otSockAddr           mSockAddr;        ///< Socket address of the peer, valid if mHasSockAddr is set.
+    bool                 mHasSockAddr;     ///< Whether the address of the peer has been resolved.
+    trelPlatPeerCounters mCounters;        ///< Traffic counters of the peer.
+} trelPlatPeerInfo;
 
 void TrelPlatInit(otInstance *aInstance, struct netif *backboneNetif);
 void TrelOnAppReady(const char *aHostName);
 void TrelOnExternalNetifDown(void);
 
+/**
+ * This function returns the next TREL peer and its traffic counters.
+ * Must be called from the OpenThread task, the counters are reset by otPlatTrelResetCounters.
+ *
+ * @param[inout] aIterator  Pointer to the iterator, must be set to NULL to get the first peer.
+ * @param[out]   aPeerInfo  Pointer to the information of the peer.
+ *
+ * @return true if a peer was returned, false if there are no more peers.
+ */
+bool TrelPlatGetNextPeer(const void **aIterator, trelPlatPeerInfo *aPeerInfo);
+
 #ifdef __cplusplus
 }
 #endif
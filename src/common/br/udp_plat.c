@@ -37,14 +37,16 @@
 /* -------------------------------------------------------------------------- */
 
 #include "udp_plat.h"
+#include "lwip_tx_batch.h"
+#include "ot_platform_common.h"
 #include <openthread/ip6.h>
 #include <openthread/tasklet.h>
 #include <openthread/udp.h>
-#include <openthread/platform/memory.h>
 #include <openthread/platform/udp.h>
 #include "lwip/api.h"
 #include "lwip/icmp6.h"
 #include "lwip/inet.h"
+#include "lwip/memp.h"
 #include "lwip/mld6.h"
 #include "lwip/prot/dns.h"
 #include "lwip/prot/iana.h"
@@ -61,12 +63,28 @@
 /* -------------------------------------------------------------------------- */
 /*                                 Definitions                                */
 /* -------------------------------------------------------------------------- */
+
+/* Number of datagrams waiting to be sent by the LwIP thread */
+#ifndef OT_UDP_PLAT_SEND_POOL_SIZE
+#define OT_UDP_PLAT_SEND_POOL_SIZE 8
+#endif
+
+/* Number of received datagrams waiting to be processed by the OT task, more are dropped */
+#ifndef OT_UDP_PLAT_RECEIVE_POOL_SIZE
+#define OT_UDP_PLAT_RECEIVE_POOL_SIZE 16
+#endif
+
 struct udpSendContext
 {
-    struct udp_pcb *pcb;
-    struct pbuf    *buf;
-    ip_addr_t       peer_addr;
-    uint16_t        peerPort;
+    lwipTxBatchEntry link;
+    struct udp_pcb  *pcb;
+    struct pbuf     *buf;
+    ip_addr_t        peer_addr;
+    uint16_t         peerPort;
+    ip_addr_t        local_ip; /* Source address, port, hop limit and loop flag of this datagram, set on the pcb */
+    uint16_t         localPort;
+    uint8_t          ttl;
+    bool             isMulticastLoop;
 };
 
 struct udpReceiveContext
@@ -90,6 +108,13 @@ static struct netif *sOtNetifPtr;
 static list_label_t sMsgList;
 static OSA_MUTEX_HANDLE_DEFINE(sMutexHandle);
 
+/* Fixed size pools for the per datagram contexts, to avoid heap allocations on every packet */
+LWIP_MEMPOOL_DECLARE(UDP_PLAT_SEND_CTX, OT_UDP_PLAT_SEND_POOL_SIZE, sizeof(struct udpSendContext), "UDP plat send");
+LWIP_MEMPOOL_DECLARE(UDP_PLAT_RECV_CTX, OT_UDP_PLAT_RECEIVE_POOL_SIZE, sizeof(struct udpReceiveContext),
+                     "UDP plat receive");
+
+static udpPlatPoolStats sPoolStats;
+
 /* -------------------------------------------------------------------------- */
 /*                             Private prototypes                             */
 /* -------------------------------------------------------------------------- */
@@ -97,7 +122,7 @@ static OSA_MUTEX_HANDLE_DEFINE(sMutexHandle);
 static void         recv_fcn(void *arg, struct udp_pcb *pcb, struct pbuf *p, const ip_addr_t *addr, u16_t port);
 static uint8_t      getInterfaceIndex(otNetifIdentifier identifier);
 static struct pbuf *convertToLwipMsg(otMessage *otIpPkt, bool bTransport);
-static void         lwipTaskCb(void *context);
+static void         lwipTaskCb(lwipTxBatchEntry *aEntry, bool aSend);
 static ip_addr_t    convertOpenthreadToLwipAddress(const otIp6Address *aAddress);
 /* -------------------------------------------------------------------------- */
 /*                              Public functions                              */
@@ -116,6 +141,17 @@ void UdpPlatInit(otInstance *aInstance, struct netif *backboneNetif, struct neti
     {
         assert(true);
     }
+
+    LWIP_MEMPOOL_INIT(UDP_PLAT_SEND_CTX);
+    LWIP_MEMPOOL_INIT(UDP_PLAT_RECV_CTX);
+
+    /* On failure, the allocation is retried by the next lwipTxBatchPost */
+    (void)lwipTxBatchInit();
+}
+
+void UdpPlatGetPoolStats(udpPlatPoolStats *aStats)
+{
+    *aStats = sPoolStats;
 }
 
 otError otPlatUdpSocket(otUdpSocket *aUdpSocket)
@@ -228,15 +264,12 @@ exit:
 otError otPlatUdpSend(otUdpSocket *aUdpSocket, otMessage *aMessage, const otMessageInfo *aMessageInfo)
 {
     otError                error            = OT_ERROR_NONE;
-    struct udpSendContext *udpSendContexPtr = (struct udpSendContext *)otPlatCAlloc(1, sizeof(struct udpSendContext));
-    VerifyOrExit(NULL != udpSendContexPtr, error = OT_ERROR_FAILED);
+    struct udpSendContext *udpSendContexPtr = (struct udpSendContext *)LWIP_MEMPOOL_ALLOC(UDP_PLAT_SEND_CTX);
+    VerifyOrExit(NULL != udpSendContexPtr, sPoolStats.mSendPoolExhausted++, error = OT_ERROR_NO_BUFS);
+    memset(udpSendContexPtr, 0, sizeof(struct udpSendContext));
 
     udpSendContexPtr->pcb = (struct udp_pcb *)aUdpSocket->mHandle;
-    ip_addr_t src_addr    = {0};
-    uint16_t  src_port;
-    uint8_t   hop_limit;
-    bool      isMulticastLoop;
-    uint8_t   netif_idx;
+    uint8_t netif_idx;
 
     if (udpSendContexPtr->pcb->netif_idx == NETIF_NO_INDEX)
     {
@@ -257,27 +290,20 @@ otError otPlatUdpSend(otUdpSocket *aUdpSocket, otMessage *aMessage, const otMess
     udpSendContexPtr->buf = convertToLwipMsg(aMessage, true);
     VerifyOrExit(udpSendContexPtr->buf != NULL, error = OT_ERROR_FAILED);
 
-    src_port                   = aMessageInfo->mSockPort;
-    udpSendContexPtr->peerPort = aMessageInfo->mPeerPort;
-    isMulticastLoop            = aMessageInfo->mMulticastLoop;
-    hop_limit                  = aMessageInfo->mHopLimit ? aMessageInfo->mHopLimit : UDP_TTL;
+    // The pcb is shared by the datagrams of the socket waiting in the batch, so what differs between them is only
+    // set on it by lwipTaskCb, right before each one is sent
+    udpSendContexPtr->localPort       = aMessageInfo->mSockPort;
+    udpSendContexPtr->peerPort        = aMessageInfo->mPeerPort;
+    udpSendContexPtr->isMulticastLoop = aMessageInfo->mMulticastLoop;
+    udpSendContexPtr->ttl             = aMessageInfo->mHopLimit ? aMessageInfo->mHopLimit : UDP_TTL;
 
-    src_addr                    = convertOpenthreadToLwipAddress(&aMessageInfo->mSockAddr);
+    udpSendContexPtr->local_ip  = convertOpenthreadToLwipAddress(&aMessageInfo->mSockAddr);
     udpSendContexPtr->peer_addr = convertOpenthreadToLwipAddress(&aMessageInfo->mPeerAddr);
 
-    udpSendContexPtr->pcb->ttl = hop_limit;
-    udpSendContexPtr->pcb->flags &= ~(UDP_FLAGS_MULTICAST_LOOP);
-    udpSendContexPtr->pcb->local_ip   = src_addr;
-    udpSendContexPtr->pcb->local_port = src_port;
-    if (isMulticastLoop)
-    {
-        udpSendContexPtr->pcb->flags |= (UDP_FLAGS_MULTICAST_LOOP);
-    }
-
-    if (!ip_addr_isany(&udpSendContexPtr->pcb->local_ip))
+    if (!ip_addr_isany(&udpSendContexPtr->local_ip))
     {
         // Assign zone if the source address has been specified by the application
-        ip6_addr_assign_zone(ip_2_ip6(&udpSendContexPtr->pcb->local_ip), IP6_UNICAST, netif_get_by_index(netif_idx));
+        ip6_addr_assign_zone(ip_2_ip6(&udpSendContexPtr->local_ip), IP6_UNICAST, netif_get_by_index(netif_idx));
     }
 
     // The LWIP address needs to be intilialized correctly with a zone
@@ -294,20 +320,24 @@ otError otPlatUdpSend(otUdpSocket *aUdpSocket, otMessage *aMessage, const otMess
     }
     else
     {
-        if (ip_addr_isany(&udpSendContexPtr->pcb->local_ip))
+        if (ip_addr_isany(&udpSendContexPtr->local_ip))
         {
-            udpSendContexPtr->pcb->local_ip.type = IPADDR_TYPE_ANY;
+            udpSendContexPtr->local_ip.type = IPADDR_TYPE_ANY;
         }
     }
 
-    if (ERR_OK != tcpip_callback(lwipTaskCb, (void *)udpSendContexPtr))
+    // The context is released by lwipTaskCb, even if the batch could not be posted
+    if (ERR_OK != lwipTxBatchPost(&udpSendContexPtr->link, lwipTaskCb))
     {
-        pbuf_free(udpSendContexPtr->buf);
-        otPlatFree(udpSendContexPtr);
         error = OT_ERROR_FAILED;
     }
+    udpSendContexPtr = NULL;
 
 exit:
+    if ((error != OT_ERROR_NONE) && (udpSendContexPtr != NULL))
+    {
+        LWIP_MEMPOOL_FREE(UDP_PLAT_SEND_CTX, udpSendContexPtr);
+    }
     otMessageFree(aMessage);
     return error;
 }
@@ -360,7 +390,9 @@ void otPlatUdpProcess()
                 udpReceiveContextPtr->socket->mHandler(udpReceiveContextPtr->socket->mContext,
                                                        udpReceiveContextPtr->message,
                                                        &udpReceiveContextPtr->message_info);
-                otPlatFree(udpReceiveContextPtr);
+                /* The socket handler does not take the message */
+                otMessageFree(udpReceiveContextPtr->message);
+                LWIP_MEMPOOL_FREE(UDP_PLAT_RECV_CTX, udpReceiveContextPtr);
             }
         } while (udpReceiveContextPtr);
     }
@@ -375,16 +407,16 @@ static void recv_fcn(void *arg, struct udp_pcb *pcb, struct pbuf *p, const ip_ad
     (void)pcb;
     otError error = OT_ERROR_NONE;
 
-    struct udpReceiveContext *udpReceiveContextPtr =
-        (struct udpReceiveContext *)otPlatCAlloc(1, sizeof(struct udpReceiveContext));
-    VerifyOrExit(NULL != udpReceiveContextPtr);
+    struct udpReceiveContext *udpReceiveContextPtr = (struct udpReceiveContext *)LWIP_MEMPOOL_ALLOC(UDP_PLAT_RECV_CTX);
+    /* The OT task is late processing the received datagrams, drop this one */
+    VerifyOrExit(NULL != udpReceiveContextPtr, sPoolStats.mReceivePoolExhausted++);
+    memset(udpReceiveContextPtr, 0, sizeof(struct udpReceiveContext));
 
     const struct ip6_hdr *ip6_header = ip6_current_header();
 #if LWIP_IPV4
     const struct ip_hdr *ip4_header = ip4_current_header();
 #endif
     struct netif *source_netif = ip_current_netif();
-    uint8_t      *data_ptr     = (uint8_t *)p->payload;
 
     udpReceiveContextPtr->socket                 = (otUdpSocket *)arg;
     udpReceiveContextPtr->message_info.mSockPort = 0;
@@ -432,22 +464,28 @@ static void recv_fcn(void *arg, struct udp_pcb *pcb, struct pbuf *p, const ip_ad
 
     udpReceiveContextPtr->message = otUdpNewMessage(sInstance, NULL);
 
-    VerifyOrExit(udpReceiveContextPtr->message != NULL, otPlatFree(udpReceiveContextPtr));
-    VerifyOrExit(otMessageAppend(udpReceiveContextPtr->message, data_ptr, p->tot_len) == OT_ERROR_NONE,
-                 error = OT_ERROR_FAILED);
+    VerifyOrExit(udpReceiveContextPtr->message != NULL, LWIP_MEMPOOL_FREE(UDP_PLAT_RECV_CTX, udpReceiveContextPtr));
+    // A datagram larger than a PBUF_POOL buffer is received in a pbuf chain.
+    for (struct pbuf *partialPkt = p; partialPkt != NULL; partialPkt = partialPkt->next)
+    {
+        VerifyOrExit(otMessageAppend(udpReceiveContextPtr->message, partialPkt->payload, partialPkt->len) ==
+                         OT_ERROR_NONE,
+                     error = OT_ERROR_FAILED);
+    }
 
     // Ignore status as we set the list to unlimited size
     (void)OSA_MutexLock((osa_mutex_handle_t)sMutexHandle, osaWaitForever_c);
     LIST_AddTail(&sMsgList, (list_element_handle_t)udpReceiveContextPtr);
     (void)OSA_MutexUnlock((osa_mutex_handle_t)sMutexHandle);
 
+    otSysEventSetPending(OT_SYS_EVENT_UDP);
     otTaskletsSignalPending(sInstance);
 
 exit:
     if (error == OT_ERROR_FAILED)
     {
         otMessageFree(udpReceiveContextPtr->message);
-        otPlatFree(udpReceiveContextPtr);
+        LWIP_MEMPOOL_FREE(UDP_PLAT_RECV_CTX, udpReceiveContextPtr);
     }
     pbuf_free(p);
 }
@@ -502,13 +540,27 @@ exit:
     return lwipIpPkt;
 }
 
-static void lwipTaskCb(void *context)
+static void lwipTaskCb(lwipTxBatchEntry *aEntry, bool aSend)
 {
-    struct udpSendContext *udpSendContexPtr = (struct udpSendContext *)context;
+    struct udpSendContext *udpSendContexPtr = (struct udpSendContext *)aEntry;
+
+    if (aSend)
+    {
+        struct udp_pcb *pcb = udpSendContexPtr->pcb;
 
-    udp_sendto(udpSendContexPtr->pcb, udpSendContexPtr->buf, &udpSendContexPtr->peer_addr, udpSendContexPtr->peerPort);
+        pcb->ttl        = udpSendContexPtr->ttl;
+        pcb->local_ip   = udpSendContexPtr->local_ip;
+        pcb->local_port = udpSendContexPtr->localPort;
+        pcb->flags &= ~(UDP_FLAGS_MULTICAST_LOOP);
+        if (udpSendContexPtr->isMulticastLoop)
+        {
+            pcb->flags |= (UDP_FLAGS_MULTICAST_LOOP);
+        }
+        udp_sendto(udpSendContexPtr->pcb, udpSendContexPtr->buf, &udpSendContexPtr->peer_addr,
+                   udpSendContexPtr->peerPort);
+    }
     pbuf_free(udpSendContexPtr->buf);
-    otPlatFree(context);
+    LWIP_MEMPOOL_FREE(UDP_PLAT_SEND_CTX, udpSendContexPtr);
 }
 
 static ip_addr_t convertOpenthreadToLwipAddress(const otIp6Address *aAddress)
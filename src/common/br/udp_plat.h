@@ -36,8 +36,17 @@
 extern "C" {
 #endif
 
+/* Number of datagrams dropped because the context pools were empty */
+typedef struct udpPlatPoolStats
+{
+    uint32_t mSendPoolExhausted;
+    uint32_t mReceivePoolExhausted;
+} udpPlatPoolStats;
+
 void UdpPlatInit(otInstance *aInstance, struct netif *backboneNetif, struct netif *otNetif);
 
+void UdpPlatGetPoolStats(udpPlatPoolStats *aStats);
+
 #ifdef __cplusplus
 }
 #endif
@@ -26,7 +26,10 @@
  *  POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <stdbool.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <openthread/error.h>
 #include <openthread/instance.h>
 #include <openthread/logging.h>
@@ -55,6 +58,14 @@
 
 #define KEY_NAME_TO_UINT(key) (key[0] - ASCII_0)
 
+/* Number of OT keys whose NVS name and stored value indexes are cached in RAM */
+#ifndef OT_NVS_SETTINGS_CACHE_SIZE
+#define OT_NVS_SETTINGS_CACHE_SIZE 16
+#endif
+
+/* Keys with more values than the single digit index supports are not cached, they are looked up in NVS */
+#define KEY_CACHE_MAX_INDEX 9
+
 struct key_data
 {
     char     name[KEY_NAME_SIZE];
@@ -64,6 +75,23 @@ struct key_data
     uint8_t *data;
 };
 
+/*
+ * Per key metadata cache: the "ot/xxxx" subtree name and the bitmap of the
+ * value indexes stored in NVS, so that adding a value or looking for a missing
+ * one does not browse the settings subtree.
+ */
+struct key_cache_entry
+{
+    uint16_t key;
+    uint16_t indexes;  /* bit i set when "ot/xxxx/i" is stored */
+    uint8_t  name_len; /* 0 when the entry is unused */
+    bool     indexes_valid;
+    char     name[KEY_NAME_SIZE];
+};
+
+static struct key_cache_entry key_cache[OT_NVS_SETTINGS_CACHE_SIZE];
+static unsigned               key_cache_next;
+
 /*
  * Zephyr settings subtree callback function used to search and read a certain
  * key
@@ -146,6 +174,29 @@ int subtree_cb_count_values(const char *key, size_t len, settings_read_cb read_c
     return 0;
 }
 
+/*
+ * Zephyr settings subtree callback function used to collect the indexes of the
+ * values available in the subtree
+ */
+int subtree_cb_index_values(const char *key, size_t len, settings_read_cb read_cb, void *cb_arg, void *param)
+{
+    struct key_cache_entry *entry = (struct key_cache_entry *)param;
+    char                   *end;
+    unsigned long           index = (key != NULL) ? strtoul(key, &end, 10) : 0;
+
+    if ((key == NULL) || (end == key) || (index > KEY_CACHE_MAX_INDEX))
+    {
+        /* Unexpected value name, do not cache this key */
+        entry->indexes_valid = false;
+        return 1;
+    }
+
+    entry->indexes |= (1u << index);
+
+    /* Continue searching the subtree for other keys */
+    return 0;
+}
+
 /*
  * Zephyr settings subtree callback function used to wipe out all the keys
  * available in the subtree
@@ -177,6 +228,104 @@ int subtree_cb_wipe(const char *key, size_t len, settings_read_cb read_cb, void
     return 0;
 }
 
+static void key_cache_invalidate(void)
+{
+    memset(key_cache, 0, sizeof(key_cache));
+    key_cache_next = 0;
+}
+
+/*
+ * Return the cache entry of aKey, formatting its name on a miss. The value
+ * indexes are only loaded when aLoadIndexes is set, check indexes_valid.
+ */
+static struct key_cache_entry *key_cache_get(uint16_t aKey, bool aLoadIndexes)
+{
+    struct key_cache_entry *entry = NULL;
+
+    for (unsigned i = 0; i < OT_NVS_SETTINGS_CACHE_SIZE; i++)
+    {
+        if ((key_cache[i].name_len != 0) && (key_cache[i].key == aKey))
+        {
+            entry = &key_cache[i];
+            break;
+        }
+    }
+
+    if (entry == NULL)
+    {
+        entry          = &key_cache[key_cache_next];
+        key_cache_next = (key_cache_next + 1) % OT_NVS_SETTINGS_CACHE_SIZE;
+
+        entry->key           = aKey;
+        entry->indexes       = 0;
+        entry->indexes_valid = false;
+        entry->name_len      = (uint8_t)snprintf(entry->name, sizeof(entry->name), OT_KEY_PREFIX "/%x", aKey);
+    }
+
+    if (aLoadIndexes && !entry->indexes_valid)
+    {
+        entry->indexes       = 0;
+        entry->indexes_valid = true;
+        if (settings_load_subtree_direct(entry->name, subtree_cb_index_values, entry) != 0)
+        {
+            entry->indexes_valid = false;
+        }
+    }
+
+    return entry;
+}
+
+/* Record that value aIndex of the key was stored (aStored true) or deleted in NVS */
+static void key_cache_update(struct key_cache_entry *aEntry, int aIndex, bool aStored)
+{
+    if ((aIndex < 0) || (aIndex > KEY_CACHE_MAX_INDEX))
+    {
+        aEntry->indexes_valid = false;
+    }
+    else if (aStored)
+    {
+        aEntry->indexes |= (1u << aIndex);
+    }
+    else
+    {
+        aEntry->indexes &= ~(1u << aIndex);
+    }
+}
+
+/* Return false when the cache knows that value aIndex of the key is not stored in NVS */
+static bool key_cache_may_contain(const struct key_cache_entry *aEntry, int aIndex)
+{
+    if (!aEntry->indexes_valid)
+    {
+        return true;
+    }
+
+    return (aIndex >= 0) && (aIndex <= KEY_CACHE_MAX_INDEX) && ((aEntry->indexes & (1u << aIndex)) != 0);
+}
+
+/* Format the "ot/xxxx/aIndex" value name of a key in aName */
+static void key_cache_format_name(const struct key_cache_entry *aEntry, unsigned aIndex, char *aName)
+{
+    char     digits[10];
+    unsigned count = 0;
+
+    memcpy(aName, aEntry->name, aEntry->name_len);
+    aName += aEntry->name_len;
+    *aName++ = '/';
+
+    do
+    {
+        digits[count++] = ASCII_0 + (aIndex % 10);
+        aIndex /= 10;
+    } while ((aIndex != 0) && (count < sizeof(digits)));
+
+    while (count != 0)
+    {
+        *aName++ = digits[--count];
+    }
+    *aName = '\0';
+}
+
 void otPlatSettingsInit(otInstance *aInstance, const uint16_t *aSensitiveKeys, uint16_t aSensitiveKeysLength)
 {
     const struct flash_area *fa;
@@ -204,6 +353,8 @@ void otPlatSettingsInit(otInstance *aInstance, const uint16_t *aSensitiveKeys, u
     {
         otLogCritPlat("ERROR: Failed initialize settings management subsystem! (err=%d)", err);
     }
+
+    key_cache_invalidate();
 }
 
 void otPlatSettingsDeinit(otInstance *aInstance)
@@ -212,13 +363,18 @@ void otPlatSettingsDeinit(otInstance *aInstance)
 
 otError otPlatSettingsGet(otInstance *aInstance, uint16_t aKey, int aIndex, uint8_t *aValue, uint16_t *aValueLength)
 {
-    int             err;
-    otError         ret = OT_ERROR_NONE;
-    struct key_data k   = {.index = aIndex, .flags = KEY_NOT_FOUND, .len = *aValueLength, .data = aValue};
+    int                     err   = 0;
+    otError                 ret   = OT_ERROR_NONE;
+    struct key_cache_entry *entry = key_cache_get(aKey, true);
+    struct key_data         k     = {.index = aIndex, .flags = KEY_NOT_FOUND, .len = *aValueLength, .data = aValue};
+
+    /* Only browse the NVS subtree when the cache does not tell the value is missing */
+    if (key_cache_may_contain(entry, aIndex))
+    {
+        memcpy(k.name, entry->name, entry->name_len + 1);
+        err = settings_load_subtree_direct(k.name, subtree_cb_read_value, &k);
+    }
 
-    /* Generate the name of the key, as known by the NVS/Settings module */
-    sprintf(k.name, OT_KEY_PREFIX "/%x", aKey);
-    err = settings_load_subtree_direct(k.name, subtree_cb_read_value, &k);
     if ((err != 0) || ((k.flags & KEY_NOT_FOUND) != 0) || ((k.flags & KEY_READ_FAILED) != 0))
     {
         *aValueLength = 0;
@@ -235,42 +391,58 @@ otError otPlatSettingsGet(otInstance *aInstance, uint16_t aKey, int aIndex, uint
 
 otError otPlatSettingsAdd(otInstance *aInstance, uint16_t aKey, const uint8_t *aValue, uint16_t aValueLength)
 {
-    int      err;
-    char     key_name[KEY_NAME_SIZE];
-    unsigned cnt = 0;
+    int                     err;
+    char                    key_name[KEY_NAME_SIZE];
+    unsigned                cnt   = 0;
+    struct key_cache_entry *entry = key_cache_get(aKey, true);
 
     /* Count the number of values already available for this key */
-    sprintf(key_name, OT_KEY_PREFIX "/%x", aKey);
-    err = settings_load_subtree_direct(key_name, subtree_cb_count_values, &cnt);
-    if (err != 0)
+    if (entry->indexes_valid)
     {
-        return OT_ERROR_NO_BUFS;
+        cnt = __builtin_popcount(entry->indexes);
+    }
+    else
+    {
+        err = settings_load_subtree_direct(entry->name, subtree_cb_count_values, &cnt);
+        if (err != 0)
+        {
+            return OT_ERROR_NO_BUFS;
+        }
     }
 
     /* Generate the name of the key, as known by the NVS/Settings module */
-    sprintf(key_name, OT_KEY_PREFIX "/%x/%u", aKey, cnt);
+    key_cache_format_name(entry, cnt, key_name);
     err = settings_save_one(key_name, aValue, aValueLength);
     if (err != 0)
     {
+        entry->indexes_valid = false;
         return OT_ERROR_NO_BUFS;
     }
 
+    key_cache_update(entry, (int)cnt, true);
+
     return OT_ERROR_NONE;
 }
 
 otError otPlatSettingsSet(otInstance *aInstance, uint16_t aKey, const uint8_t *aValue, uint16_t aValueLength)
 {
-    int     err;
-    otError ret = OT_ERROR_NONE;
-    char    key_name[KEY_NAME_SIZE];
+    int                     err;
+    otError                 ret = OT_ERROR_NONE;
+    char                    key_name[KEY_NAME_SIZE];
+    struct key_cache_entry *entry = key_cache_get(aKey, false);
 
     /* Generate the name of the key, as known by the NVS/Settings module */
-    sprintf(key_name, OT_KEY_PREFIX "/%x/0", aKey);
+    key_cache_format_name(entry, 0, key_name);
     err = settings_save_one(key_name, aValue, aValueLength);
     if (err != 0)
     {
         otLogWarnPlat("ERROR: Failed to set settings key 0x%04x!", aKey);
-        ret = OT_ERROR_NO_BUFS;
+        entry->indexes_valid = false;
+        ret                  = OT_ERROR_NO_BUFS;
+    }
+    else
+    {
+        key_cache_update(entry, 0, true);
     }
 
     return ret;
@@ -278,30 +450,42 @@ otError otPlatSettingsSet(otInstance *aInstance, uint16_t aKey, const uint8_t *a
 
 otError otPlatSettingsDelete(otInstance *aInstance, uint16_t aKey, int aIndex)
 {
-    int     err;
-    otError ret = OT_ERROR_NONE;
-    char    key_name[KEY_NAME_SIZE];
+    int                     err;
+    otError                 ret = OT_ERROR_NONE;
+    char                    key_name[KEY_NAME_SIZE];
+    struct key_cache_entry *entry = key_cache_get(aKey, false);
 
     /* When aIndex is -1 we have to remove all instances of specified key */
     if (aIndex == -1)
     {
-        sprintf(key_name, OT_KEY_PREFIX "/%x", aKey);
+        memcpy(key_name, entry->name, entry->name_len + 1);
         err = settings_load_subtree_direct(key_name, subtree_cb_wipe, key_name);
         if (err != 0)
         {
             otLogWarnPlat("ERROR: Failed to remove all values for key 0x%04x!", aKey);
-            ret = OT_ERROR_NOT_FOUND;
+            entry->indexes_valid = false;
+            ret                  = OT_ERROR_NOT_FOUND;
+        }
+        else
+        {
+            entry->indexes       = 0;
+            entry->indexes_valid = true;
         }
     }
     else
     {
         /* Generate the name of the key, as known by the NVS/Settings module */
-        sprintf(key_name, OT_KEY_PREFIX "/%x/%d", aKey, aIndex);
+        key_cache_format_name(entry, (unsigned)aIndex, key_name);
         err = settings_delete(key_name);
         if (err != 0)
         {
             otLogWarnPlat("ERROR: Failed to remove settings key 0x%04x[%d]!", aKey, aIndex);
-            ret = OT_ERROR_NOT_FOUND;
+            entry->indexes_valid = false;
+            ret                  = OT_ERROR_NOT_FOUND;
+        }
+        else
+        {
+            key_cache_update(entry, aIndex, false);
         }
     }
 
@@ -317,6 +501,8 @@ void otPlatSettingsWipe(otInstance *aInstance)
     {
         otLogWarnPlat("WARNING: Failed to wipe out OT settings keys (err=%d)!", err);
     }
+
+    key_cache_invalidate();
 }
 
 void otPlatSaveSettingsIdle(void)
@@ -38,6 +38,7 @@
 #include <openthread/platform/toolchain.h>
 
 #include "fsl_debug_console.h"
+#include "ot_platform_common.h"
 #include "stdio.h"
 #include "string.h"
 
@@ -56,101 +57,629 @@
 #endif
 #define EOL_CHARS "\r\n\0" /* End of Line Characters */
 #define EOL_CHARS_LEN 3    /* Length of EOL */
+#ifndef LOG_DUMP_TASK_SIZE
+#ifdef LOG_BINARY_ENABLED
+#define LOG_DUMP_TASK_SIZE ((configSTACK_DEPTH_TYPE)3072 / sizeof(portSTACK_TYPE))
+#else
 #define LOG_DUMP_TASK_SIZE ((configSTACK_DEPTH_TYPE)2048 / sizeof(portSTACK_TYPE))
-
-static char sTxBuffer[LOG_BUFFER_SIZE];
+#endif
+#endif
 
 #ifdef LOG_BUFFER_ENABLED
+#if (LOG_RING_BUFFER_SIZE % 4) != 0
+#error "LOG_RING_BUFFER_SIZE must be a multiple of 4"
+#endif
+
+#define LOG_RECORD_HEADER_SIZE sizeof(uint32_t)
+#define LOG_RECORD_COMMITTED 0x80000000U /* Set in the header once the log has been copied in the ring */
+#define LOG_RECORD_LENGTH_MASK 0x0000FFFFU
+#define LOG_RECORD_SIZE(len) (((len) + LOG_RECORD_HEADER_SIZE + 3U) & ~3U)
+
+/*
+ * Multi-producer single-consumer ring buffer, without lock.
+ * Producers reserve a record by moving head with a compare and swap, copy the log in it and then commit it by writing
+ * its header. The dump task consumes the committed records in order from tail and clears them, so that the header of
+ * a record reserved but not yet committed always reads as 0.
+ * head and tail run from 0 to 2 * LOG_RING_BUFFER_SIZE to tell a full ring from an empty one.
+ */
 typedef struct
 {
-    uint8_t  buffer[LOG_RING_BUFFER_SIZE]; /* format: <2_bytes_log_size1><log1> ... <2_bytes_log_sizeN><logN> */
-    uint32_t in;
-    uint32_t out;
-    uint32_t space_left;
+    uint8_t  buffer[LOG_RING_BUFFER_SIZE] __attribute__((aligned(4))); /* format: <4_bytes_header1><log1> ... */
+    uint32_t head;    /* End of the reserved records */
+    uint32_t tail;    /* Start of the first record not consumed */
+    uint32_t dropped; /* Number of logs dropped because the ring was full */
 } logRingBuffer_t;
 
-static logRingBuffer_t   logRingBuffer;
-static TaskHandle_t      dump_task_handle = NULL;
-static SemaphoreHandle_t mutexHandle      = NULL;
+static logRingBuffer_t logRingBuffer;
+static TaskHandle_t    dump_task_handle = NULL;
 
 static void RingInit(logRingBuffer_t *ring)
 {
-    ring->in         = 0;
-    ring->out        = 0;
-    ring->space_left = LOG_RING_BUFFER_SIZE;
-    mutexHandle      = xSemaphoreCreateMutex();
+    memset(ring, 0, sizeof(*ring));
+}
+
+static uint32_t RingOffset(uint32_t pos)
+{
+    return (pos < LOG_RING_BUFFER_SIZE) ? pos : pos - LOG_RING_BUFFER_SIZE;
+}
+
+static uint32_t RingAdvance(uint32_t pos, uint32_t size)
+{
+    pos += size;
+    return (pos < 2 * LOG_RING_BUFFER_SIZE) ? pos : pos - 2 * LOG_RING_BUFFER_SIZE;
+}
+
+static uint32_t RingUsed(uint32_t head, uint32_t tail)
+{
+    return (head >= tail) ? head - tail : head + 2 * LOG_RING_BUFFER_SIZE - tail;
+}
+
+/* Copy in or out of the ring with at most two memcpy, aData is NULL to clear the ring */
+static void RingCopy(logRingBuffer_t *ring, uint32_t pos, uint8_t *aData, uint32_t size, bool toRing)
+{
+    uint32_t offset = RingOffset(pos);
+    uint32_t first  = LOG_RING_BUFFER_SIZE - offset;
+
+    if (first > size)
+    {
+        first = size;
+    }
+
+    if (aData == NULL)
+    {
+        memset(&ring->buffer[offset], 0, first);
+        memset(&ring->buffer[0], 0, size - first);
+    }
+    else if (toRing)
+    {
+        memcpy(&ring->buffer[offset], aData, first);
+        memcpy(&ring->buffer[0], aData + first, size - first);
+    }
+    else
+    {
+        memcpy(aData, &ring->buffer[offset], first);
+        memcpy(aData + first, &ring->buffer[0], size - first);
+    }
 }
 
 /*
  * Consume a log in the ring buffer
- * Return the length of the log buffer consumed in the ring buffer.
+ * Return the length of the log buffer consumed in the ring buffer, 0 if no log is committed yet.
  */
 static uint16_t RingLogConsume(logRingBuffer_t *ring, uint8_t *pBufferOut, uint16_t bufferOutSize)
 {
-    uint32_t nbByteToRead = 0;
+    uint32_t  tail   = __atomic_load_n(&ring->tail, __ATOMIC_RELAXED);
+    uint32_t *header = (uint32_t *)&ring->buffer[RingOffset(tail)];
+    uint32_t  value  = __atomic_load_n(header, __ATOMIC_ACQUIRE);
+    uint16_t  len    = 0;
+
+    if (value & LOG_RECORD_COMMITTED)
+    {
+        len = (uint16_t)(value & LOG_RECORD_LENGTH_MASK);
+        RingCopy(ring, RingAdvance(tail, LOG_RECORD_HEADER_SIZE), pBufferOut,
+                 (len < bufferOutSize) ? len : bufferOutSize, false);
+        RingCopy(ring, tail, NULL, LOG_RECORD_SIZE(len), false);
+        __atomic_store_n(&ring->tail, RingAdvance(tail, LOG_RECORD_SIZE(len)), __ATOMIC_RELEASE);
+    }
+
+    return len;
+}
+
+/*
+ * Add a log buffer in the ring buffer.
+ * Return true if the whole log message has been added otherwise false
+ */
+static bool RingLogAdd(logRingBuffer_t *ring, const uint8_t *pData, uint16_t size)
+{
+    uint32_t recordSize = LOG_RECORD_SIZE(size);
+    uint32_t head       = __atomic_load_n(&ring->head, __ATOMIC_RELAXED);
+    bool     logAdded   = false;
 
-    xSemaphoreTake(mutexHandle, portMAX_DELAY);
+    /* Reserve the record */
     do
     {
-        nbByteToRead = LOG_RING_BUFFER_SIZE - ring->space_left;
-        if (nbByteToRead == 0)
+        if (RingUsed(head, __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE)) + recordSize > LOG_RING_BUFFER_SIZE)
+        {
+            __atomic_fetch_add(&ring->dropped, 1, __ATOMIC_RELAXED);
+            goto exit;
+        }
+    } while (!__atomic_compare_exchange_n(&ring->head, &head, RingAdvance(head, recordSize), true, __ATOMIC_ACQ_REL,
+                                          __ATOMIC_RELAXED));
+
+    /* Copy the log and commit it */
+    RingCopy(ring, RingAdvance(head, LOG_RECORD_HEADER_SIZE), (uint8_t *)pData, size, true);
+    __atomic_store_n((uint32_t *)&ring->buffer[RingOffset(head)], LOG_RECORD_COMMITTED | size, __ATOMIC_RELEASE);
+    logAdded = true;
+
+exit:
+    return logAdded;
+}
+#endif /* LOG_BUFFER_ENABLED */
+
+#ifdef LOG_BINARY_ENABLED
+#ifndef LOG_BUFFER_ENABLED
+#error "LOG_BINARY_ENABLED requires LOG_BUFFER_ENABLED"
+#endif
+
+/*
+ * Maximum number of characters of a %s argument stored in a binary log, unless it is the last argument: that one
+ * can fill the rest of the record, which is what the OpenThread core logs need as they are passed already formatted
+ * as otPlatLog(level, region, "%s", line).
+ */
+#ifndef LOG_BINARY_MAX_STRING_SIZE
+#define LOG_BINARY_MAX_STRING_SIZE 64
+#endif
+
+/* A truncated string is stored as <LOG_BINARY_STRING_TRUNCATED><1_byte_length><characters> */
+#define LOG_BINARY_STRING_TRUNCATED 0xFF
+#define LOG_BINARY_STRING_MAX_LENGTH (LOG_BINARY_STRING_TRUNCATED - 1)
+
+#if LOG_BINARY_MAX_STRING_SIZE > LOG_BINARY_STRING_MAX_LENGTH
+#error "LOG_BINARY_MAX_STRING_SIZE must fit in the 1 byte length of the strings"
+#endif
+
+/* Prefix of the hexadecimal binary logs decoded on the host by script/decode-binary-log */
+#define LOG_BINARY_PREFIX "#B:"
+#define LOG_TEXT_BUFFER_SIZE (sizeof(LOG_BINARY_PREFIX) + 2 * LOG_BUFFER_SIZE + EOL_CHARS_LEN)
+
+/*
+ * Binary logs are formatted in the dump task or on the host instead of the calling task.
+ * A binary log contains the address of the format string, a timestamp and the arguments in their native size and
+ * order, except for the strings which are copied as <1_byte_length><characters>, and marked when truncated.
+ */
+typedef enum
+{
+    kLogArgNone,
+    kLogArgInt,
+    kLogArgLong,
+    kLogArgLongLong,
+    kLogArgSize,
+    kLogArgPointer,
+    kLogArgDouble,
+    kLogArgLongDouble,
+    kLogArgString,
+} logArgType_t;
+
+typedef struct
+{
+    const char  *start; /* '%' of the conversion specification */
+    const char  *end;   /* Character following the conversion specifier */
+    uint8_t      stars; /* Number of '*' field width and precision arguments */
+    logArgType_t type;
+} logFormatSpec_t;
+
+static uint32_t LogTimestamp(void)
+{
+#ifdef LOG_32K_TICK_TIMESTAMP_ENABLED
+    return GPT_GetCurrentTimerCount(GPT2);
+#else
+    return xTaskGetTickCount();
+#endif
+}
+
+/*
+ * Find the next conversion specification of a format string.
+ * Return the character following it, or NULL if there is none.
+ */
+static const char *LogNextSpec(const char *aFormat, logFormatSpec_t *aSpec)
+{
+    const char *p = strchr(aFormat, '%');
+
+    if (p != NULL)
+    {
+        aSpec->start = p++;
+        aSpec->stars = 0;
+        aSpec->type  = kLogArgInt;
+
+        while ((*p != '\0') && (strchr("-+ #0123456789.*", *p) != NULL))
+        {
+            aSpec->stars += (*p++ == '*');
+        }
+        while ((*p != '\0') && (strchr("hlLjzt", *p) != NULL))
+        {
+            switch (*p++)
+            {
+            case 'l':
+                aSpec->type = (aSpec->type == kLogArgLong) ? kLogArgLongLong : kLogArgLong;
+                break;
+            case 'j':
+                aSpec->type = kLogArgLongLong;
+                break;
+            case 'z':
+            case 't':
+                aSpec->type = kLogArgSize;
+                break;
+            case 'L':
+                aSpec->type = kLogArgLongDouble;
+                break;
+            default:
+                break;
+            }
+        }
+
+        switch (*p)
+        {
+        case 'd':
+        case 'i':
+        case 'u':
+        case 'o':
+        case 'x':
+        case 'X':
+        case 'c':
+            aSpec->type = (aSpec->type == kLogArgLongDouble) ? kLogArgLongLong : aSpec->type;
+            break;
+        case 'p':
+            aSpec->type = kLogArgPointer;
+            break;
+        case 'f':
+        case 'F':
+        case 'e':
+        case 'E':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A':
+            aSpec->type = (aSpec->type == kLogArgLongDouble) ? kLogArgLongDouble : kLogArgDouble;
+            break;
+        case 's':
+            aSpec->type = kLogArgString;
+            break;
+        default:
+            /* "%%" or an unsupported conversion, which is then output as is */
+            aSpec->type  = kLogArgNone;
+            aSpec->stars = 0;
+            break;
+        }
+
+        aSpec->end = (*p != '\0') ? p + 1 : p;
+        p          = aSpec->end;
+    }
+
+    return p;
+}
+
+#define LOG_BINARY_APPEND(aRecord, aLen, aSize, aValue)      \
+    do                                                       \
+    {                                                        \
+        if ((aLen) + sizeof(aValue) > (aSize))               \
+        {                                                    \
+            goto exit;                                       \
+        }                                                    \
+        memcpy(&(aRecord)[aLen], &(aValue), sizeof(aValue)); \
+        (aLen) += sizeof(aValue);                            \
+    } while (0)
+
+/*
+ * Store a log in binary format, the arguments which do not fit in the record are dropped.
+ * Return the length of the record.
+ */
+static uint16_t LogBinaryEncode(uint8_t *aRecord, uint16_t aSize, const char *aFormat, va_list ap)
+{
+    const char     *format    = aFormat;
+    uint32_t        timestamp = LogTimestamp();
+    uint16_t        len       = 0;
+    logFormatSpec_t spec;
+
+    LOG_BINARY_APPEND(aRecord, len, aSize, aFormat);
+    LOG_BINARY_APPEND(aRecord, len, aSize, timestamp);
+
+    while ((format = LogNextSpec(format, &spec)) != NULL)
+    {
+        for (uint8_t i = 0; i < spec.stars; i++)
+        {
+            int value = va_arg(ap, int);
+            LOG_BINARY_APPEND(aRecord, len, aSize, value);
+        }
+
+        switch (spec.type)
+        {
+        case kLogArgInt:
+        {
+            int value = va_arg(ap, int);
+            LOG_BINARY_APPEND(aRecord, len, aSize, value);
+            break;
+        }
+        case kLogArgLong:
+        {
+            long value = va_arg(ap, long);
+            LOG_BINARY_APPEND(aRecord, len, aSize, value);
+            break;
+        }
+        case kLogArgLongLong:
+        {
+            long long value = va_arg(ap, long long);
+            LOG_BINARY_APPEND(aRecord, len, aSize, value);
+            break;
+        }
+        case kLogArgSize:
+        {
+            size_t value = va_arg(ap, size_t);
+            LOG_BINARY_APPEND(aRecord, len, aSize, value);
+            break;
+        }
+        case kLogArgPointer:
+        {
+            void *value = va_arg(ap, void *);
+            LOG_BINARY_APPEND(aRecord, len, aSize, value);
             break;
-        /* Extract/read the size of the log message */
-        nbByteToRead = ring->buffer[ring->out] << 8;
-        nbByteToRead += ring->buffer[(ring->out + 1) % LOG_RING_BUFFER_SIZE];
-        /* Check that we have enough space to store the whole log, otherwise abort */
-        if (nbByteToRead > bufferOutSize)
+        }
+        case kLogArgDouble:
+        case kLogArgLongDouble:
         {
-            nbByteToRead = 0;
+            double value = (spec.type == kLogArgDouble) ? va_arg(ap, double) : (double)va_arg(ap, long double);
+            LOG_BINARY_APPEND(aRecord, len, aSize, value);
             break;
         }
-        /* Jump to the log content and skip the log length */
-        ring->out = (ring->out + sizeof(uint16_t)) % LOG_RING_BUFFER_SIZE;
-        for (int i = 0; i < nbByteToRead; i++)
+        case kLogArgString:
         {
-            pBufferOut[i] = ring->buffer[ring->out];
-            ring->out++;
-            if (ring->out == LOG_RING_BUFFER_SIZE)
-                ring->out = 0;
-            ring->space_left++;
+            const char *value     = va_arg(ap, const char *);
+            bool        last      = (strchr(format, '%') == NULL);
+            uint16_t    maxLength = last ? LOG_BINARY_STRING_MAX_LENGTH : LOG_BINARY_MAX_STRING_SIZE;
+            uint16_t    length    = 0;
+
+            /* Keep room for the truncation mark and the length */
+            if (len + 2 > aSize)
+            {
+                goto exit;
+            }
+            if (maxLength > aSize - len - 2)
+            {
+                maxLength = aSize - len - 2;
+            }
+
+            value = (value != NULL) ? value : "(null)";
+            while ((length < maxLength) && (value[length] != '\0'))
+            {
+                length++;
+            }
+            if (value[length] != '\0')
+            {
+                aRecord[len++] = LOG_BINARY_STRING_TRUNCATED;
+            }
+            aRecord[len++] = (uint8_t)length;
+            memcpy(&aRecord[len], value, length);
+            len += length;
+            break;
         }
-    } while (0);
-    xSemaphoreGive(mutexHandle);
-    return nbByteToRead;
+        default:
+            break;
+        }
+    }
+
+exit:
+    return len;
 }
 
+#ifdef LOG_BINARY_EXPAND_ON_TARGET
+#define LOG_BINARY_READ(aRecord, aRecordLen, aOffset, aValue)   \
+    (((aOffset) + sizeof(aValue) <= (aRecordLen)) &&            \
+     (memcpy(&(aValue), &(aRecord)[aOffset], sizeof(aValue)) && \
+      ((aOffset) += sizeof(aValue), true)))
 /*
- * Add a log buffer in the ring buffer.
- * Return true if the whole log message has been added otherwise false
+ * Format a binary log in the dump task.
+ * Return the length of the text, including the end of line characters.
  */
-static bool RingLogAdd(logRingBuffer_t *ring, const uint8_t *pData, uint16_t size)
+static uint16_t LogBinaryExpand(const uint8_t *aRecord, uint16_t aRecordLen, char *aText, uint16_t aTextSize)
 {
-    bool logAdded = false;
+    int             maxSize = aTextSize - EOL_CHARS_LEN;
+    int             len     = 0;
+    uint16_t        offset  = 0;
+    const char     *format  = NULL;
+    const char     *literal;
+    uint32_t        timestamp;
+    logFormatSpec_t spec;
+
+    if (!LOG_BINARY_READ(aRecord, aRecordLen, offset, format) ||
+        !LOG_BINARY_READ(aRecord, aRecordLen, offset, timestamp))
+    {
+        format    = "<invalid binary log>";
+        timestamp = 0;
+    }
 
-    xSemaphoreTake(mutexHandle, portMAX_DELAY);
-    /* Check that we have enough space to store the log and its size */
-    if (ring->space_left >= size + sizeof(uint16_t))
+#define LOG_TEXT_APPEND(...)                                                      \
+    do                                                                            \
+    {                                                                             \
+        int ret = snprintf(aText + len, maxSize - len, __VA_ARGS__);              \
+        len += (ret < 0) ? 0 : ((ret < maxSize - len) ? ret : maxSize - len - 1); \
+    } while (0)
+
+    LOG_TEXT_APPEND("[%lu]", (unsigned long)timestamp);
+
+    literal = format;
+    while ((format = LogNextSpec(literal, &spec)) != NULL)
     {
-        ring->buffer[ring->in]                              = size >> 8;
-        ring->buffer[(ring->in + 1) % LOG_RING_BUFFER_SIZE] = (uint8_t)size;
-        ring->in                                            = (ring->in + sizeof(uint16_t)) % LOG_RING_BUFFER_SIZE;
-        for (int i = 0; i < size; i++)
+        /* Copy of the specification with the '*' replaced by their value */
+        char     specFormat[24];
+        uint16_t specLen = 0;
+        bool     valid   = true;
+
+        LOG_TEXT_APPEND("%.*s", (int)(spec.start - literal), literal);
+        literal = format;
+
+        for (const char *p = spec.start; (p < spec.end) && (specLen < sizeof(specFormat) - 12); p++)
+        {
+            int star;
+
+            if (*p != '*')
+            {
+                specFormat[specLen++] = *p;
+            }
+            else if ((valid = LOG_BINARY_READ(aRecord, aRecordLen, offset, star)))
+            {
+                specLen += snprintf(&specFormat[specLen], sizeof(specFormat) - specLen, "%d", star);
+            }
+        }
+        specFormat[specLen] = '\0';
+
+        switch (spec.type)
+        {
+        case kLogArgNone:
+            if (strcmp(specFormat, "%%") == 0)
+            {
+                LOG_TEXT_APPEND("%%");
+            }
+            else
+            {
+                LOG_TEXT_APPEND("%.*s", (int)(spec.end - spec.start), spec.start);
+            }
+            break;
+        case kLogArgInt:
+        {
+            int value;
+            if ((valid = valid && LOG_BINARY_READ(aRecord, aRecordLen, offset, value)))
+                LOG_TEXT_APPEND(specFormat, value);
+            break;
+        }
+        case kLogArgLong:
+        {
+            long value;
+            if ((valid = valid && LOG_BINARY_READ(aRecord, aRecordLen, offset, value)))
+                LOG_TEXT_APPEND(specFormat, value);
+            break;
+        }
+        case kLogArgLongLong:
+        {
+            long long value;
+            if ((valid = valid && LOG_BINARY_READ(aRecord, aRecordLen, offset, value)))
+                LOG_TEXT_APPEND(specFormat, value);
+            break;
+        }
+        case kLogArgSize:
+        {
+            size_t value;
+            if ((valid = valid && LOG_BINARY_READ(aRecord, aRecordLen, offset, value)))
+                LOG_TEXT_APPEND(specFormat, value);
+            break;
+        }
+        case kLogArgPointer:
         {
-            ring->buffer[ring->in++] = pData[i];
-            if (ring->in == LOG_RING_BUFFER_SIZE)
-                ring->in = 0;
-            ring->space_left--;
+            void *value;
+            if ((valid = valid && LOG_BINARY_READ(aRecord, aRecordLen, offset, value)))
+                LOG_TEXT_APPEND(specFormat, value);
+            break;
+        }
+        case kLogArgDouble:
+        case kLogArgLongDouble:
+        {
+            double value;
+            if ((valid = valid && LOG_BINARY_READ(aRecord, aRecordLen, offset, value)))
+            {
+                if (spec.type == kLogArgDouble)
+                    LOG_TEXT_APPEND(specFormat, value);
+                else
+                    LOG_TEXT_APPEND(specFormat, (long double)value);
+            }
+            break;
+        }
+        case kLogArgString:
+        {
+            uint8_t length;
+            bool    truncated = false;
+            if ((valid = valid && LOG_BINARY_READ(aRecord, aRecordLen, offset, length)) &&
+                (length == LOG_BINARY_STRING_TRUNCATED))
+            {
+                truncated = true;
+                valid     = LOG_BINARY_READ(aRecord, aRecordLen, offset, length);
+            }
+            if ((valid = valid && (offset + length <= aRecordLen)))
+            {
+                /* The string is not terminated in the record, limit the precision to its length */
+                char stringFormat[sizeof(specFormat) + 8];
+                int  precision = strcspn(specFormat, ".");
+                int  shown     = length;
+
+                precision = (precision < specLen) ? precision : specLen - 1;
+
+                snprintf(stringFormat, sizeof(stringFormat), "%.*s.*s", precision, specFormat);
+                if (specFormat[precision] == '.')
+                {
+                    int requested = atoi(&specFormat[precision + 1]);
+                    shown         = (requested < length) ? requested : length;
+                }
+                LOG_TEXT_APPEND(stringFormat, shown, (const char *)&aRecord[offset]);
+                if (truncated)
+                {
+                    LOG_TEXT_APPEND("...");
+                }
+                offset += length;
+            }
+            break;
+        }
+        }
+
+        if (!valid)
+        {
+            /* Arguments dropped because the record was full */
+            LOG_TEXT_APPEND("?");
+            break;
         }
-        logAdded = true;
     }
-    xSemaphoreGive(mutexHandle);
-    return logAdded;
+
+    if (format == NULL)
+    {
+        LOG_TEXT_APPEND("%s", literal);
+    }
+
+#undef LOG_TEXT_APPEND
+
+    memcpy(aText + len, EOL_CHARS, EOL_CHARS_LEN);
+    return len + EOL_CHARS_LEN;
 }
+#endif /* LOG_BINARY_EXPAND_ON_TARGET */
 
+/*
+ * Convert a binary log into a line of text, formatted on target with LOG_BINARY_EXPAND_ON_TARGET or encoded in
+ * hexadecimal for script/decode-binary-log otherwise.
+ * Return the length of the text, including the end of line characters.
+ */
+static uint16_t LogBinaryToText(const uint8_t *aRecord, uint16_t aRecordLen, char *aText, uint16_t aTextSize)
+{
+#ifdef LOG_BINARY_EXPAND_ON_TARGET
+    return LogBinaryExpand(aRecord, aRecordLen, aText, aTextSize);
+#else
+    static const char kHexDigits[] = "0123456789abcdef";
+    uint16_t          len          = sizeof(LOG_BINARY_PREFIX) - 1;
+
+    memcpy(aText, LOG_BINARY_PREFIX, len);
+    for (uint16_t i = 0; (i < aRecordLen) && (len + 2 + EOL_CHARS_LEN <= aTextSize); i++)
+    {
+        aText[len++] = kHexDigits[aRecord[i] >> 4];
+        aText[len++] = kHexDigits[aRecord[i] & 0x0F];
+    }
+    memcpy(aText + len, EOL_CHARS, EOL_CHARS_LEN);
+    return len + EOL_CHARS_LEN;
+#endif
+}
+#endif /* LOG_BINARY_ENABLED */
+
+static void otPlatLogOutput(uint8_t *logBuffer, uint16_t logBufferSize)
+{
+#ifdef MULTICORE_LOGGING_ENABLED
+    multicore_send_data(logBuffer, logBufferSize);
+#else
+    OT_UNUSED_VARIABLE(logBufferSize);
+    PRINTF("%s", logBuffer);
+#endif
+}
+
+static void otPlatLogFlush(void)
+{
+#ifdef MULTICORE_LOGGING_ENABLED
+    multicore_flush_data();
+#endif
+}
+
+#ifdef LOG_BUFFER_ENABLED
 static void otPlatLogDumpTask(void *param)
 {
     uint8_t  logBuffer[LOG_BUFFER_SIZE];
     uint16_t logBufferSize = 0;
+#ifdef LOG_BINARY_ENABLED
+    char     textBuffer[LOG_TEXT_BUFFER_SIZE];
+    uint16_t textSize;
+#endif
+    uint32_t dropped       = 0;
+    uint32_t reported      = 0;
 
     while (1)
     {
@@ -161,47 +690,81 @@ static void otPlatLogDumpTask(void *param)
             logBufferSize = RingLogConsume(&logRingBuffer, logBuffer, sizeof(logBuffer));
             if (logBufferSize == 0)
                 break;
-#ifdef MULTICORE_LOGGING_ENABLED
-            multicore_send_data(logBuffer, logBufferSize);
+#ifdef LOG_BINARY_ENABLED
+            textSize = LogBinaryToText(logBuffer, logBufferSize, textBuffer, sizeof(textBuffer));
+            otPlatLogOutput((uint8_t *)textBuffer, textSize);
 #else
-            PRINTF("%s", logBuffer);
+            otPlatLogOutput(logBuffer, logBufferSize);
 #endif
         } while (1);
+
+        dropped = otPlatLogGetDroppedCount();
+        if (dropped != reported)
+        {
+            logBufferSize = snprintf((char *)logBuffer, sizeof(logBuffer), "[%lu logs dropped]" EOL_CHARS,
+                                     (unsigned long)(dropped - reported));
+            otPlatLogOutput(logBuffer, logBufferSize + 1);
+            reported = dropped;
+        }
+
+        otPlatLogFlush();
     }
 }
 #endif
 
+uint32_t otPlatLogGetDroppedCount(void)
+{
+#ifdef LOG_BUFFER_ENABLED
+    return __atomic_load_n(&logRingBuffer.dropped, __ATOMIC_RELAXED);
+#else
+    return 0;
+#endif
+}
+
 static void otPlatLogImpl(otLogLevel aLogLevel, otLogRegion aLogRegion, const char *aFormat, va_list ap)
 {
     OT_UNUSED_VARIABLE(aLogLevel);
     OT_UNUSED_VARIABLE(aLogRegion);
-    int len     = 0;
-    int maxSize = LOG_BUFFER_SIZE - EOL_CHARS_LEN;
+#ifdef LOG_BINARY_ENABLED
+    /* The log is formatted later by the dump task or on the host, only its arguments are copied here */
+    uint8_t  record[LOG_BUFFER_SIZE];
+    uint16_t len = LogBinaryEncode(record, sizeof(record), aFormat, ap);
+
+    if (RingLogAdd(&logRingBuffer, record, len))
+    {
+        xTaskNotifyGive(dump_task_handle);
+    }
+#else
+    /* Formatted on the stack of the calling task, so that tasks logging at the same time do not share a buffer */
+    char txBuffer[LOG_BUFFER_SIZE];
+    int  len     = 0;
+    int  maxSize = LOG_BUFFER_SIZE - EOL_CHARS_LEN;
+    int  ret;
 
 #ifdef LOG_32K_TICK_TIMESTAMP_ENABLED
     uint32_t curTimeStampS = GPT_GetCurrentTimerCount(GPT2);
-    len                    = snprintf(sTxBuffer, maxSize, "[%lu]", curTimeStampS);
+    len                    = snprintf(txBuffer, maxSize, "[%lu]", curTimeStampS);
     maxSize -= len;
 #endif
 
-    len += vsnprintf(sTxBuffer + len, maxSize, aFormat, ap);
-    if (len >= 0)
+    ret = vsnprintf(txBuffer + len, maxSize, aFormat, ap);
+    if (ret >= 0)
     {
-        memcpy(sTxBuffer + len, EOL_CHARS, EOL_CHARS_LEN);
+        /* Keep the truncated log if it did not fit */
+        len += (ret < maxSize) ? ret : maxSize - 1;
+        memcpy(txBuffer + len, EOL_CHARS, EOL_CHARS_LEN);
         len += EOL_CHARS_LEN;
 #ifdef LOG_BUFFER_ENABLED
-        if (RingLogAdd(&logRingBuffer, (uint8_t *)sTxBuffer, len))
+        if (RingLogAdd(&logRingBuffer, (uint8_t *)txBuffer, len))
         {
             xTaskNotifyGive(dump_task_handle);
         }
 #else
-#ifdef MULTICORE_LOGGING_ENABLED
-        multicore_send_data((uint8_t *)sTxBuffer, len);
-#else
-        PRINTF("%s", sTxBuffer);
-#endif
+        otPlatLogOutput((uint8_t *)txBuffer, len);
+        otPlatLogFlush();
 #endif
     }
+#endif /* LOG_BINARY_ENABLED */
 }
 
 #if (OPENTHREAD_CONFIG_LOG_OUTPUT == OPENTHREAD_CONFIG_LOG_OUTPUT_PLATFORM_DEFINED)
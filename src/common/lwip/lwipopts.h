@@ -520,5 +520,12 @@ u32_t lwip_rand(void);
 #define LWIP_NETCONN_FULLDUPLEX 0
 // Note: According to Thread Conformance v1.2.0, a Thread Border Router MUST be able to hold a Multicast Listeners Table
 //  in memory with at least seventy five (75) entries.
-#define MEMP_NUM_MLD6_GROUP 10 + 75
+// Number of multicast groups the Border Router forwards from the infrastructure link (lwip_mcast.c). Each one also needs
+//  an MLD group, so overriding it, for both LwIP and the platform, raises MEMP_NUM_MLD6_GROUP and the filter size too.
+#ifndef OT_LWIP_MCAST_MAX_GROUPS
+#define OT_LWIP_MCAST_MAX_GROUPS 75
+#endif
+#ifndef MEMP_NUM_MLD6_GROUP
+#define MEMP_NUM_MLD6_GROUP (10 + OT_LWIP_MCAST_MAX_GROUPS)
+#endif
 #endif /* __LWIPOPTS_H__ */
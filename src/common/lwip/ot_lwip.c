@@ -31,8 +31,10 @@
 /* -------------------------------------------------------------------------- */
 
 #include "ot_lwip.h"
+#include "ot_platform_common.h"
 #include "token_bucket.h"
 
+#include <assert.h>
 #include <string.h>
 
 #include <common/code_utils.hpp>
@@ -42,15 +44,71 @@
 #include <openthread/ip6.h>
 #include <openthread/message.h>
 #include <openthread/nat64.h>
+#include <openthread/tasklet.h>
 #include <openthread/thread.h>
 
 #include "lwip_tcpip_init_once.h"
+#include "lwip/prot/ip6.h"
 #include "lwip/tcpip.h"
 
 /* -------------------------------------------------------------------------- */
 /*                                 Definitions                                */
 /* -------------------------------------------------------------------------- */
 
+/* Number of IPv6 packets from LwIP waiting to be sent by the OpenThread task.
+ * When 0, packets are sent from the LwIP thread, which then waits for the OpenThread lock. */
+#ifndef OT_LWIP_INGRESS_QUEUE_SIZE
+#define OT_LWIP_INGRESS_QUEUE_SIZE 16
+#endif
+
+/* Maximum number of queued packets sent in one otPlatLwipProcess call */
+#ifndef OT_LWIP_INGRESS_BATCH_SIZE
+#define OT_LWIP_INGRESS_BATCH_SIZE 8
+#endif
+
+/* Queued packets are spread in flows by destination address and DSCP, and sent with deficit round robin so that a bulk
+ * flow does not delay the other ones. Each flow queues up to OT_LWIP_INGRESS_FLOW_DEPTH packets and gets
+ * OT_LWIP_INGRESS_FLOW_QUANTUM bytes of credit per round. */
+#ifndef OT_LWIP_INGRESS_FLOWS
+#define OT_LWIP_INGRESS_FLOWS 4
+#endif
+
+#ifndef OT_LWIP_INGRESS_FLOW_DEPTH
+#define OT_LWIP_INGRESS_FLOW_DEPTH 8
+#endif
+
+#ifndef OT_LWIP_INGRESS_FLOW_QUANTUM
+#define OT_LWIP_INGRESS_FLOW_QUANTUM 320
+#endif
+
+#if defined(OT_APP_THREAD_RATE_LIMIT) && (OT_APP_THREAD_RATE_LIMIT >= 8)
+/* Rate limiting charges the bytes sent on air: an IPv6 packet is sent in one or more 802.15.4 frames, each costing
+ * the PHY header and a full PSDU. The payload left in a frame by the MAC header, security and FCS is an estimate for
+ * short addresses and key id mode 1. */
+#define THREAD_FRAME_AIR_SIZE (6U + 127U)
+#ifndef OT_LWIP_RATE_LIMIT_FRAME_PAYLOAD
+#define OT_LWIP_RATE_LIMIT_FRAME_PAYLOAD 106U
+#endif
+/* The first fragment has a 4 bytes header and the IPv6 header compressed to about 6 bytes (IPHC). The next fragments
+ * have a 5 bytes header and carry a multiple of 8 bytes. */
+#define THREAD_FIRST_FRAG_IP6_BYTES (OT_LWIP_RATE_LIMIT_FRAME_PAYLOAD - 4U + 34U)
+#define THREAD_NEXT_FRAG_IP6_BYTES ((OT_LWIP_RATE_LIMIT_FRAME_PAYLOAD - 5U) & ~7U)
+/* Bytes sent on air for an IPv6 packet of the Thread interface MTU, as computed by otPlatLwipThreadAirCost */
+#define THREAD_MAX_IP6_PACKET 1280U
+#define THREAD_MAX_PACKET_AIR_COST                                                                       \
+    ((1U + (THREAD_MAX_IP6_PACKET - THREAD_FIRST_FRAG_IP6_BYTES + THREAD_NEXT_FRAG_IP6_BYTES - 1U) / \
+               THREAD_NEXT_FRAG_IP6_BYTES) *                                                             \
+     THREAD_FRAME_AIR_SIZE)
+/* OT_APP_THREAD_RATE_LIMIT is in IPv6 bits per second. It is converted to on air bytes per second with the overhead
+ * of a full size packet, so that full size packets keep that IPv6 rate and smaller ones pay for their extra frames. */
+#define THREAD_AIR_RATE_LIMIT \
+    ((uint32_t)(((uint64_t)OT_APP_THREAD_RATE_LIMIT * THREAD_MAX_PACKET_AIR_COST) / (8U * THREAD_MAX_IP6_PACKET)))
+/* The bucket holds one second of tokens, it must hold a full size packet for it to ever be sent */
+#if OT_APP_THREAD_RATE_LIMIT < 8U * THREAD_MAX_IP6_PACKET
+#error "OT_APP_THREAD_RATE_LIMIT must allow at least one 1280 bytes IPv6 packet per second (10240 bits per second)"
+#endif
+#endif
+
 /* -------------------------------------------------------------------------- */
 /*                               Private memory                               */
 /* -------------------------------------------------------------------------- */
@@ -64,6 +122,25 @@ static bool             sThreadIfaceNotAdded = true;
 #if defined(OT_APP_THREAD_RATE_LIMIT) && (OT_APP_THREAD_RATE_LIMIT >= 8)
 static otTokenBucket sTokenBucket;
 #endif
+static otPlatLwipCopyStats sCopyStats;
+#if OT_LWIP_INGRESS_QUEUE_SIZE > 0
+typedef struct otPlatLwipFlow
+{
+    struct pbuf        *mPackets[OT_LWIP_INGRESS_FLOW_DEPTH];
+    uint8_t             mHead;
+    uint8_t             mCount;
+    bool                mActive;  ///< The flow is in the round robin list.
+    int32_t             mDeficit; ///< Bytes the flow can still send in the current round.
+    otPlatLwipFlowStats mStats;
+} otPlatLwipFlow;
+
+static otPlatLwipFlow         sIngressFlows[OT_LWIP_INGRESS_FLOWS];
+static uint8_t                sActiveFlows[OT_LWIP_INGRESS_FLOWS]; /* Round robin order of the flows with packets */
+static uint8_t                sActiveHead   = 0;
+static uint8_t                sActiveCount  = 0;
+static uint16_t               sIngressCount = 0;
+static otPlatLwipIngressStats sIngressStats;
+#endif
 /* -------------------------------------------------------------------------- */
 /*                             Private prototypes                             */
 /* -------------------------------------------------------------------------- */
@@ -71,6 +148,14 @@ static otTokenBucket sTokenBucket;
 static err_t   otPlatLwipThreadNetIfInitCallback(struct netif *netif);
 static err_t   otPlatLwipSendPacket(struct netif *netif, struct pbuf *pkt, const struct ip6_addr *ipaddr);
 static err_t   otPlatLwipSendIp4Packet(struct netif *netif, struct pbuf *pkt, const struct ip4_addr *ipaddr);
+static err_t   otPlatLwipSendToOt(struct pbuf *pkt);
+#if OT_LWIP_INGRESS_QUEUE_SIZE > 0
+static uint8_t      otPlatLwipGetFlowIndex(struct pbuf *pkt);
+static struct pbuf *otPlatLwipIngressDequeue(void);
+#endif
+#if defined(OT_APP_THREAD_RATE_LIMIT) && (OT_APP_THREAD_RATE_LIMIT >= 8)
+static uint32_t otPlatLwipThreadAirCost(uint32_t ip6Length);
+#endif
 static void    otPlatLwipReceivePacket(otMessage *pkt, void *context);
 static otError otPlatLwipCopyToOtMsg(struct pbuf *lwipIpPkt, otMessage *otIpPkt);
 
@@ -126,8 +211,8 @@ void otPlatLwipAddThreadInterface(void)
 #if defined(OT_APP_THREAD_RATE_LIMIT) && (OT_APP_THREAD_RATE_LIMIT >= 8)
     /* Initialize rate limiter. This is done while lwIP lock is held to prevent it being called before initialization is
      * complete. */
-    otTokenBucketInit(&sTokenBucket,
-                      OT_APP_THREAD_RATE_LIMIT / 8U); /* Convert from bits per second to bytes per second. */
+    otTokenBucketInit(&sTokenBucket, THREAD_AIR_RATE_LIMIT);
+    assert(otPlatLwipThreadAirCost(THREAD_MAX_IP6_PACKET) == THREAD_MAX_PACKET_AIR_COST);
 #endif
     /* Unlock LwIP stack */
     UNLOCK_TCPIP_CORE();
@@ -263,6 +348,13 @@ void otPlatLwipUpdateState(otChangedFlags flags, void *context)
 
         UNLOCK_TCPIP_CORE();
     }
+
+    otPlatLwipHooksUpdateState(flags);
+}
+
+OT_TOOL_WEAK void otPlatLwipHooksUpdateState(otChangedFlags flags)
+{
+    OT_UNUSED_VARIABLE(flags);
 }
 
 struct pbuf *otPlatLwipConvertToLwipMsg(otMessage *otIpPkt, bool bTransport)
@@ -270,6 +362,7 @@ struct pbuf *otPlatLwipConvertToLwipMsg(otMessage *otIpPkt, bool bTransport)
     struct pbuf *lwipIpPkt    = NULL;
     bool         bFreeLwipPkt = false;
     uint16_t     lwipIpPktLen = otMessageGetLength(otIpPkt);
+    uint16_t     offset       = 0;
 
     // Allocate an LwIP pbuf to hold the inbound packet.
     if (bTransport)
@@ -283,12 +376,21 @@ struct pbuf *otPlatLwipConvertToLwipMsg(otMessage *otIpPkt, bool bTransport)
 
     VerifyOrExit(lwipIpPkt != NULL);
 
-    // Copy the packet data from the OpenThread message object to the pbuf.
-    if (otMessageRead(otIpPkt, 0, lwipIpPkt->payload, lwipIpPktLen) != lwipIpPktLen)
+    // Copy the packet data from the OpenThread message object to the pbuf. A PBUF_POOL pbuf is a chain when the
+    // packet does not fit in a single pool buffer.
+    for (struct pbuf *partialPkt = lwipIpPkt; (partialPkt != NULL) && (offset < lwipIpPktLen);
+         partialPkt              = partialPkt->next)
     {
-        ExitNow(bFreeLwipPkt = true);
+        if (otMessageRead(otIpPkt, offset, partialPkt->payload, partialPkt->len) != partialPkt->len)
+        {
+            ExitNow(bFreeLwipPkt = true);
+        }
+        offset = (uint16_t)(offset + partialPkt->len);
     }
 
+    sCopyStats.mToLwipPackets++;
+    sCopyStats.mToLwipBytes += lwipIpPktLen;
+
 exit:
     if (bFreeLwipPkt)
     {
@@ -325,6 +427,80 @@ struct netif *otPlatLwipGetOtNetif(void)
     return &sThreadNetIf;
 }
 
+void otPlatLwipGetCopyStats(otPlatLwipCopyStats *stats)
+{
+    *stats = sCopyStats;
+}
+
+void otPlatLwipProcess(void)
+{
+#if OT_LWIP_INGRESS_QUEUE_SIZE > 0
+    struct pbuf *pkt;
+    uint32_t     batchSize  = 0;
+    uint32_t     sendFailed = 0;
+
+    SYS_ARCH_DECL_PROTECT(lev);
+
+    while ((batchSize < OT_LWIP_INGRESS_BATCH_SIZE) && ((pkt = otPlatLwipIngressDequeue()) != NULL))
+    {
+        if (otPlatLwipSendToOt(pkt) != ERR_OK)
+        {
+            sendFailed++;
+        }
+        pbuf_free(pkt);
+        batchSize++;
+    }
+
+    if (batchSize > 0)
+    {
+        SYS_ARCH_PROTECT(lev);
+        sIngressStats.mSendFailed += sendFailed;
+        sIngressStats.mBatches++;
+        if (batchSize > sIngressStats.mMaxBatch)
+        {
+            sIngressStats.mMaxBatch = batchSize;
+        }
+        SYS_ARCH_UNPROTECT(lev);
+    }
+
+    if (sIngressCount > 0)
+    {
+        /* Let the other OpenThread processing run before the next batch */
+        otSysEventSetPending(OT_SYS_EVENT_LWIP);
+        otTaskletsSignalPending(sInstance);
+    }
+#endif
+}
+
+void otPlatLwipGetIngressStats(otPlatLwipIngressStats *stats)
+{
+#if OT_LWIP_INGRESS_QUEUE_SIZE > 0
+    SYS_ARCH_DECL_PROTECT(lev);
+
+    SYS_ARCH_PROTECT(lev);
+    *stats = sIngressStats;
+    SYS_ARCH_UNPROTECT(lev);
+#else
+    memset(stats, 0, sizeof(*stats));
+#endif
+}
+
+bool otPlatLwipGetFlowStats(uint8_t flowIndex, otPlatLwipFlowStats *stats)
+{
+#if OT_LWIP_INGRESS_QUEUE_SIZE > 0
+    SYS_ARCH_DECL_PROTECT(lev);
+
+    if (flowIndex < OT_LWIP_INGRESS_FLOWS)
+    {
+        SYS_ARCH_PROTECT(lev);
+        *stats = sIngressFlows[flowIndex].mStats;
+        SYS_ARCH_UNPROTECT(lev);
+        return true;
+    }
+#endif
+    return false;
+}
+
 #if OPENTHREAD_CONFIG_NAT64_TRANSLATOR_ENABLE
 otError otPlatLwipNat64Send(struct pbuf *lwipIpv4Pkt)
 {
@@ -343,8 +519,9 @@ otError otPlatLwipNat64Send(struct pbuf *lwipIpv4Pkt)
     (20U) /* Expected length increase after translating from IPv4 to IPv6 (IPv6 header size (40) - smallest IPv4 \
              header size (20)) */
     /* Check we haven't exceeded rate limit so far */
-    VerifyOrExit(otTokenBucketCanTake(&sTokenBucket, lwipIpv4Pkt->tot_len + IPV6_HEADER_OVERHEAD),
-                 result = OT_ERROR_BUSY);
+    VerifyOrExit(
+        otTokenBucketCanTake(&sTokenBucket, otPlatLwipThreadAirCost(lwipIpv4Pkt->tot_len + IPV6_HEADER_OVERHEAD)),
+        result = OT_ERROR_BUSY);
 #endif
 
     /* Create OT message to copy lwIP packet into */
@@ -368,7 +545,7 @@ otError otPlatLwipNat64Send(struct pbuf *lwipIpv4Pkt)
     /* Packet really consumed by translator, count it to the rate limit now.
      * If tokenBucket has been depleted after the call to otTokenBucketCanTake
      * from a concurrent task, we may have exceeded a rate limit a little. */
-    (void)otTokenBucketTake(&sTokenBucket, lwipIpv4Pkt->tot_len + IPV6_HEADER_OVERHEAD);
+    (void)otTokenBucketTake(&sTokenBucket, otPlatLwipThreadAirCost(lwipIpv4Pkt->tot_len + IPV6_HEADER_OVERHEAD));
 #endif
 
 exit:
@@ -399,7 +576,80 @@ static err_t otPlatLwipThreadNetIfInitCallback(struct netif *netif)
 
 static err_t otPlatLwipSendPacket(struct netif *netif, struct pbuf *pkt, const struct ip6_addr *ipaddr)
 {
-    err_t lwipErr = ERR_IF;
+#if OT_LWIP_INGRESS_QUEUE_SIZE > 0
+    err_t           lwipErr   = ERR_OK;
+    struct pbuf    *queuedPkt = pkt;
+    bool            queued    = false;
+    otPlatLwipFlow *flow      = &sIngressFlows[otPlatLwipGetFlowIndex(pkt)];
+
+    SYS_ARCH_DECL_PROTECT(lev);
+
+    /* The packet is sent later by the OpenThread task, so the LwIP thread never waits for the OpenThread lock.
+     * Keep a reference to the pbuf, or a copy when its payload may change after this call (PBUF_REF/ROM). */
+    for (struct pbuf *partialPkt = pkt; partialPkt != NULL; partialPkt = partialPkt->next)
+    {
+        if (PBUF_NEEDS_COPY(partialPkt))
+        {
+            queuedPkt = pbuf_clone(PBUF_RAW, PBUF_RAM, pkt);
+            VerifyOrExit(queuedPkt != NULL, lwipErr = ERR_MEM);
+            break;
+        }
+    }
+
+    if (queuedPkt == pkt)
+    {
+        pbuf_ref(pkt);
+    }
+
+    SYS_ARCH_PROTECT(lev);
+    if ((sIngressCount < OT_LWIP_INGRESS_QUEUE_SIZE) && (flow->mCount < OT_LWIP_INGRESS_FLOW_DEPTH))
+    {
+        flow->mPackets[(flow->mHead + flow->mCount) % OT_LWIP_INGRESS_FLOW_DEPTH] = queuedPkt;
+        flow->mCount++;
+
+        if (!flow->mActive)
+        {
+            /* The flow joins the end of the round */
+            sActiveFlows[(sActiveHead + sActiveCount) % OT_LWIP_INGRESS_FLOWS] = (uint8_t)(flow - sIngressFlows);
+
+            sActiveCount++;
+            flow->mActive  = true;
+            flow->mDeficit = 0;
+        }
+
+        sIngressCount = sIngressCount + 1;
+        queued        = true;
+
+        flow->mStats.mEnqueued++;
+        sIngressStats.mEnqueued++;
+        if (sIngressCount > sIngressStats.mMaxDepth)
+        {
+            sIngressStats.mMaxDepth = sIngressCount;
+        }
+    }
+    else
+    {
+        flow->mStats.mDropped++;
+        sIngressStats.mDropped++;
+    }
+    SYS_ARCH_UNPROTECT(lev);
+
+    if (queued)
+    {
+        otSysEventSetPending(OT_SYS_EVENT_LWIP);
+        otTaskletsSignalPending(sInstance);
+    }
+    else
+    {
+        pbuf_free(queuedPkt);
+        lwipErr = ERR_MEM;
+    }
+
+exit:
+    /* pkt is freed by LWIP stack */
+    return lwipErr;
+#else
+    err_t lwipErr;
 
     /* Temporarily release the TCP/IP mutex, take OT mutex, and take back TCP/IP mutex to preserve the
      * mutex take order as to avoid deadlock. */
@@ -411,10 +661,99 @@ static err_t otPlatLwipSendPacket(struct netif *netif, struct pbuf *pkt, const s
     // Take back TCP/IP mutex which was temporarily released above
     LOCK_TCPIP_CORE();
 
+    lwipErr = otPlatLwipSendToOt(pkt);
+
+    // Unlock OT
+    sLockTaskCb(false);
+
+    /* pkt is freed by LWIP stack */
+    return lwipErr;
+#endif
+}
+
+#if OT_LWIP_INGRESS_QUEUE_SIZE > 0
+/* Return the flow of an IPv6 packet, hashing its destination address and DSCP */
+static uint8_t otPlatLwipGetFlowIndex(struct pbuf *pkt)
+{
+    const struct ip6_hdr *ip6Header = (const struct ip6_hdr *)pkt->payload;
+    const uint8_t        *dest      = (const uint8_t *)&ip6Header->dest;
+    uint32_t              hash      = 2166136261U;
+
+    VerifyOrExit(pkt->len >= IP6_HLEN, hash = 0);
+
+    /* FNV-1a */
+    for (uint8_t i = 0; i < sizeof(ip6Header->dest); i++)
+    {
+        hash = (hash ^ dest[i]) * 16777619U;
+    }
+    hash = (hash ^ (IP6H_TC(ip6Header) >> 2)) * 16777619U;
+
+exit:
+    return (uint8_t)(hash % OT_LWIP_INGRESS_FLOWS);
+}
+
+/* Remove the next packet to send from the flows, using deficit round robin, and count it as sent by its flow */
+static struct pbuf *otPlatLwipIngressDequeue(void)
+{
+    struct pbuf *pkt = NULL;
+
+    SYS_ARCH_DECL_PROTECT(lev);
+
+    SYS_ARCH_PROTECT(lev);
+    while ((pkt == NULL) && (sActiveCount > 0))
+    {
+        uint8_t         flowIndex  = sActiveFlows[sActiveHead];
+        otPlatLwipFlow *activeFlow = &sIngressFlows[flowIndex];
+        struct pbuf    *headPkt    = activeFlow->mPackets[activeFlow->mHead];
+
+        sActiveHead = (sActiveHead + 1) % OT_LWIP_INGRESS_FLOWS;
+
+        if (activeFlow->mDeficit < headPkt->tot_len)
+        {
+            /* Not enough credit left in this round, give the next quantum and move the flow to the end */
+            activeFlow->mDeficit += OT_LWIP_INGRESS_FLOW_QUANTUM;
+            sActiveFlows[(sActiveHead + sActiveCount - 1) % OT_LWIP_INGRESS_FLOWS] = flowIndex;
+            continue;
+        }
+
+        pkt               = headPkt;
+        activeFlow->mHead = (activeFlow->mHead + 1) % OT_LWIP_INGRESS_FLOW_DEPTH;
+        activeFlow->mCount--;
+        activeFlow->mDeficit -= headPkt->tot_len;
+
+        sIngressCount = sIngressCount - 1;
+
+        activeFlow->mStats.mSentPackets++;
+        activeFlow->mStats.mSentBytes += headPkt->tot_len;
+
+        if (activeFlow->mCount == 0)
+        {
+            /* The flow leaves the round, it does not keep its credit */
+            activeFlow->mActive  = false;
+            activeFlow->mDeficit = 0;
+            sActiveCount--;
+        }
+        else
+        {
+            /* The flow keeps sending while it has credit */
+            sActiveHead = (sActiveHead + OT_LWIP_INGRESS_FLOWS - 1) % OT_LWIP_INGRESS_FLOWS;
+        }
+    }
+    SYS_ARCH_UNPROTECT(lev);
+
+    return pkt;
+}
+#endif
+
+/* Send an IPv6 packet from LwIP to OpenThread, OT lock must be held */
+static err_t otPlatLwipSendToOt(struct pbuf *pkt)
+{
+    err_t lwipErr = ERR_IF;
+
 #if defined(OT_APP_THREAD_RATE_LIMIT) && (OT_APP_THREAD_RATE_LIMIT >= 8)
-    /* TODO: Instead of using lwIP packet length for rate limiting, calculate how many bytes
-     * would be output to Thread network with its fragmentation and different header size. */
-    if (otTokenBucketTake(&sTokenBucket, pkt->tot_len) != pkt->tot_len)
+    uint32_t cost = otPlatLwipThreadAirCost(pkt->tot_len);
+
+    if (otTokenBucketTake(&sTokenBucket, cost) != cost)
     {
         /* Sending the packet would exceed the rate limit. */
         lwipErr = ERR_IF;
@@ -437,10 +776,6 @@ static err_t otPlatLwipSendPacket(struct netif *netif, struct pbuf *pkt, const s
     }
 #endif
 
-    // Unlock OT
-    sLockTaskCb(false);
-
-    /* pkt is freed by LWIP stack */
     return lwipErr;
 }
 
@@ -485,6 +820,22 @@ static err_t otPlatLwipSendIp4Packet(struct netif *netif, struct pbuf *pkt, cons
     return lwipErr;
 }
 
+#if defined(OT_APP_THREAD_RATE_LIMIT) && (OT_APP_THREAD_RATE_LIMIT >= 8)
+/* Estimate the bytes sent on air for an IPv6 packet, from the number of 6LoWPAN fragments */
+static uint32_t otPlatLwipThreadAirCost(uint32_t ip6Length)
+{
+    uint32_t frames = 1U;
+
+    if (ip6Length > THREAD_FIRST_FRAG_IP6_BYTES)
+    {
+        ip6Length -= THREAD_FIRST_FRAG_IP6_BYTES;
+        frames += (ip6Length + THREAD_NEXT_FRAG_IP6_BYTES - 1U) / THREAD_NEXT_FRAG_IP6_BYTES;
+    }
+
+    return frames * THREAD_FRAME_AIR_SIZE;
+}
+#endif
+
 static void otPlatLwipReceivePacket(otMessage *pkt, void *context)
 {
     struct pbuf *lwipIpPkt = otPlatLwipConvertToLwipMsg(pkt, false);
@@ -506,21 +857,28 @@ static void otPlatLwipReceivePacket(otMessage *pkt, void *context)
 
 static otError otPlatLwipCopyToOtMsg(struct pbuf *lwipIpPkt, otMessage *otIpPkt)
 {
-    uint16_t remainingLen;
-    otError  error = OT_ERROR_FAILED;
+    uint16_t remainingLen = lwipIpPkt->tot_len;
+    uint16_t offset       = otMessageGetLength(otIpPkt);
+    otError  error        = OT_ERROR_FAILED;
+
+    // Allocate the message buffers once for the whole packet instead of growing the message for each pbuf.
+    VerifyOrExit(otMessageSetLength(otIpPkt, offset + remainingLen) == OT_ERROR_NONE);
 
     // Copy data from LwIP's packet buffer chain into the OpenThread message.
-    remainingLen = lwipIpPkt->tot_len;
     for (struct pbuf *partialPkt = lwipIpPkt; (partialPkt != NULL) && (remainingLen > 0); partialPkt = partialPkt->next)
     {
         VerifyOrExit(partialPkt->len <= remainingLen);
 
-        VerifyOrExit(otMessageAppend(otIpPkt, partialPkt->payload, partialPkt->len) == OT_ERROR_NONE);
+        otMessageWrite(otIpPkt, offset, partialPkt->payload, partialPkt->len);
+        offset       = (uint16_t)(offset + partialPkt->len);
         remainingLen = (uint16_t)(remainingLen - partialPkt->len);
     }
     VerifyOrExit(remainingLen == 0);
     error = OT_ERROR_NONE;
 
+    sCopyStats.mToOtPackets++;
+    sCopyStats.mToOtBytes += lwipIpPkt->tot_len;
+
 exit:
     return error;
 }
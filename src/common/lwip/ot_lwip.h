@@ -46,6 +46,35 @@ extern "C" {
  */
 typedef void (*otPlatLockTaskCb)(bool bLockState);
 
+/* Packets and bytes copied between OpenThread messages and LwIP pbufs, in each direction */
+typedef struct otPlatLwipCopyStats
+{
+    uint32_t mToLwipPackets;
+    uint32_t mToLwipBytes;
+    uint32_t mToOtPackets;
+    uint32_t mToOtBytes;
+} otPlatLwipCopyStats;
+
+/* IPv6 packets queued by the LwIP thread for the OpenThread task */
+typedef struct otPlatLwipIngressStats
+{
+    uint32_t mEnqueued;   ///< Packets queued.
+    uint32_t mDropped;    ///< Packets dropped because the queue was full.
+    uint32_t mSendFailed; ///< Queued packets that OpenThread could not send.
+    uint32_t mBatches;    ///< Number of otPlatLwipProcess calls which sent packets.
+    uint32_t mMaxBatch;   ///< Largest number of packets sent by one otPlatLwipProcess call.
+    uint32_t mMaxDepth;   ///< Largest number of packets waiting in the queue.
+} otPlatLwipIngressStats;
+
+/* Counters of a flow of the queue of packets sent from LwIP to the Thread interface */
+typedef struct otPlatLwipFlowStats
+{
+    uint32_t mEnqueued;    ///< Packets queued.
+    uint32_t mDropped;     ///< Packets dropped because the flow or the queue was full.
+    uint32_t mSentPackets; ///< Packets passed to OpenThread.
+    uint32_t mSentBytes;   ///< Bytes passed to OpenThread.
+} otPlatLwipFlowStats;
+
 /*!
  * @brief This function initializes LWIP stack
  *
@@ -77,6 +106,15 @@ void otPlatLwipAddThreadInterface(void);
  */
 void otPlatLwipUpdateState(otChangedFlags flags, void *context);
 
+/*!
+ * @brief Called by otPlatLwipUpdateState for every state change, so that the border router lwIP hooks can refresh
+ * their copy of the network data prefixes without registering another otStateChangedCallback
+ * (OPENTHREAD_CONFIG_MAX_STATECHANGE_HANDLERS). The default implementation does nothing.
+ *
+ * @param[in] flags flags informing on what's changed
+ */
+void otPlatLwipHooksUpdateState(otChangedFlags flags);
+
 /*!
  * @brief This function converts an OT message to a Lwip message
  *
@@ -101,6 +139,29 @@ otMessage *otPlatLwipConvertToOtMsg(struct pbuf *lwipIpPkt);
  */
 struct netif *otPlatLwipGetOtNetif(void);
 
+/*!
+ * @brief This function returns the number of packets and bytes copied between OT messages and Lwip messages
+ *
+ * @param[out] stats pointer to the copy statistics
+ */
+void otPlatLwipGetCopyStats(otPlatLwipCopyStats *stats);
+
+/*!
+ * @brief This function returns the statistics of the queue of packets sent from Lwip to the Thread interface
+ *
+ * @param[out] stats pointer to the queue statistics
+ */
+void otPlatLwipGetIngressStats(otPlatLwipIngressStats *stats);
+
+/*!
+ * @brief This function returns the counters of a flow of the queue of packets sent from Lwip to the Thread interface
+ *
+ * @param[in] flowIndex index of the flow, from 0
+ * @param[out] stats pointer to the flow counters
+ * @return true if the flow exists, false otherwise
+ */
+bool otPlatLwipGetFlowStats(uint8_t flowIndex, otPlatLwipFlowStats *stats);
+
 #if OPENTHREAD_CONFIG_NAT64_TRANSLATOR_ENABLE
 /*!
  * @brief This function checks if an IPv4 lwIP datagram should be translated to an IPv6 datagram
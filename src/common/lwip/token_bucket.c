@@ -46,7 +46,7 @@
 /*                             Private prototypes                             */
 /* -------------------------------------------------------------------------- */
 
-static void otTokenBucketCallback(TimerHandle_t xTimer);
+static void otTokenBucketRefill(otTokenBucket *aBucket);
 
 /* -------------------------------------------------------------------------- */
 /*                              Public functions                              */
@@ -54,109 +54,91 @@ static void otTokenBucketCallback(TimerHandle_t xTimer);
 
 void otTokenBucketInit(otTokenBucket *aBucket, uint32_t rate)
 {
-    uint32_t timerPeriodTicks;
-
     assert(aBucket != NULL);
     assert(rate != 0U);
     assert(rate <= MAX_RATE);
 
-    aBucket->mutex = xSemaphoreCreateMutex();
-    assert(aBucket->mutex != NULL);
-
     /* Rate and tokens are internally stored as thousandths to have "three decimal places" */
-    aBucket->rate   = TO_FRACTIONS(rate);
-    aBucket->tokens = aBucket->rate;
-
-    /* Period in RTOS ticks after which token(s) should be added */
-    timerPeriodTicks = configTICK_RATE_HZ / rate;
-    if (timerPeriodTicks == 0U)
-    {
-        timerPeriodTicks = 1U;
-    }
-
-    /* Set token increment to ((rate per second) / (timer period in Hz)) */
-    aBucket->increment = aBucket->rate / (configTICK_RATE_HZ / timerPeriodTicks);
-
-    aBucket->timer = xTimerCreate("tokenTimer", timerPeriodTicks, pdTRUE, (void *)aBucket, otTokenBucketCallback);
-    assert(aBucket->timer != NULL);
-
-    assert(xTimerStart(aBucket->timer, 0) == pdPASS);
+    aBucket->rate       = TO_FRACTIONS(rate);
+    aBucket->tokens     = aBucket->rate;
+    aBucket->lastRefill = (uint32_t)xTaskGetTickCount();
 }
 
 uint32_t otTokenBucketTake(otTokenBucket *aBucket, uint32_t tokens)
 {
     uint32_t fractionsToTake;
-    uint32_t tokensTaken = 0U;
+    uint32_t fractions;
 
     assert(aBucket != NULL);
     assert(tokens <= MAX_RATE);
 
     fractionsToTake = TO_FRACTIONS(tokens);
 
-    xSemaphoreTake(aBucket->mutex, portMAX_DELAY);
-    if (fractionsToTake <= aBucket->tokens)
+    otTokenBucketRefill(aBucket);
+
+    fractions = __atomic_load_n(&aBucket->tokens, __ATOMIC_RELAXED);
+    do
     {
-        aBucket->tokens -= fractionsToTake;
-        tokensTaken = tokens;
-    }
-    xSemaphoreGive(aBucket->mutex);
+        if (fractionsToTake > fractions)
+        {
+            return 0U;
+        }
+    } while (!__atomic_compare_exchange_n(&aBucket->tokens, &fractions, fractions - fractionsToTake, true,
+                                          __ATOMIC_RELAXED, __ATOMIC_RELAXED));
 
-    return tokensTaken;
+    return tokens;
 }
 
 bool otTokenBucketCanTake(otTokenBucket *aBucket, uint32_t tokens)
 {
-    uint32_t fractionsToTake;
-    bool     canTake = false;
-
     assert(aBucket != NULL);
     assert(tokens <= MAX_RATE);
 
-    fractionsToTake = TO_FRACTIONS(tokens);
+    otTokenBucketRefill(aBucket);
 
-    xSemaphoreTake(aBucket->mutex, portMAX_DELAY);
-    if (fractionsToTake <= aBucket->tokens)
-    {
-        canTake = true;
-    }
-    xSemaphoreGive(aBucket->mutex);
-
-    return canTake;
+    return TO_FRACTIONS(tokens) <= __atomic_load_n(&aBucket->tokens, __ATOMIC_RELAXED);
 }
 
 /* -------------------------------------------------------------------------- */
 /*                              Private functions                             */
 /* -------------------------------------------------------------------------- */
 
-static void otTokenBucketCallback(TimerHandle_t xTimer)
+/* Add the tokens earned since the last refill. There is no periodic timer, so an idle bucket costs no wakeup. */
+static void otTokenBucketRefill(otTokenBucket *aBucket)
 {
-    otTokenBucket *aBucket;
-    uint32_t       newTokens;
-
-    aBucket = (otTokenBucket *)pvTimerGetTimerID(xTimer);
-
-    xSemaphoreTake(aBucket->mutex, portMAX_DELAY);
+    uint32_t now     = (uint32_t)xTaskGetTickCount();
+    uint32_t last    = __atomic_load_n(&aBucket->lastRefill, __ATOMIC_RELAXED);
+    uint32_t elapsed = now - last;
+    uint32_t newFractions;
+    uint32_t fractions;
+    uint32_t newTokens;
+
+    if (elapsed == 0U)
+    {
+        return;
+    }
 
-    if (aBucket->tokens != aBucket->rate)
+    /* Only the caller which moves the refill time forward adds the tokens of the elapsed ticks */
+    if (!__atomic_compare_exchange_n(&aBucket->lastRefill, &last, now, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
     {
-        /* Bucket not full at the moment */
-        newTokens = aBucket->tokens += aBucket->increment;
+        return;
+    }
 
-        if (newTokens < aBucket->tokens)
-        {
-            /* Integral overflow, set the bucket to the full */
-            aBucket->tokens = aBucket->rate;
-        }
-        else if (newTokens >= aBucket->rate)
-        {
-            /* Would exceed maximum tokens, set the bucket to the full */
-            aBucket->tokens = aBucket->rate;
-        }
-        else
-        {
-            aBucket->tokens = newTokens;
-        }
+    if (elapsed >= configTICK_RATE_HZ)
+    {
+        /* A second or more, the bucket is full */
+        newFractions = aBucket->rate;
+    }
+    else
+    {
+        newFractions = (uint32_t)(((uint64_t)elapsed * aBucket->rate) / configTICK_RATE_HZ);
     }
 
-    xSemaphoreGive(aBucket->mutex);
+    fractions = __atomic_load_n(&aBucket->tokens, __ATOMIC_RELAXED);
+    do
+    {
+        /* Do not exceed maximum tokens */
+        newTokens = (newFractions >= aBucket->rate - fractions) ? aBucket->rate : fractions + newFractions;
+    } while (!__atomic_compare_exchange_n(&aBucket->tokens, &fractions, newTokens, true, __ATOMIC_RELAXED,
+                                          __ATOMIC_RELAXED));
 }
@@ -37,8 +37,7 @@
 #include <stdint.h>
 
 #include <FreeRTOS.h>
-#include <semphr.h>
-#include <timers.h>
+#include <task.h>
 
 /* -------------------------------------------------------------------------- */
 /*                                 Definitions                                */
@@ -46,14 +45,15 @@
 
 /**
  * A token bucket structure used for rate limiting.
+ *
+ * The bucket is refilled when it is accessed, from the RTOS tick count. tokens and lastRefill are accessed with
+ * atomic operations, so the bucket can be used from several tasks without a lock.
  */
 typedef struct otTokenBucket
 {
-    SemaphoreHandle_t mutex;     ///< Guards access to the tokens.
-    TimerHandle_t     timer;     ///< Timer which refills the bucket with tokens.
-    uint32_t          rate;      ///< Rate per second in thousandths. Also sets the maximum limit for tokens.
-    uint32_t          tokens;    ///< Actual number of tokens in the bucket in thousandths of tokens.
-    uint32_t          increment; ///< Number of thousands to increment the token number with when timer fires.
+    uint32_t rate;       ///< Rate per second in thousandths. Also sets the maximum limit for tokens.
+    uint32_t tokens;     ///< Actual number of tokens in the bucket in thousandths of tokens.
+    uint32_t lastRefill; ///< RTOS tick count at which tokens were last added.
 } otTokenBucket;
 
 /* -------------------------------------------------------------------------- */
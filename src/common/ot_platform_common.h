@@ -93,6 +93,39 @@ LOG_MODULE_DEFINE(LOG_MODULE_NAME, kLOG_LevelDebug);
 #define OT_PLAT_ERR(...)
 #endif
 
+/**
+ * This enumeration represents the drivers processed by otSysProcessDrivers.
+ */
+typedef enum otSysEvent
+{
+    OT_SYS_EVENT_ALARM = 0, ///< otPlatAlarmProcess.
+    OT_SYS_EVENT_RADIO,     ///< otPlatRadioProcess.
+    OT_SYS_EVENT_CLI_UART,  ///< otPlatCliUartProcess.
+    OT_SYS_EVENT_UDP,       ///< otPlatUdpProcess.
+    OT_SYS_EVENT_LWIP,      ///< otPlatLwipProcess.
+    OT_SYS_EVENT_COUNT,
+} otSysEvent;
+
+/**
+ * This structure represents the statistics of a driver processed by otSysProcessDrivers.
+ */
+typedef struct otSysEventHandlerStats
+{
+    uint32_t mRuns;        ///< Number of times the driver was processed.
+    uint32_t mTotalTimeUs; ///< Total processing time, in microseconds.
+    uint32_t mMaxTimeUs;   ///< Longest processing time, in microseconds.
+} otSysEventHandlerStats;
+
+/**
+ * This structure represents the statistics of otSysProcessDrivers.
+ */
+typedef struct otSysEventStats
+{
+    uint32_t               mProcessCalls;                ///< Number of otSysProcessDrivers calls.
+    uint32_t               mIdleCalls;                   ///< Calls without pending driver event (tasklets only).
+    otSysEventHandlerStats mHandlers[OT_SYS_EVENT_COUNT]; ///< Statistics of each driver.
+} otSysEventStats;
+
 /**
  * This structure represents different CCA mode configurations before Tx.
  */
@@ -125,6 +158,16 @@ void otPlatAlarmDeinit(void);
  */
 void otPlatAlarmProcess(otInstance *aInstance);
 
+/**
+ * This function returns the number of RTOS ticks the system can stay idle before the next alarm, at most
+ * aExpectedIdleTicks. Called by the tickless idle hook (vPortSuppressTicksAndSleep), as the alarms running on a
+ * hardware counter are not known to the RTOS.
+ *
+ * @param[in]  aExpectedIdleTicks  The idle time computed by the RTOS, in ticks.
+ *
+ */
+uint32_t otPlatAlarmGetIdleTicks(uint32_t aExpectedIdleTicks);
+
 /**
  * This function initializes the radio service used by OpenThread.
  *
@@ -169,11 +212,22 @@ void otPlatRandomDeinit(void);
  */
 void otPlatLogInit(void);
 
+/**
+ * This function returns the number of logs dropped because the log ring buffer was full
+ */
+uint32_t otPlatLogGetDroppedCount(void);
+
 /**
  * Save settings in flash while in Idle
  */
 void otPlatSaveSettingsIdle(void);
 
+/**
+ * This function displays settings storage statistics (flash writes and write amplification) on OT CLI
+ *
+ */
+otError otPlatSettingsDiag(void);
+
 /**
  * This function performs a software reset on the platform, if otPlatReset() function
  *  was previously called.
@@ -186,6 +240,12 @@ void otPlatResetIdle(void);
  */
 void otPlatUdpProcess();
 
+/**
+ * This function sends the IPv6 packets queued by the LwIP Thread interface to OpenThread.
+ *
+ */
+void otPlatLwipProcess(void);
+
 /**
  * This function allows to send spinel set prop vendor cmd with uint8_t value to be set.
  */
@@ -259,12 +319,65 @@ otError otPlatRadioCcaConfigValue(uint32_t aKey, otCCAModeConfig *aCcaConfig, ui
  */
 void otSysRunIdleTask(void);
 
+/**
+ * This function marks a driver as having work for the next otSysProcessDrivers call. It can be called from any
+ * context, the caller still has to wake up the OpenThread task (otSysEventSignalPending or otTaskletsSignalPending).
+ *
+ * @param[in]  aEvent  The driver to process.
+ *
+ */
+void otSysEventSetPending(otSysEvent aEvent);
+
+/**
+ * This function returns the statistics of otSysProcessDrivers, all zero unless built with OT_PLAT_SYS_EVENT_STATS.
+ *
+ * @param[out]  aStats  A pointer to the statistics.
+ *
+ */
+void otSysGetEventStats(otSysEventStats *aStats);
+
+/**
+ * This function enables the cycle counter read by otPlatTimestampGet.
+ *
+ */
+void otPlatTimestampInit(void);
+
+/**
+ * This function returns the current value of the cycle counter.
+ *
+ * @returns The current timestamp, in CPU cycles.
+ *
+ */
+uint32_t otPlatTimestampGet(void);
+
+/**
+ * This function converts a difference of two otPlatTimestampGet values to microseconds.
+ *
+ * @param[in]  aTimestampDelta  The difference of two timestamps, in CPU cycles.
+ *
+ * @returns The duration in microseconds.
+ *
+ */
+uint32_t otPlatTimestampToUs(uint32_t aTimestampDelta);
+
+/**
+ * This function displays the statistics of otSysProcessDrivers on OT CLI
+ *
+ */
+otError otSysEventDiag(void);
+
 /**
  * This function displays SPI diagnostic statistics on OT CLI
  *
  */
 otError otPlatRadioSpiDiag(void);
 
+/**
+ * This function displays HDLC diagnostic statistics on OT CLI
+ *
+ */
+otError otPlatRadioHdlcDiag(void);
+
 #ifdef __cplusplus
 } // end of extern "C"
 #endif
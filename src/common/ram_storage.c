@@ -54,27 +54,457 @@
 #define RAM_STORAGE_PRINTF(...)
 #endif
 
+#if RAM_STORAGE_INDEX
+/* Index entries map (key, index) to the offset of the settingsBlock in the RAM buffer.
+ * An extra (key, kIndexKeyCount) entry per key stores its number of values in the offset field.
+ * Open addressing with linear probing, deletions use backward shifting so there are no index tombstones.
+ */
+#define kIndexKeyCount 0xFFFF
+#define kIndexEmptyOffset 0xFFFF
+#define kIndexStaleLength 0xFFFF
+#define kIndexMinSize 16
+
+typedef struct
+{
+    uint16_t key;
+    uint16_t index;
+    uint16_t offset;
+} ramIndexEntry;
+
+/* size: number of entries, power of two, kept at most 3/4 full.
+ * length: RAM buffer length the index was last updated for, used to detect external changes.
+ */
+struct ramStorageIndex
+{
+    uint16_t      size;
+    uint16_t      used;
+    uint16_t      length;
+    ramIndexEntry entries[];
+};
+#endif
+
+static void markDirty(ramBufferDescriptor *pBuffer, uint16_t aOffset, uint16_t aLength)
+{
+#if PDM_SAVE_IDLE
+    uint16_t segment;
+    uint16_t lastSegment;
+
+    otEXPECT((aLength != 0) && (pBuffer->header.backendRegionSize != 0));
+
+    lastSegment = (aOffset + aLength - 1) / pBuffer->header.backendRegionSize;
+    for (segment = aOffset / pBuffer->header.backendRegionSize; segment <= lastSegment; segment++)
+    {
+        pBuffer->header.dirtySegments |= RAM_STORAGE_SEGMENT_BIT(segment);
+        if (segment >= kRamBufferMaxDirtySegments - 1)
+        {
+            break;
+        }
+    }
+
+exit:
+    return;
+#else
+    OT_UNUSED_VARIABLE(pBuffer);
+    OT_UNUSED_VARIABLE(aOffset);
+    OT_UNUSED_VARIABLE(aLength);
+#endif
+}
+
+static bool_t hasRoom(const ramBufferDescriptor *pBuffer, uint16_t aBlockLength)
+{
+    bool_t room = (pBuffer->header.length + aBlockLength <= pBuffer->header.maxLength);
+
+    if (pBuffer->header.extendedSearch == FALSE)
+    {
+        room = room && (pBuffer->header.length + aBlockLength < pBuffer->header.backendRegionSize);
+    }
+
+    return room;
+}
+
+static bool_t spansRegions(const ramBufferDescriptor *pBuffer, uint16_t aOffset, uint16_t aLength)
+{
+    uint16_t regionSize = pBuffer->header.backendRegionSize;
+
+    return (regionSize != 0) && (aOffset / regionSize != (aOffset + aLength - 1) / regionSize);
+}
+
+/* Length of a settingsBlock and its value, deleted or not */
+static uint16_t getBlockLength(const struct settingsBlock *aBlock)
+{
+    return sizeof(struct settingsBlock) + (aBlock->length & (uint16_t)~kRamBufferDeletedFlag);
+}
+
+static bool_t isBlockDeleted(const struct settingsBlock *aBlock)
+{
+    return (aBlock->length & kRamBufferDeletedFlag) != 0;
+}
+
+/* Whether the settingsBlock at aOffset is padding written without kRamBufferDeletedFlag by an older
+ * ramStorageEnsureBlockConsistency override: it fills its region and the next block is longer than the padding.
+ */
+static bool_t isLegacyDummyBlock(const ramBufferDescriptor  *pBuffer,
+                                 uint16_t                    aOffset,
+                                 const struct settingsBlock *aBlock)
+{
+#if RAM_STORAGE_LEGACY_DUMMY_PADDING
+    uint16_t             regionSize = pBuffer->header.backendRegionSize;
+    uint16_t             end        = aOffset + getBlockLength(aBlock);
+    struct settingsBlock nextBlock;
+
+    if ((aBlock->key != kRamBufferDummyKey) || (regionSize == 0) || (end % regionSize != 0) ||
+        (end >= pBuffer->header.length))
+    {
+        return FALSE;
+    }
+
+    memcpy(&nextBlock, &pBuffer->buffer[end], sizeof(struct settingsBlock));
+
+    return getBlockLength(&nextBlock) > getBlockLength(aBlock);
+#else
+    OT_UNUSED_VARIABLE(pBuffer);
+    OT_UNUSED_VARIABLE(aOffset);
+    OT_UNUSED_VARIABLE(aBlock);
+
+    return FALSE;
+#endif
+}
+
+#if RAM_STORAGE_INDEX
+
+static uint16_t indexSlot(const struct ramStorageIndex *pIndex, uint16_t aKey, uint16_t aIndex)
+{
+    uint32_t hash = (((uint32_t)aKey << 16) | aIndex) * 2654435761u;
+
+    return (uint16_t)(hash >> 16) & (pIndex->size - 1);
+}
+
+static ramIndexEntry *indexFind(struct ramStorageIndex *pIndex, uint16_t aKey, uint16_t aIndex)
+{
+    uint16_t mask = pIndex->size - 1;
+
+    for (uint16_t slot = indexSlot(pIndex, aKey, aIndex); pIndex->entries[slot].offset != kIndexEmptyOffset;
+         slot          = (slot + 1) & mask)
+    {
+        if (pIndex->entries[slot].key == aKey && pIndex->entries[slot].index == aIndex)
+        {
+            return &pIndex->entries[slot];
+        }
+    }
+
+    return NULL;
+}
+
+static void indexInsert(struct ramStorageIndex *pIndex, uint16_t aKey, uint16_t aIndex, uint16_t aOffset)
+{
+    uint16_t mask = pIndex->size - 1;
+    uint16_t slot = indexSlot(pIndex, aKey, aIndex);
+
+    while (pIndex->entries[slot].offset != kIndexEmptyOffset)
+    {
+        slot = (slot + 1) & mask;
+    }
+
+    pIndex->entries[slot].key    = aKey;
+    pIndex->entries[slot].index  = aIndex;
+    pIndex->entries[slot].offset = aOffset;
+    pIndex->used++;
+}
+
+static void indexRemove(struct ramStorageIndex *pIndex, ramIndexEntry *pEntry)
+{
+    uint16_t mask = pIndex->size - 1;
+    uint16_t hole = pEntry - pIndex->entries;
+    uint16_t slot = hole;
+
+    /* Move back the following entries of the probe sequence which can take the hole */
+    for (slot = (slot + 1) & mask; pIndex->entries[slot].offset != kIndexEmptyOffset; slot = (slot + 1) & mask)
+    {
+        uint16_t home = indexSlot(pIndex, pIndex->entries[slot].key, pIndex->entries[slot].index);
+
+        if (((slot - home) & mask) >= ((slot - hole) & mask))
+        {
+            pIndex->entries[hole] = pIndex->entries[slot];
+            hole                  = slot;
+        }
+    }
+
+    pIndex->entries[hole].offset = kIndexEmptyOffset;
+    pIndex->used--;
+}
+
+static uint16_t indexGetKeyCount(struct ramStorageIndex *pIndex, uint16_t aKey)
+{
+    ramIndexEntry *entry = indexFind(pIndex, aKey, kIndexKeyCount);
+
+    return (entry != NULL) ? entry->offset : 0;
+}
+
+static void indexSetKeyCount(struct ramStorageIndex *pIndex, uint16_t aKey, uint16_t aCount)
+{
+    ramIndexEntry *entry = indexFind(pIndex, aKey, kIndexKeyCount);
+
+    if (entry == NULL)
+    {
+        if (aCount != 0)
+        {
+            indexInsert(pIndex, aKey, kIndexKeyCount, aCount);
+        }
+    }
+    else if (aCount == 0)
+    {
+        indexRemove(pIndex, entry);
+    }
+    else
+    {
+        entry->offset = aCount;
+    }
+}
+
+/* Build the index from the RAM buffer content, (re)allocating it to fit the number of records */
+static struct ramStorageIndex *indexBuild(ramBufferDescriptor *pBuffer)
+{
+    struct ramStorageIndex *index   = pBuffer->header.index;
+    uint16_t                records = 0;
+    uint16_t                size    = kIndexMinSize;
+    uint16_t                i;
+    struct settingsBlock    currentBlock;
+
+    for (i = 0; i < pBuffer->header.length; i += getBlockLength(&currentBlock))
+    {
+        memcpy(&currentBlock, &pBuffer->buffer[i], sizeof(struct settingsBlock));
+        records++;
+    }
+
+    /* Up to two entries per record (value and key count), with room to add a few before growing */
+    while (size * 3 < (records + 4) * 2 * 4)
+    {
+        size <<= 1;
+    }
+
+    if (index == NULL || index->size != size)
+    {
+        otPlatFree(index);
+        index =
+            (struct ramStorageIndex *)otPlatCAlloc(1, sizeof(struct ramStorageIndex) + size * sizeof(ramIndexEntry));
+        pBuffer->header.index = index;
+        otEXPECT(index != NULL);
+        index->size = size;
+    }
+
+    index->used = 0;
+    memset(index->entries, 0xFF, index->size * sizeof(ramIndexEntry));
+
+    for (i = 0; i < pBuffer->header.length; i += getBlockLength(&currentBlock))
+    {
+        memcpy(&currentBlock, &pBuffer->buffer[i], sizeof(struct settingsBlock));
+        if (!isBlockDeleted(&currentBlock))
+        {
+            uint16_t count = indexGetKeyCount(index, currentBlock.key);
+
+            indexInsert(index, currentBlock.key, count, i);
+            indexSetKeyCount(index, currentBlock.key, count + 1);
+        }
+    }
+    index->length = pBuffer->header.length;
+
+exit:
+    return index;
+}
+
+/* Return the index of the RAM buffer, rebuilt if the buffer was changed behind its back, or NULL if there is no
+ * memory for it. In that case the records are searched linearly.
+ */
+static struct ramStorageIndex *indexGet(ramBufferDescriptor *pBuffer)
+{
+    struct ramStorageIndex *index = pBuffer->header.index;
+
+    if (index == NULL || index->length != pBuffer->header.length)
+    {
+        index = indexBuild(pBuffer);
+    }
+
+    return index;
+}
+
+static void indexInvalidate(ramBufferDescriptor *pBuffer)
+{
+    if (pBuffer->header.index != NULL)
+    {
+        pBuffer->header.index->length = kIndexStaleLength;
+    }
+}
+
+#endif /* RAM_STORAGE_INDEX */
+
+/* Return the offset of the aIndex-th settingsBlock of aKey */
+static bool_t findBlock(const ramBufferDescriptor *pBuffer, uint16_t aKey, uint16_t aIndex, uint16_t *aOffset)
+{
+    uint16_t             i            = 0;
+    uint16_t             currentIndex = 0;
+    struct settingsBlock currentBlock = {0};
+
+#if RAM_STORAGE_INDEX
+    /* The index is a cache, it is rebuilt on demand even for a const RAM buffer */
+    struct ramStorageIndex *index = indexGet((ramBufferDescriptor *)pBuffer);
+
+    if (index != NULL)
+    {
+        ramIndexEntry *entry = indexFind(index, aKey, aIndex);
+
+        if (entry != NULL)
+        {
+            *aOffset = entry->offset;
+        }
+        return (entry != NULL);
+    }
+#endif
+
+    while (i < pBuffer->header.length)
+    {
+        memcpy(&currentBlock, &pBuffer->buffer[i], sizeof(struct settingsBlock));
+
+        if ((aKey == currentBlock.key) && !isBlockDeleted(&currentBlock))
+        {
+            if (currentIndex == aIndex)
+            {
+                *aOffset = i;
+                return TRUE;
+            }
+            currentIndex++;
+        }
+
+        i += getBlockLength(&currentBlock);
+    }
+
+    return FALSE;
+}
+
+/* Flag the settingsBlock at aOffset as deleted, or drop it if it is the last one */
+static void deleteBlock(ramBufferDescriptor *pBuffer, uint16_t aOffset)
+{
+    struct settingsBlock currentBlock = {0};
+    uint16_t             blockLength;
+
+    memcpy(&currentBlock, &pBuffer->buffer[aOffset], sizeof(struct settingsBlock));
+    blockLength = getBlockLength(&currentBlock);
+
+    if (aOffset + blockLength >= pBuffer->header.length)
+    {
+        pBuffer->header.length = aOffset;
+        markDirty(pBuffer, aOffset, blockLength);
+    }
+    else
+    {
+        currentBlock.length |= kRamBufferDeletedFlag;
+        memcpy(&pBuffer->buffer[aOffset + sizeof(currentBlock.key)], &currentBlock.length,
+               sizeof(currentBlock.length));
+        markDirty(pBuffer, aOffset + sizeof(currentBlock.key), sizeof(currentBlock.length));
+    }
+}
+
 OT_TOOL_WEAK rsError ramStorageEnsureBlockConsistency(ramBufferDescriptor *pBuffer, uint16_t aValueLength)
 {
     return RS_ERROR_NONE;
 }
 
+void ramStorageMarkDirty(ramBufferDescriptor *pBuffer, uint16_t aOffset, uint16_t aLength)
+{
+    markDirty(pBuffer, aOffset, aLength);
+#if RAM_STORAGE_INDEX
+    indexInvalidate(pBuffer);
+#endif
+}
+
+uint16_t ramStorageCompact(ramBufferDescriptor *pBuffer)
+{
+    uint16_t             oldLength   = pBuffer->header.length;
+    uint16_t             readOffset  = 0;
+    uint16_t             writeOffset = 0;
+    uint16_t             firstChange = oldLength;
+    uint16_t             blockLength;
+    struct settingsBlock currentBlock = {0};
+
+    assert(pBuffer);
+    assert(pBuffer->buffer);
+
+    while (readOffset < oldLength)
+    {
+        memcpy(&currentBlock, &pBuffer->buffer[readOffset], sizeof(struct settingsBlock));
+        blockLength = getBlockLength(&currentBlock);
+
+        if (!isBlockDeleted(&currentBlock) && !isLegacyDummyBlock(pBuffer, readOffset, &currentBlock))
+        {
+            /* Let the padding be added again where needed. Blocks only move backwards so the padding never goes
+             * past a block contained in a single region. Blocks already spanning two regions are moved as is.
+             */
+            if (!spansRegions(pBuffer, readOffset, blockLength))
+            {
+                pBuffer->header.length = writeOffset;
+                if (ramStorageEnsureBlockConsistency(pBuffer, currentBlock.length) == RS_ERROR_NONE)
+                {
+                    writeOffset = pBuffer->header.length;
+                }
+                assert(writeOffset <= readOffset);
+            }
+
+            if (writeOffset != readOffset)
+            {
+                memmove(&pBuffer->buffer[writeOffset], &pBuffer->buffer[readOffset], blockLength);
+                firstChange = (firstChange < writeOffset) ? firstChange : writeOffset;
+            }
+            writeOffset += blockLength;
+        }
+        else
+        {
+            firstChange = (firstChange < writeOffset) ? firstChange : writeOffset;
+        }
+
+        readOffset += blockLength;
+    }
+
+    pBuffer->header.length = writeOffset;
+    if (firstChange < oldLength)
+    {
+        markDirty(pBuffer, firstChange, oldLength - firstChange);
+    }
+#if RAM_STORAGE_INDEX
+    indexInvalidate(pBuffer);
+#endif
+
+    RAM_STORAGE_PRINTF("reclaimed = %d", oldLength - writeOffset);
+
+    return oldLength - writeOffset;
+}
+
 rsError ramStorageAdd(ramBufferDescriptor *pBuffer, uint16_t aKey, const uint8_t *aValue, uint16_t aValueLength)
 {
     rsError              error          = RS_ERROR_NONE;
     struct settingsBlock currentBlock   = {0};
     const uint16_t       newBlockLength = sizeof(struct settingsBlock) + aValueLength;
+    uint16_t             start;
+#if RAM_STORAGE_INDEX
+    struct ramStorageIndex *index;
+    uint16_t                count;
+#endif
 
     assert(pBuffer);
     assert(pBuffer->buffer);
-    otEXPECT_ACTION(pBuffer->header.length + newBlockLength <= pBuffer->header.maxLength, error = RS_ERROR_NO_BUFS);
+    otEXPECT_ACTION(aValueLength <= kRamBufferMaxLength - sizeof(struct settingsBlock), error = RS_ERROR_NO_BUFS);
 
-    if (pBuffer->header.extendedSearch == FALSE)
+    /* Deleted records are reclaimed only when running out of space */
+    if (!hasRoom(pBuffer, newBlockLength) && (ramStorageCompact(pBuffer) == 0 || !hasRoom(pBuffer, newBlockLength)))
     {
-        otEXPECT_ACTION(pBuffer->header.length + newBlockLength < pBuffer->header.backendRegionSize,
-                        error = RS_ERROR_NO_BUFS);
+        error = RS_ERROR_NO_BUFS;
+        goto exit;
     }
 
+#if RAM_STORAGE_INDEX
+    index = indexGet(pBuffer);
+#endif
+
+    /* ramStorageEnsureBlockConsistency may pad the buffer before the new block */
+    start = pBuffer->header.length;
     error = ramStorageEnsureBlockConsistency(pBuffer, aValueLength);
     otEXPECT(error == RS_ERROR_NONE);
 
@@ -82,7 +512,33 @@ rsError ramStorageAdd(ramBufferDescriptor *pBuffer, uint16_t aKey, const uint8_t
     currentBlock.length = aValueLength;
     memcpy(&pBuffer->buffer[pBuffer->header.length], &currentBlock, sizeof(currentBlock));
     memcpy(&pBuffer->buffer[pBuffer->header.length + sizeof(currentBlock)], aValue, aValueLength);
+
+#if RAM_STORAGE_INDEX
+    if (index != NULL)
+    {
+        if ((index->used + 2) * 4 > index->size * 3)
+        {
+            /* Grow the index on next access */
+            indexInvalidate(pBuffer);
+        }
+        else
+        {
+            count = indexGetKeyCount(index, aKey);
+            indexInsert(index, aKey, count, pBuffer->header.length);
+            indexSetKeyCount(index, aKey, count + 1);
+        }
+    }
+#endif
+
     pBuffer->header.length += newBlockLength;
+    markDirty(pBuffer, start, pBuffer->header.length - start);
+
+#if RAM_STORAGE_INDEX
+    if (index != NULL && index->length != kIndexStaleLength)
+    {
+        index->length = pBuffer->header.length;
+    }
+#endif
 
     RAM_STORAGE_PRINTF("key = %d lengthWriten = %d err = %d", aKey, aValueLength, error);
 
@@ -96,47 +552,34 @@ rsError ramStorageGet(const ramBufferDescriptor *pBuffer,
                       uint8_t                   *aValue,
                       uint16_t                  *aValueLength)
 {
-    uint16_t             i            = 0;
+    uint16_t             offset       = 0;
     uint16_t             valueLength  = 0;
     uint16_t             readLength   = 0;
-    int                  currentIndex = 0;
     struct settingsBlock currentBlock = {0};
     rsError              error        = RS_ERROR_NOT_FOUND;
 
     assert(pBuffer);
     assert(pBuffer->buffer);
 
-    while (i < pBuffer->header.length)
+    if (aIndex >= 0 && findBlock(pBuffer, aKey, (uint16_t)aIndex, &offset))
     {
-        memcpy(&currentBlock, &pBuffer->buffer[i], sizeof(struct settingsBlock));
+        memcpy(&currentBlock, &pBuffer->buffer[offset], sizeof(struct settingsBlock));
+        readLength = currentBlock.length;
 
-        if (aKey == currentBlock.key)
+        // Perform read only if an input buffer was passed in
+        if (aValue != NULL && aValueLength != NULL)
         {
-            if (currentIndex == aIndex)
+            // Adjust read length if input buffer size is smaller
+            if (readLength > *aValueLength)
             {
-                readLength = currentBlock.length;
-
-                // Perform read only if an input buffer was passed in
-                if (aValue != NULL && aValueLength != NULL)
-                {
-                    // Adjust read length if input buffer size is smaller
-                    if (readLength > *aValueLength)
-                    {
-                        readLength = *aValueLength;
-                    }
-
-                    memcpy(aValue, &pBuffer->buffer[i + sizeof(struct settingsBlock)], readLength);
-                }
-
-                valueLength = currentBlock.length;
-                error       = RS_ERROR_NONE;
-                break;
+                readLength = *aValueLength;
             }
 
-            currentIndex++;
+            memcpy(aValue, &pBuffer->buffer[offset + sizeof(struct settingsBlock)], readLength);
         }
 
-        i += sizeof(struct settingsBlock) + currentBlock.length;
+        valueLength = currentBlock.length;
+        error       = RS_ERROR_NONE;
     }
 
     if (aValueLength != NULL)
@@ -151,98 +594,105 @@ rsError ramStorageGet(const ramBufferDescriptor *pBuffer,
 
 rsError ramStorageSet(ramBufferDescriptor *pBuffer, uint16_t aKey, const uint8_t *aValue, uint16_t aValueLength)
 {
-    uint16_t             i                  = 0;
-    uint16_t             currentBlockLength = 0;
-    struct settingsBlock currentBlock       = {0};
-    bool_t               alreadyExists      = FALSE;
-    rsError              error              = RS_ERROR_NONE;
+    uint16_t             offset       = 0;
+    struct settingsBlock currentBlock = {0};
 
     assert(pBuffer);
     assert(pBuffer->buffer);
 
-    while (i < pBuffer->header.length)
+    if (findBlock(pBuffer, aKey, 0, &offset))
     {
-        memcpy(&currentBlock, &pBuffer->buffer[i], sizeof(struct settingsBlock));
-        currentBlockLength = sizeof(struct settingsBlock) + currentBlock.length;
+        memcpy(&currentBlock, &pBuffer->buffer[offset], sizeof(struct settingsBlock));
 
-        if (aKey == currentBlock.key)
+        /* unlikely: the updated value has a different length */
+        if (currentBlock.length != aValueLength)
         {
-            /* unlikely: the updated value has a different length */
-            if (currentBlock.length != aValueLength)
-            {
-                ramStorageDelete(pBuffer, aKey, -1);
-                break;
-            }
-
-            memcpy(&pBuffer->buffer[i + sizeof(struct settingsBlock)], aValue, aValueLength);
-            alreadyExists = TRUE;
-            break;
+            ramStorageDelete(pBuffer, aKey, -1);
         }
         else
         {
-            i += currentBlockLength;
+            memcpy(&pBuffer->buffer[offset + sizeof(struct settingsBlock)], aValue, aValueLength);
+            markDirty(pBuffer, offset + sizeof(struct settingsBlock), aValueLength);
+            return RS_ERROR_NONE;
         }
     }
 
-    if (!alreadyExists)
-    {
-        error = ramStorageAdd(pBuffer, aKey, aValue, aValueLength);
-    }
-
-    return error;
+    return ramStorageAdd(pBuffer, aKey, aValue, aValueLength);
 }
 
 rsError ramStorageDelete(ramBufferDescriptor *pBuffer, uint16_t aKey, int aIndex)
 {
     uint16_t             i                  = 0;
-    int                  currentIndex       = 0;
-    uint16_t             nextBlockStart     = 0;
     uint16_t             currentBlockLength = 0;
     struct settingsBlock currentBlock       = {0};
     rsError              error              = RS_ERROR_NOT_FOUND;
-    bool_t               found              = FALSE;
+#if RAM_STORAGE_INDEX
+    struct ramStorageIndex *index;
+#endif
 
     assert(pBuffer);
     assert(pBuffer->buffer);
 
-    while (i < pBuffer->header.length)
+#if RAM_STORAGE_INDEX
+    index = indexGet(pBuffer);
+    if (index != NULL)
     {
-        memcpy(&currentBlock, &pBuffer->buffer[i], sizeof(struct settingsBlock));
-        currentBlockLength = sizeof(struct settingsBlock) + currentBlock.length;
+        uint16_t       count = indexGetKeyCount(index, aKey);
+        uint16_t       first = (aIndex == -1) ? 0 : (uint16_t)aIndex;
+        uint16_t       last  = (aIndex == -1) ? count : (uint16_t)aIndex + 1;
+        ramIndexEntry *entry;
 
-        if (aKey == currentBlock.key)
+        otEXPECT(aIndex >= -1 && first < count);
+
+        for (uint16_t j = first; j < last; j++)
         {
-            if ((currentIndex == aIndex) || (aIndex == -1))
-            {
-                currentIndex++;
+            entry = indexFind(index, aKey, j);
+            deleteBlock(pBuffer, entry->offset);
+            indexRemove(index, entry);
+        }
 
-                nextBlockStart = i + currentBlockLength;
+        /* The following values of the key move down by one index */
+        for (uint16_t j = last; j < count; j++)
+        {
+            uint16_t offset;
 
-                if (nextBlockStart < pBuffer->header.length)
-                {
-                    memmove(&pBuffer->buffer[i], &pBuffer->buffer[nextBlockStart],
-                            pBuffer->header.length - nextBlockStart);
-                }
+            entry  = indexFind(index, aKey, j);
+            offset = entry->offset;
+            indexRemove(index, entry);
+            indexInsert(index, aKey, j - (last - first), offset);
+        }
+
+        indexSetKeyCount(index, aKey, count - (last - first));
+        index->length = pBuffer->header.length;
+        error         = RS_ERROR_NONE;
+        goto exit;
+    }
+#endif
 
-                assert(pBuffer->header.length >= currentBlockLength);
-                pBuffer->header.length -= currentBlockLength;
-                found = TRUE;
+    for (int currentIndex = 0; i < pBuffer->header.length; i += currentBlockLength)
+    {
+        memcpy(&currentBlock, &pBuffer->buffer[i], sizeof(struct settingsBlock));
+        currentBlockLength = getBlockLength(&currentBlock);
 
+        if ((aKey == currentBlock.key) && !isBlockDeleted(&currentBlock))
+        {
+            if ((currentIndex == aIndex) || (aIndex == -1))
+            {
+                deleteBlock(pBuffer, i);
                 error = RS_ERROR_NONE;
-            }
 
-            if (found && (aIndex != -1))
-            {
-                break;
+                if (aIndex != -1)
+                {
+                    break;
+                }
             }
+            currentIndex++;
         }
-
-        if (!found)
-        {
-            i += currentBlockLength;
-        }
-        found = FALSE;
     }
+
+#if RAM_STORAGE_INDEX
+exit:
+#endif
     RAM_STORAGE_PRINTF("key = %d err = %d", aKey, error);
     return error;
 }
@@ -41,6 +41,32 @@ typedef enum
     RS_ERROR_PDM_ENC
 } rsError;
 
+/* Optional hash index of the RAM buffer records, trading heap for constant time lookups */
+#ifndef RAM_STORAGE_INDEX
+#define RAM_STORAGE_INDEX 0
+#endif
+
+/* Key of the dummy entries added at the end of a PDM region by ramStorageEnsureBlockConsistency */
+#define kRamBufferDummyKey (uint16_t)0xFFFF
+
+/* Also reclaim the dummy entries written without kRamBufferDeletedFlag by older ramStorageEnsureBlockConsistency
+ * overrides, see ramStorageCompact. Set it to 0 when kRamBufferDummyKey is a regular key of the application.
+ */
+#ifndef RAM_STORAGE_LEGACY_DUMMY_PADDING
+#define RAM_STORAGE_LEGACY_DUMMY_PADDING 1
+#endif
+
+/* A RAM buffer is at most kRamBufferMaxLength bytes long, so the top bit of a settingsBlock length is never set by
+ * ramStorageAdd, nor in the records of older images. It marks the deleted settingsBlocks, which keep their length
+ * in the other bits and are only reclaimed when the RAM buffer runs out of space.
+ * The deleted settingsBlocks are saved to the backend as they are. Older images read their length as is and cannot
+ * load such a RAM buffer, so a downgrade must be preceded by a ramStorageCompact and a save.
+ */
+#define kRamBufferMaxLength 0x8000U
+#define kRamBufferDeletedFlag (uint16_t)kRamBufferMaxLength
+
+struct ramStorageIndex;
+
 /* Header for a RAM buffer descriptor.
  * length: actual RAM buffer length (currently occupied with settingsBlock + data pairs).
  * maxLength: total allocated memory for RAM buffer (without header).
@@ -53,6 +79,9 @@ typedef enum
  *                    the buffer.
  *                    If extendedSearch is true, it is ignored.
  * mutexHandle: mutex that protects RAM buffer operations.
+ * dirtySegments: bitmap of the backendRegionSize regions modified since they were last saved.
+ *                Regions above kRamBufferMaxDirtySegments - 1 share the last bit.
+ * index: hash index of the records, allocated on first use.
  */
 typedef struct
 {
@@ -62,6 +91,10 @@ typedef struct
     uint16_t backendRegionSize;
 #if PDM_SAVE_IDLE
     osaMutexId_t mutexHandle;
+    uint32_t     dirtySegments;
+#endif
+#if RAM_STORAGE_INDEX
+    struct ramStorageIndex *index;
 #endif
 } ramBufferHeader;
 
@@ -95,8 +128,17 @@ struct settingsBlock
 #define kRamBufferReallocSize 512
 #define kRamBufferMaxAllocSize 12288
 
+#if kRamBufferMaxAllocSize > kRamBufferMaxLength
+#error "kRamBufferMaxAllocSize must not exceed kRamBufferMaxLength"
+#endif
+
 #define kRamDescSize sizeof(ramBufferDescriptor)
 
+/* number of backend regions tracked individually in ramBufferHeader.dirtySegments */
+#define kRamBufferMaxDirtySegments 32
+#define RAM_STORAGE_SEGMENT_BIT(segment) \
+    ((uint32_t)1 << (((segment) < kRamBufferMaxDirtySegments) ? (segment) : (kRamBufferMaxDirtySegments - 1)))
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -122,16 +164,35 @@ rsError ramStorageAdd(ramBufferDescriptor *pBuffer, uint16_t aKey, const uint8_t
 
 /* search RAM Buffer for aKey (with aIndex) and delete it:
  * - if aIndex is -1 then all the  occurences of aKey are deleted
+ * - the deleted settingsBlocks are flagged with kRamBufferDeletedFlag, unless they are at the end of the RAM buffer
  */
 rsError ramStorageDelete(ramBufferDescriptor *pBuffer, uint16_t aKey, int aIndex);
 
+/* removes the deleted settingsBlocks from the RAM buffer, done by ramStorageAdd when it runs out of space.
+ * With RAM_STORAGE_LEGACY_DUMMY_PADDING, a kRamBufferDummyKey entry without kRamBufferDeletedFlag is removed as well
+ * when it is padding: it ends at a backend region boundary and the next settingsBlock would not have fit in its place.
+ * Returns the number of bytes reclaimed.
+ */
+uint16_t ramStorageCompact(ramBufferDescriptor *pBuffer);
+
 /* adds a dummy entry to the end of a corresponding PDM region in RAM buffer,
  * if the key length does not fit in the current region. This allows the key
  * to be actually added in the next PDM region, avoiding having a key span
  * across two PDM regions.
+ * The dummy entry length should have kRamBufferDeletedFlag set, so that ramStorageCompact
+ * reclaims it before adding the padding again where it is still needed. Dummy entries written
+ * without it are reclaimed with RAM_STORAGE_LEGACY_DUMMY_PADDING.
  */
 rsError ramStorageEnsureBlockConsistency(ramBufferDescriptor *pBuffer, uint16_t aValueLength);
 
+/* marks the backend regions covering aLength bytes from aOffset as modified, so that they are saved
+ * on the next idle save, and drops the records index. The ramStorage functions do it already.
+ * Code that writes pBuffer->buffer directly must call it for the bytes it changed before requesting
+ * the save, otherwise the regions it changed are not saved when others are marked modified. A save
+ * requested with no region marked modified saves the whole RAM buffer.
+ */
+void ramStorageMarkDirty(ramBufferDescriptor *pBuffer, uint16_t aOffset, uint16_t aLength);
+
 #ifdef __cplusplus
 }
 #endif
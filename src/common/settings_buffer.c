@@ -0,0 +1,937 @@
+/*
+ *  Copyright (c) 2026, The OpenThread Authors.
+ *  Copyright 2026 NXP
+ *
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/***********************************************************************************************************************
+ * Included files
+ **********************************************************************************************************************/
+#include "settings_buffer.h"
+
+#include <assert.h>
+#include <string.h>
+
+#include <openthread/logging.h>
+
+/***********************************************************************************************************************
+ * Definitions
+ **********************************************************************************************************************/
+#define KEY_HASH_MASK (OT_SETTINGS_INDEX_HASH_SIZE - 1)
+#define NO_KEY_SLOT 0xFFFF
+
+#if OT_SETTINGS_INDEX_MAX_KEYS > 255
+#error "OT_SETTINGS_INDEX_MAX_KEYS must be at most 255, keyHash stores the key slots on 8 bits"
+#endif
+
+#if (OT_SETTINGS_INDEX_HASH_SIZE & KEY_HASH_MASK) != 0 || OT_SETTINGS_INDEX_HASH_SIZE <= OT_SETTINGS_INDEX_MAX_KEYS || \
+    OT_SETTINGS_INDEX_HASH_SIZE > 256
+#error "OT_SETTINGS_INDEX_HASH_SIZE must be a power of two larger than OT_SETTINGS_INDEX_MAX_KEYS, at most 256"
+#endif
+
+/***********************************************************************************************************************
+ * Private functions
+ **********************************************************************************************************************/
+static uint16_t readTlvHeader(const otSettingsBuffer_t *pBuffer, uint16_t aOffset, uint16_t *aLength)
+{
+    uint16_t key;
+
+    memcpy(&key, &pBuffer->buffer[aOffset], sizeof(key));
+    memcpy(aLength, &pBuffer->buffer[aOffset + sizeof(key)], sizeof(*aLength));
+
+    return key;
+}
+
+static uint16_t recordStart(const otSettingsBuffer_t *pBuffer, const otSettingsIndex_t *pIndex, uint16_t aRecord)
+{
+    return (aRecord < pIndex->recordCount) ? pIndex->recordOffset[aRecord] : pBuffer->recordLen;
+}
+
+static uint8_t keyHash(uint16_t aKey)
+{
+    return (uint8_t)((aKey ^ (aKey >> 8)) & KEY_HASH_MASK);
+}
+
+static void rebuildKeyHash(otSettingsIndex_t *pIndex)
+{
+    memset(pIndex->keyHash, 0, sizeof(pIndex->keyHash));
+
+    for (uint16_t slot = 0; slot < pIndex->keyCount; slot++)
+    {
+        uint8_t bucket = keyHash(pIndex->keys[slot].key);
+
+        while (pIndex->keyHash[bucket] != 0)
+        {
+            bucket = (bucket + 1) & KEY_HASH_MASK;
+        }
+        pIndex->keyHash[bucket] = (uint8_t)(slot + 1);
+    }
+}
+
+static uint16_t findKeySlot(const otSettingsIndex_t *pIndex, uint16_t aKey)
+{
+    uint8_t bucket = keyHash(aKey);
+
+    /* The table is never full (see OT_SETTINGS_INDEX_HASH_SIZE check), so an empty bucket ends the probe */
+    while (pIndex->keyHash[bucket] != 0)
+    {
+        uint16_t slot = pIndex->keyHash[bucket] - 1;
+
+        if (pIndex->keys[slot].key == aKey)
+        {
+            return slot;
+        }
+        bucket = (bucket + 1) & KEY_HASH_MASK;
+    }
+
+    return NO_KEY_SLOT;
+}
+
+static uint16_t addKeySlot(otSettingsIndex_t *pIndex, uint16_t aKey)
+{
+    uint16_t slot   = pIndex->keyCount++;
+    uint8_t  bucket = keyHash(aKey);
+
+    /* New keys are always appended at the end of the buffer, which keeps keys[] in buffer order */
+    pIndex->keys[slot].key         = aKey;
+    pIndex->keys[slot].firstRecord = pIndex->recordCount;
+    pIndex->keys[slot].recordCount = 0;
+
+    while (pIndex->keyHash[bucket] != 0)
+    {
+        bucket = (bucket + 1) & KEY_HASH_MASK;
+    }
+    pIndex->keyHash[bucket] = (uint8_t)(slot + 1);
+
+    return slot;
+}
+
+static void removeKeySlot(otSettingsIndex_t *pIndex, uint16_t aSlot)
+{
+    memmove(&pIndex->keys[aSlot], &pIndex->keys[aSlot + 1],
+            (pIndex->keyCount - aSlot - 1) * sizeof(otSettingsIndexKey_t));
+    pIndex->keyCount--;
+    rebuildKeyHash(pIndex);
+}
+
+/* Remove aCount records starting at aRecord, all belonging to the key at aSlot */
+static void removeRecords(otSettingsBuffer_t *pBuffer,
+                          otSettingsIndex_t  *pIndex,
+                          uint16_t            aSlot,
+                          uint16_t            aRecord,
+                          uint16_t            aCount)
+{
+    uint16_t start = recordStart(pBuffer, pIndex, aRecord);
+    uint16_t end   = recordStart(pBuffer, pIndex, aRecord + aCount);
+    uint16_t size  = end - start;
+
+    memmove(&pBuffer->buffer[start], &pBuffer->buffer[end], pBuffer->recordLen - end);
+    pBuffer->recordLen -= size;
+    pBuffer->recordFreeLen = OT_SETTINGS_BUFFER_SIZE - pBuffer->recordLen;
+    /* Clean remaining bytes */
+    memset(&pBuffer->buffer[pBuffer->recordLen], 0, size);
+
+    for (uint16_t i = aRecord + aCount; i < pIndex->recordCount; i++)
+    {
+        pIndex->recordOffset[i - aCount] = pIndex->recordOffset[i] - size;
+    }
+    pIndex->recordCount -= aCount;
+
+    pIndex->keys[aSlot].recordCount -= aCount;
+    for (uint16_t slot = aSlot + 1; slot < pIndex->keyCount; slot++)
+    {
+        pIndex->keys[slot].firstRecord -= aCount;
+    }
+}
+
+/* Insert a record at position aRecord, as the last record of the key at aSlot.
+ * The caller has checked there is room for it in both the buffer and the index.
+ */
+static void insertRecord(otSettingsBuffer_t *pBuffer,
+                         otSettingsIndex_t  *pIndex,
+                         uint16_t            aSlot,
+                         uint16_t            aRecord,
+                         const uint8_t      *aValue,
+                         uint16_t            aValueLength)
+{
+    uint16_t pos  = recordStart(pBuffer, pIndex, aRecord);
+    uint16_t size = OT_SETTINGS_TLV_HEADER_SIZE + aValueLength;
+    uint16_t key  = pIndex->keys[aSlot].key;
+
+    memmove(&pBuffer->buffer[pos + size], &pBuffer->buffer[pos], pBuffer->recordLen - pos);
+    memcpy(&pBuffer->buffer[pos], &key, sizeof(key));
+    memcpy(&pBuffer->buffer[pos + sizeof(key)], &aValueLength, sizeof(aValueLength));
+    if (aValueLength != 0)
+    {
+        memcpy(&pBuffer->buffer[pos + OT_SETTINGS_TLV_HEADER_SIZE], aValue, aValueLength);
+    }
+    pBuffer->recordLen += size;
+    pBuffer->recordFreeLen = OT_SETTINGS_BUFFER_SIZE - pBuffer->recordLen;
+
+    for (uint16_t i = pIndex->recordCount; i > aRecord; i--)
+    {
+        pIndex->recordOffset[i] = pIndex->recordOffset[i - 1] + size;
+    }
+    pIndex->recordOffset[aRecord] = pos;
+    pIndex->recordCount++;
+
+    pIndex->keys[aSlot].recordCount++;
+    for (uint16_t slot = aSlot + 1; slot < pIndex->keyCount; slot++)
+    {
+        pIndex->keys[slot].firstRecord++;
+    }
+}
+
+/* Called with the mutex held */
+static void storeUpdated(otSettingsStore_t *pStore, uint16_t aKey, uint16_t aUpdateLength)
+{
+    pStore->writeStats.updateBytes += aUpdateLength;
+
+    if (!settingsJournalMarkDirty(&pStore->journal, aKey))
+    {
+        pStore->compactionRequired = true;
+    }
+    pStore->saveRequired = true;
+}
+
+/***********************************************************************************************************************
+ * Public functions
+ **********************************************************************************************************************/
+
+void settingsBufferReset(otSettingsBuffer_t *pBuffer, otSettingsIndex_t *pIndex)
+{
+    memset(pBuffer, 0, sizeof(*pBuffer));
+    memset(pIndex, 0, sizeof(*pIndex));
+    pBuffer->recordFreeLen = OT_SETTINGS_BUFFER_SIZE;
+}
+
+otError settingsBufferLoad(otSettingsBuffer_t *pBuffer, otSettingsIndex_t *pIndex, uint16_t aLength)
+{
+    otError  error  = OT_ERROR_NONE;
+    uint16_t offset = 0;
+    uint16_t slot   = NO_KEY_SLOT;
+
+    assert(aLength <= OT_SETTINGS_BUFFER_SIZE);
+    memset(pIndex, 0, sizeof(*pIndex));
+
+    while (offset + OT_SETTINGS_TLV_HEADER_SIZE <= aLength)
+    {
+        uint16_t length;
+        uint16_t key = readTlvHeader(pBuffer, offset, &length);
+
+        if (offset + OT_SETTINGS_TLV_HEADER_SIZE + length > aLength)
+        {
+            break;
+        }
+
+        if (slot == NO_KEY_SLOT || pIndex->keys[slot].key != key)
+        {
+            /* A key already seen means its records are not contiguous, which this module never produces */
+            if (findKeySlot(pIndex, key) != NO_KEY_SLOT)
+            {
+                break;
+            }
+            if (pIndex->keyCount >= OT_SETTINGS_INDEX_MAX_KEYS)
+            {
+                error = OT_ERROR_NO_BUFS;
+                break;
+            }
+            slot = addKeySlot(pIndex, key);
+        }
+
+        pIndex->recordOffset[pIndex->recordCount++] = offset;
+        pIndex->keys[slot].recordCount++;
+        offset += OT_SETTINGS_TLV_HEADER_SIZE + length;
+    }
+
+    pBuffer->recordLen     = offset;
+    pBuffer->recordFreeLen = OT_SETTINGS_BUFFER_SIZE - offset;
+    memset(&pBuffer->buffer[offset], 0, OT_SETTINGS_BUFFER_SIZE - offset);
+
+    if (error == OT_ERROR_NONE && offset != aLength)
+    {
+        error = OT_ERROR_PARSE;
+    }
+
+    return error;
+}
+
+otError settingsBufferGet(const otSettingsBuffer_t *pBuffer,
+                          const otSettingsIndex_t  *pIndex,
+                          uint16_t                  aKey,
+                          int                       aIndex,
+                          uint8_t                  *aValue,
+                          uint16_t                 *aValueLength)
+{
+    otError  error = OT_ERROR_NOT_FOUND;
+    uint16_t slot  = findKeySlot(pIndex, aKey);
+    uint16_t offset;
+    uint16_t length;
+
+    if (slot != NO_KEY_SLOT && aIndex >= 0 && aIndex < pIndex->keys[slot].recordCount)
+    {
+        offset = pIndex->recordOffset[pIndex->keys[slot].firstRecord + aIndex];
+        (void)readTlvHeader(pBuffer, offset, &length);
+
+        if (aValueLength != NULL)
+        {
+            if (aValue != NULL)
+            {
+                memcpy(aValue, &pBuffer->buffer[offset + OT_SETTINGS_TLV_HEADER_SIZE],
+                       (*aValueLength < length) ? *aValueLength : length);
+            }
+            *aValueLength = length;
+        }
+        error = OT_ERROR_NONE;
+    }
+
+    return error;
+}
+
+otError settingsBufferAdd(otSettingsBuffer_t *pBuffer,
+                          otSettingsIndex_t  *pIndex,
+                          uint16_t            aKey,
+                          const uint8_t      *aValue,
+                          uint16_t            aValueLength)
+{
+    otError  error = OT_ERROR_NO_BUFS;
+    uint16_t slot  = findKeySlot(pIndex, aKey);
+
+    if (pBuffer->recordFreeLen < OT_SETTINGS_TLV_HEADER_SIZE + aValueLength ||
+        pIndex->recordCount >= OT_SETTINGS_INDEX_MAX_RECORDS)
+    {
+        goto exit;
+    }
+
+    if (slot == NO_KEY_SLOT)
+    {
+        if (pIndex->keyCount >= OT_SETTINGS_INDEX_MAX_KEYS)
+        {
+            goto exit;
+        }
+        slot = addKeySlot(pIndex, aKey);
+    }
+
+    insertRecord(pBuffer, pIndex, slot, pIndex->keys[slot].firstRecord + pIndex->keys[slot].recordCount, aValue,
+                 aValueLength);
+    error = OT_ERROR_NONE;
+
+exit:
+    return error;
+}
+
+otError settingsBufferSet(otSettingsBuffer_t *pBuffer,
+                          otSettingsIndex_t  *pIndex,
+                          uint16_t            aKey,
+                          const uint8_t      *aValue,
+                          uint16_t            aValueLength)
+{
+    otError  error       = OT_ERROR_NO_BUFS;
+    uint16_t slot        = findKeySlot(pIndex, aKey);
+    uint16_t bytesToFree = 0;
+
+    if (slot != NO_KEY_SLOT)
+    {
+        otSettingsIndexKey_t *entry = &pIndex->keys[slot];
+
+        bytesToFree = recordStart(pBuffer, pIndex, entry->firstRecord + entry->recordCount) -
+                      recordStart(pBuffer, pIndex, entry->firstRecord);
+    }
+    else if (pIndex->keyCount >= OT_SETTINGS_INDEX_MAX_KEYS || pIndex->recordCount >= OT_SETTINGS_INDEX_MAX_RECORDS)
+    {
+        goto exit;
+    }
+
+    if (pBuffer->recordFreeLen + bytesToFree < OT_SETTINGS_TLV_HEADER_SIZE + aValueLength)
+    {
+        goto exit;
+    }
+
+    if (slot == NO_KEY_SLOT)
+    {
+        slot = addKeySlot(pIndex, aKey);
+    }
+    else
+    {
+        removeRecords(pBuffer, pIndex, slot, pIndex->keys[slot].firstRecord, pIndex->keys[slot].recordCount);
+    }
+
+    insertRecord(pBuffer, pIndex, slot, pIndex->keys[slot].firstRecord, aValue, aValueLength);
+    error = OT_ERROR_NONE;
+
+exit:
+    return error;
+}
+
+otError settingsBufferDelete(otSettingsBuffer_t *pBuffer, otSettingsIndex_t *pIndex, uint16_t aKey, int aIndex)
+{
+    otError  error = OT_ERROR_NOT_FOUND;
+    uint16_t slot  = findKeySlot(pIndex, aKey);
+
+    if (slot == NO_KEY_SLOT)
+    {
+        goto exit;
+    }
+
+    if (aIndex == -1)
+    {
+        removeRecords(pBuffer, pIndex, slot, pIndex->keys[slot].firstRecord, pIndex->keys[slot].recordCount);
+    }
+    else if (aIndex >= 0 && aIndex < pIndex->keys[slot].recordCount)
+    {
+        removeRecords(pBuffer, pIndex, slot, pIndex->keys[slot].firstRecord + aIndex, 1);
+    }
+    else
+    {
+        goto exit;
+    }
+
+    if (pIndex->keys[slot].recordCount == 0)
+    {
+        removeKeySlot(pIndex, slot);
+    }
+    error = OT_ERROR_NONE;
+
+exit:
+    return error;
+}
+
+void settingsJournalClear(otSettingsJournal_t *pJournal)
+{
+    pJournal->keyCount = 0;
+}
+
+bool settingsJournalMarkDirty(otSettingsJournal_t *pJournal, uint16_t aKey)
+{
+    bool tracked = true;
+
+    for (uint16_t i = 0; i < pJournal->keyCount; i++)
+    {
+        if (pJournal->keys[i] == aKey)
+        {
+            goto exit;
+        }
+    }
+
+    if (pJournal->keyCount < OT_SETTINGS_INDEX_MAX_KEYS)
+    {
+        pJournal->keys[pJournal->keyCount++] = aKey;
+    }
+    else
+    {
+        tracked = false;
+    }
+
+exit:
+    return tracked;
+}
+
+uint16_t settingsJournalBuild(const otSettingsJournal_t *pJournal,
+                              const otSettingsBuffer_t  *pBuffer,
+                              const otSettingsIndex_t   *pIndex,
+                              uint32_t                   aBaseHash,
+                              uint16_t                   aBaseLength,
+                              uint32_t                   aBaseGeneration,
+                              uint8_t                   *aOutput,
+                              uint16_t                   aSize)
+{
+    otSettingsJournalHeader_t header;
+    uint16_t                  length = sizeof(header);
+
+    if (aSize < sizeof(header))
+    {
+        return 0;
+    }
+
+    for (uint16_t i = 0; i < pJournal->keyCount; i++)
+    {
+        uint16_t key         = pJournal->keys[i];
+        uint16_t slot        = findKeySlot(pIndex, key);
+        uint16_t start       = 0;
+        uint16_t entryLength = 0;
+
+        /* A deleted key is journaled with no records */
+        if (slot != NO_KEY_SLOT)
+        {
+            const otSettingsIndexKey_t *entry = &pIndex->keys[slot];
+
+            start       = recordStart(pBuffer, pIndex, entry->firstRecord);
+            entryLength = recordStart(pBuffer, pIndex, entry->firstRecord + entry->recordCount) - start;
+        }
+
+        if (length + OT_SETTINGS_TLV_HEADER_SIZE + entryLength > aSize)
+        {
+            return 0;
+        }
+
+        memcpy(&aOutput[length], &key, sizeof(key));
+        memcpy(&aOutput[length + sizeof(key)], &entryLength, sizeof(entryLength));
+        memcpy(&aOutput[length + OT_SETTINGS_TLV_HEADER_SIZE], &pBuffer->buffer[start], entryLength);
+        length += OT_SETTINGS_TLV_HEADER_SIZE + entryLength;
+    }
+
+    header.baseLength    = aBaseLength;
+    header.entriesLength = length - sizeof(header);
+    header.baseHash       = aBaseHash;
+    header.baseGeneration = aBaseGeneration;
+    memcpy(aOutput, &header, sizeof(header));
+
+    return length;
+}
+
+/* Check that the entries of a journal are well formed: each entry only holds complete records of its own key */
+static bool journalIsValid(const uint8_t *aEntries, uint16_t aLength)
+{
+    uint16_t offset = 0;
+
+    while (offset < aLength)
+    {
+        uint16_t key;
+        uint16_t entryLength;
+        uint16_t recordOffset;
+
+        if (offset + OT_SETTINGS_TLV_HEADER_SIZE > aLength)
+        {
+            return false;
+        }
+        memcpy(&key, &aEntries[offset], sizeof(key));
+        memcpy(&entryLength, &aEntries[offset + sizeof(key)], sizeof(entryLength));
+        offset += OT_SETTINGS_TLV_HEADER_SIZE;
+
+        if (offset + entryLength > aLength)
+        {
+            return false;
+        }
+
+        for (recordOffset = offset; recordOffset < offset + entryLength;)
+        {
+            uint16_t recordKey;
+            uint16_t recordLength;
+
+            if (recordOffset + OT_SETTINGS_TLV_HEADER_SIZE > offset + entryLength)
+            {
+                return false;
+            }
+            memcpy(&recordKey, &aEntries[recordOffset], sizeof(recordKey));
+            memcpy(&recordLength, &aEntries[recordOffset + sizeof(recordKey)], sizeof(recordLength));
+            recordOffset += OT_SETTINGS_TLV_HEADER_SIZE + recordLength;
+
+            if (recordKey != key || recordOffset > offset + entryLength)
+            {
+                return false;
+            }
+        }
+        offset += entryLength;
+    }
+
+    return true;
+}
+
+bool settingsJournalReplay(otSettingsJournal_t *pJournal,
+                           otSettingsBuffer_t  *pBuffer,
+                           otSettingsIndex_t   *pIndex,
+                           uint32_t             aBaseHash,
+                           uint16_t             aBaseLength,
+                           uint32_t             aBaseGeneration,
+                           const uint8_t       *aJournal,
+                           uint16_t             aLength)
+{
+    otSettingsJournalHeader_t header;
+    const uint8_t            *entries = aJournal + sizeof(header);
+    uint16_t                  offset  = 0;
+    bool                      applied = true;
+
+    if (aLength < sizeof(header))
+    {
+        return false;
+    }
+
+    memcpy(&header, aJournal, sizeof(header));
+    if (header.baseLength != aBaseLength || header.baseHash != aBaseHash || header.baseGeneration != aBaseGeneration ||
+        header.entriesLength != aLength - sizeof(header) || !journalIsValid(entries, header.entriesLength))
+    {
+        return false;
+    }
+
+    /* Remove all the journaled keys first, so that the buffer never holds more than the final records */
+    while (offset < header.entriesLength)
+    {
+        uint16_t key;
+        uint16_t entryLength;
+
+        memcpy(&key, &entries[offset], sizeof(key));
+        memcpy(&entryLength, &entries[offset + sizeof(key)], sizeof(entryLength));
+        offset += OT_SETTINGS_TLV_HEADER_SIZE + entryLength;
+
+        (void)settingsBufferDelete(pBuffer, pIndex, key, -1);
+
+        /* The file does not hold the journaled records, keep them in the next journal */
+        if (!settingsJournalMarkDirty(pJournal, key))
+        {
+            applied = false;
+        }
+    }
+
+    for (offset = 0; offset < header.entriesLength;)
+    {
+        uint16_t key;
+        uint16_t entryLength;
+        uint16_t end;
+
+        memcpy(&key, &entries[offset], sizeof(key));
+        memcpy(&entryLength, &entries[offset + sizeof(key)], sizeof(entryLength));
+        offset += OT_SETTINGS_TLV_HEADER_SIZE;
+        end = offset + entryLength;
+
+        while (offset < end)
+        {
+            uint16_t recordLength;
+
+            memcpy(&recordLength, &entries[offset + sizeof(key)], sizeof(recordLength));
+            if (settingsBufferAdd(pBuffer, pIndex, key, &entries[offset + OT_SETTINGS_TLV_HEADER_SIZE],
+                                  recordLength) != OT_ERROR_NONE)
+            {
+                applied = false;
+            }
+            offset += OT_SETTINGS_TLV_HEADER_SIZE + recordLength;
+        }
+    }
+
+    return applied;
+}
+
+uint32_t settingsBufferHash(const uint8_t *aData, uint16_t aLength)
+{
+    /* FNV-1a */
+    uint32_t hash = 2166136261u;
+
+    for (uint16_t i = 0; i < aLength; i++)
+    {
+        hash = (hash ^ aData[i]) * 16777619u;
+    }
+
+    return hash;
+}
+
+uint16_t settingsFileParse(const uint8_t *aFile, uint16_t aLength, uint32_t *aGeneration)
+{
+    otSettingsFileTrailer_t trailer;
+    uint16_t                recordsLength = aLength - OT_SETTINGS_FILE_TRAILER_SIZE;
+    uint32_t                offset        = 0;
+
+    *aGeneration = 0;
+
+    if (aLength < OT_SETTINGS_FILE_TRAILER_SIZE)
+    {
+        return aLength;
+    }
+
+    memcpy(&trailer, &aFile[recordsLength], sizeof(trailer));
+    if (trailer.magic != OT_SETTINGS_FILE_MAGIC)
+    {
+        return aLength;
+    }
+
+    /* The trailer must start on a record boundary */
+    while (offset + OT_SETTINGS_TLV_HEADER_SIZE <= recordsLength)
+    {
+        uint16_t length;
+
+        memcpy(&length, &aFile[offset + sizeof(uint16_t)], sizeof(length));
+        offset += OT_SETTINGS_TLV_HEADER_SIZE + length;
+    }
+    if (offset != recordsLength)
+    {
+        return aLength;
+    }
+
+    *aGeneration = trailer.generation;
+
+    return recordsLength;
+}
+
+uint16_t settingsFileAddTrailer(uint8_t *aFile, uint16_t aLength, uint32_t aGeneration)
+{
+    otSettingsFileTrailer_t trailer;
+
+    trailer.magic      = OT_SETTINGS_FILE_MAGIC;
+    trailer.generation = aGeneration;
+    memcpy(&aFile[aLength], &trailer, sizeof(trailer));
+
+    return aLength + OT_SETTINGS_FILE_TRAILER_SIZE;
+}
+
+void settingsStoreInit(otSettingsStore_t *pStore, const otSettingsFileOps_t *aFileOps)
+{
+    int     len;
+    otError error;
+
+    pStore->fileOps            = aFileOps;
+    pStore->compactionRequired = false;
+    memset(&pStore->writeStats, 0, sizeof(pStore->writeStats));
+
+    (void)OSA_MutexCreate(pStore->mutex);
+    (void)OSA_MutexLock((osa_mutex_handle_t)pStore->mutex, osaWaitForever_c);
+
+    settingsBufferReset(&pStore->buffer, &pStore->index);
+    settingsJournalClear(&pStore->journal);
+
+    /* Try to load the ot settings in RAM */
+    len = aFileOps->readFile(aFileOps->settingsFileName, pStore->buffer.buffer, sizeof(pStore->buffer.buffer));
+
+    assert(len <= (int)sizeof(pStore->buffer.buffer));
+    assert(len >= 0);
+    pStore->baseLength = settingsFileParse(pStore->buffer.buffer, (uint16_t)len, &pStore->baseGeneration);
+
+    if (pStore->baseLength > OT_SETTINGS_BUFFER_SIZE)
+    {
+        /* Only a corrupted file without trailer can be that long, keep what fits */
+        pStore->baseLength         = OT_SETTINGS_BUFFER_SIZE;
+        pStore->compactionRequired = true;
+    }
+    pStore->baseHash = settingsBufferHash(pStore->buffer.buffer, pStore->baseLength);
+
+    error = settingsBufferLoad(&pStore->buffer, &pStore->index, pStore->baseLength);
+    if (error == OT_ERROR_NO_BUFS)
+    {
+        /* The file is left as is until the settings are rewritten, a build tracking more keys can still load it */
+        otLogCritPlat("ot settings file has more than %d keys, the last ones are dropped, "
+                      "increase OT_SETTINGS_INDEX_MAX_KEYS",
+                      OT_SETTINGS_INDEX_MAX_KEYS);
+    }
+    else if (error != OT_ERROR_NONE)
+    {
+        otLogDebgPlat("ot settings file inconsistent, truncated to %d", pStore->buffer.recordLen);
+        pStore->compactionRequired = true;
+    }
+
+    /* Apply the updates saved after the settings file was written */
+    len = aFileOps->readFile(aFileOps->journalFileName, pStore->journalIdle, sizeof(pStore->journalIdle));
+    if (len > 0 && !settingsJournalReplay(&pStore->journal, &pStore->buffer, &pStore->index, pStore->baseHash,
+                                          pStore->baseLength, pStore->baseGeneration, pStore->journalIdle,
+                                          (uint16_t)len))
+    {
+        otLogDebgPlat("ot settings journal discarded");
+        pStore->compactionRequired = true;
+    }
+    pStore->journalOnFlash = (len > 0);
+
+    /* Get rid of a discarded journal or of an inconsistent settings file */
+    pStore->saveRequired = pStore->compactionRequired;
+
+    (void)OSA_MutexUnlock((osa_mutex_handle_t)pStore->mutex);
+
+    otLogDebgPlat("ot read %d", pStore->buffer.recordLen);
+}
+
+otError settingsStoreGet(otSettingsStore_t *pStore, uint16_t aKey, int aIndex, uint8_t *aValue, uint16_t *aValueLength)
+{
+    otError error;
+
+    (void)OSA_MutexLock((osa_mutex_handle_t)pStore->mutex, osaWaitForever_c);
+    error = settingsBufferGet(&pStore->buffer, &pStore->index, aKey, aIndex, aValue, aValueLength);
+    (void)OSA_MutexUnlock((osa_mutex_handle_t)pStore->mutex);
+
+    return error;
+}
+
+otError settingsStoreAdd(otSettingsStore_t *pStore, uint16_t aKey, const uint8_t *aValue, uint16_t aValueLength)
+{
+    otError error;
+
+    (void)OSA_MutexLock((osa_mutex_handle_t)pStore->mutex, osaWaitForever_c);
+
+    error = settingsBufferAdd(&pStore->buffer, &pStore->index, aKey, aValue, aValueLength);
+    if (error == OT_ERROR_NONE)
+    {
+        storeUpdated(pStore, aKey, OT_SETTINGS_TLV_HEADER_SIZE + aValueLength);
+    }
+
+    (void)OSA_MutexUnlock((osa_mutex_handle_t)pStore->mutex);
+
+    return error;
+}
+
+otError settingsStoreSet(otSettingsStore_t *pStore, uint16_t aKey, const uint8_t *aValue, uint16_t aValueLength)
+{
+    otError error;
+
+    (void)OSA_MutexLock((osa_mutex_handle_t)pStore->mutex, osaWaitForever_c);
+
+    error = settingsBufferSet(&pStore->buffer, &pStore->index, aKey, aValue, aValueLength);
+    if (error == OT_ERROR_NONE)
+    {
+        storeUpdated(pStore, aKey, OT_SETTINGS_TLV_HEADER_SIZE + aValueLength);
+    }
+
+    (void)OSA_MutexUnlock((osa_mutex_handle_t)pStore->mutex);
+
+    return error;
+}
+
+otError settingsStoreDelete(otSettingsStore_t *pStore, uint16_t aKey, int aIndex)
+{
+    otError error;
+
+    (void)OSA_MutexLock((osa_mutex_handle_t)pStore->mutex, osaWaitForever_c);
+
+    error = settingsBufferDelete(&pStore->buffer, &pStore->index, aKey, aIndex);
+    if (error == OT_ERROR_NONE)
+    {
+        storeUpdated(pStore, aKey, OT_SETTINGS_TLV_HEADER_SIZE);
+    }
+
+    (void)OSA_MutexUnlock((osa_mutex_handle_t)pStore->mutex);
+
+    return error;
+}
+
+void settingsStoreWipe(otSettingsStore_t *pStore)
+{
+    (void)OSA_MutexLock((osa_mutex_handle_t)pStore->mutex, osaWaitForever_c);
+
+    settingsBufferReset(&pStore->buffer, &pStore->index);
+    settingsJournalClear(&pStore->journal);
+    pStore->compactionRequired = true;
+    pStore->saveRequired       = true;
+
+    (void)OSA_MutexUnlock((osa_mutex_handle_t)pStore->mutex);
+}
+
+/* Write the pending updates in flash: the journal holds the current records of the updated keys, the full settings
+ * file is only rewritten (compaction) when the journal does not fit in OT_SETTINGS_JOURNAL_SIZE.
+ * The journal is bound to the settings file content and generation, and each compaction writes a new generation, so
+ * the settings file write itself invalidates the journal: a reset between this write and the journal deletion, or a
+ * failed deletion, never replays an outdated journal. Deleting the journal first would lose the journaled updates
+ * on a reset before the settings file is written.
+ * The flash is written without holding the mutex, so that the settings can be read and updated meanwhile.
+ */
+void settingsStoreSave(otSettingsStore_t *pStore)
+{
+    const otSettingsFileOps_t *fileOps       = pStore->fileOps;
+    uint16_t                   journalLength  = 0;
+    uint16_t                   fileLength     = 0;
+    uint32_t                   generation;
+    bool                       compaction;
+    bool                       deleteJournal  = false;
+    bool                       journalDeleted = false;
+    int                        res;
+
+    (void)OSA_MutexLock((osa_mutex_handle_t)pStore->mutex, osaWaitForever_c);
+
+    if (!pStore->saveRequired)
+    {
+        (void)OSA_MutexUnlock((osa_mutex_handle_t)pStore->mutex);
+        return;
+    }
+
+    /* Clear the flag first, so there could be an other write
+        if the buffer is updated when the write in flash has not completed fully */
+    pStore->saveRequired = false;
+
+    compaction = pStore->compactionRequired;
+    if (!compaction)
+    {
+        journalLength = settingsJournalBuild(&pStore->journal, &pStore->buffer, &pStore->index, pStore->baseHash,
+                                             pStore->baseLength, pStore->baseGeneration, pStore->journalIdle,
+                                             sizeof(pStore->journalIdle));
+        compaction    = (journalLength == 0);
+    }
+    if (compaction)
+    {
+        pStore->bufferIdle.recordLen     = pStore->buffer.recordLen;
+        pStore->bufferIdle.recordFreeLen = pStore->buffer.recordFreeLen;
+        memcpy(pStore->bufferIdle.buffer, pStore->buffer.buffer, pStore->buffer.recordLen);
+
+        settingsJournalClear(&pStore->journal);
+        pStore->compactionRequired = false;
+        deleteJournal              = pStore->journalOnFlash;
+    }
+    generation = pStore->baseGeneration + 1;
+
+    (void)OSA_MutexUnlock((osa_mutex_handle_t)pStore->mutex);
+
+    if (compaction)
+    {
+        /* Empty settings are written too, their generation must replace the one the journal is bound to */
+        fileLength = settingsFileAddTrailer(pStore->bufferIdle.buffer, pStore->bufferIdle.recordLen, generation);
+        res        = fileOps->writeFile(fileOps->settingsFileName, pStore->bufferIdle.buffer, fileLength);
+        otLogDebgPlat("ot setting written ret=%d", res);
+
+        /* The journal is outdated now, deleting it only frees its space. If that fails, the next save writes an
+         * empty journal over it.
+         */
+        journalDeleted = (res >= 0) && deleteJournal && (fileOps->deleteFile(fileOps->journalFileName) >= 0);
+    }
+    else
+    {
+        res = fileOps->writeFile(fileOps->journalFileName, pStore->journalIdle, journalLength);
+        otLogDebgPlat("ot setting journal written len=%d ret=%d", journalLength, res);
+    }
+
+    (void)OSA_MutexLock((osa_mutex_handle_t)pStore->mutex, osaWaitForever_c);
+
+    if (res < 0)
+    {
+        /* The flash content is unknown, write everything on the next attempt */
+        pStore->compactionRequired = true;
+        pStore->saveRequired       = true;
+    }
+    else if (compaction)
+    {
+        pStore->baseLength     = pStore->bufferIdle.recordLen;
+        pStore->baseHash       = settingsBufferHash(pStore->bufferIdle.buffer, pStore->bufferIdle.recordLen);
+        pStore->baseGeneration = generation;
+        if (deleteJournal && !journalDeleted)
+        {
+            pStore->saveRequired = true;
+        }
+        else
+        {
+            pStore->journalOnFlash = false;
+        }
+
+        pStore->writeStats.flashBytes += fileLength;
+        pStore->writeStats.compactions++;
+    }
+    else
+    {
+        pStore->journalOnFlash = true;
+        pStore->writeStats.flashBytes += journalLength;
+        pStore->writeStats.journalWrites++;
+    }
+
+    (void)OSA_MutexUnlock((osa_mutex_handle_t)pStore->mutex);
+}
+
+void settingsStoreGetWriteStats(otSettingsStore_t *pStore, otSettingsWriteStats_t *aStats, uint16_t *aRecordLen)
+{
+    (void)OSA_MutexLock((osa_mutex_handle_t)pStore->mutex, osaWaitForever_c);
+    *aStats     = pStore->writeStats;
+    *aRecordLen = pStore->buffer.recordLen;
+    (void)OSA_MutexUnlock((osa_mutex_handle_t)pStore->mutex);
+}
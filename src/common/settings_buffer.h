@@ -0,0 +1,304 @@
+/*
+ *  Copyright (c) 2026, The OpenThread Authors.
+ *  Copyright 2026 NXP
+ *
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SETTINGS_BUFFER_H_
+#define SETTINGS_BUFFER_H_
+
+#include <openthread/error.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "fsl_os_abstraction.h"
+
+/* Size of the RAM image of the settings file */
+#ifndef OT_SETTINGS_BUFFER_SIZE
+#define OT_SETTINGS_BUFFER_SIZE 1024
+#endif
+
+/* Maximum number of distinct keys tracked by the settings index, at most 255.
+ * OpenThread core uses less than 20 keys, the remaining entries are left for vendor keys.
+ */
+#ifndef OT_SETTINGS_INDEX_MAX_KEYS
+#define OT_SETTINGS_INDEX_MAX_KEYS 32
+#endif
+
+/* Size of the key hash table, must be a power of two larger than OT_SETTINGS_INDEX_MAX_KEYS and at most 256.
+ * The default keeps the table at most half full.
+ */
+#ifndef OT_SETTINGS_INDEX_HASH_SIZE
+#if OT_SETTINGS_INDEX_MAX_KEYS <= 8
+#define OT_SETTINGS_INDEX_HASH_SIZE 16
+#elif OT_SETTINGS_INDEX_MAX_KEYS <= 16
+#define OT_SETTINGS_INDEX_HASH_SIZE 32
+#elif OT_SETTINGS_INDEX_MAX_KEYS <= 32
+#define OT_SETTINGS_INDEX_HASH_SIZE 64
+#elif OT_SETTINGS_INDEX_MAX_KEYS <= 64
+#define OT_SETTINGS_INDEX_HASH_SIZE 128
+#else
+#define OT_SETTINGS_INDEX_HASH_SIZE 256
+#endif
+#endif
+
+/* Maximum size of the settings journal file, header included.
+ * When the journal would grow past it, the full settings file is rewritten and the journal is dropped.
+ */
+#ifndef OT_SETTINGS_JOURNAL_SIZE
+#define OT_SETTINGS_JOURNAL_SIZE 256
+#endif
+
+#define OT_SETTINGS_TLV_HEADER_SIZE (2 * sizeof(uint16_t))
+
+/* The settings file ends with an otSettingsFileTrailer_t after the records. The magic, read as a TLV header, gives a
+ * record length which is not the size of the generation, so a file written without trailer is never mistaken for one.
+ */
+#define OT_SETTINGS_FILE_MAGIC 0x5453474Fu
+#define OT_SETTINGS_FILE_TRAILER_SIZE (2 * sizeof(uint32_t))
+#define OT_SETTINGS_INDEX_MAX_RECORDS (OT_SETTINGS_BUFFER_SIZE / OT_SETTINGS_TLV_HEADER_SIZE)
+
+typedef struct
+{
+    uint16_t recordLen;
+    uint16_t recordFreeLen;
+    /* Format: <Tag1, Len1, Value1>, ... <TagN, LenN, ValueN>, with room for the file trailer */
+    uint8_t buffer[OT_SETTINGS_BUFFER_SIZE + OT_SETTINGS_FILE_TRAILER_SIZE];
+} otSettingsBuffer_t;
+
+/* All the records of a key are stored contiguously in the buffer.
+ * firstRecord: position of the first record of the key in recordOffset.
+ * recordCount: number of records (values) stored for the key.
+ */
+typedef struct
+{
+    uint16_t key;
+    uint16_t firstRecord;
+    uint16_t recordCount;
+} otSettingsIndexKey_t;
+
+/* RAM index of an otSettingsBuffer_t, it is never persisted and is rebuilt at load time.
+ * recordOffset: byte offset of each TLV in the buffer, in buffer order.
+ * keys: one entry per distinct key, in buffer order.
+ * keyHash: open addressing table giving (slot + 1) in keys for a key, 0 for an empty bucket.
+ */
+typedef struct
+{
+    uint16_t             recordOffset[OT_SETTINGS_INDEX_MAX_RECORDS];
+    otSettingsIndexKey_t keys[OT_SETTINGS_INDEX_MAX_KEYS];
+    uint8_t              keyHash[OT_SETTINGS_INDEX_HASH_SIZE];
+    uint16_t             recordCount;
+    uint16_t             keyCount;
+} otSettingsIndex_t;
+
+/* Keys modified since the settings file was last written.
+ * The journal stores the current records of each of these keys, so replaying it is idempotent.
+ */
+typedef struct
+{
+    uint16_t keys[OT_SETTINGS_INDEX_MAX_KEYS];
+    uint16_t keyCount;
+} otSettingsJournal_t;
+
+/* Journal file header, followed by entriesLength bytes of |key, length, records of key| entries.
+ * A journal only applies to the settings file it was written against (baseLength, baseHash and baseGeneration).
+ */
+typedef struct
+{
+    uint16_t baseLength;
+    uint16_t entriesLength;
+    uint32_t baseHash;
+    uint32_t baseGeneration;
+} otSettingsJournalHeader_t;
+
+/* Last bytes of the settings file. The generation is incremented each time the file is written, so a journal left
+ * from an earlier file never matches, even when both files hold the same records.
+ */
+typedef struct
+{
+    uint32_t magic;
+    uint32_t generation;
+} otSettingsFileTrailer_t;
+
+/* File system used by a settings store, the functions have the semantics of the connectivity framework FS_ and FSA_
+ * functions: a negative value is an error, readFile returns the number of bytes read and 0 for a missing file.
+ */
+typedef struct
+{
+    const char *settingsFileName;
+    const char *journalFileName;
+    int (*readFile)(const char *aName, uint8_t *aBuffer, uint32_t aLength);
+    int (*writeFile)(const char *aName, const uint8_t *aBuffer, uint32_t aLength);
+    int (*deleteFile)(const char *aName);
+} otSettingsFileOps_t;
+
+/* Bytes written to flash compared to the size of the settings updates */
+typedef struct
+{
+    uint32_t updateBytes;
+    uint32_t flashBytes;
+    uint32_t journalWrites;
+    uint32_t compactions;
+} otSettingsWriteStats_t;
+
+/* Settings kept in RAM and saved in a settings file, with the updates made since it was written in a journal file.
+ * baseLength, baseHash and baseGeneration: records of the settings file on flash, the journal is bound to them.
+ * compactionRequired: the next save rewrites the settings file instead of the journal.
+ * journalOnFlash: a journal file may exist and must be deleted after the next settings file write.
+ * saveRequired: the RAM settings differ from the flash content.
+ * bufferIdle and journalIdle: copies written to flash without holding the mutex.
+ * mutex: protects the other fields, taken by all the settingsStore functions.
+ */
+typedef struct
+{
+    const otSettingsFileOps_t *fileOps;
+    otSettingsBuffer_t         buffer;
+    otSettingsIndex_t          index;
+    otSettingsJournal_t        journal;
+    otSettingsWriteStats_t     writeStats;
+    uint16_t                   baseLength;
+    uint32_t                   baseHash;
+    uint32_t                   baseGeneration;
+    bool                       compactionRequired;
+    bool                       journalOnFlash;
+    bool                       saveRequired;
+    otSettingsBuffer_t         bufferIdle;
+    uint8_t                    journalIdle[OT_SETTINGS_JOURNAL_SIZE];
+    OSA_MUTEX_HANDLE_DEFINE(mutex);
+} otSettingsStore_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* empty the settings buffer and its index */
+void settingsBufferReset(otSettingsBuffer_t *pBuffer, otSettingsIndex_t *pIndex);
+
+/* rebuild the index after pBuffer->buffer has been loaded from flash with aLength bytes.
+ * Records that cannot be indexed are dropped, along with all the records after them. Returns:
+ * - OT_ERROR_NONE if all the records were loaded.
+ * - OT_ERROR_NO_BUFS if the records hold more than OT_SETTINGS_INDEX_MAX_KEYS keys, the file was written by a
+ *   build with a larger OT_SETTINGS_INDEX_MAX_KEYS or by the linear scan used before the index.
+ * - OT_ERROR_PARSE if a TLV is truncated or the records of a key are not contiguous.
+ */
+otError settingsBufferLoad(otSettingsBuffer_t *pBuffer, otSettingsIndex_t *pIndex, uint16_t aLength);
+
+/* read the aIndex-th value of aKey, semantics of otPlatSettingsGet() */
+otError settingsBufferGet(const otSettingsBuffer_t *pBuffer,
+                          const otSettingsIndex_t  *pIndex,
+                          uint16_t                  aKey,
+                          int                       aIndex,
+                          uint8_t                  *aValue,
+                          uint16_t                 *aValueLength);
+
+/* append a value after the existing values of aKey, semantics of otPlatSettingsAdd() */
+otError settingsBufferAdd(otSettingsBuffer_t *pBuffer,
+                          otSettingsIndex_t  *pIndex,
+                          uint16_t            aKey,
+                          const uint8_t      *aValue,
+                          uint16_t            aValueLength);
+
+/* replace all the values of aKey by a single value, semantics of otPlatSettingsSet() */
+otError settingsBufferSet(otSettingsBuffer_t *pBuffer,
+                          otSettingsIndex_t  *pIndex,
+                          uint16_t            aKey,
+                          const uint8_t      *aValue,
+                          uint16_t            aValueLength);
+
+/* delete the aIndex-th value of aKey, or all of them if aIndex is -1, semantics of otPlatSettingsDelete() */
+otError settingsBufferDelete(otSettingsBuffer_t *pBuffer, otSettingsIndex_t *pIndex, uint16_t aKey, int aIndex);
+
+/* forget all the modified keys, to be called once the full settings file has been written */
+void settingsJournalClear(otSettingsJournal_t *pJournal);
+
+/* record that aKey was modified. Returns false if the key cannot be tracked,
+ * in which case the full settings file must be written.
+ */
+bool settingsJournalMarkDirty(otSettingsJournal_t *pJournal, uint16_t aKey);
+
+/* serialize the journal in aOutput. Returns the journal length, or 0 if it does not fit in aSize */
+uint16_t settingsJournalBuild(const otSettingsJournal_t *pJournal,
+                              const otSettingsBuffer_t  *pBuffer,
+                              const otSettingsIndex_t   *pIndex,
+                              uint32_t                   aBaseHash,
+                              uint16_t                   aBaseLength,
+                              uint32_t                   aBaseGeneration,
+                              uint8_t                   *aOutput,
+                              uint16_t                   aSize);
+
+/* apply a journal read from flash on top of the loaded settings file. The keys found in the journal are marked
+ * dirty. Returns false if the journal does not belong to the settings file or is malformed (nothing is applied then),
+ * or if it could not be applied entirely. In both cases the full settings file must be rewritten.
+ */
+bool settingsJournalReplay(otSettingsJournal_t *pJournal,
+                           otSettingsBuffer_t  *pBuffer,
+                           otSettingsIndex_t   *pIndex,
+                           uint32_t             aBaseHash,
+                           uint16_t             aBaseLength,
+                           uint32_t             aBaseGeneration,
+                           const uint8_t       *aJournal,
+                           uint16_t             aLength);
+
+/* hash of a settings file content, used to bind a journal to the file it applies to */
+uint32_t settingsBufferHash(const uint8_t *aData, uint16_t aLength);
+
+/* split a settings file read from flash in aFile. Returns the length of its records and their generation, which is 0
+ * for a file written without trailer.
+ */
+uint16_t settingsFileParse(const uint8_t *aFile, uint16_t aLength, uint32_t *aGeneration);
+
+/* append the trailer after the aLength bytes of records of aFile, which must have OT_SETTINGS_FILE_TRAILER_SIZE
+ * bytes of room. Returns the length of the file to write.
+ */
+uint16_t settingsFileAddTrailer(uint8_t *aFile, uint16_t aLength, uint32_t aGeneration);
+
+/* load the settings file and apply the journal found in flash with aFileOps. The flash content is rewritten on the
+ * next save if it is inconsistent.
+ */
+void settingsStoreInit(otSettingsStore_t *pStore, const otSettingsFileOps_t *aFileOps);
+
+/* otPlatSettingsGet(), otPlatSettingsAdd(), otPlatSettingsSet(), otPlatSettingsDelete() and otPlatSettingsWipe() on
+ * the RAM settings. The updates are written to flash by settingsStoreSave().
+ */
+otError settingsStoreGet(otSettingsStore_t *pStore, uint16_t aKey, int aIndex, uint8_t *aValue, uint16_t *aValueLength);
+otError settingsStoreAdd(otSettingsStore_t *pStore, uint16_t aKey, const uint8_t *aValue, uint16_t aValueLength);
+otError settingsStoreSet(otSettingsStore_t *pStore, uint16_t aKey, const uint8_t *aValue, uint16_t aValueLength);
+otError settingsStoreDelete(otSettingsStore_t *pStore, uint16_t aKey, int aIndex);
+void    settingsStoreWipe(otSettingsStore_t *pStore);
+
+/* write the pending updates to flash, in the journal file or by rewriting the settings file */
+void settingsStoreSave(otSettingsStore_t *pStore);
+
+/* copy the write statistics and the length of the records */
+void settingsStoreGetWriteStats(otSettingsStore_t *pStore, otSettingsWriteStats_t *aStats, uint16_t *aRecordLen);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SETTINGS_BUFFER_H_ */
@@ -624,3 +624,15 @@ otError otPlatRadioSpiDiag(void)
 #endif
     return error;
 }
+
+otError otPlatRadioHdlcDiag(void)
+{
+    otError error;
+#if defined(OT_PLAT_SPINEL_OVER_HDLC) || defined(OT_PLAT_SPINEL_HCI_OVER_HDLC)
+    sSpinelInterface.DiagLogStats();
+    error = OT_ERROR_NONE;
+#else
+    error                   = OT_ERROR_INVALID_COMMAND;
+#endif
+    return error;
+}
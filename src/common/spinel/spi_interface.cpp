@@ -40,6 +40,7 @@
 #include "fsl_lpspi.h"
 #include "fsl_os_abstraction.h"
 #include "fwk_platform_ot.h"
+#include "ot_platform_common.h"
 #include <FreeRTOS.h>
 #include <timers.h>
 #include "common/logging.hpp"
@@ -55,6 +56,25 @@
 #define OT_PLATFORM_CONFIG_SPI_DEFAULT_SMALL_PACKET_SIZE \
     48 ///< Default smallest SPI packet size we can receive in a single transaction.
 
+#ifndef OT_PLATFORM_CONFIG_SPI_MAX_SMALL_PACKET_SIZE
+#define OT_PLATFORM_CONFIG_SPI_MAX_SMALL_PACKET_SIZE \
+    144 ///< Largest value the small packet size can be adapted to, enough for a full 802.15.4 frame.
+#endif
+
+#define OT_PLATFORM_CONFIG_SPI_SLAVE_READY_DELAY_US \
+    50 ///< Minimum delay between two transactions for the slave to be ready again.
+
+/* Cost in bytes of the second transaction needed by a frame larger than the small packet size, used to learn that
+ * size: the frame header and the alignment allowance are clocked again, and the slave ready delay is waited for
+ * (12 bytes at 2 MHz). A larger value makes the small packet size grow sooner, trading bytes clocked for every small
+ * frame against fewer second transactions.
+ */
+#ifndef OT_PLATFORM_CONFIG_SPI_RETRY_OVERHEAD
+#define OT_PLATFORM_CONFIG_SPI_RETRY_OVERHEAD                                   \
+    (5 + OT_PLATFORM_CONFIG_SPI_DEFAULT_ALIGN_ALLOWANCE +                       \
+     OT_PLATFORM_CONFIG_SPI_SLAVE_READY_DELAY_US * (OT_PLATFORM_CONFIG_SPI_DEFAULT_SPEED_HZ / 8) / 1000000)
+#endif
+
 #ifndef OT_PLATFORM_CONFIG_SPI_INSTANCE
 #define OT_PLATFORM_CONFIG_SPI_INSTANCE 1
 #endif
@@ -101,7 +121,14 @@ SpiInterface::SpiInterface(const Url::Url &aRadioUrl)
     , mSpiSlaveAcceptLen(0)
     , isInitialized(false)
     , pendingSpiRxDataCounter(0)
+    , mSpiLastTransferCycles(0)
+    , mSpiReadyDelayCycles(0)
+    , mSpiIntTimestamp(0)
+    , mSpiSizeSampleCount(0)
 {
+    memset(mSpiSizeHistogram, 0, sizeof(mSpiSizeHistogram));
+    memset(&mInterfaceMetrics, 0, sizeof(mInterfaceMetrics));
+    mInterfaceMetrics.mRcpInterfaceType = kSpinelInterfaceTypeSpi;
 }
 
 void SpiInterface::OnRcpReset(void)
@@ -162,6 +189,11 @@ void SpiInterface::InitSpi(void)
     status = HAL_SpiMasterInit((hal_spi_master_handle_t)otSpiMasterHandle, &spiConfig);
     assert(status == kStatus_HAL_SpiSuccess);
 
+    /* The cycle counter measures the time elapsed since the last transaction, so that the slave ready delay is only
+     * waited for when the host comes back faster than the slave */
+    LatencyHistogram::InitTimestamp();
+    mSpiReadyDelayCycles = USEC_TO_COUNT(OT_PLATFORM_CONFIG_SPI_SLAVE_READY_DELAY_US, CLOCK_GetFreq(kCLOCK_CpuClk));
+
     OT_UNUSED_VARIABLE(status);
 }
 
@@ -192,8 +224,13 @@ void SpiInterface::Deinit(void)
 
 void SpiInterface::IncreasePendingSpiRxDataCounter(void)
 {
+    if (pendingSpiRxDataCounter == 0)
+    {
+        mSpiIntTimestamp = LatencyHistogram::GetTimestamp();
+    }
     pendingSpiRxDataCounter++;
     /* Schedule a push pull */
+    otSysEventSetPending(OT_SYS_EVENT_RADIO);
     otSysEventSignalPending();
 }
 
@@ -210,6 +247,7 @@ otError SpiInterface::PushPullSpi(void)
     uint16_t         skipAlignAllowanceLength;
     bool             decreaseSpiRxDataCounter = false;
     bool             needRetry                = false;
+    bool             sizedForSlave            = false;
     uint32_t         intMask;
 
     VerifyOrExit((mReceiveFrameCallback != nullptr) && (mRxFrameBuffer != nullptr), error = OT_ERROR_INVALID_STATE);
@@ -260,6 +298,8 @@ otError SpiInterface::PushPullSpi(void)
 
     if (mSpiSlaveDataLen != 0)
     {
+        sizedForSlave = true;
+
         // In a previous transaction the slave indicated it had something to send us. Make sure our transaction
         // is large enough to handle it.
         if (mSpiSlaveDataLen > spiTransferBytes)
@@ -373,6 +413,13 @@ otError SpiInterface::PushPullSpi(void)
 
         mSpiValidFrameCount++;
 
+        if ((mSpiSlaveDataLen != 0) && !sizedForSlave)
+        {
+            // Only learn from frames announced in a transaction sized with the small packet size, a retry would
+            // account for the same frame twice.
+            UpdateSmallPacketSize(mSpiSlaveDataLen);
+        }
+
         if (rxFrame.IsResetFlagSet())
         {
             mSlaveResetCount++;
@@ -412,6 +459,13 @@ otError SpiInterface::PushPullSpi(void)
                     // Upper layer will free the frame buffer.
                     discardRxFrame = false;
 
+                    mRoundTrip.HandleFrameReceived(mRxFrameBuffer->GetFrame(), mRxFrameBuffer->GetLength(),
+                                                   mSpiLastTransferCycles);
+                    if (decreaseSpiRxDataCounter)
+                    {
+                        mRxToCallbackLatency.RecordSince(mSpiIntTimestamp);
+                    }
+
                     mReceiveFrameCallback(mReceiveFrameContext);
                 }
             }
@@ -487,10 +541,9 @@ exit:
      */
     if (error != OT_ERROR_NONE || pendingSpiRxDataCounter > 0)
     {
-        // Add delay ( about 50us) before engaging next exchange, to be sure that transceiver is ready
-        SDK_DelayAtLeastUs(50U, CLOCK_GetFreq(kCLOCK_CpuClk));
-
+        // The next exchange waits for the transceiver to be ready in DoSpiTransfer, if it's still needed by then
         otLogDebgPlat("error = %d, pendingSpiRxDataCounter=%d", error, pendingSpiRxDataCounter);
+        otSysEventSetPending(OT_SYS_EVENT_RADIO);
         otTaskletsSignalPending(NULL);
     }
 
@@ -519,6 +572,7 @@ otError SpiInterface::DoSpiTransfer(uint8_t *aSpiRxFrameBuffer, uint32_t aTransf
 {
     hal_spi_status_t   status;
     hal_spi_transfer_t spiTransfer;
+    uint32_t           transferStart;
 
     memset(&spiTransfer, 0, sizeof(hal_spi_transfer_t));
     memset(aSpiRxFrameBuffer, 0, aTransferLength);
@@ -529,7 +583,13 @@ otError SpiInterface::DoSpiTransfer(uint8_t *aSpiRxFrameBuffer, uint32_t aTransf
 
     assert(mSpiTxFrameBuffer[0] & 0x2);
 
-    status = HAL_SpiMasterTransferBlocking((hal_spi_master_handle_t)otSpiMasterHandle, &spiTransfer);
+    WaitForSlaveReady();
+
+    transferStart = LatencyHistogram::GetTimestamp();
+    status        = HAL_SpiMasterTransferBlocking((hal_spi_master_handle_t)otSpiMasterHandle, &spiTransfer);
+
+    mSpiLastTransferCycles = LatencyHistogram::GetTimestamp();
+    mTransferLatency.Record(LatencyHistogram::TimestampToUs(mSpiLastTransferCycles - transferStart));
 
     if (status == kStatus_HAL_SpiSuccess)
     {
@@ -539,6 +599,71 @@ otError SpiInterface::DoSpiTransfer(uint8_t *aSpiRxFrameBuffer, uint32_t aTransf
     return (status != kStatus_HAL_SpiSuccess) ? OT_ERROR_FAILED : OT_ERROR_NONE;
 }
 
+void SpiInterface::WaitForSlaveReady(void)
+{
+    // Only wait for what remains of the delay, which has most of the time already elapsed. The interrupt line is not
+    // sampled: right after a transaction it can still read asserted until the slave has deasserted and re-armed it.
+    // The remainder is at most the slave ready delay, far shorter than a tick, so it's spun on the cycle counter.
+    while ((LatencyHistogram::GetTimestamp() - mSpiLastTransferCycles) < mSpiReadyDelayCycles)
+    {
+    }
+}
+
+void SpiInterface::UpdateSmallPacketSize(uint16_t aSlaveDataLen)
+{
+    uint32_t cost;
+    uint32_t bestCost = UINT32_MAX;
+    uint16_t bestSize = mSpiSmallPacketSize;
+    uint16_t bucket   = (aSlaveDataLen - 1) / kSpiSizeBucketWidth;
+
+    mSpiSizeHistogram[(bucket < kSpiSizeBucketCount) ? bucket : (kSpiSizeBucketCount - 1)]++;
+    mSpiSizeSampleCount++;
+
+    if (mSpiSizeSampleCount < kSpiSizeAdaptPeriod)
+    {
+        return;
+    }
+
+    // Pick the transfer size minimizing the bytes clocked for the recorded frames: every frame pays for the small
+    // packet size, frames larger than it pay for a second transaction sized for them.
+    for (uint16_t i = 0; i < kSpiSizeBucketCount; i++)
+    {
+        uint16_t size = (i + 1) * kSpiSizeBucketWidth;
+
+        if ((size < OT_PLATFORM_CONFIG_SPI_DEFAULT_SMALL_PACKET_SIZE) ||
+            (size > OT_PLATFORM_CONFIG_SPI_MAX_SMALL_PACKET_SIZE))
+        {
+            continue;
+        }
+
+        cost = mSpiSizeSampleCount * size;
+        for (uint16_t j = i + 1; j < kSpiSizeBucketCount; j++)
+        {
+            cost += mSpiSizeHistogram[j] * ((j + 1) * kSpiSizeBucketWidth + OT_PLATFORM_CONFIG_SPI_RETRY_OVERHEAD);
+        }
+
+        if (cost < bestCost)
+        {
+            bestCost = cost;
+            bestSize = size;
+        }
+    }
+
+    if (bestSize != mSpiSmallPacketSize)
+    {
+        otLogInfoPlat("SPI small packet size %d -> %d", mSpiSmallPacketSize, bestSize);
+        mSpiSmallPacketSize = bestSize;
+    }
+
+    // Age the histogram so that the size follows changes in the traffic
+    mSpiSizeSampleCount = 0;
+    for (uint16_t i = 0; i < kSpiSizeBucketCount; i++)
+    {
+        mSpiSizeHistogram[i] /= 2;
+        mSpiSizeSampleCount += mSpiSizeHistogram[i];
+    }
+}
+
 void SpiInterface::Process(const void *aInstance)
 {
     OT_UNUSED_VARIABLE(aInstance);
@@ -579,6 +704,8 @@ otError SpiInterface::SendFrame(const uint8_t *aFrame, uint16_t aLength)
     mSpiTxIsReady     = true;
     mSpiTxPayloadSize = aLength;
 
+    mRoundTrip.HandleFrameSent(aFrame, aLength);
+
     IgnoreError(PushPullSpi());
 
 exit:
@@ -599,6 +726,19 @@ void SpiInterface::LogStats(void)
     otLogInfoPlat("INFO: mSpiTxFrameByteCount=%lld", mSpiTxFrameByteCount);
 }
 
+const otRcpInterfaceMetrics *SpiInterface::GetRcpInterfaceMetrics(void) const
+{
+    mInterfaceMetrics.mTransferredFrameCount        = mSpiFrameCount;
+    mInterfaceMetrics.mTransferredValidFrameCount   = mSpiValidFrameCount;
+    mInterfaceMetrics.mTransferredGarbageFrameCount = mSpiGarbageFrameCount;
+    mInterfaceMetrics.mRxFrameCount                 = mSpiRxFrameCount;
+    mInterfaceMetrics.mRxFrameByteCount             = mSpiRxFrameByteCount;
+    mInterfaceMetrics.mTxFrameCount                 = mSpiTxFrameCount;
+    mInterfaceMetrics.mTxFrameByteCount             = mSpiTxFrameByteCount;
+
+    return &mInterfaceMetrics;
+}
+
 void SpiInterface::DiagLogStats(void)
 {
     otCliOutputFormat("reset count :              %d\r\n", (int)mSlaveResetCount);
@@ -612,6 +752,10 @@ void SpiInterface::DiagLogStats(void)
     otCliOutputFormat("Tx frame count :           %d\r\n", (int)mSpiTxFrameCount);
     otCliOutputFormat("Tx frame byte count :      %d\r\n", (int)mSpiTxFrameByteCount);
     otCliOutputFormat("Rx frame larger count :    %d\r\n", (int)mSpiRxFrameLargerCount);
+    otCliOutputFormat("small packet size :        %d\r\n", (int)mSpiSmallPacketSize);
+    mRoundTrip.GetHistogram().Print("Round trip");
+    mRxToCallbackLatency.Print("Rx interrupt to callback");
+    mTransferLatency.Print("Transfer");
 }
 
 } // namespace NXP
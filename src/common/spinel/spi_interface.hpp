@@ -44,6 +44,8 @@
 #include "lib/url/url.hpp"
 #include "ncp/ncp_spi.hpp"
 
+#include "spinel_metrics.hpp"
+
 namespace ot {
 namespace NXP {
 
@@ -162,6 +164,13 @@ private:
         kSpiFrameHeaderSize   = 5,
     };
 
+    enum
+    {
+        kSpiSizeBucketWidth = 16, ///< Granularity of the learnt small packet size.
+        kSpiSizeBucketCount = 16, ///< Last bucket gathers all the frames larger than the previous ones.
+        kSpiSizeAdaptPeriod = 64, ///< Number of frames recorded before the small packet size is updated.
+    };
+
     enum
     {
         kMaxFrameSize = Spinel::SpinelInterface::kMaxFrameSize,
@@ -204,6 +213,17 @@ private:
     GPIO_HANDLE_DEFINE(otGpioSpiIntHandle);
     volatile uint16_t pendingSpiRxDataCounter;
 
+    uint32_t mSpiLastTransferCycles;
+    uint32_t mSpiReadyDelayCycles;
+    uint32_t mSpiIntTimestamp;
+
+    mutable otRcpInterfaceMetrics mInterfaceMetrics;
+    SpinelRoundTripTracker        mRoundTrip;
+    LatencyHistogram              mRxToCallbackLatency;
+    LatencyHistogram              mTransferLatency;
+    uint16_t mSpiSizeHistogram[kSpiSizeBucketCount];
+    uint16_t mSpiSizeSampleCount;
+
     void InitSpi(void);
     void DeinitSpi(void);
 
@@ -212,9 +232,11 @@ private:
     uint8_t *GetRealRxFrameStart(uint8_t *aSpiRxFrameBuffer, uint8_t aAlignAllowance, uint16_t &aSkipLength);
     otError  PushPullSpi(void);
     otError  DoSpiTransfer(uint8_t *aSpiRxFrameBuffer, uint32_t aTransferLength);
+    void     WaitForSlaveReady(void);
+    void     UpdateSmallPacketSize(uint16_t aSlaveDataLen);
 
     // Non-copyable, intentionally not implemented.
-    const otRcpInterfaceMetrics *GetRcpInterfaceMetrics(void) const { return nullptr; }
+    const otRcpInterfaceMetrics *GetRcpInterfaceMetrics(void) const;
     uint32_t                     GetBusSpeed(void) const { return 0; }
     void                         UpdateFdSet(void *aMainloopContext) { (void)aMainloopContext; }
     SpiInterface(const SpiInterface &);
@@ -31,21 +31,170 @@
 #include "spinel_hdlc.hpp"
 #include "board.h"
 #include "fwk_platform_hdlc.h"
+#include "ot_platform_common.h"
 
 #include "FreeRTOS.h"
 #include "event_groups.h"
-#include "queue.h"
 #include "semphr.h"
 
+#include <string.h>
+
+#include <openthread/cli.h>
 #include <openthread/tasklet.h>
 #include <openthread/platform/alarm-milli.h>
 #include "common/logging.hpp"
 #include "lib/utils/utils.hpp"
 
+OT_TOOL_WEAK void otPlatSpinelHdlcRxFlowControl(bool aStop)
+{
+    OT_UNUSED_VARIABLE(aStop);
+}
+
 namespace ot {
 
 namespace NXP {
 
+RxFrameRing::RxFrameRing(void)
+    : FrameWritePointer()
+    , mFrameStart(0)
+    , mHead(0)
+    , mTail(0)
+{
+    PrepareFrame();
+}
+
+void RxFrameRing::Clear(void)
+{
+    mHead.store(0, std::memory_order_relaxed);
+    mTail.store(0, std::memory_order_relaxed);
+    mWritePointer = nullptr;
+    PrepareFrame();
+}
+
+void RxFrameRing::PrepareFrame(void)
+{
+    uint16_t head  = mHead.load(std::memory_order_relaxed);
+    uint16_t tail  = mTail.load(std::memory_order_acquire);
+    uint16_t start = head;
+    uint16_t space;
+
+    /* Don't move a frame which is being decoded */
+    if ((mWritePointer != nullptr) && (GetLength() != 0))
+    {
+        return;
+    }
+
+    if (head >= tail)
+    {
+        /* One byte is always kept free so that a full ring can't be mistaken for an empty one */
+        space = kSize - head - ((tail == 0) ? 1 : 0);
+
+        /* Restart from the beginning of the ring if the end is too small for a max size frame and the beginning
+         * has more room */
+        if ((space < kHeaderSize + kMaxFrameLen) && (tail > space + 1))
+        {
+            if (kSize - head >= kHeaderSize)
+            {
+                uint16_t marker = kWrapMarker;
+                memcpy(&mBuffer[head], &marker, sizeof(marker));
+            }
+            start = 0;
+            space = tail - 1;
+        }
+    }
+    else
+    {
+        space = tail - head - 1;
+    }
+
+    mFrameStart      = start;
+    mWritePointer    = GetFrame();
+    mRemainingLength = (space > kHeaderSize) ? static_cast<uint16_t>(space - kHeaderSize) : 0;
+
+    /* The frame must never extend past the end of the ring */
+    if (mFrameStart + kHeaderSize > kSize)
+    {
+        mFrameStart      = 0;
+        mWritePointer    = GetFrame();
+        mRemainingLength = 0;
+    }
+}
+
+void RxFrameRing::SaveFrame(uint32_t aTimestamp)
+{
+    uint16_t length = GetLength();
+
+    memcpy(&mBuffer[mFrameStart], &length, sizeof(length));
+    memcpy(&mBuffer[mFrameStart + sizeof(length)], &aTimestamp, sizeof(aTimestamp));
+    /* Release ordering makes the frame content visible to the consumer before the new head */
+    mHead.store(static_cast<uint16_t>(mFrameStart + kHeaderSize + length), std::memory_order_release);
+
+    mWritePointer = nullptr;
+    PrepareFrame();
+}
+
+void RxFrameRing::DiscardFrame(void)
+{
+    mWritePointer = nullptr;
+    PrepareFrame();
+}
+
+uint16_t RxFrameRing::ReadHeader(uint16_t aOffset) const
+{
+    uint16_t header = kWrapMarker;
+
+    /* Less than a header left at the end of the ring means the next frame starts at the beginning */
+    if (kSize - aOffset >= kHeaderSize)
+    {
+        memcpy(&header, &mBuffer[aOffset], sizeof(header));
+    }
+
+    return header;
+}
+
+otError RxFrameRing::PeekFrame(const uint8_t *&aFrame, uint16_t &aLength, uint32_t &aTimestamp)
+{
+    otError  error = OT_ERROR_NOT_FOUND;
+    uint16_t head  = mHead.load(std::memory_order_acquire);
+    uint16_t tail  = mTail.load(std::memory_order_relaxed);
+
+    if (tail != head)
+    {
+        aLength = ReadHeader(tail);
+
+        if (aLength == kWrapMarker)
+        {
+            tail = 0;
+            mTail.store(tail, std::memory_order_release);
+            aLength = ReadHeader(tail);
+        }
+
+        if (tail != head)
+        {
+            memcpy(&aTimestamp, &mBuffer[tail + sizeof(uint16_t)], sizeof(aTimestamp));
+            aFrame = &mBuffer[tail + kHeaderSize];
+            error  = OT_ERROR_NONE;
+        }
+    }
+
+    return error;
+}
+
+void RxFrameRing::ReleaseFrame(void)
+{
+    uint16_t tail = mTail.load(std::memory_order_relaxed);
+
+    mTail.store(static_cast<uint16_t>(tail + kHeaderSize + ReadHeader(tail)), std::memory_order_release);
+}
+
+uint16_t RxFrameRing::GetFillLevel(void) const
+{
+    uint16_t head = mHead.load(std::memory_order_acquire);
+    uint16_t tail = mTail.load(std::memory_order_acquire);
+
+    return (head >= tail) ? (head - tail) : static_cast<uint16_t>(kSize - tail + head);
+}
+
 HdlcInterface::HdlcInterface(const Url::Url &aRadioUrl)
     : mEncoderBuffer()
     , mHdlcEncoder(mEncoderBuffer)
@@ -55,12 +204,17 @@ HdlcInterface::HdlcInterface(const Url::Url &aRadioUrl)
     , mReceiveFrameContext(nullptr)
     , mHdlcSpinelDecoder()
     , mIsInitialized(false)
-    , mSavedFrame(nullptr)
-    , mSavedFrameLen(0)
-    , mIsSpinelBufferFull(false)
+    , mIsRxFlowStopped(false)
+    , mOtTaskHandle(nullptr)
     , mRadioUrl(aRadioUrl)
+    , mTxQueuedFrames(0)
+    , mRxChunkTimestamp(0)
 {
     mHdlcRxCallbackField = HdlcRxCallback;
+    memset(&mTxStats, 0, sizeof(mTxStats));
+    memset(&mRxStats, 0, sizeof(mRxStats));
+    memset(&mInterfaceMetrics, 0, sizeof(mInterfaceMetrics));
+    mInterfaceMetrics.mRcpInterfaceType = kSpinelInterfaceTypeHdlc;
 }
 
 HdlcInterface::~HdlcInterface(void)
@@ -75,14 +229,16 @@ otError HdlcInterface::Init(ReceiveFrameCallback aCallback, void *aCallbackConte
     if (!mIsInitialized)
     {
         mWriteMutexHandle     = xSemaphoreCreateMutex();
-        mReadMutexHandle      = xSemaphoreCreateMutex();
-        mMsqQueue             = xQueueCreate(1, sizeof(uint8_t));
         mSpinelHdlcEventGroup = xEventGroupCreate();
 
-        assert((mWriteMutexHandle != NULL) && (mReadMutexHandle != NULL) && (mMsqQueue != NULL) &&
-               (mSpinelHdlcEventGroup != NULL));
+        assert((mWriteMutexHandle != NULL) && (mSpinelHdlcEventGroup != NULL));
+
+        /* The interface is initialized by the ot task, the other tasks only send HCI frames */
+        mOtTaskHandle = xTaskGetCurrentTaskHandle();
 
-        mHdlcSpinelDecoder.Init(mRxSpinelFrameBuffer, HandleHdlcFrame, this);
+        LatencyHistogram::InitTimestamp();
+        mRxFrameRing.Clear();
+        mHdlcSpinelDecoder.Init(mRxFrameRing, HandleHdlcFrame, this);
         mReceiveFrameCallback = aCallback;
         mReceiveFrameContext  = aCallbackContext;
         mReceiveFrameBuffer   = &aFrameBuffer;
@@ -125,12 +281,14 @@ void HdlcInterface::Deinit(void)
 void HdlcInterface::Process(const void *aInstance)
 {
     OT_UNUSED_VARIABLE(aInstance);
-    TryReadAndDecode(false);
+    IgnoreError(FlushPendingFrames());
+    TryReadAndDecode();
 }
 
 otError HdlcInterface::SendFrame(const uint8_t *aFrame, uint16_t aLength)
 {
-    otError error = OT_ERROR_NONE;
+    otError  error = OT_ERROR_NONE;
+    uint32_t encodeStart;
 
     /* Protect concurrent Send operation to avoid any buffer corruption */
     if (xSemaphoreTake(mWriteMutexHandle, portMAX_DELAY) != pdTRUE)
@@ -139,13 +297,35 @@ otError HdlcInterface::SendFrame(const uint8_t *aFrame, uint16_t aLength)
         goto exit;
     }
 
-    assert(mEncoderBuffer.IsEmpty());
-
-    EXPECT_NO_ERROR(error = mHdlcEncoder.BeginFrame());
-    EXPECT_NO_ERROR(error = mHdlcEncoder.Encode(aFrame, aLength));
-    EXPECT_NO_ERROR(error = mHdlcEncoder.EndFrame());
+    encodeStart = LatencyHistogram::GetTimestamp();
+    error       = EncodeFrame(aFrame, aLength);
+    if ((error == OT_ERROR_NO_BUFS) && (mTxQueuedFrames.load(std::memory_order_relaxed) > 0))
+    {
+        /* Not enough room behind the queued frames, send them and retry with an empty encoder buffer */
+        EXPECT_NO_ERROR(error = FlushTxQueue());
+        encodeStart = LatencyHistogram::GetTimestamp();
+        error       = EncodeFrame(aFrame, aLength);
+    }
+    EXPECT_NO_ERROR(error);
+    mEncodeLatency.RecordSince(encodeStart);
+    if (IsOtTask())
+    {
+        /* Only the spinel frames carry a TID, and the tracker is only updated by the ot task */
+        mRoundTrip.HandleFrameSent(aFrame, aLength);
+    }
     otLogDebgPlat("frame len to send = %d/%d", mEncoderBuffer.GetLength(), aLength);
-    EXPECT_NO_ERROR(error = Write(mEncoderBuffer.GetFrame(), mEncoderBuffer.GetLength()));
+
+    /* The HCI frames of the other tasks are sent right away instead of waiting for the ot task to run Process */
+    if (!IsOtTask() || (mTxQueuedFrames.load(std::memory_order_relaxed) >= kTxBatchMaxFrames))
+    {
+        EXPECT_NO_ERROR(error = FlushTxQueue());
+    }
+    else
+    {
+        /* Make sure the ot task runs Process soon to send the queued frames */
+        otSysEventSetPending(OT_SYS_EVENT_RADIO);
+        otTaskletsSignalPending(NULL);
+    }
 
 exit:
     if (xSemaphoreGive(mWriteMutexHandle) != pdTRUE)
@@ -160,12 +340,86 @@ exit:
     return error;
 }
 
+otError HdlcInterface::EncodeFrame(const uint8_t *aFrame, uint16_t aLength)
+{
+    otError  error       = OT_ERROR_NONE;
+    uint16_t startLength = mEncoderBuffer.GetLength();
+
+    EXPECT_NO_ERROR(error = mHdlcEncoder.BeginFrame());
+    EXPECT_NO_ERROR(error = mHdlcEncoder.Encode(aFrame, aLength));
+    EXPECT_NO_ERROR(error = mHdlcEncoder.EndFrame());
+
+    mTxQueuedFrames.fetch_add(1, std::memory_order_relaxed);
+    mInterfaceMetrics.mTxFrameCount++;
+    mInterfaceMetrics.mTxFrameByteCount += aLength;
+
+exit:
+    if (error != OT_ERROR_NONE)
+    {
+        /* Drop the partially encoded frame, the frames queued before it are kept */
+        mEncoderBuffer.UndoLastWrites(mEncoderBuffer.GetLength() - startLength);
+    }
+    return error;
+}
+
+otError HdlcInterface::FlushTxQueue(void)
+{
+    otError error        = OT_ERROR_NONE;
+    uint8_t queuedFrames = mTxQueuedFrames.load(std::memory_order_relaxed);
+
+    if (queuedFrames > 0)
+    {
+        if (queuedFrames > mTxStats.mMaxQueueDepth)
+        {
+            mTxStats.mMaxQueueDepth = queuedFrames;
+        }
+        if (queuedFrames > 1)
+        {
+            mTxStats.mCoalescedFrameCount += queuedFrames;
+        }
+        mTxStats.mTransferCount++;
+        mTxQueuedFrames.store(0, std::memory_order_relaxed);
+
+        error = Write(mEncoderBuffer.GetFrame(), mEncoderBuffer.GetLength());
+    }
+
+    return error;
+}
+
+otError HdlcInterface::FlushPendingFrames(void)
+{
+    otError error = OT_ERROR_NONE;
+
+    /* Avoid taking the mutex when nothing is queued, which is always the case without TX batching. A frame queued
+     * after this check sets the radio event again, so the ot task comes back to send it.
+     */
+    if (mTxQueuedFrames.load(std::memory_order_relaxed) > 0)
+    {
+        if (xSemaphoreTake(mWriteMutexHandle, portMAX_DELAY) != pdTRUE)
+        {
+            assert(0);
+        }
+
+        error = FlushTxQueue();
+
+        if (xSemaphoreGive(mWriteMutexHandle) != pdTRUE)
+        {
+            assert(0);
+        }
+    }
+
+    return error;
+}
+
 otError HdlcInterface::WaitForFrame(uint64_t aTimeoutUs)
 {
     otError     error        = OT_ERROR_RESPONSE_TIMEOUT;
     TickType_t  timeoutTicks = ((uint32_t)(aTimeoutUs / 1000U)) / portTICK_PERIOD_MS;
     EventBits_t eventBits;
 
+    /* The response can't come before the queued frames are sent */
+    IgnoreError(FlushPendingFrames());
+
     do
     {
         /* Wait for kSpinelHdlcFrameReadyEvent indicating a frame has been received */
@@ -180,7 +434,7 @@ otError HdlcInterface::WaitForFrame(uint64_t aTimeoutUs)
              * If TryReadAndDecode returns 0, it means the event was set for a previous frame, so we loop and wait again
              * If TryReadAndDecode returns anything else, it means there's real data to process, so we can exit from
              * WaitForFrame */
-            if (TryReadAndDecode(true) != 0)
+            if (TryReadAndDecode() != 0)
             {
                 error = OT_ERROR_NONE;
                 break;
@@ -199,51 +453,49 @@ otError HdlcInterface::WaitForFrame(uint64_t aTimeoutUs)
 
 void HdlcInterface::ProcessRxData(uint8_t *data, uint16_t len)
 {
-    uint8_t  event;
-    uint32_t remainingRxBufferSize = 0;
+    uint16_t fillLevel;
+
+    mRxChunkTimestamp = LatencyHistogram::GetTimestamp();
 
-    if (xSemaphoreTake(mReadMutexHandle, portMAX_DELAY) != pdTRUE)
+    /* Give the frame to come as much room as the consumer freed since the last frame */
+    mRxFrameRing.PrepareFrame();
+
+    // otDumpDebgPlat("Serial", data, len);
+    mHdlcSpinelDecoder.Decode(data, len);
+    mDecodeLatency.RecordSince(mRxChunkTimestamp);
+
+    fillLevel = mRxFrameRing.GetFillLevel();
+    if (fillLevel > mRxStats.mMaxFillLevel)
     {
-        assert(0);
+        mRxStats.mMaxFillLevel = fillLevel;
     }
 
-    do
-    {
-        /* Check if we have enough space to store the frame in the buffer */
-        remainingRxBufferSize = mRxSpinelFrameBuffer.GetFrameMaxLength() - mRxSpinelFrameBuffer.GetLength();
-        otLogDebgPlat("remainingRxBufferSize = %lu", remainingRxBufferSize);
+    UpdateRxFlowControl();
+}
 
-        if (remainingRxBufferSize >= len)
-        {
-            // otDumpDebgPlat("Serial", data, len);
-            mHdlcSpinelDecoder.Decode(data, len);
-            break;
-        }
-        else
-        {
-            mIsSpinelBufferFull = true;
-            otLogDebgPlat("Spinel buffer full remainingRxLen = %lu", remainingRxBufferSize);
-            /* Send a signal to the openthread task to indicate to empty the spinel buffer */
-            otTaskletsSignalPending(NULL);
-            /* Give the mutex */
-            if (xSemaphoreGive(mReadMutexHandle) != pdTRUE)
-            {
-                assert(0);
-            }
-            /* Lock the task here until the spinel buffer becomes empty */
-            xQueueReceive(mMsqQueue, &event, portMAX_DELAY);
-            /* take the mutex again */
-            if (xSemaphoreTake(mReadMutexHandle, portMAX_DELAY) != pdTRUE)
-            {
-                assert(0);
-            }
-        }
-    } while (true);
+void HdlcInterface::UpdateRxFlowControl(void)
+{
+    uint16_t fillLevel;
+
+    /* Called from both the producer and the consumer, the state change and the platform notification must not be
+     * interleaved */
+    taskENTER_CRITICAL();
+
+    fillLevel = mRxFrameRing.GetFillLevel();
 
-    if (xSemaphoreGive(mReadMutexHandle) != pdTRUE)
+    if (!mIsRxFlowStopped && (fillLevel >= kRxHighWatermark))
     {
-        assert(0);
+        mIsRxFlowStopped = true;
+        mRxStats.mHighWatermarkCount++;
+        otPlatSpinelHdlcRxFlowControl(true);
     }
+    else if (mIsRxFlowStopped && (fillLevel <= kRxLowWatermark))
+    {
+        mIsRxFlowStopped = false;
+        otPlatSpinelHdlcRxFlowControl(false);
+    }
+
+    taskEXIT_CRITICAL();
 }
 
 otError HdlcInterface::Write(const uint8_t *aFrame, uint16_t aLength)
@@ -265,76 +517,56 @@ otError HdlcInterface::Write(const uint8_t *aFrame, uint16_t aLength)
     return otResult;
 }
 
-uint32_t HdlcInterface::TryReadAndDecode(bool fullRead)
+uint32_t HdlcInterface::TryReadAndDecode(void)
 {
-    uint32_t totalBytesRead  = 0;
-    uint32_t i               = 0;
-    uint8_t  event           = 1;
-    uint8_t *oldFrame        = mSavedFrame;
-    uint16_t oldLen          = mSavedFrameLen;
-    otError  savedFrameFound = OT_ERROR_NONE;
+    uint32_t       totalBytesRead = 0;
+    const uint8_t *frame;
+    uint16_t       frameLen;
+    uint32_t       frameTimestamp;
 
-    (void)fullRead;
-
-    if (xSemaphoreTake(mReadMutexHandle, portMAX_DELAY) != pdTRUE)
+    while (mRxFrameRing.PeekFrame(frame, frameLen, frameTimestamp) == OT_ERROR_NONE)
     {
-        assert(0);
-    }
-
-    savedFrameFound = mRxSpinelFrameBuffer.GetNextSavedFrame(mSavedFrame, mSavedFrameLen);
+        mRoundTrip.HandleFrameReceived(frame, frameLen, frameTimestamp);
 
-    while (savedFrameFound == OT_ERROR_NONE)
-    {
-        /* Copy the data to the ot frame buffer */
-        for (i = 0; i < mSavedFrameLen; i++)
+        /* Hand the whole frame over to the ot frame buffer in a single block copy */
+        if (CopyFrameToReceiveBuffer(frame, frameLen) != OT_ERROR_NONE)
         {
-            if (mReceiveFrameBuffer->WriteByte(mSavedFrame[i]) != OT_ERROR_NONE)
-            {
-                mReceiveFrameBuffer->UndoLastWrites(i);
-                /* No more space restore the mSavedFrame to the previous frame */
-                mSavedFrame    = oldFrame;
-                mSavedFrameLen = oldLen;
-                /* Signal the ot task to re-try later */
-                otTaskletsSignalPending(NULL);
-                otLogDebgPlat("No more space");
-                if (xSemaphoreGive(mReadMutexHandle) != pdTRUE)
-                {
-                    assert(0);
-                }
-                return totalBytesRead;
-            }
-            totalBytesRead++;
+            /* No more space, keep the frame in the ring and signal the ot task to re-try later */
+            otSysEventSetPending(OT_SYS_EVENT_RADIO);
+            otTaskletsSignalPending(NULL);
+            otLogDebgPlat("No more space");
+            break;
         }
-        otLogDebgPlat("Frame len %d consumed", mSavedFrameLen);
+        mRxFrameRing.ReleaseFrame();
+        totalBytesRead += frameLen;
+        otLogDebgPlat("Frame len %d consumed", frameLen);
+        mRxToCallbackLatency.RecordSince(frameTimestamp);
         mReceiveFrameCallback(mReceiveFrameContext);
-        oldFrame        = mSavedFrame;
-        oldLen          = mSavedFrameLen;
-        savedFrameFound = mRxSpinelFrameBuffer.GetNextSavedFrame(mSavedFrame, mSavedFrameLen);
     }
 
-    if (savedFrameFound != OT_ERROR_NONE)
+    if (mIsRxFlowStopped)
     {
-        /* No more frame saved clear the buffer */
-        mRxSpinelFrameBuffer.ClearSavedFrames();
-        /* If the spinel queue was locked */
-        if (mIsSpinelBufferFull)
-        {
-            mIsSpinelBufferFull = false;
-            /* Send an event to unlock the task */
-            if (xQueueOverwrite(mMsqQueue, (void *)&event) != pdTRUE)
-            {
-                assert(0);
-            }
-        }
+        UpdateRxFlowControl();
     }
 
-    if (xSemaphoreGive(mReadMutexHandle) != pdTRUE)
-    {
-        assert(0);
-    }
     return totalBytesRead;
 }
 
+otError HdlcInterface::CopyFrameToReceiveBuffer(const uint8_t *aFrame, uint16_t aLength)
+{
+    otError  error         = OT_ERROR_NONE;
+    uint16_t currentLength = mReceiveFrameBuffer->GetLength();
+
+    /* Check the space left once, instead of on each byte, so nothing has to be undone on overflow */
+    EXPECT(mReceiveFrameBuffer->GetFrameMaxLength() - currentLength >= aLength, error = OT_ERROR_NO_BUFS);
+
+    memcpy(mReceiveFrameBuffer->GetFrame() + currentLength, aFrame, aLength);
+    error = mReceiveFrameBuffer->SetLength(currentLength + aLength);
+
+exit:
+    return error;
+}
+
 void HdlcInterface::HandleHdlcFrame(void *aContext, otError aError)
 {
     static_cast<HdlcInterface *>(aContext)->HandleHdlcFrame(aError);
@@ -342,8 +574,8 @@ void HdlcInterface::HandleHdlcFrame(void *aContext, otError aError)
 
 void HdlcInterface::HandleHdlcFrame(otError aError)
 {
-    uint8_t *buf       = mRxSpinelFrameBuffer.GetFrame();
-    uint16_t bufLength = mRxSpinelFrameBuffer.GetLength();
+    uint8_t *buf       = mRxFrameRing.GetFrame();
+    uint16_t bufLength = mRxFrameRing.GetLength();
 
     otDumpDebgPlat("RX FRAME", buf, bufLength);
 
@@ -352,9 +584,13 @@ void HdlcInterface::HandleHdlcFrame(otError aError)
         if ((buf[0] & SPINEL_HEADER_FLAG) == SPINEL_HEADER_FLAG)
         {
             otLogDebgPlat("Frame correctly received %d", bufLength);
+            mInterfaceMetrics.mTransferredValidFrameCount++;
+            mInterfaceMetrics.mRxFrameCount++;
+            mInterfaceMetrics.mRxFrameByteCount += bufLength;
             /* Save the frame */
-            mRxSpinelFrameBuffer.SaveFrame();
+            mRxFrameRing.SaveFrame(mRxChunkTimestamp);
             /* Send a signal to the openthread task to indicate that a spinel data is pending */
+            otSysEventSetPending(OT_SYS_EVENT_RADIO);
             otTaskletsSignalPending(NULL);
             /* Notify WaitForFrame that a frame is ready */
             (void)xEventGroupSetBits(mSpinelHdlcEventGroup, HdlcInterface::kSpinelHdlcFrameReadyEvent);
@@ -367,13 +603,19 @@ void HdlcInterface::HandleHdlcFrame(otError aError)
              * override this method */
             HandleUnknownHdlcContent(buf, bufLength);
             /* Not a Spinel frame, discard */
-            mRxSpinelFrameBuffer.DiscardFrame();
+            mRxFrameRing.DiscardFrame();
         }
     }
     else
     {
+        mInterfaceMetrics.mTransferredGarbageFrameCount++;
+        if (aError == OT_ERROR_NO_BUFS)
+        {
+            /* The ring is full, the ot task didn't consume the frames fast enough */
+            mRxStats.mOverrunCount++;
+        }
         otLogCritPlat("Frame will be discarded error = 0x%x", aError);
-        mRxSpinelFrameBuffer.DiscardFrame();
+        mRxFrameRing.DiscardFrame();
     }
 }
 
@@ -390,6 +632,35 @@ void HdlcInterface::HandleUnknownHdlcContent(uint8_t *buffer, uint16_t len)
     assert(0);
 }
 
+const otRcpInterfaceMetrics *HdlcInterface::GetRcpInterfaceMetrics(void) const
+{
+    /* Computed here as the RX and TX counters are updated from different tasks */
+    mInterfaceMetrics.mTransferredFrameCount = mInterfaceMetrics.mTransferredValidFrameCount +
+                                               mInterfaceMetrics.mTransferredGarbageFrameCount +
+                                               mInterfaceMetrics.mTxFrameCount;
+    return &mInterfaceMetrics;
+}
+
+void HdlcInterface::DiagLogStats(void)
+{
+    otCliOutputFormat("Tx frame count :           %lu\r\n", (uint32_t)mInterfaceMetrics.mTxFrameCount);
+    otCliOutputFormat("Tx frame byte count :      %lu\r\n", (uint32_t)mInterfaceMetrics.mTxFrameByteCount);
+    otCliOutputFormat("Tx transfer count :        %lu\r\n", mTxStats.mTransferCount);
+    otCliOutputFormat("Tx coalesced frame count : %lu\r\n", mTxStats.mCoalescedFrameCount);
+    otCliOutputFormat("Tx max queue depth :       %u\r\n", mTxStats.mMaxQueueDepth);
+    otCliOutputFormat("Rx frame count :           %lu\r\n", (uint32_t)mInterfaceMetrics.mRxFrameCount);
+    otCliOutputFormat("Rx frame byte count :      %lu\r\n", (uint32_t)mInterfaceMetrics.mRxFrameByteCount);
+    otCliOutputFormat("Rx garbage frame count :   %lu\r\n",
+                      (uint32_t)mInterfaceMetrics.mTransferredGarbageFrameCount);
+    otCliOutputFormat("Rx overrun count :         %lu\r\n", mRxStats.mOverrunCount);
+    otCliOutputFormat("Rx high watermark count :  %lu\r\n", mRxStats.mHighWatermarkCount);
+    otCliOutputFormat("Rx max fill level :        %u/%u\r\n", mRxStats.mMaxFillLevel, RxFrameRing::GetSize());
+    mRoundTrip.GetHistogram().Print("Round trip");
+    mRxToCallbackLatency.Print("Rx to callback");
+    mEncodeLatency.Print("Encode");
+    mDecodeLatency.Print("Decode");
+}
+
 void HdlcInterface::OnRcpReset(void)
 {
     mHdlcSpinelDecoder.Reset();
@@ -36,20 +36,192 @@
 #include "ot_platform_common.h"
 
 #include "FreeRTOS.h"
-#include "queue.h"
 #include "semphr.h"
+#include "task.h"
+
+#include <atomic>
 
 #include "lib/hdlc/hdlc.hpp"
 #include "lib/spinel/spinel.h"
 #include "lib/spinel/spinel_interface.hpp"
 #include "lib/url/url.hpp"
 
+#include "spinel_metrics.hpp"
+
+/**
+ * Maximum number of spinel frames coalesced into a single HDLC transfer.
+ *
+ * When greater than 1, `SendFrame` only encodes the frame and the pending frames are sent together from `Process`
+ * or `WaitForFrame`, or as soon as the limit is reached or the encoder buffer is full.
+ * The default value of 1 sends every frame immediately.
+ */
+#ifndef OT_PLAT_SPINEL_HDLC_TX_BATCH_MAX_FRAMES
+#define OT_PLAT_SPINEL_HDLC_TX_BATCH_MAX_FRAMES 1
+#endif
+
+/**
+ * Size of the HDLC encoder buffer, must be able to hold at least one fully escaped spinel frame.
+ */
+#ifndef OT_PLAT_SPINEL_HDLC_TX_BUFFER_SIZE
+#define OT_PLAT_SPINEL_HDLC_TX_BUFFER_SIZE (SPINEL_FRAME_MAX_SIZE * 2)
+#endif
+
+/**
+ * Size of the ring holding the decoded spinel frames until the OT task consumes them.
+ *
+ * Frames are stored contiguously, so the ring should be at least twice as large as the biggest expected frame.
+ */
+#ifndef OT_PLAT_SPINEL_HDLC_RX_RING_SIZE
+#define OT_PLAT_SPINEL_HDLC_RX_RING_SIZE 4096
+#endif
+
+/**
+ * Fill level (in percent of the RX ring) above which RX flow control is asserted.
+ */
+#ifndef OT_PLAT_SPINEL_HDLC_RX_HIGH_WATERMARK
+#define OT_PLAT_SPINEL_HDLC_RX_HIGH_WATERMARK 75
+#endif
+
+/**
+ * Fill level (in percent of the RX ring) below which RX flow control is released.
+ */
+#ifndef OT_PLAT_SPINEL_HDLC_RX_LOW_WATERMARK
+#define OT_PLAT_SPINEL_HDLC_RX_LOW_WATERMARK 25
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * This function is called when the HDLC RX ring crosses one of its watermarks.
+ *
+ * The default implementation does nothing. A platform can override it to drive the UART RTS line or any other
+ * signalling asking the RCP to pause its transmissions. Without it, the HDLC RX callback never blocks: the frames which
+ * don't fit in the full ring are dropped and counted as overruns, shown by the `debug_nxp hdlc` CLI command.
+ *
+ * @param[in] aStop  true when the RCP should stop sending, false when it can resume.
+ *
+ */
+void otPlatSpinelHdlcRxFlowControl(bool aStop);
+
+#ifdef __cplusplus
+} // end of extern "C"
+#endif
+
 namespace ot {
 
 namespace NXP {
 
 typedef uint8_t HdlcSpinelContext;
 
+/**
+ * This class implements a lock-free single producer, single consumer ring of decoded spinel frames.
+ *
+ * The HDLC decoder (producer) writes each frame in place through the `FrameWritePointer` interface and publishes it
+ * once complete. The OT task (consumer) then reads the published frames without taking any lock.
+ * Each frame is stored contiguously, preceded by its length and its reception timestamp.
+ *
+ */
+class RxFrameRing : public ot::Spinel::FrameWritePointer
+{
+public:
+    /**
+     * This constructor initializes the object.
+     *
+     */
+    RxFrameRing(void);
+
+    /**
+     * This method empties the ring, it must not be called concurrently with the producer or the consumer.
+     *
+     */
+    void Clear(void);
+
+    /**
+     * This method places the frame being written where the most contiguous space is available.
+     *
+     * It has no effect while a frame is partially written. Producer side.
+     *
+     */
+    void PrepareFrame(void);
+
+    /**
+     * This method returns a pointer to the frame being written. Producer side.
+     *
+     */
+    uint8_t *GetFrame(void) const { return &mBuffer[mFrameStart + kHeaderSize]; }
+
+    /**
+     * This method returns the length of the frame being written. Producer side.
+     *
+     */
+    uint16_t GetLength(void) const { return static_cast<uint16_t>(mWritePointer - GetFrame()); }
+
+    /**
+     * This method publishes the frame being written to the consumer. Producer side.
+     *
+     * @param[in] aTimestamp  The timestamp at which the frame was received.
+     *
+     */
+    void SaveFrame(uint32_t aTimestamp);
+
+    /**
+     * This method drops the frame being written. Producer side.
+     *
+     */
+    void DiscardFrame(void);
+
+    /**
+     * This method gets the oldest published frame without removing it. Consumer side.
+     *
+     * @param[out] aFrame      A pointer to the frame.
+     * @param[out] aLength     The length of the frame.
+     * @param[out] aTimestamp  The timestamp at which the frame was received.
+     *
+     * @retval OT_ERROR_NONE       A frame is available.
+     * @retval OT_ERROR_NOT_FOUND  The ring is empty.
+     *
+     */
+    otError PeekFrame(const uint8_t *&aFrame, uint16_t &aLength, uint32_t &aTimestamp);
+
+    /**
+     * This method removes the frame returned by the last `PeekFrame` call. Consumer side.
+     *
+     */
+    void ReleaseFrame(void);
+
+    /**
+     * This method returns the number of bytes used by published frames. Can be called from both sides.
+     *
+     */
+    uint16_t GetFillLevel(void) const;
+
+    /**
+     * This method returns the size of the ring in bytes.
+     *
+     */
+    static constexpr uint16_t GetSize(void) { return kSize; }
+
+private:
+    enum
+    {
+        kSize        = OT_PLAT_SPINEL_HDLC_RX_RING_SIZE,
+        kHeaderSize  = sizeof(uint16_t) + sizeof(uint32_t),
+        kWrapMarker  = 0xFFFF,
+        kMaxFrameLen = SPINEL_FRAME_MAX_SIZE,
+    };
+
+    static_assert(kSize < kWrapMarker, "OT_PLAT_SPINEL_HDLC_RX_RING_SIZE is too large");
+
+    uint16_t ReadHeader(uint16_t aOffset) const;
+
+    mutable uint8_t       mBuffer[kSize];
+    uint16_t              mFrameStart; // Offset of the frame being written, owned by the producer
+    std::atomic<uint16_t> mHead;       // End of the last published frame, written by the producer
+    std::atomic<uint16_t> mTail;       // Start of the oldest published frame, written by the consumer
+};
+
 /**
  * This class defines an HDLC spinel interface to the Radio Co-processor (RCP).
  *
@@ -57,6 +229,28 @@ typedef uint8_t HdlcSpinelContext;
 class HdlcInterface : public ot::Spinel::SpinelInterface
 {
 public:
+    /**
+     * This structure holds the HDLC transmit statistics.
+     *
+     */
+    struct TxStats
+    {
+        uint32_t mTransferCount;       ///< Number of HDLC transfers submitted to the platform.
+        uint32_t mCoalescedFrameCount; ///< Number of spinel frames which shared a transfer with other frames.
+        uint8_t  mMaxQueueDepth;       ///< Highest number of spinel frames pending in a single transfer.
+    };
+
+    /**
+     * This structure holds the HDLC receive statistics.
+     *
+     */
+    struct RxStats
+    {
+        uint32_t mOverrunCount;       ///< Number of frames dropped because the RX ring was full.
+        uint32_t mHighWatermarkCount; ///< Number of times the RX ring crossed the high watermark.
+        uint16_t mMaxFillLevel;       ///< Highest number of bytes used in the RX ring.
+    };
+
     /**
      * This constructor initializes the object.
      *
@@ -97,6 +291,9 @@ public:
      * This is blocking call, i.e., if the socket is not writable, this method waits for it to become writable for
      * up to `kMaxWaitTime` interval.
      *
+     * When `OT_PLAT_SPINEL_HDLC_TX_BATCH_MAX_FRAMES` is greater than 1, the encoded frame may be kept in the encoder
+     * buffer and sent later along with the next frames.
+     *
      * @param[in] aFrame     A pointer to buffer containing the spinel frame to send.
      * @param[in] aLength    The length (number of bytes) in the frame.
      *
@@ -121,8 +318,9 @@ public:
     /**
      * This method is called by the HDLC RX Callback when a HDLC message has been received
      *
-     * It will decode and store the Spinel frames in a temporary Spinel frame buffer (mRxSpinelFrameBuffer)
-     * This buffer will be then copied to the OpenThread Spinel frame buffer, from the OpenThread task context
+     * It will decode and store the Spinel frames in a lock-free ring (mRxFrameRing), without ever blocking.
+     * The frames will be then copied to the OpenThread Spinel frame buffer, from the OpenThread task context
+     * If the ring is full, the frame being decoded is dropped and counted as an overrun.
      *
      * @param[in] data A pointer to buffer containing the HDLC message to decode.
      * @param[in] len  The length (number of bytes) in the message.
@@ -151,14 +349,34 @@ public:
      */
     otError HardwareReset(void) { return OT_ERROR_NOT_IMPLEMENTED; }
 
+    /**
+     * This method returns the HDLC transmit statistics.
+     *
+     */
+    const TxStats &GetTxStats(void) const { return mTxStats; }
+
+    /**
+     * This method returns the HDLC receive statistics.
+     *
+     */
+    const RxStats &GetRxStats(void) const { return mRxStats; }
+
+    /**
+     * This method displays HDLC diagnostic statistics on OT CLI.
+     *
+     */
+    void DiagLogStats(void);
+
 private:
     enum
     {
         /* HDLC encoder buffer must be larger than the max spinel frame size to be able to handle the HDLC overhead
-         * As a host, a TX frame will always contain only 1 spinel frame + HDLC overhead
-         * Sizing the buffer for 2 spinel frames should be large enough to handle this */
-        kEncoderBufferSize         = SPINEL_FRAME_MAX_SIZE * 2,
-        kMaxMultiFrameSize         = 2048,
+         * Sizing the buffer for 2 spinel frames should be large enough to handle a single frame, frames which don't
+         * fit behind the already queued ones trigger a transfer of the queued frames first */
+        kEncoderBufferSize         = OT_PLAT_SPINEL_HDLC_TX_BUFFER_SIZE,
+        kTxBatchMaxFrames          = OT_PLAT_SPINEL_HDLC_TX_BATCH_MAX_FRAMES,
+        kRxHighWatermark           = RxFrameRing::GetSize() * OT_PLAT_SPINEL_HDLC_RX_HIGH_WATERMARK / 100,
+        kRxLowWatermark            = RxFrameRing::GetSize() * OT_PLAT_SPINEL_HDLC_RX_LOW_WATERMARK / 100,
         kSpinelHdlcFrameReadyEvent = 1 << 0,
     };
 
@@ -168,25 +386,37 @@ private:
     ot::Spinel::SpinelInterface::RxFrameBuffer       *mReceiveFrameBuffer;
     ot::Spinel::SpinelInterface::ReceiveFrameCallback mReceiveFrameCallback;
     void                                             *mReceiveFrameContext;
-    ot::Spinel::MultiFrameBuffer<kMaxMultiFrameSize>  mRxSpinelFrameBuffer;
+    RxFrameRing                                       mRxFrameRing;
     ot::Hdlc::Decoder                                 mHdlcSpinelDecoder;
     bool                                              mIsInitialized;
-    uint8_t                                          *mSavedFrame;
-    uint16_t                                          mSavedFrameLen;
-    bool                                              mIsSpinelBufferFull;
+    bool                                              mIsRxFlowStopped;
     SemaphoreHandle_t                                 mWriteMutexHandle;
-    SemaphoreHandle_t                                 mReadMutexHandle;
-    QueueHandle_t                                     mMsqQueue;
+    TaskHandle_t                                      mOtTaskHandle;
     EventGroupHandle_t                                mSpinelHdlcEventGroup;
     const Url::Url                                   &mRadioUrl;
+    std::atomic<uint8_t>                              mTxQueuedFrames; // Written under mWriteMutexHandle
+    TxStats                                           mTxStats;
+    RxStats                                           mRxStats;
+    mutable otRcpInterfaceMetrics                     mInterfaceMetrics;
+    uint32_t                                          mRxChunkTimestamp;
+    SpinelRoundTripTracker                            mRoundTrip;
+    LatencyHistogram                                  mRxToCallbackLatency;
+    LatencyHistogram                                  mEncodeLatency;
+    LatencyHistogram                                  mDecodeLatency;
 
     otError     Write(const uint8_t *aFrame, uint16_t aLength);
-    uint32_t    TryReadAndDecode(bool fullRead);
+    otError     EncodeFrame(const uint8_t *aFrame, uint16_t aLength);
+    otError     FlushTxQueue(void);
+    otError     FlushPendingFrames(void);
+    bool        IsOtTask(void) const { return xTaskGetCurrentTaskHandle() == mOtTaskHandle; }
+    uint32_t    TryReadAndDecode(void);
+    otError     CopyFrameToReceiveBuffer(const uint8_t *aFrame, uint16_t aLength);
+    void        UpdateRxFlowControl(void);
     void        HandleHdlcFrame(otError aError);
     static void HandleHdlcFrame(void *aContext, otError aError);
     static void HdlcRxCallback(uint8_t *data, uint16_t len, void *param);
 
-    const otRcpInterfaceMetrics *GetRcpInterfaceMetrics(void) const { return nullptr; }
+    const otRcpInterfaceMetrics *GetRcpInterfaceMetrics(void) const;
     uint32_t                     GetBusSpeed(void) const { return 0; }
     void                         UpdateFdSet(void *aMainloopContext) { (void)aMainloopContext; }
 
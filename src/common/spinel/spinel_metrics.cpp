@@ -0,0 +1,174 @@
+/*
+ *  Copyright (c) 2026, The OpenThread Authors.
+ *  Copyright 2026 NXP
+ *
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the spinel interfaces timing instrumentation.
+ */
+
+#include "spinel_metrics.hpp"
+
+#include "fsl_common.h"
+#include "ot_platform_common.h"
+#include <string.h>
+#include <openthread/cli.h>
+
+namespace ot {
+
+namespace NXP {
+
+void LatencyHistogram::Clear(void)
+{
+    memset(mBuckets, 0, sizeof(mBuckets));
+    mCount = 0;
+    mMinUs = UINT32_MAX;
+    mMaxUs = 0;
+    mSumUs = 0;
+}
+
+void LatencyHistogram::Record(uint32_t aLatencyUs)
+{
+    uint8_t bucket = 0;
+
+    /* Index of the most significant bit set, plus one */
+    while ((bucket < kBucketCount - 1) && ((aLatencyUs >> bucket) != 0))
+    {
+        bucket++;
+    }
+
+    mBuckets[bucket]++;
+    mCount++;
+    mSumUs += aLatencyUs;
+
+    if (aLatencyUs < mMinUs)
+    {
+        mMinUs = aLatencyUs;
+    }
+    if (aLatencyUs > mMaxUs)
+    {
+        mMaxUs = aLatencyUs;
+    }
+}
+
+void LatencyHistogram::Print(const char *aName) const
+{
+    if (mCount == 0)
+    {
+        otCliOutputFormat("%s : no sample\r\n", aName);
+        return;
+    }
+
+    otCliOutputFormat("%s (us) : count %lu min %lu avg %lu max %lu\r\n", aName, mCount, mMinUs,
+                      (uint32_t)(mSumUs / mCount), mMaxUs);
+
+    for (uint8_t i = 0; i < kBucketCount; i++)
+    {
+        if (mBuckets[i] == 0)
+        {
+            continue;
+        }
+        if (i == kBucketCount - 1)
+        {
+            otCliOutputFormat("    >= %7lu : %lu\r\n", 1UL << (i - 1), mBuckets[i]);
+        }
+        else
+        {
+            otCliOutputFormat("    <  %7lu : %lu\r\n", 1UL << i, mBuckets[i]);
+        }
+    }
+}
+
+void LatencyHistogram::InitTimestamp(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+uint32_t LatencyHistogram::GetTimestamp(void)
+{
+    return DWT->CYCCNT;
+}
+
+uint32_t LatencyHistogram::TimestampToUs(uint32_t aTimestampDelta)
+{
+    return aTimestampDelta / (SystemCoreClock / 1000000U);
+}
+
+void SpinelRoundTripTracker::HandleFrameSent(const uint8_t *aFrame, uint16_t aLength)
+{
+    uint8_t tid;
+
+    if (aLength > 0)
+    {
+        tid = SPINEL_HEADER_GET_TID(aFrame[0]);
+
+        /* TID 0 is used by frames which don't expect any response */
+        if (tid != 0)
+        {
+            mSentTimestamps[tid] = LatencyHistogram::GetTimestamp();
+            mPendingTids |= (1U << tid);
+        }
+    }
+}
+
+void SpinelRoundTripTracker::HandleFrameReceived(const uint8_t *aFrame, uint16_t aLength, uint32_t aRxTimestamp)
+{
+    uint8_t tid;
+
+    if (aLength > 0)
+    {
+        tid = SPINEL_HEADER_GET_TID(aFrame[0]);
+
+        if ((tid != 0) && ((mPendingTids & (1U << tid)) != 0))
+        {
+            mPendingTids &= ~(1U << tid);
+            mHistogram.Record(LatencyHistogram::TimestampToUs(aRxTimestamp - mSentTimestamps[tid]));
+        }
+    }
+}
+
+} // namespace NXP
+
+} // namespace ot
+
+extern "C" void otPlatTimestampInit(void)
+{
+    ot::NXP::LatencyHistogram::InitTimestamp();
+}
+
+extern "C" uint32_t otPlatTimestampGet(void)
+{
+    return ot::NXP::LatencyHistogram::GetTimestamp();
+}
+
+extern "C" uint32_t otPlatTimestampToUs(uint32_t aTimestampDelta)
+{
+    return ot::NXP::LatencyHistogram::TimestampToUs(aTimestampDelta);
+}
@@ -0,0 +1,185 @@
+/*
+ *  Copyright (c) 2026, The OpenThread Authors.
+ *  Copyright 2026 NXP
+ *
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions for the spinel interfaces timing instrumentation.
+ */
+
+#ifndef OT_NXP_SPINEL_METRICS_HPP_
+#define OT_NXP_SPINEL_METRICS_HPP_
+
+#include <stdint.h>
+
+#include "lib/spinel/spinel.h"
+
+namespace ot {
+
+namespace NXP {
+
+/**
+ * This class implements a fixed-memory histogram of latencies.
+ *
+ * Bucket 0 counts the latencies below 1 us, bucket i counts the latencies in [2^(i-1), 2^i) us and the last bucket
+ * counts all the larger latencies.
+ *
+ */
+class LatencyHistogram
+{
+public:
+    /**
+     * This constructor initializes the object.
+     *
+     */
+    LatencyHistogram(void) { Clear(); }
+
+    /**
+     * This method resets all the recorded latencies.
+     *
+     */
+    void Clear(void);
+
+    /**
+     * This method records a latency.
+     *
+     * @param[in] aLatencyUs  The latency in microseconds.
+     *
+     */
+    void Record(uint32_t aLatencyUs);
+
+    /**
+     * This method records the time elapsed since a timestamp returned by `GetTimestamp`.
+     *
+     * @param[in] aStartTimestamp  The timestamp at which the measured operation started.
+     *
+     */
+    void RecordSince(uint32_t aStartTimestamp) { Record(TimestampToUs(GetTimestamp() - aStartTimestamp)); }
+
+    /**
+     * This method returns the number of recorded latencies.
+     *
+     */
+    uint32_t GetCount(void) const { return mCount; }
+
+    /**
+     * This method displays the histogram on OT CLI.
+     *
+     * @param[in] aName  The name of the measured latency.
+     *
+     */
+    void Print(const char *aName) const;
+
+    /**
+     * This function enables the cycle counter used for the timestamps.
+     *
+     */
+    static void InitTimestamp(void);
+
+    /**
+     * This function returns a high resolution timestamp, in CPU cycles.
+     *
+     */
+    static uint32_t GetTimestamp(void);
+
+    /**
+     * This function converts a difference of timestamps to microseconds.
+     *
+     */
+    static uint32_t TimestampToUs(uint32_t aTimestampDelta);
+
+private:
+    enum
+    {
+        kBucketCount = 20,
+    };
+
+    uint32_t mBuckets[kBucketCount];
+    uint32_t mCount;
+    uint32_t mMinUs;
+    uint32_t mMaxUs;
+    uint64_t mSumUs;
+};
+
+/**
+ * This class measures the host -> RCP -> host round trip of the spinel commands, matching responses by TID.
+ *
+ * Both methods must be called from the same task.
+ *
+ */
+class SpinelRoundTripTracker
+{
+public:
+    /**
+     * This constructor initializes the object.
+     *
+     */
+    SpinelRoundTripTracker(void)
+        : mPendingTids(0)
+    {
+    }
+
+    /**
+     * This method is called when a spinel frame is sent to the RCP.
+     *
+     */
+    void HandleFrameSent(const uint8_t *aFrame, uint16_t aLength);
+
+    /**
+     * This method is called when a spinel frame is received from the RCP.
+     *
+     * @param[in] aFrame        A pointer to the spinel frame.
+     * @param[in] aLength       The length of the frame.
+     * @param[in] aRxTimestamp  The timestamp at which the frame was received on the bus.
+     *
+     */
+    void HandleFrameReceived(const uint8_t *aFrame, uint16_t aLength, uint32_t aRxTimestamp);
+
+    /**
+     * This method returns the round trip histogram.
+     *
+     */
+    const LatencyHistogram &GetHistogram(void) const { return mHistogram; }
+
+private:
+    enum
+    {
+        kTidCount = (SPINEL_HEADER_TID_MASK >> SPINEL_HEADER_TID_SHIFT) + 1,
+    };
+
+    uint32_t         mSentTimestamps[kTidCount];
+    uint16_t         mPendingTids;
+    LatencyHistogram mHistogram;
+};
+
+} // namespace NXP
+
+} // namespace ot
+
+#endif // OT_NXP_SPINEL_METRICS_HPP_
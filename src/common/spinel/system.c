@@ -33,13 +33,18 @@
  *
  */
 
+#include "fsl_common.h"
 #include "fsl_os_abstraction.h"
 #include "fwk_platform.h"
 #include "fwk_platform_coex.h"
 #include "fwk_platform_ot.h"
 #include "ot_platform_common.h"
 #include <stdlib.h>
+#include <string.h>
+#include <openthread/cli.h>
 #include <openthread/platform/alarm-milli.h>
+#include <openthread/platform/radio.h>
+#include <openthread/platform/toolchain.h>
 #include "common/logging.hpp"
 
 #if (defined(LOG_ENABLE) && (LOG_ENABLE > 0))
@@ -56,6 +61,30 @@
 
 #define SYSTEM_BUFFER_LOG_SIZE 256
 
+/* Only process the drivers which signaled an event with otSysEventSetPending, instead of all of them on each wake */
+#ifndef OT_PLAT_SYS_EVENT_DRIVEN
+#define OT_PLAT_SYS_EVENT_DRIVEN 1
+#endif
+
+/* Count the runs of each driver and measure their processing time with the cycle counter, for the "events" debug
+ * command
+ */
+#ifndef OT_PLAT_SYS_EVENT_STATS
+#define OT_PLAT_SYS_EVENT_STATS 0
+#endif
+
+#define SYS_EVENT_BIT(event) (1U << (event))
+#define SYS_EVENT_ALL (SYS_EVENT_BIT(OT_SYS_EVENT_COUNT) - 1U)
+
+/* Set from any context, cleared by otSysProcessDrivers. Everything is processed on the first call */
+static uint32_t sPendingEvents = SYS_EVENT_ALL;
+
+#if OT_PLAT_SYS_EVENT_STATS
+static otSysEventStats sEventStats;
+
+static const char *const sEventNames[OT_SYS_EVENT_COUNT] = {"alarm", "radio", "cli uart", "udp", "lwip"};
+#endif
+
 #ifdef OT_PLAT_SYS_LOG_MANAGEMENT
 #if (defined(LOG_ENABLE) && (LOG_ENABLE > 0)) && ((defined LOG_ENABLE_ASYNC_MODE) && (LOG_ENABLE_ASYNC_MODE))
 static uint8_t bufferLog[SYSTEM_BUFFER_LOG_SIZE];
@@ -94,6 +123,11 @@ void otSysInit(int argc, char *argv[])
     /* Must be initialized before spinel interface in case it deschedules and calls timestamp API */
     PLATFORM_InitTimeStamp();
 
+#if OT_PLAT_SYS_EVENT_STATS
+    /* Cycle counter used to measure the processing time of the drivers */
+    otPlatTimestampInit();
+#endif
+
 #ifdef OT_PLAT_SYS_WIFI_INIT
     PLATFORM_InitControllers((uint8_t)conn802_15_4_c | (uint8_t)connWlan_c);
 #endif
@@ -117,19 +151,141 @@ void otSysDeinit(void)
     otPlatRandomDeinit();
 }
 
+OT_TOOL_WEAK void otPlatLwipProcess(void)
+{
+    /* Overridden by ot_lwip.c when the LwIP Thread interface is used */
+}
+
 bool otSysPseudoResetWasRequested(void)
 {
     return false;
 }
 
+void otSysEventSetPending(otSysEvent aEvent)
+{
+    (void)__atomic_fetch_or(&sPendingEvents, SYS_EVENT_BIT(aEvent), __ATOMIC_RELEASE);
+}
+
+static uint32_t sysEventStart(void)
+{
+#if OT_PLAT_SYS_EVENT_STATS
+    return otPlatTimestampGet();
+#else
+    return 0;
+#endif
+}
+
+static void sysEventRecord(otSysEvent aEvent, uint32_t aStartCycles)
+{
+#if OT_PLAT_SYS_EVENT_STATS
+    otSysEventHandlerStats *stats  = &sEventStats.mHandlers[aEvent];
+    uint32_t                timeUs = otPlatTimestampToUs(otPlatTimestampGet() - aStartCycles);
+
+    stats->mRuns++;
+    stats->mTotalTimeUs += timeUs;
+    if (timeUs > stats->mMaxTimeUs)
+    {
+        stats->mMaxTimeUs = timeUs;
+    }
+#else
+    OT_UNUSED_VARIABLE(aEvent);
+    OT_UNUSED_VARIABLE(aStartCycles);
+#endif
+}
+
 void otSysProcessDrivers(otInstance *aInstance)
 {
-    otPlatAlarmProcess(aInstance);
-    otPlatRadioProcess(aInstance);
-    otPlatCliUartProcess();
+    uint32_t events;
+    uint32_t start;
+
+#if OT_PLAT_SYS_EVENT_DRIVEN
+    events = __atomic_exchange_n(&sPendingEvents, 0U, __ATOMIC_ACQUIRE);
+
+    /* The radio driver also checks its response and transmit timeouts, which signal no event: give it a chance on
+     * each alarm, and on every wake up while a transmit is in flight
+     */
+    if ((events & SYS_EVENT_BIT(OT_SYS_EVENT_ALARM)) || (otPlatRadioGetState(aInstance) == OT_RADIO_STATE_TRANSMIT))
+    {
+        events |= SYS_EVENT_BIT(OT_SYS_EVENT_RADIO);
+    }
+#else
+    events = SYS_EVENT_ALL;
+#endif
+
+#if OT_PLAT_SYS_EVENT_STATS
+    sEventStats.mProcessCalls++;
+    if (events == 0)
+    {
+        sEventStats.mIdleCalls++;
+    }
+#endif
+
+    if (events & SYS_EVENT_BIT(OT_SYS_EVENT_ALARM))
+    {
+        start = sysEventStart();
+        otPlatAlarmProcess(aInstance);
+        sysEventRecord(OT_SYS_EVENT_ALARM, start);
+    }
+
+    if (events & SYS_EVENT_BIT(OT_SYS_EVENT_RADIO))
+    {
+        start = sysEventStart();
+        otPlatRadioProcess(aInstance);
+        sysEventRecord(OT_SYS_EVENT_RADIO, start);
+    }
+
+    if (events & SYS_EVENT_BIT(OT_SYS_EVENT_CLI_UART))
+    {
+        start = sysEventStart();
+        otPlatCliUartProcess();
+        sysEventRecord(OT_SYS_EVENT_CLI_UART, start);
+    }
 
 #if OPENTHREAD_CONFIG_PLATFORM_UDP_ENABLE
-    otPlatUdpProcess();
+    if (events & SYS_EVENT_BIT(OT_SYS_EVENT_UDP))
+    {
+        start = sysEventStart();
+        otPlatUdpProcess();
+        sysEventRecord(OT_SYS_EVENT_UDP, start);
+    }
+#endif
+
+    if (events & SYS_EVENT_BIT(OT_SYS_EVENT_LWIP))
+    {
+        start = sysEventStart();
+        otPlatLwipProcess();
+        sysEventRecord(OT_SYS_EVENT_LWIP, start);
+    }
+}
+
+void otSysGetEventStats(otSysEventStats *aStats)
+{
+#if OT_PLAT_SYS_EVENT_STATS
+    *aStats = sEventStats;
+#else
+    memset(aStats, 0, sizeof(*aStats));
+#endif
+}
+
+otError otSysEventDiag(void)
+{
+#if OT_PLAT_SYS_EVENT_STATS
+    otSysEventStats stats;
+
+    otSysGetEventStats(&stats);
+
+    otCliOutputFormat("process calls: %lu\r\n", stats.mProcessCalls);
+    otCliOutputFormat("tasklets only: %lu\r\n", stats.mIdleCalls);
+    for (uint8_t i = 0; i < OT_SYS_EVENT_COUNT; i++)
+    {
+        otCliOutputFormat("%s: runs %lu, total %lu us, max %lu us\r\n", sEventNames[i], stats.mHandlers[i].mRuns,
+                          stats.mHandlers[i].mTotalTimeUs, stats.mHandlers[i].mMaxTimeUs);
+    }
+
+    return OT_ERROR_NONE;
+#else
+    otCliOutputFormat("built without OT_PLAT_SYS_EVENT_STATS\r\n");
+    return OT_ERROR_NOT_CAPABLE;
 #endif
 }
 
@@ -42,6 +42,7 @@
 #include "fsl_os_abstraction.h"
 
 #include "openthread-system.h"
+#include "ot_platform_common.h"
 #include <utils/code_utils.h>
 #include <utils/uart.h>
 #include <openthread/tasklet.h>
@@ -214,6 +215,13 @@ void otPlatCliUartProcess(void)
         (bytesRead != 0))
     {
         otPlatUartReceived(rxBuffer, bytesRead);
+
+        if (bytesRead == OT_PLAT_UART_RECEIVE_BUFFER_SIZE)
+        {
+            /* There may be more bytes in the serial manager ring buffer, read them on the next call */
+            otSysEventSetPending(OT_SYS_EVENT_CLI_UART);
+            otTaskletsSignalPending(NULL);
+        }
     }
 
     intMask = DisableGlobalIRQ();
@@ -246,6 +254,7 @@ OT_TOOL_WEAK void otPlatUartReceived(const uint8_t *aBuf, uint16_t aBufLength)
 static void Uart_RxCallBack(void *pData, serial_manager_callback_message_t *message, serial_manager_status_t status)
 {
     /* notify the main loop that a RX buffer is available */
+    otSysEventSetPending(OT_SYS_EVENT_CLI_UART);
     otSysEventSignalPending();
 }
 
@@ -253,5 +262,6 @@ static void Uart_TxCallBack(void *pBuffer, serial_manager_callback_message_t *me
 {
     /* notify the main loop that the TX is done */
     txDone = true;
+    otSysEventSetPending(OT_SYS_EVENT_CLI_UART);
     otSysEventSignalPending();
 }
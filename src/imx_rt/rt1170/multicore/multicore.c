@@ -7,10 +7,13 @@
  */
 
 #include "fsl_debug_console.h"
+#include "FreeRTOS.h"
 #include "mcmgr.h"
+#include "multicore.h"
 #include "rpmsg_lite.h"
 #include "rpmsg_ns.h"
 #include "rpmsg_queue.h"
+#include "task.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -43,7 +46,15 @@ extern int         core1_image_size;
 #define LOCAL_EPT_ADDR (40U)
 #define APP_RPMSG_READY_EVENT_DATA (1U)
 
+/* Must match the shared memory and RL_BUFFER_* configuration of the secondary core image */
+#ifndef SH_MEM_TOTAL_SIZE
 #define SH_MEM_TOTAL_SIZE (6144U)
+#endif
+
+/* Number of log batches sent to the secondary core and not acknowledged yet, at most the number of TX buffers */
+#ifndef MULTICORE_LOG_MAX_IN_FLIGHT
+#define MULTICORE_LOG_MAX_IN_FLIGHT (RL_BUFFER_COUNT)
+#endif
 #if defined(__ICCARM__) /* IAR Workbench */
 #pragma location = "rpmsg_sh_mem_section"
 static char rpmsg_lite_base[SH_MEM_TOTAL_SIZE];
@@ -61,6 +72,19 @@ static struct rpmsg_lite_instance *my_rpmsg;
 static rpmsg_queue_handle          my_queue;
 static volatile uint16_t           RPMsgRemoteReadyEventData = 0U;
 
+/* Batch of logs being written in a shared memory buffer, sent as a single message */
+static char    *tx_buffer   = NULL;
+static uint32_t tx_capacity = 0U;
+static uint32_t tx_len      = 0U;
+static uint32_t tx_start_tick;
+
+/* Send time of the batches waiting for the acknowledgement of the secondary core, oldest first */
+static uint32_t in_flight_ticks[MULTICORE_LOG_MAX_IN_FLIGHT];
+static uint32_t in_flight_head  = 0U;
+static uint32_t in_flight_count = 0U;
+
+static multicore_log_stats_t log_stats;
+
 void MU_Tx3EmptyFlagISR(void);
 /*******************************************************************************
  * Prototypes
@@ -151,13 +175,138 @@ void multicore_init(void)
     };
 }
 
-void multicore_send_data(uint8_t *pData, uint32_t size)
+/* Handle the acknowledgement of the oldest batch, waiting for it if aTimeout is RL_BLOCK */
+static bool multicore_receive_ack(uint32_t aTimeout)
 {
     uint8_t  value;
     uint32_t lenRead;
-    rpmsg_lite_send(my_rpmsg, my_ept, remote_addr, (char *)pData, size, RL_BLOCK);
-    (void)rpmsg_queue_recv(my_rpmsg, my_queue, (uint32_t *)&remote_addr, (char *)&value, sizeof(value), &lenRead,
-                           RL_BLOCK);
-    (void)value;
-    (void)lenRead;
+    uint32_t src;
+    uint32_t latency;
+
+    if ((in_flight_count == 0U) ||
+        (rpmsg_queue_recv(my_rpmsg, my_queue, &src, (char *)&value, sizeof(value), &lenRead, aTimeout) != RL_SUCCESS))
+    {
+        return false;
+    }
+
+    latency = xTaskGetTickCount() - in_flight_ticks[in_flight_head];
+    if (latency > log_stats.max_ack_latency)
+    {
+        log_stats.max_ack_latency = latency;
+    }
+    in_flight_head = (in_flight_head + 1U) % MULTICORE_LOG_MAX_IN_FLIGHT;
+    in_flight_count--;
+    log_stats.acks++;
+
+    return true;
+}
+
+static bool multicore_start_batch(void)
+{
+    /* Logs written before multicore_init are dropped */
+    if (remote_addr == 0U)
+    {
+        return false;
+    }
+
+    /* Collect the acknowledgements already received without waiting for them */
+    while (multicore_receive_ack(RL_DONT_BLOCK))
+    {
+    }
+
+    if (in_flight_count < MULTICORE_LOG_MAX_IN_FLIGHT)
+    {
+        tx_buffer = rpmsg_lite_alloc_tx_buffer(my_rpmsg, &tx_capacity, RL_DONT_BLOCK);
+    }
+
+    if (tx_buffer == NULL)
+    {
+        /* The secondary core is behind, wait until it releases a buffer. Only the log dump task waits here, the
+         * logging tasks keep writing in the log ring buffer. */
+        log_stats.stalls++;
+        while ((in_flight_count >= MULTICORE_LOG_MAX_IN_FLIGHT) && multicore_receive_ack(RL_BLOCK))
+        {
+        }
+        tx_buffer = rpmsg_lite_alloc_tx_buffer(my_rpmsg, &tx_capacity, RL_BLOCK);
+    }
+
+    tx_len        = 0U;
+    tx_start_tick = xTaskGetTickCount();
+
+    return tx_buffer != NULL;
+}
+
+void multicore_send_data(uint8_t *pData, uint32_t size)
+{
+    /* Logs are concatenated in the batch, which is terminated once when sent */
+    while ((size > 0U) && (pData[size - 1U] == '\0'))
+    {
+        size--;
+    }
+
+    if ((tx_buffer != NULL) && (tx_len + size + 1U > tx_capacity))
+    {
+        multicore_flush_data();
+    }
+
+    if ((size == 0U) || ((tx_buffer == NULL) && !multicore_start_batch()))
+    {
+        log_stats.dropped += (size != 0U);
+        return;
+    }
+
+    /* A log larger than the payload of a whole buffer is cut, the batch being empty at this point */
+    if (tx_len + size + 1U > tx_capacity)
+    {
+        log_stats.truncated++;
+        size = tx_capacity - tx_len - 1U;
+    }
+
+    (void)memcpy(&tx_buffer[tx_len], pData, size);
+    tx_len += size;
+    log_stats.messages++;
+    log_stats.bytes += size;
+}
+
+void multicore_flush_data(void)
+{
+    uint32_t latency;
+    uint32_t tail;
+
+    if (tx_buffer == NULL)
+    {
+        return;
+    }
+
+    tx_buffer[tx_len++] = '\0';
+    if (rpmsg_lite_send_nocopy(my_rpmsg, my_ept, remote_addr, tx_buffer, tx_len) != RL_SUCCESS)
+    {
+        /* The buffer is still owned by this core and RPMsg-Lite cannot take back an unsent TX buffer, so the batch is
+         * dropped and the buffer is reused by the next one instead of being leaked */
+        log_stats.dropped++;
+        tx_len        = 0U;
+        tx_start_tick = xTaskGetTickCount();
+        return;
+    }
+
+    tail                  = (in_flight_head + in_flight_count) % MULTICORE_LOG_MAX_IN_FLIGHT;
+    in_flight_ticks[tail] = xTaskGetTickCount();
+    in_flight_count++;
+    log_stats.batches++;
+    if (in_flight_count > log_stats.max_in_flight)
+    {
+        log_stats.max_in_flight = in_flight_count;
+    }
+
+    latency = in_flight_ticks[tail] - tx_start_tick;
+    if (latency > log_stats.max_batch_latency)
+    {
+        log_stats.max_batch_latency = latency;
+    }
+    tx_buffer = NULL;
+}
+
+void multicore_get_log_stats(multicore_log_stats_t *stats)
+{
+    *stats = log_stats;
 }
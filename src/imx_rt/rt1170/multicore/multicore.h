@@ -9,8 +9,36 @@
 #ifndef MULTICORE_H_
 #define MULTICORE_H_
 
+#include <stdint.h>
+
+/* Counters of the logs sent to the secondary core, latencies are in RTOS ticks */
+typedef struct multicore_log_stats
+{
+    uint32_t messages;          /* Logs added to a batch */
+    uint32_t bytes;             /* Bytes of the logs added to a batch */
+    uint32_t batches;           /* Batches sent to the secondary core */
+    uint32_t acks;              /* Batches acknowledged by the secondary core */
+    uint32_t dropped;           /* Logs or batches which could not be sent */
+    uint32_t truncated;         /* Logs longer than a shared memory buffer */
+    uint32_t stalls;            /* Times all the shared memory buffers were in use */
+    uint32_t max_in_flight;     /* Largest number of batches not acknowledged */
+    uint32_t max_batch_latency; /* Longest time between the first log of a batch and its transmission */
+    uint32_t max_ack_latency;   /* Longest time between the transmission of a batch and its acknowledgement */
+} multicore_log_stats_t;
+
 void multicore_init(void);
 
+/*!
+ * @brief Add a log to the batch sent to the secondary core, a new batch is started when it is full.
+ * Must be called from a single task, the log dump task when LOG_BUFFER_ENABLED is set.
+ */
 void multicore_send_data(uint8_t *pData, uint32_t size);
 
+/*!
+ * @brief Send the current batch of logs to the secondary core without waiting for its acknowledgement.
+ */
+void multicore_flush_data(void);
+
+void multicore_get_log_stats(multicore_log_stats_t *stats);
+
 #endif /* MULTICORE_H_ */
@@ -33,10 +33,13 @@
  */
 
 #include <stdio.h>
+#include <string.h>
 #include <openthread/config.h>
 #include <openthread/platform/alarm-milli.h>
 #include <openthread/platform/radio.h>
 
+#include "pdm_ram_storage_glue.h"
+
 #if OPENTHREAD_ENABLE_DIAG
 
 /**
@@ -50,6 +53,19 @@ void otPlatDiagProcess(otInstance *aInstance, int argc, char *argv[], char *aOut
     OT_UNUSED_VARIABLE(aInstance);
     OT_UNUSED_VARIABLE(argc);
 
+#if PDM_SAVE_IDLE
+    if (strcmp(argv[0], "pdmstats") == 0)
+    {
+        tsFsSaveStats stats;
+
+        FS_vGetSaveStats(&stats);
+        snprintf(aOutput, aOutputMaxLen, "bytes saved: %lu\r\nsegments saved: %lu\r\nsegments skipped: %lu\r\n",
+                 (unsigned long)stats.u32BytesSaved, (unsigned long)stats.u32SegmentsSaved,
+                 (unsigned long)stats.u32SegmentsSkipped);
+        return;
+    }
+#endif
+
     // Add more platform specific diagnostics features here.
     snprintf(aOutput, aOutputMaxLen, "diag feature '%s' is not supported\r\n", argv[0]);
 }
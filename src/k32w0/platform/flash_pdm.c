@@ -146,6 +146,10 @@ void otPlatSettingsDeinit(otInstance *aInstance)
         otPlatFree(ramDescr->buffer);
         ramDescr->buffer = NULL;
     }
+#if RAM_STORAGE_INDEX
+    otPlatFree(ramDescr->header.index);
+    ramDescr->header.index = NULL;
+#endif
     pdmMutexTaken = FALSE;
     mutex_unlock(pdmMutexHandle);
     mutex_destroy(pdmMutexHandle);
@@ -277,6 +281,9 @@ void otPlatSettingsWipe(otInstance *aInstance)
     pdmMutexTaken = TRUE;
     memset(ramDescr->buffer, 0, ramDescr->header.maxLength);
     ramDescr->header.length = 0;
+#if PDM_SAVE_IDLE
+    ramDescr->header.dirtySegments = 0;
+#endif
     PDM_vDeleteDataRecord(kNvmIdOTConfigData);
     pdmMutexTaken = FALSE;
     mutex_unlock(pdmMutexHandle);
@@ -69,16 +69,14 @@ static uint32_t sPdmSegmentSize = 0;
 
 #define MAX_QUEUE_SIZE (16)
 
-/* Dummy keys are introduced at the end of a PDM region if the current key does not fit the free space. */
-#define kRamBufferDummyKey (uint16_t)0xFFFF
-
 typedef struct
 {
     ramBufferDescriptor *pvDataBuffer;
     uint16_t             u16IdValue;
 } tsQueueEntry;
 
-static tsQueueEntry asQueue[MAX_QUEUE_SIZE];
+static tsQueueEntry  asQueue[MAX_QUEUE_SIZE];
+static tsFsSaveStats sSaveStats;
 static uint8_t      u8QueueWritePtr;
 static uint8_t      u8QueueReadPtr;
 static osaMutexId_t asQueueMutex;
@@ -86,7 +84,8 @@ static bool_t       asQueueMutexTaken;
 /* Buffer used to temporary copy RAM buffer data in order to sync save it. */
 static uint8_t *sSegmentBuffer = NULL;
 
-static uint8_t u8IncrementQueuePtr(uint8_t u8CurrentValue);
+static uint8_t      u8IncrementQueuePtr(uint8_t u8CurrentValue);
+static PDM_teStatus FS_eQueueRecordData(uint16_t u16IdValue, ramBufferDescriptor *pvDataBuffer);
 
 #endif /* PDM_SAVE_IDLE */
 
@@ -188,6 +187,10 @@ static void loadData(uint16_t id, uint16_t nbIds, ramBufferDescriptor *handle)
 {
     PDM_teStatus status = PDM_E_STATUS_OK;
     uint16_t     length;
+#if PDM_SAVE_IDLE
+    uint32_t previousLength = PDM_SEGMENT_SIZE;
+    bool_t   sameLayout     = TRUE;
+#endif
 
     handle->header.length = 0;
 
@@ -198,6 +201,11 @@ static void loadData(uint16_t id, uint16_t nbIds, ramBufferDescriptor *handle)
         if (PDM_E_STATUS_OK == status)
         {
             handle->header.length += length;
+#if PDM_SAVE_IDLE
+            /* Only a full segment can be followed by another one */
+            sameLayout     = sameLayout && (previousLength == PDM_SEGMENT_SIZE) && (length <= PDM_SEGMENT_SIZE);
+            previousLength = length;
+#endif
         }
         else
         {
@@ -205,6 +213,15 @@ static void loadData(uint16_t id, uint16_t nbIds, ramBufferDescriptor *handle)
         }
     }
 
+#if PDM_SAVE_IDLE
+    /* Records not split as FS_SaveRecordData does (sync save, other segment size) are all rewritten on next save */
+    handle->header.dirtySegments = 0;
+    if (!sameLayout)
+    {
+        ramStorageMarkDirty(handle, 0, handle->header.length);
+    }
+#endif
+
     if ((PDM_E_STATUS_OK != status) || (handle->header.length > handle->header.maxLength))
     {
         handle->header.length = 0;
@@ -343,6 +360,12 @@ rsError ramStorageResize(ramBufferDescriptor *pBuffer, uint16_t aKey, const uint
         otEXPECT_ACTION(allocSize <= pBuffer->header.backendRegionSize, err = RS_ERROR_NO_BUFS);
     }
 
+    if (allocSize < pBuffer->header.length + newBlockLength)
+    {
+        /* Reclaim the deleted records before growing the buffer */
+        (void)ramStorageCompact(pBuffer);
+    }
+
     if (allocSize < pBuffer->header.length + newBlockLength)
     {
         while ((allocSize < pBuffer->header.length + newBlockLength))
@@ -394,6 +417,7 @@ ramBufferDescriptor *getRamBuffer(uint16_t nvmId, uint16_t initialSize, bool_t e
     ramDescr->header.backendRegionSize = PDM_SEGMENT_SIZE;
     ramDescr->header.maxLength         = PDM_BUFFER_SIZE - kRamDescSize;
     ramDescr->buffer                   = (uint8_t *)&sPdmBuffer[kRamDescSize];
+    otEXPECT_ACTION((PDM_BUFFER_SIZE - kRamDescSize <= kRamBufferMaxLength), ramDescr = NULL);
 #if PDM_SAVE_IDLE
     ramDescr->header.mutexHandle       = OSA_MutexCreate();
     otEXPECT_ACTION((NULL != ramDescr->header.mutexHandle), ramDescr = NULL);
@@ -454,6 +478,20 @@ void FS_Deinit()
 }
 
 PDM_teStatus FS_eSaveRecordDataInIdleTask(uint16_t u16IdValue, ramBufferDescriptor *pvDataBuffer)
+{
+    /* A save requested without any modified segment comes from a writer which changed the RAM buffer directly and
+     * did not call ramStorageMarkDirty. The whole buffer is saved then, as it was before the segments were tracked. */
+    OSA_InterruptDisable();
+    if (pvDataBuffer->header.dirtySegments == 0)
+    {
+        ramStorageMarkDirty(pvDataBuffer, 0, pvDataBuffer->header.length);
+    }
+    OSA_InterruptEnable();
+
+    return FS_eQueueRecordData(u16IdValue, pvDataBuffer);
+}
+
+static PDM_teStatus FS_eQueueRecordData(uint16_t u16IdValue, ramBufferDescriptor *pvDataBuffer)
 {
     tsQueueEntry *psQueueEntry;
     PDM_teStatus  status = PDM_E_STATUS_OK;
@@ -528,6 +566,7 @@ PDM_teStatus FS_eSaveRecordDataInIdleTask(uint16_t u16IdValue, ramBufferDescript
  * id used in the RAM buffer entry. The PDM id user (e.g. Matter) should
  * take into account this limitation and choose the PDM ids accordingly, to
  * avoid the possibility of overwriting data.
+ * Only the chunks marked in the RAM buffer dirtySegments bitmap are saved.
  */
 static void FS_SaveRecordData(tsQueueEntry *entry)
 {
@@ -539,6 +578,8 @@ static void FS_SaveRecordData(tsQueueEntry *entry)
     {
         PDM_teStatus status = PDM_E_STATUS_INTERNAL_ERROR;
         uint16_t     size   = (length < PDM_SEGMENT_SIZE) ? length : PDM_SEGMENT_SIZE;
+        uint32_t     bit    = RAM_STORAGE_SEGMENT_BIT(i);
+        bool_t       dirty  = FALSE;
 
         // There might be a corner case in which correlated keys are in different
         // PDM regions, which might cause deprecated fabric data if an issue occurs
@@ -546,18 +587,45 @@ static void FS_SaveRecordData(tsQueueEntry *entry)
         // data spans across a maximum of two PDM regions.
         if (osaStatus_Success == mutex_lock(handle->header.mutexHandle, 0))
         {
-            memcpy(sSegmentBuffer, handle->buffer + i * PDM_SEGMENT_SIZE, size);
+            dirty = ((handle->header.dirtySegments & bit) != 0);
+            if (dirty)
+            {
+                memcpy(sSegmentBuffer, handle->buffer + i * PDM_SEGMENT_SIZE, size);
+
+                /* The segments above the bitmap share its last bit, it is cleared with the last one */
+                if ((i < kRamBufferMaxDirtySegments - 1) || (i == segments - 1))
+                {
+                    handle->header.dirtySegments &= ~bit;
+                }
+            }
             mutex_unlock(handle->header.mutexHandle);
 
-            status = PDM_eSaveRecordData(entry->u16IdValue + i, sSegmentBuffer, size);
+            status = dirty ? PDM_eSaveRecordData(entry->u16IdValue + i, sSegmentBuffer, size) : PDM_E_STATUS_OK;
         }
 
         if (status != PDM_E_STATUS_OK)
         {
-            FS_eSaveRecordDataInIdleTask(entry->u16IdValue, handle);
+            if (dirty)
+            {
+                /* Can't block on the RAM buffer mutex from the idle task */
+                OSA_InterruptDisable();
+                handle->header.dirtySegments |= bit;
+                OSA_InterruptEnable();
+            }
+            FS_eQueueRecordData(entry->u16IdValue, handle);
             break;
         }
 
+        if (dirty)
+        {
+            sSaveStats.u32BytesSaved += size;
+            sSaveStats.u32SegmentsSaved++;
+        }
+        else
+        {
+            sSaveStats.u32SegmentsSkipped++;
+        }
+
         length -= size;
     }
 }
@@ -584,6 +652,13 @@ void FS_vIdleTask(uint8_t u8WritesAllowed)
     }
 }
 
+void FS_vGetSaveStats(tsFsSaveStats *psStats)
+{
+    OSA_InterruptDisable();
+    *psStats = sSaveStats;
+    OSA_InterruptEnable();
+}
+
 bool_t idleMutexIsTaken()
 {
     return asQueueMutexTaken;
@@ -67,10 +67,23 @@ bool_t PDM_RetrieveSegmentSize();
 ramBufferDescriptor *getRamBuffer(uint16_t nvmId, uint16_t initialSize, bool_t extendedSearch);
 
 #if PDM_SAVE_IDLE
+/* Idle save counters.
+ * u32BytesSaved: bytes written to PDM.
+ * u32SegmentsSaved: PDM segments written.
+ * u32SegmentsSkipped: PDM segments not written because they were not modified.
+ */
+typedef struct
+{
+    uint32_t u32BytesSaved;
+    uint32_t u32SegmentsSaved;
+    uint32_t u32SegmentsSkipped;
+} tsFsSaveStats;
+
 bool_t       FS_Init();
 void         FS_Deinit();
 PDM_teStatus FS_eSaveRecordDataInIdleTask(uint16_t u16IdValue, ramBufferDescriptor *pvDataBuffer);
 void         FS_vIdleTask(uint8_t u8WritesAllowed);
+void         FS_vGetSaveStats(tsFsSaveStats *psStats);
 bool_t       idleMutexIsTaken();
 #endif /* PDM_SAVE_IDLE */
 
@@ -39,6 +39,7 @@
 
 #include "ncp_ot.h"
 #include "openthread-system.h"
+#include "ot_platform_common.h"
 #include <utils/uart.h>
 
 /* -------------------------------------------------------------------------- */
@@ -120,6 +121,7 @@ void otPlatCliUartProcess(void)
 void Ot_Data_RxDone(void)
 {
     /* notify the main loop that a RX buffer is available */
+    otSysEventSetPending(OT_SYS_EVENT_CLI_UART);
     otSysEventSignalPending();
 }
 
@@ -127,6 +129,7 @@ void Ot_Data_TxDone(void)
 {
     /* notify the main loop that the TX is done */
     txDone = true;
+    otSysEventSetPending(OT_SYS_EVENT_CLI_UART);
     otSysEventSignalPending();
 }
 
@@ -0,0 +1,503 @@
+/*
+ *  Copyright (c) 2025, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file benchmarks the key cache of the NVS settings backend (flash_nvs.c) against the backend without cache.
+ *
+ *   The settings partition is emulated in RAM the way the Zephyr settings NVS backend uses it: browsing a subtree or
+ *   saving a value reads the name of every stored setting, and reading a value is one more flash read. Both backends
+ *   replay the same sequence of settings operations, modelled on a router with child churn and lookups of missing
+ *   keys. Their results and the final partition content must be identical, and the cache must not read the flash
+ *   more. The flash reads, subtree walks and time per operation are printed; build with
+ *   OT_NXP_HOST_TESTS_SANITIZE=OFF for meaningful timings.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "host_test.h"
+
+#include <time.h>
+
+#include "flash_nvs.c"
+
+#define TEST_OPERATIONS 200000U
+#define TEST_NVS_MAX_ENTRIES 64U
+#define TEST_MAX_VALUE_SIZE 128U
+#define TEST_MAX_CHILDREN 8U
+#define TEST_CHILD_INFO_KEY 5U
+#define TEST_CHILD_INFO_SIZE 17U
+#define TEST_CHILD_MAX_INDEX 9U
+
+/* Keys stored by the OpenThread core on a router, with typical value sizes */
+static const struct
+{
+    uint16_t key;
+    uint16_t size;
+} sCoreKeys[] = {
+    {1, 120}, {3, 38}, {4, 10}, {7, 32}, {8, 9}, {11, 121}, {12, 18}, {13, 2}, {15, 8}, {16, 26}, {17, 16},
+};
+
+/* Keys looked up by the OpenThread core but never stored on this router */
+static const uint16_t sMissingKeys[] = {2, 6, 9, 10, 14};
+
+#define TEST_CORE_KEY_COUNT (sizeof(sCoreKeys) / sizeof(sCoreKeys[0]))
+#define TEST_MISSING_KEY_COUNT (sizeof(sMissingKeys) / sizeof(sMissingKeys[0]))
+
+typedef enum
+{
+    kTestGet,
+    kTestSet,
+    kTestAdd,
+    kTestDelete,
+} testOperationType_t;
+
+typedef struct
+{
+    uint8_t  type;
+    uint16_t key;
+    int16_t  index;
+    uint16_t size;
+} testOperation_t;
+
+/* Outcome of an operation, compared between the two backends */
+typedef struct
+{
+    otError  error;
+    uint16_t length;
+    uint32_t sequence;
+} testResult_t;
+
+typedef struct
+{
+    bool     used;
+    char     name[KEY_NAME_SIZE];
+    uint16_t length;
+    uint8_t  value[TEST_MAX_VALUE_SIZE];
+} testNvsEntry_t;
+
+/* Flash accesses of the emulated partition */
+typedef struct
+{
+    uint32_t reads;
+    uint32_t writes;
+    uint32_t walks;
+} testNvsStats_t;
+
+static testNvsEntry_t  sNvs[TEST_NVS_MAX_ENTRIES];
+static testNvsEntry_t  sCachedNvs[TEST_NVS_MAX_ENTRIES];
+static testNvsStats_t  sStats;
+static testOperation_t sOperations[TEST_OPERATIONS];
+static testResult_t    sCachedResults[TEST_OPERATIONS];
+static testResult_t    sUncachedResults[TEST_OPERATIONS];
+static uint8_t         sValue[TEST_MAX_VALUE_SIZE];
+
+int flash_area_open(int id, const struct flash_area **fa)
+{
+    static const struct flash_area sArea;
+
+    *fa = &sArea;
+    return 0;
+}
+
+int flash_init(const void *dev)
+{
+    return 0;
+}
+
+int settings_subsys_init(void)
+{
+    return 0;
+}
+
+static ssize_t testNvsRead(void *cb_arg, void *data, size_t len)
+{
+    const testNvsEntry_t *entry = (const testNvsEntry_t *)cb_arg;
+    size_t                size  = (len < entry->length) ? len : entry->length;
+
+    sStats.reads++;
+    memcpy(data, entry->value, size);
+
+    return (ssize_t)size;
+}
+
+/* Like the NVS backend, browse the names from the most recent one and read each of them */
+int settings_load_subtree_direct(const char *subtree, settings_load_direct_cb cb, void *param)
+{
+    size_t length = strlen(subtree);
+
+    sStats.walks++;
+
+    for (uint32_t i = TEST_NVS_MAX_ENTRIES; i-- > 0;)
+    {
+        testNvsEntry_t *entry = &sNvs[i];
+        const char     *key;
+
+        if (!entry->used)
+        {
+            continue;
+        }
+
+        sStats.reads++;
+        if (strncmp(entry->name, subtree, length) != 0 || (entry->name[length] != '\0' && entry->name[length] != '/'))
+        {
+            continue;
+        }
+
+        key = (entry->name[length] == '/') ? &entry->name[length + 1] : NULL;
+        if (cb(key, entry->length, testNvsRead, entry, param) != 0)
+        {
+            break;
+        }
+    }
+
+    return 0;
+}
+
+/* Like the NVS backend, look the name up by reading the stored names, an empty value deletes the setting */
+int settings_save_one(const char *name, const void *value, size_t val_len)
+{
+    testNvsEntry_t *entry = NULL;
+    testNvsEntry_t *free  = NULL;
+
+    HOST_TEST_VERIFY(strlen(name) < KEY_NAME_SIZE && val_len <= TEST_MAX_VALUE_SIZE);
+
+    for (uint32_t i = TEST_NVS_MAX_ENTRIES; i-- > 0;)
+    {
+        if (!sNvs[i].used)
+        {
+            free = &sNvs[i];
+            continue;
+        }
+
+        sStats.reads++;
+        if (strcmp(sNvs[i].name, name) == 0)
+        {
+            entry = &sNvs[i];
+            break;
+        }
+    }
+
+    if (val_len == 0)
+    {
+        if (entry != NULL)
+        {
+            entry->used = false;
+            sStats.writes++;
+        }
+        return 0;
+    }
+
+    if (entry == NULL)
+    {
+        if (free == NULL)
+        {
+            return -1;
+        }
+        entry       = free;
+        entry->used = true;
+        strcpy(entry->name, name);
+    }
+
+    entry->length = (uint16_t)val_len;
+    memcpy(entry->value, value, val_len);
+    sStats.writes++;
+
+    return 0;
+}
+
+int settings_delete(const char *name)
+{
+    return settings_save_one(name, NULL, 0);
+}
+
+/* The backend before the key cache: the name is formatted and the subtree browsed on every call */
+static otError testUncachedGet(uint16_t aKey, int aIndex, uint8_t *aValue, uint16_t *aValueLength)
+{
+    struct key_data k = {.index = aIndex, .flags = KEY_NOT_FOUND, .len = *aValueLength, .data = aValue};
+    int             err;
+
+    sprintf(k.name, OT_KEY_PREFIX "/%x", aKey);
+    err = settings_load_subtree_direct(k.name, subtree_cb_read_value, &k);
+    if ((err != 0) || ((k.flags & KEY_NOT_FOUND) != 0) || ((k.flags & KEY_READ_FAILED) != 0))
+    {
+        *aValueLength = 0;
+        return OT_ERROR_NOT_FOUND;
+    }
+
+    *aValueLength = k.len;
+    return OT_ERROR_NONE;
+}
+
+static otError testUncachedAdd(uint16_t aKey, const uint8_t *aValue, uint16_t aValueLength)
+{
+    char     key_name[KEY_NAME_SIZE];
+    unsigned cnt = 0;
+
+    sprintf(key_name, OT_KEY_PREFIX "/%x", aKey);
+    if (settings_load_subtree_direct(key_name, subtree_cb_count_values, &cnt) != 0)
+    {
+        return OT_ERROR_NO_BUFS;
+    }
+
+    sprintf(key_name, OT_KEY_PREFIX "/%x/%u", aKey, cnt);
+    return (settings_save_one(key_name, aValue, aValueLength) == 0) ? OT_ERROR_NONE : OT_ERROR_NO_BUFS;
+}
+
+static otError testUncachedSet(uint16_t aKey, const uint8_t *aValue, uint16_t aValueLength)
+{
+    char key_name[KEY_NAME_SIZE];
+
+    sprintf(key_name, OT_KEY_PREFIX "/%x/0", aKey);
+    return (settings_save_one(key_name, aValue, aValueLength) == 0) ? OT_ERROR_NONE : OT_ERROR_NO_BUFS;
+}
+
+static otError testUncachedDelete(uint16_t aKey, int aIndex)
+{
+    char key_name[KEY_NAME_SIZE];
+    int  err;
+
+    if (aIndex == -1)
+    {
+        sprintf(key_name, OT_KEY_PREFIX "/%x", aKey);
+        err = settings_load_subtree_direct(key_name, subtree_cb_wipe, key_name);
+    }
+    else
+    {
+        sprintf(key_name, OT_KEY_PREFIX "/%x/%d", aKey, aIndex);
+        err = settings_delete(key_name);
+    }
+
+    return (err == 0) ? OT_ERROR_NONE : OT_ERROR_NOT_FOUND;
+}
+
+/* Only the first bytes of a value change between writes, so that filling it costs little next to the operation */
+static void testFillValue(uint32_t aSequence)
+{
+    memcpy(sValue, &aSequence, sizeof(aSequence));
+}
+
+static void testGenerateOperations(void)
+{
+    uint32_t children = 0;
+    uint32_t count    = 0;
+
+    for (uint16_t i = 0; i < TEST_CORE_KEY_COUNT; i++)
+    {
+        sOperations[count++] = (testOperation_t){kTestSet, sCoreKeys[i].key, 0, sCoreKeys[i].size};
+    }
+
+    for (; count < TEST_OPERATIONS; count++)
+    {
+        testOperation_t *operation = &sOperations[count];
+        unsigned         draw      = (unsigned)rand() % 100;
+        uint16_t         slot      = (uint16_t)((unsigned)rand() % TEST_CORE_KEY_COUNT);
+
+        *operation = (testOperation_t){kTestGet, sCoreKeys[slot].key, 0, sCoreKeys[slot].size};
+
+        if (draw < 40)
+        {
+            continue;
+        }
+        else if (draw < 55)
+        {
+            operation->key   = TEST_CHILD_INFO_KEY;
+            operation->index = (int16_t)((unsigned)rand() % (TEST_CHILD_MAX_INDEX + 1));
+        }
+        else if (draw < 65)
+        {
+            operation->key = sMissingKeys[(unsigned)rand() % TEST_MISSING_KEY_COUNT];
+        }
+        else if (draw < 80)
+        {
+            operation->type = kTestSet;
+        }
+        else if (draw < 90 && children < TEST_MAX_CHILDREN)
+        {
+            operation->type = kTestAdd;
+            operation->key  = TEST_CHILD_INFO_KEY;
+            operation->size = TEST_CHILD_INFO_SIZE;
+            children++;
+        }
+        else if (draw < 99 && children > 0)
+        {
+            operation->type  = kTestDelete;
+            operation->key   = TEST_CHILD_INFO_KEY;
+            operation->index = (int16_t)((unsigned)rand() % children);
+            children--;
+        }
+        else if (draw == 99)
+        {
+            operation->type  = kTestDelete;
+            operation->key   = TEST_CHILD_INFO_KEY;
+            operation->index = -1;
+            children         = 0;
+        }
+    }
+}
+
+static void testRun(bool aCached, testResult_t *aResults)
+{
+    for (uint32_t i = 0; i < TEST_OPERATIONS; i++)
+    {
+        const testOperation_t *operation = &sOperations[i];
+        testResult_t          *result    = &aResults[i];
+        uint8_t                value[TEST_MAX_VALUE_SIZE];
+
+        result->length   = 0;
+        result->sequence = 0;
+
+        switch (operation->type)
+        {
+        case kTestGet:
+            result->length = sizeof(value);
+            result->error  = aCached ? otPlatSettingsGet(NULL, operation->key, operation->index, value, &result->length)
+                                     : testUncachedGet(operation->key, operation->index, value, &result->length);
+            if (result->error == OT_ERROR_NONE)
+            {
+                memcpy(&result->sequence, value,
+                       (result->length < sizeof(result->sequence)) ? result->length : sizeof(result->sequence));
+            }
+            break;
+
+        case kTestSet:
+            testFillValue(i);
+            result->error = aCached ? otPlatSettingsSet(NULL, operation->key, sValue, operation->size)
+                                    : testUncachedSet(operation->key, sValue, operation->size);
+            break;
+
+        case kTestAdd:
+            testFillValue(i);
+            result->error = aCached ? otPlatSettingsAdd(NULL, operation->key, sValue, operation->size)
+                                    : testUncachedAdd(operation->key, sValue, operation->size);
+            break;
+
+        default:
+            result->error = aCached ? otPlatSettingsDelete(NULL, operation->key, operation->index)
+                                    : testUncachedDelete(operation->key, operation->index);
+            break;
+        }
+    }
+}
+
+static double testTimeRun(bool aCached, testResult_t *aResults, testNvsStats_t *aStats)
+{
+    struct timespec start;
+    struct timespec end;
+
+    memset(sNvs, 0, sizeof(sNvs));
+    otPlatSettingsInit(NULL, NULL, 0);
+    memset(&sStats, 0, sizeof(sStats));
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    testRun(aCached, aResults);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    *aStats = sStats;
+
+    return ((double)(end.tv_sec - start.tv_sec) * 1e9 + (double)(end.tv_nsec - start.tv_nsec)) / TEST_OPERATIONS;
+}
+
+static void testPrint(const char *aName, double aTime, const testNvsStats_t *aStats)
+{
+    printf("%-8s: %6.1f ns/op, %5.2f flash reads/op, %5.2f flash writes/op, %4.2f subtree walks/op\n", aName, aTime,
+           (double)aStats->reads / TEST_OPERATIONS, (double)aStats->writes / TEST_OPERATIONS,
+           (double)aStats->walks / TEST_OPERATIONS);
+}
+
+static void testBenchmark(void)
+{
+    testNvsStats_t cachedStats;
+    testNvsStats_t uncachedStats;
+    double         cachedTime;
+    double         uncachedTime;
+
+    testGenerateOperations();
+
+    cachedTime = testTimeRun(true, sCachedResults, &cachedStats);
+    memcpy(sCachedNvs, sNvs, sizeof(sNvs));
+    uncachedTime = testTimeRun(false, sUncachedResults, &uncachedStats);
+
+    for (uint32_t i = 0; i < TEST_OPERATIONS; i++)
+    {
+        HOST_TEST_VERIFY(sCachedResults[i].error == sUncachedResults[i].error);
+        HOST_TEST_VERIFY(sCachedResults[i].length == sUncachedResults[i].length);
+        HOST_TEST_VERIFY(sCachedResults[i].sequence == sUncachedResults[i].sequence);
+    }
+
+    for (uint32_t i = 0; i < TEST_NVS_MAX_ENTRIES; i++)
+    {
+        HOST_TEST_VERIFY(sCachedNvs[i].used == sNvs[i].used);
+        HOST_TEST_VERIFY(!sNvs[i].used || (strcmp(sCachedNvs[i].name, sNvs[i].name) == 0 &&
+                                           sCachedNvs[i].length == sNvs[i].length &&
+                                           memcmp(sCachedNvs[i].value, sNvs[i].value, sNvs[i].length) == 0));
+    }
+
+    /* The cache only saves flash reads, it never changes what is written */
+    HOST_TEST_VERIFY(cachedStats.writes == uncachedStats.writes);
+    HOST_TEST_VERIFY(cachedStats.reads < uncachedStats.reads);
+
+    testPrint("cached", cachedTime, &cachedStats);
+    testPrint("uncached", uncachedTime, &uncachedStats);
+}
+
+static uint32_t testNvsCount(void)
+{
+    uint32_t count = 0;
+
+    for (uint32_t i = 0; i < TEST_NVS_MAX_ENTRIES; i++)
+    {
+        count += sNvs[i].used ? 1 : 0;
+    }
+
+    return count;
+}
+
+static void testWipe(void)
+{
+    uint16_t length = sizeof(sValue);
+
+    otPlatSettingsWipe(NULL);
+    HOST_TEST_VERIFY(testNvsCount() == 0);
+
+    /* The wipe must not leave stale indexes in the cache */
+    HOST_TEST_VERIFY(otPlatSettingsGet(NULL, sCoreKeys[0].key, 0, sValue, &length) == OT_ERROR_NOT_FOUND);
+    HOST_TEST_VERIFY(otPlatSettingsAdd(NULL, TEST_CHILD_INFO_KEY, sValue, TEST_CHILD_INFO_SIZE) == OT_ERROR_NONE);
+    HOST_TEST_VERIFY(testNvsCount() == 1 && strcmp(sNvs[0].name, "ot/5/0") == 0);
+}
+
+int main(void)
+{
+    srand(1);
+
+    testBenchmark();
+    testWipe();
+
+    printf("flash nvs: ok\n");
+    return 0;
+}
@@ -0,0 +1,314 @@
+/*
+ *  Copyright (c) 2025, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file tests and benchmarks the on-mesh prefix table of the lwIP forwarding hooks (lwip_hooks.c).
+ *
+ *   Random synthetic network data, including more prefixes or prefix lengths than the table holds, must give the
+ *   same forwarding decisions with the table as with the network data walk it replaced. The table must only change
+ *   when the network data is reported as changed. The time per lookup of both is then printed for a growing number
+ *   of /64 prefixes; build with OT_NXP_HOST_TESTS_SANITIZE=OFF for meaningful timings.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "host_test.h"
+
+#include <time.h>
+
+#include "lwip_hooks.c"
+
+#define TEST_ROUNDS 2000U
+#define TEST_ADDRESSES_PER_ROUND 200U
+#define TEST_MAX_PREFIXES 12U
+#define TEST_PREFIX_BASES 4U
+#define TEST_LOOKUPS 1000000U
+
+static otInstance          *sTestInstance = (otInstance *)&sTestInstance;
+static struct netif         sTestInfraIf;
+static struct netif         sTestThreadIf;
+static otBorderRouterConfig sNetData[TEST_MAX_PREFIXES];
+static uint32_t             sNetDataCount;
+static otMeshLocalPrefix    sMeshLocalPrefix;
+static otIp6Address         sPrefixBases[TEST_PREFIX_BASES];
+
+otError otNetDataGetNextOnMeshPrefix(otInstance            *aInstance,
+                                     otNetworkDataIterator *aIterator,
+                                     otBorderRouterConfig  *aConfig)
+{
+    HOST_TEST_VERIFY(aInstance == sTestInstance);
+
+    if (*aIterator >= sNetDataCount)
+    {
+        return OT_ERROR_NOT_FOUND;
+    }
+
+    *aConfig = sNetData[(*aIterator)++];
+    return OT_ERROR_NONE;
+}
+
+const otMeshLocalPrefix *otThreadGetMeshLocalPrefix(otInstance *aInstance)
+{
+    return &sMeshLocalPrefix;
+}
+
+otBackboneRouterState otBackboneRouterGetState(otInstance *aInstance)
+{
+    return OT_BACKBONE_ROUTER_STATE_PRIMARY;
+}
+
+bool lwipMcastFilterHas(ip6_addr_t *addr)
+{
+    return false;
+}
+
+static void testRandomBytes(uint8_t *aBytes, size_t aLength)
+{
+    for (size_t i = 0; i < aLength; i++)
+    {
+        aBytes[i] = (uint8_t)rand();
+    }
+}
+
+static uint8_t testRandomPrefixLength(void)
+{
+    unsigned draw = (unsigned)rand() % 10;
+
+    return (draw < 6) ? 64 : (draw < 8) ? 48 : (draw < 9) ? 56 : (uint8_t)(1 + (unsigned)rand() % 128);
+}
+
+static void testSetPrefix(otBorderRouterConfig *aConfig, const otIp6Address *aBase, uint8_t aLength)
+{
+    memset(aConfig, 0, sizeof(*aConfig));
+    aConfig->mPrefix.mPrefix = *aBase;
+    aConfig->mPrefix.mLength = aLength;
+    aConfig->mOnMesh         = true;
+    aConfig->mSlaac          = true;
+}
+
+/* Network data with prefixes derived from a few bases, so that they overlap and are sometimes repeated */
+static void testRandomNetData(void)
+{
+    sNetDataCount = (uint32_t)rand() % (TEST_MAX_PREFIXES + 1);
+
+    for (uint32_t i = 0; i < sNetDataCount; i++)
+    {
+        otIp6Address prefix = sPrefixBases[(unsigned)rand() % TEST_PREFIX_BASES];
+
+        /* Vary the subnet of the base, or keep it to publish the same prefix twice */
+        if (rand() % 4 != 0)
+        {
+            prefix.mFields.m8[6 + (unsigned)rand() % 2] = (uint8_t)rand();
+        }
+
+        testSetPrefix(&sNetData[i], &prefix, testRandomPrefixLength());
+        sNetData[i].mDp = (rand() % 10 == 0);
+    }
+
+    testRandomBytes(sMeshLocalPrefix.m8, sizeof(sMeshLocalPrefix.m8));
+}
+
+/* An address within a network data prefix, the mesh-local prefix, a prefix base or anywhere */
+static void testRandomAddress(ip6_addr_t *aAddress)
+{
+    unsigned draw = (unsigned)rand() % 4;
+
+    testRandomBytes((uint8_t *)aAddress->addr, sizeof(aAddress->addr));
+    aAddress->zone = IP6_NO_ZONE;
+
+    if (draw == 0 && sNetDataCount != 0)
+    {
+        const otIp6Prefix *prefix = &sNetData[(unsigned)rand() % sNetDataCount].mPrefix;
+        uint8_t           *bytes  = (uint8_t *)aAddress->addr;
+
+        memcpy(bytes, prefix->mPrefix.mFields.m8, prefix->mLength / 8U);
+        if ((prefix->mLength % 8U) != 0 && rand() % 2 == 0)
+        {
+            bytes[prefix->mLength / 8U] = prefix->mPrefix.mFields.m8[prefix->mLength / 8U];
+        }
+    }
+    else if (draw == 1)
+    {
+        memcpy(aAddress->addr, sMeshLocalPrefix.m8, sizeof(sMeshLocalPrefix.m8));
+    }
+    else if (draw == 2)
+    {
+        memcpy(aAddress->addr, sPrefixBases[(unsigned)rand() % TEST_PREFIX_BASES].mFields.m8, OT_IP6_PREFIX_SIZE);
+    }
+}
+
+/* Forwarding decision of isLegalToForward computed from the network data */
+static int testExpectedLegalToForward(const ip6_addr_t *aSrc, const ip6_addr_t *aDest, const struct netif *aNetif)
+{
+    if (aNetif == &sTestThreadIf && netDataHasOmrPrefix(aDest))
+    {
+        return 0;
+    }
+
+    if (memcmp(aSrc->addr, sMeshLocalPrefix.m8, OT_IP6_PREFIX_SIZE) == 0 ||
+        memcmp(aDest->addr, sMeshLocalPrefix.m8, OT_IP6_PREFIX_SIZE) == 0)
+    {
+        return 0;
+    }
+
+    return 1;
+}
+
+static void testRandomDecisions(void)
+{
+    uint32_t overflows = 0;
+    uint32_t matches   = 0;
+
+    for (uint32_t round = 0; round < TEST_ROUNDS; round++)
+    {
+        testRandomNetData();
+        otPlatLwipHooksUpdateState(OT_CHANGED_THREAD_NETDATA);
+        overflows += sPrefixTable.mOverflow ? 1 : 0;
+
+        for (uint32_t i = 0; i < TEST_ADDRESSES_PER_ROUND; i++)
+        {
+            struct netif *netif = (rand() % 2 == 0) ? &sTestThreadIf : &sTestInfraIf;
+            ip6_addr_t    src;
+            ip6_addr_t    dest;
+
+            testRandomAddress(&src);
+            testRandomAddress(&dest);
+
+            HOST_TEST_VERIFY(hasOmrPrefix(&dest) == netDataHasOmrPrefix(&dest));
+            HOST_TEST_VERIFY(isLegalToForward(&src, &dest, NULL, netif) ==
+                             testExpectedLegalToForward(&src, &dest, netif));
+            matches += netDataHasOmrPrefix(&dest) ? 1 : 0;
+        }
+    }
+
+    /* Both the table and its fallback to the network data walk must have been exercised */
+    HOST_TEST_VERIFY(overflows > 0 && overflows < TEST_ROUNDS);
+    HOST_TEST_VERIFY(matches > 0);
+}
+
+static void testRefreshOnNetDataChange(void)
+{
+    ip6_addr_t address;
+
+    sNetDataCount = 0;
+    otPlatLwipHooksUpdateState(OT_CHANGED_THREAD_NETDATA);
+
+    testSetPrefix(&sNetData[0], &sPrefixBases[0], 64);
+    sNetDataCount = 1;
+    memcpy(address.addr, sPrefixBases[0].mFields.m8, sizeof(address.addr));
+    address.zone = IP6_NO_ZONE;
+
+    /* Other changes keep the table, the packets keep being checked against the previous network data */
+    otPlatLwipHooksUpdateState(OT_CHANGED_THREAD_ROLE | OT_CHANGED_IP6_ADDRESS_ADDED);
+    HOST_TEST_VERIFY(!hasOmrPrefix(&address));
+
+    otPlatLwipHooksUpdateState(OT_CHANGED_THREAD_NETDATA);
+    HOST_TEST_VERIFY(hasOmrPrefix(&address));
+
+    sNetData[0].mDp = true;
+    otPlatLwipHooksUpdateState(OT_CHANGED_ACTIVE_DATASET);
+    HOST_TEST_VERIFY(!hasOmrPrefix(&address));
+
+    testRandomBytes(sMeshLocalPrefix.m8, sizeof(sMeshLocalPrefix.m8));
+    memcpy(address.addr, sMeshLocalPrefix.m8, sizeof(sMeshLocalPrefix.m8));
+    HOST_TEST_VERIFY(!hasMeshLocalPrefix(&address));
+    otPlatLwipHooksUpdateState(OT_CHANGED_THREAD_ML_ADDR);
+    HOST_TEST_VERIFY(hasMeshLocalPrefix(&address));
+}
+
+static double testTimeLookups(int (*aLookup)(const ip6_addr_t *), const ip6_addr_t *aAddresses, uint32_t aCount)
+{
+    struct timespec start;
+    struct timespec end;
+    uint32_t        found = 0;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (uint32_t i = 0; i < TEST_LOOKUPS; i++)
+    {
+        found += (uint32_t)aLookup(&aAddresses[i % aCount]);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    HOST_TEST_VERIFY(found > 0 && found < TEST_LOOKUPS);
+
+    return ((double)(end.tv_sec - start.tv_sec) * 1e9 + (double)(end.tv_nsec - start.tv_nsec)) / TEST_LOOKUPS;
+}
+
+/* Half of the packets are within a prefix, the other half miss them all which is the longest network data walk */
+static void testBenchmark(void)
+{
+    static ip6_addr_t addresses[256];
+
+    for (uint32_t prefixes = 1; prefixes <= 8; prefixes *= 2)
+    {
+        for (uint32_t i = 0; i < prefixes; i++)
+        {
+            otIp6Address prefix = sPrefixBases[0];
+
+            prefix.mFields.m8[7] = (uint8_t)i;
+            testSetPrefix(&sNetData[i], &prefix, 64);
+        }
+        sNetDataCount = prefixes;
+        otPlatLwipHooksUpdateState(OT_CHANGED_THREAD_NETDATA);
+        HOST_TEST_VERIFY(!sPrefixTable.mOverflow);
+
+        for (uint32_t i = 0; i < OT_ARRAY_LENGTH(addresses); i++)
+        {
+            testRandomBytes((uint8_t *)addresses[i].addr, sizeof(addresses[i].addr));
+            addresses[i].zone = IP6_NO_ZONE;
+            if (i % 2 == 0)
+            {
+                memcpy(addresses[i].addr, sNetData[i / 2 % prefixes].mPrefix.mPrefix.mFields.m8, OT_IP6_PREFIX_SIZE);
+            }
+        }
+
+        printf("%u /64 prefixes: network data walk %5.1f ns/lookup, prefix table %5.1f ns/lookup\n",
+               (unsigned)prefixes, testTimeLookups(netDataHasOmrPrefix, addresses, OT_ARRAY_LENGTH(addresses)),
+               testTimeLookups(hasOmrPrefix, addresses, OT_ARRAY_LENGTH(addresses)));
+    }
+}
+
+int main(void)
+{
+    srand(1);
+
+    for (uint32_t i = 0; i < TEST_PREFIX_BASES; i++)
+    {
+        testRandomBytes(sPrefixBases[i].mFields.m8, sizeof(sPrefixBases[i].mFields.m8));
+    }
+
+    lwipHooksInit(sTestInstance, &sTestInfraIf, &sTestThreadIf);
+
+    testRandomDecisions();
+    testRefreshOnNetDataChange();
+    testBenchmark();
+
+    printf("lwip hooks: ok\n");
+    return 0;
+}
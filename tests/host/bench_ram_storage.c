@@ -0,0 +1,183 @@
+/*
+ *  Copyright (c) 2025, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file benchmarks the records lookup of the RAM buffer used by the PDM settings (ram_storage.c).
+ *
+ *   It is built twice, walking the records linearly and with RAM_STORAGE_INDEX. The RAM buffer is filled with a few
+ *   thousand small records, as stored by the Matter key value store, then the same random sequence of reads and
+ *   updates is run, some of them changing the value length so that records are deleted and the buffer is compacted.
+ *   The results are checked against a copy of the values. The time per operation of the fill, the sequence and of
+ *   reading every record back is printed; build with OT_NXP_HOST_TESTS_SANITIZE=OFF for meaningful timings.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "host_test.h"
+
+#include <string.h>
+#include <time.h>
+
+#include <openthread/platform/memory.h>
+
+#include "ram_storage.h"
+
+#define TEST_BUFFER_SIZE 30000U
+#define TEST_REGION_SIZE 4096U
+#define TEST_RECORDS 2000U
+#define TEST_OPERATIONS 100000U
+#define TEST_MIN_VALUE_SIZE 6U
+#define TEST_MAX_VALUE_SIZE 10U
+
+typedef struct
+{
+    uint16_t length;
+    uint8_t  value[TEST_MAX_VALUE_SIZE];
+} testValue_t;
+
+static uint8_t     sBuffer[TEST_BUFFER_SIZE];
+static testValue_t sValues[TEST_RECORDS];
+
+#if RAM_STORAGE_INDEX
+static const char sName[] = "index";
+#else
+static const char sName[] = "linear walk";
+#endif
+
+static double testElapsed(const struct timespec *aStart, uint32_t aOperations)
+{
+    struct timespec end;
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    return ((double)(end.tv_sec - aStart->tv_sec) * 1e9 + (double)(end.tv_nsec - aStart->tv_nsec)) / aOperations;
+}
+
+/* The key of a record, spread over the key space as the Matter key value store does with its key hashes */
+static uint16_t testKey(uint16_t aRecord)
+{
+    return (uint16_t)(aRecord * 40503U);
+}
+
+static void testNewValue(testValue_t *aValue)
+{
+    aValue->length = TEST_MIN_VALUE_SIZE;
+    if (rand() % 4 == 0)
+    {
+        aValue->length += (uint16_t)(rand() % (TEST_MAX_VALUE_SIZE - TEST_MIN_VALUE_SIZE + 1));
+    }
+
+    for (uint16_t i = 0; i < aValue->length; i++)
+    {
+        aValue->value[i] = (uint8_t)rand();
+    }
+}
+
+static void testVerifyRecord(ramBufferDescriptor *aDescr, uint16_t aRecord)
+{
+    uint8_t  value[TEST_MAX_VALUE_SIZE];
+    uint16_t length = sizeof(value);
+
+    HOST_TEST_VERIFY(ramStorageGet(aDescr, testKey(aRecord), 0, value, &length) == RS_ERROR_NONE);
+    HOST_TEST_VERIFY(length == sValues[aRecord].length);
+    HOST_TEST_VERIFY(memcmp(value, sValues[aRecord].value, length) == 0);
+}
+
+int main(void)
+{
+    ramBufferDescriptor descr = {0};
+    struct timespec     start;
+    double              fillTime;
+    double              mixedTime;
+    double              readTime;
+    uint32_t            appended = 0;
+
+    srand(1);
+
+    descr.buffer                   = sBuffer;
+    descr.header.maxLength         = TEST_BUFFER_SIZE;
+    descr.header.extendedSearch    = TRUE;
+    descr.header.backendRegionSize = TEST_REGION_SIZE;
+
+    for (uint16_t record = 0; record < TEST_RECORDS; record++)
+    {
+        testNewValue(&sValues[record]);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (uint16_t record = 0; record < TEST_RECORDS; record++)
+    {
+        HOST_TEST_VERIFY(ramStorageSet(&descr, testKey(record), sValues[record].value, sValues[record].length) ==
+                         RS_ERROR_NONE);
+    }
+    fillTime = testElapsed(&start, TEST_RECORDS);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (uint32_t op = 0; op < TEST_OPERATIONS; op++)
+    {
+        uint16_t record = (uint16_t)(rand() % TEST_RECORDS);
+        uint16_t length = sValues[record].length;
+
+        if (rand() % 4 == 0)
+        {
+            testNewValue(&sValues[record]);
+            HOST_TEST_VERIFY(ramStorageSet(&descr, testKey(record), sValues[record].value, sValues[record].length) ==
+                             RS_ERROR_NONE);
+            if (sValues[record].length != length)
+            {
+                appended += sizeof(struct settingsBlock) + sValues[record].length;
+            }
+        }
+        else
+        {
+            testVerifyRecord(&descr, record);
+        }
+    }
+    mixedTime = testElapsed(&start, TEST_OPERATIONS);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (uint16_t record = 0; record < TEST_RECORDS; record++)
+    {
+        testVerifyRecord(&descr, record);
+    }
+    readTime = testElapsed(&start, TEST_RECORDS);
+
+    /* The records appended when the value length changes fill the buffer, which is compacted */
+    HOST_TEST_VERIFY(appended > TEST_BUFFER_SIZE);
+
+    printf("%s, %u records, %u bytes: fill %7.1f ns/op, 3/4 get 1/4 set %7.1f ns/op, get %7.1f ns/op\n", sName,
+           TEST_RECORDS, (unsigned)descr.header.length, fillTime, mixedTime, readTime);
+
+#if RAM_STORAGE_INDEX
+    otPlatFree(descr.header.index);
+#endif
+
+    printf("ram storage: ok\n");
+    return 0;
+}
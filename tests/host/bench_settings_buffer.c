@@ -0,0 +1,532 @@
+/*
+ *  Copyright (c) 2025, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file benchmarks the indexed settings buffer (settings_buffer.c) against the linear TLV scan it replaced in
+ *   flash_littlefs.c and flash_fsa.c.
+ *
+ *   Both layouts replay the same sequence of settings operations, modelled on a router with child churn: frequent
+ *   reads, updates of the network and parent information, and children added and removed, with a growing number of
+ *   vendor keys. Their results and their final buffers must be identical. The time per operation of the sequence, and
+ *   of reading every key back, is printed; build with OT_NXP_HOST_TESTS_SANITIZE=OFF for meaningful timings.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "host_test.h"
+
+#include <string.h>
+#include <time.h>
+
+#include "settings_buffer.h"
+
+#define TEST_OPERATIONS 200000U
+#define TEST_MAX_CHILDREN 12U
+#define TEST_CHILD_INFO_KEY 5U
+#define TEST_CHILD_INFO_SIZE 17U
+#define TEST_VENDOR_KEY_BASE 0x8000U
+#define TEST_VENDOR_VALUE_SIZE 8U
+#define TEST_MAX_VALUE_SIZE 128U
+
+/* Keys stored by the OpenThread core on a router, with typical value sizes */
+static const struct
+{
+    uint16_t key;
+    uint16_t size;
+} sCoreKeys[] = {
+    {1, 120}, {3, 38}, {4, 10}, {7, 32}, {8, 9}, {11, 121}, {12, 18}, {13, 2}, {15, 8}, {16, 26}, {17, 16},
+};
+
+#define TEST_CORE_KEY_COUNT (sizeof(sCoreKeys) / sizeof(sCoreKeys[0]))
+
+typedef enum
+{
+    kTestGet,
+    kTestSet,
+    kTestAdd,
+    kTestDelete,
+} testOperationType_t;
+
+typedef struct
+{
+    uint8_t  type;
+    uint16_t key;
+    int16_t  index;
+    uint16_t size;
+} testOperation_t;
+
+/* Outcome of an operation, compared between the two layouts */
+typedef struct
+{
+    otError  error;
+    uint16_t length;
+    uint32_t sequence;
+} testResult_t;
+
+/* Settings buffer as it was before the index: a TLV array scanned for every call, bytes moved one at a time */
+typedef struct
+{
+    uint16_t recordLen;
+    uint16_t recordFreeLen;
+    uint8_t  buffer[OT_SETTINGS_BUFFER_SIZE];
+} testScanBuffer_t;
+
+static testOperation_t    sOperations[TEST_OPERATIONS];
+static testResult_t       sScanResults[TEST_OPERATIONS];
+static testResult_t       sIndexResults[TEST_OPERATIONS];
+static testScanBuffer_t   sScanBuffer;
+static otSettingsBuffer_t sIndexBuffer;
+static otSettingsIndex_t  sIndex;
+static uint8_t            sValue[TEST_MAX_VALUE_SIZE];
+
+static void testScanReadTlv(const uint8_t *aTlv, uint16_t *aKey, uint16_t *aLength)
+{
+    memcpy(aKey, aTlv, sizeof(*aKey));
+    memcpy(aLength, aTlv + sizeof(*aKey), sizeof(*aLength));
+}
+
+static void testScanMoveData(uint8_t *pSrc, uint8_t *pDst)
+{
+    uint8_t *end = sScanBuffer.buffer + sScanBuffer.recordLen;
+
+    if (pDst > pSrc)
+    {
+        for (uint8_t *reader = end - 1; reader >= pSrc; reader--)
+        {
+            reader[pDst - pSrc] = *reader;
+        }
+        sScanBuffer.recordLen += (uint16_t)(pDst - pSrc);
+    }
+    else if (pDst < pSrc)
+    {
+        for (uint8_t *reader = pSrc, *writer = pDst; reader < end; reader++, writer++)
+        {
+            *writer = *reader;
+        }
+        sScanBuffer.recordLen -= (uint16_t)(pSrc - pDst);
+        memset(sScanBuffer.buffer + sScanBuffer.recordLen, 0, (size_t)(pSrc - pDst));
+    }
+    sScanBuffer.recordFreeLen = OT_SETTINGS_BUFFER_SIZE - sScanBuffer.recordLen;
+}
+
+static void testScanWriteTlv(uint8_t *aTlv, uint16_t aKey, const uint8_t *aValue, uint16_t aLength)
+{
+    memcpy(aTlv, &aKey, sizeof(aKey));
+    memcpy(aTlv + sizeof(aKey), &aLength, sizeof(aLength));
+    memcpy(aTlv + OT_SETTINGS_TLV_HEADER_SIZE, aValue, aLength);
+}
+
+static otError testScanGet(uint16_t aKey, int aIndex, uint8_t *aValue, uint16_t *aValueLength)
+{
+    uint8_t *iterator = sScanBuffer.buffer;
+    int      found    = 0;
+    uint16_t key;
+    uint16_t length;
+
+    while (iterator < sScanBuffer.buffer + sScanBuffer.recordLen)
+    {
+        testScanReadTlv(iterator, &key, &length);
+        if (key == aKey && found == aIndex)
+        {
+            memcpy(aValue, iterator + OT_SETTINGS_TLV_HEADER_SIZE, (*aValueLength < length) ? *aValueLength : length);
+            *aValueLength = length;
+            return OT_ERROR_NONE;
+        }
+        else if (key == aKey)
+        {
+            found++;
+        }
+        iterator += OT_SETTINGS_TLV_HEADER_SIZE + length;
+    }
+
+    return OT_ERROR_NOT_FOUND;
+}
+
+static otError testScanAdd(uint16_t aKey, const uint8_t *aValue, uint16_t aValueLength)
+{
+    uint8_t *iterator  = sScanBuffer.buffer;
+    bool     tagFound  = false;
+    bool     moveFound = false;
+    uint16_t key;
+    uint16_t length;
+
+    if (sScanBuffer.recordFreeLen < OT_SETTINGS_TLV_HEADER_SIZE + aValueLength)
+    {
+        return OT_ERROR_NO_BUFS;
+    }
+
+    while (iterator < sScanBuffer.buffer + sScanBuffer.recordLen)
+    {
+        testScanReadTlv(iterator, &key, &length);
+        if (key == aKey)
+        {
+            tagFound = true;
+        }
+        else if (tagFound)
+        {
+            moveFound = true;
+            break;
+        }
+        iterator += OT_SETTINGS_TLV_HEADER_SIZE + length;
+    }
+
+    if (moveFound)
+    {
+        testScanMoveData(iterator, iterator + OT_SETTINGS_TLV_HEADER_SIZE + aValueLength);
+    }
+    else
+    {
+        sScanBuffer.recordLen += OT_SETTINGS_TLV_HEADER_SIZE + aValueLength;
+        sScanBuffer.recordFreeLen = OT_SETTINGS_BUFFER_SIZE - sScanBuffer.recordLen;
+    }
+    testScanWriteTlv(iterator, aKey, aValue, aValueLength);
+
+    return OT_ERROR_NONE;
+}
+
+static otError testScanSet(uint16_t aKey, const uint8_t *aValue, uint16_t aValueLength)
+{
+    uint8_t *iterator  = sScanBuffer.buffer;
+    uint8_t *tagFound  = NULL;
+    bool     moveFound = false;
+    uint16_t toRemove  = 0;
+    uint16_t key;
+    uint16_t length;
+
+    while (iterator < sScanBuffer.buffer + sScanBuffer.recordLen)
+    {
+        testScanReadTlv(iterator, &key, &length);
+        if (key == aKey)
+        {
+            /* Keep the first record of the key, as the value is written in its place */
+            tagFound = (tagFound == NULL) ? iterator : tagFound;
+        }
+        else if (tagFound != NULL)
+        {
+            moveFound = true;
+            break;
+        }
+        iterator += OT_SETTINGS_TLV_HEADER_SIZE + length;
+    }
+
+    if (tagFound != NULL)
+    {
+        toRemove = (uint16_t)(iterator - tagFound);
+    }
+
+    if (sScanBuffer.recordFreeLen + toRemove < OT_SETTINGS_TLV_HEADER_SIZE + aValueLength)
+    {
+        return OT_ERROR_NO_BUFS;
+    }
+
+    if (moveFound)
+    {
+        testScanMoveData(iterator, tagFound + OT_SETTINGS_TLV_HEADER_SIZE + aValueLength);
+    }
+    else
+    {
+        sScanBuffer.recordLen = sScanBuffer.recordLen - toRemove + OT_SETTINGS_TLV_HEADER_SIZE + aValueLength;
+        sScanBuffer.recordFreeLen = OT_SETTINGS_BUFFER_SIZE - sScanBuffer.recordLen;
+    }
+
+    if (tagFound == NULL)
+    {
+        tagFound = iterator;
+    }
+    testScanWriteTlv(tagFound, aKey, aValue, aValueLength);
+
+    return OT_ERROR_NONE;
+}
+
+static otError testScanDelete(uint16_t aKey, int aIndex)
+{
+    uint8_t *iterator = sScanBuffer.buffer;
+    uint8_t *start    = NULL;
+    uint8_t *end      = NULL;
+    int      found    = 0;
+    uint16_t key;
+    uint16_t length;
+
+    while (iterator < sScanBuffer.buffer + sScanBuffer.recordLen)
+    {
+        testScanReadTlv(iterator, &key, &length);
+        if (key == aKey)
+        {
+            start = (start == NULL) ? iterator : start;
+            if (aIndex == found)
+            {
+                start = iterator;
+                end   = iterator + OT_SETTINGS_TLV_HEADER_SIZE + length;
+                break;
+            }
+            found++;
+        }
+        else if (start != NULL)
+        {
+            end = iterator;
+            break;
+        }
+        iterator += OT_SETTINGS_TLV_HEADER_SIZE + length;
+    }
+
+    if (start == NULL)
+    {
+        return OT_ERROR_NOT_FOUND;
+    }
+
+    if (end == NULL)
+    {
+        end = sScanBuffer.buffer + sScanBuffer.recordLen;
+    }
+    testScanMoveData(end, start);
+
+    return OT_ERROR_NONE;
+}
+
+/* Only the first bytes of a value change between writes, so that filling it costs little next to the operation */
+static void testFillValue(uint32_t aSequence)
+{
+    memcpy(sValue, &aSequence, sizeof(aSequence));
+}
+
+/* Settings of a router which has been running for a while: the core keys, some children and aVendorKeys keys */
+static uint16_t testInitialOperations(uint16_t aVendorKeys)
+{
+    uint16_t count = 0;
+
+    for (uint16_t i = 0; i < TEST_CORE_KEY_COUNT; i++)
+    {
+        sOperations[count++] = (testOperation_t){kTestSet, sCoreKeys[i].key, 0, sCoreKeys[i].size};
+    }
+
+    for (uint16_t i = 0; i < TEST_MAX_CHILDREN / 2; i++)
+    {
+        sOperations[count++] = (testOperation_t){kTestAdd, TEST_CHILD_INFO_KEY, 0, TEST_CHILD_INFO_SIZE};
+    }
+
+    for (uint16_t i = 0; i < aVendorKeys; i++)
+    {
+        sOperations[count++] = (testOperation_t){kTestSet, TEST_VENDOR_KEY_BASE + i, 0, TEST_VENDOR_VALUE_SIZE};
+    }
+
+    return count;
+}
+
+static void testGenerateOperations(uint16_t aVendorKeys)
+{
+    uint16_t keyCount = TEST_CORE_KEY_COUNT + aVendorKeys;
+    uint32_t children = TEST_MAX_CHILDREN / 2;
+
+    for (uint32_t i = testInitialOperations(aVendorKeys); i < TEST_OPERATIONS; i++)
+    {
+        testOperation_t *operation = &sOperations[i];
+        unsigned         draw      = (unsigned)rand() % 100;
+        uint16_t         slot      = (uint16_t)((unsigned)rand() % keyCount);
+
+        operation->key   = (slot < TEST_CORE_KEY_COUNT) ? sCoreKeys[slot].key
+                                                               : TEST_VENDOR_KEY_BASE + slot - TEST_CORE_KEY_COUNT;
+        operation->size  = (slot < TEST_CORE_KEY_COUNT) ? sCoreKeys[slot].size : TEST_VENDOR_VALUE_SIZE;
+        operation->index = 0;
+
+        if (draw < 50)
+        {
+            operation->type = kTestGet;
+            if (draw < 20)
+            {
+                operation->key   = TEST_CHILD_INFO_KEY;
+                operation->index = (int16_t)((unsigned)rand() % TEST_MAX_CHILDREN);
+            }
+        }
+        else if (draw < 70)
+        {
+            operation->type = kTestSet;
+        }
+        else if (draw < 85 && children < TEST_MAX_CHILDREN)
+        {
+            operation->type = kTestAdd;
+            operation->key  = TEST_CHILD_INFO_KEY;
+            operation->size = TEST_CHILD_INFO_SIZE;
+            children++;
+        }
+        else if (children > 0)
+        {
+            operation->type  = kTestDelete;
+            operation->key   = TEST_CHILD_INFO_KEY;
+            operation->index = (int16_t)((unsigned)rand() % children);
+            children--;
+        }
+        else
+        {
+            operation->type = kTestGet;
+        }
+    }
+}
+
+static void testRun(bool aIndexed, testResult_t *aResults)
+{
+    for (uint32_t i = 0; i < TEST_OPERATIONS; i++)
+    {
+        const testOperation_t *operation = &sOperations[i];
+        testResult_t          *result    = &aResults[i];
+        uint8_t                value[TEST_MAX_VALUE_SIZE];
+
+        result->length   = 0;
+        result->sequence = 0;
+
+        switch (operation->type)
+        {
+        case kTestGet:
+            result->length = sizeof(value);
+            result->error  = aIndexed ? settingsBufferGet(&sIndexBuffer, &sIndex, operation->key, operation->index,
+                                                          value, &result->length)
+                                      : testScanGet(operation->key, operation->index, value, &result->length);
+            if (result->error == OT_ERROR_NONE)
+            {
+                memcpy(&result->sequence, value,
+                       (result->length < sizeof(result->sequence)) ? result->length : sizeof(result->sequence));
+            }
+            break;
+
+        case kTestSet:
+            testFillValue(i);
+            result->error =
+                aIndexed ? settingsBufferSet(&sIndexBuffer, &sIndex, operation->key, sValue, operation->size)
+                         : testScanSet(operation->key, sValue, operation->size);
+            break;
+
+        case kTestAdd:
+            testFillValue(i);
+            result->error =
+                aIndexed ? settingsBufferAdd(&sIndexBuffer, &sIndex, operation->key, sValue, operation->size)
+                         : testScanAdd(operation->key, sValue, operation->size);
+            break;
+
+        default:
+            result->error = aIndexed ? settingsBufferDelete(&sIndexBuffer, &sIndex, operation->key, operation->index)
+                                     : testScanDelete(operation->key, operation->index);
+            break;
+        }
+    }
+}
+
+/* Read back the key of every operation from the final settings, returns the sum of the lengths read */
+static uint32_t testReadAll(bool aIndexed)
+{
+    uint32_t total = 0;
+
+    for (uint32_t i = 0; i < TEST_OPERATIONS; i++)
+    {
+        const testOperation_t *operation = &sOperations[i];
+        uint8_t                value[TEST_MAX_VALUE_SIZE];
+        uint16_t               length = sizeof(value);
+        otError                error;
+
+        error = aIndexed ? settingsBufferGet(&sIndexBuffer, &sIndex, operation->key, operation->index, value, &length)
+                         : testScanGet(operation->key, operation->index, value, &length);
+        total += (error == OT_ERROR_NONE) ? length : 0;
+    }
+
+    return total;
+}
+
+static double testElapsed(const struct timespec *aStart)
+{
+    struct timespec end;
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    return ((double)(end.tv_sec - aStart->tv_sec) * 1e9 + (double)(end.tv_nsec - aStart->tv_nsec)) / TEST_OPERATIONS;
+}
+
+static void testBenchmark(uint16_t aVendorKeys)
+{
+    struct timespec start;
+    double          scanTime;
+    double          indexTime;
+    double          scanReadTime;
+    double          indexReadTime;
+    uint32_t        scanRead;
+    uint32_t        indexRead;
+
+    testGenerateOperations(aVendorKeys);
+
+    memset(&sScanBuffer, 0, sizeof(sScanBuffer));
+    sScanBuffer.recordFreeLen = OT_SETTINGS_BUFFER_SIZE;
+    settingsBufferReset(&sIndexBuffer, &sIndex);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    testRun(false, sScanResults);
+    scanTime = testElapsed(&start);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    testRun(true, sIndexResults);
+    indexTime = testElapsed(&start);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    scanRead     = testReadAll(false);
+    scanReadTime = testElapsed(&start);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    indexRead     = testReadAll(true);
+    indexReadTime = testElapsed(&start);
+
+    for (uint32_t i = 0; i < TEST_OPERATIONS; i++)
+    {
+        HOST_TEST_VERIFY(sScanResults[i].error == sIndexResults[i].error);
+        HOST_TEST_VERIFY(sScanResults[i].length == sIndexResults[i].length);
+        HOST_TEST_VERIFY(sScanResults[i].sequence == sIndexResults[i].sequence);
+    }
+
+    HOST_TEST_VERIFY(sScanBuffer.recordLen == sIndexBuffer.recordLen);
+    HOST_TEST_VERIFY(memcmp(sScanBuffer.buffer, sIndexBuffer.buffer, OT_SETTINGS_BUFFER_SIZE) == 0);
+    HOST_TEST_VERIFY(scanRead == indexRead);
+
+    printf("%2u keys, %3u bytes: mixed linear scan %6.1f ns/op, index %6.1f ns/op; "
+           "get linear scan %6.1f ns/op, index %6.1f ns/op\n",
+           (unsigned)sIndex.keyCount, (unsigned)sIndexBuffer.recordLen, scanTime, indexTime, scanReadTime,
+           indexReadTime);
+}
+
+int main(void)
+{
+    srand(1);
+
+    for (uint16_t i = 0; i < sizeof(sValue); i++)
+    {
+        sValue[i] = (uint8_t)(i * 31U);
+    }
+
+    for (uint16_t vendorKeys = 0; vendorKeys <= 16; vendorKeys += 8)
+    {
+        testBenchmark(vendorKeys);
+    }
+
+    printf("settings buffer: ok\n");
+    return 0;
+}
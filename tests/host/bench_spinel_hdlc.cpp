@@ -0,0 +1,592 @@
+/*
+ *  Copyright (c) 2025, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file tests and benchmarks the RX path of the HDLC spinel interface (spinel_hdlc.cpp).
+ *
+ *   The lock-free frame ring must hand every frame over intact and in order between a producer and a consumer
+ *   thread, including the frames which don't fit at the end of the ring. Through the whole interface, HDLC chunks
+ *   decoded by a producer thread must reach the receive callback without any loss while the producer obeys the RX
+ *   flow control. When it doesn't, as on the platforms without flow control, the producer must never block and every
+ *   lost frame must be counted as an overrun. The time to hand the decoded frames over to the OpenThread RX frame
+ *   buffer is then compared with the byte per byte copy it replaced; build with OT_NXP_HOST_TESTS_SANITIZE=OFF for
+ *   meaningful timings.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "host_test.h"
+
+#include <atomic>
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+#include <time.h>
+
+#include "fsl_common.h"
+#include "spinel_hdlc.hpp"
+
+#define TEST_RING_FRAMES 50000U
+#define TEST_RX_FRAMES 50000U
+#define TEST_RX_MIN_LENGTH 5U
+#define TEST_RX_MAX_LENGTH 200U
+#define TEST_RX_MAX_CHUNK 64U
+#define TEST_CORRUPT_PERIOD 97U
+#define TEST_BENCH_ROUNDS 5000U
+#define TEST_BENCH_BATCH_SIZE 2048U
+
+using namespace ot;
+using namespace ot::NXP;
+
+typedef Spinel::SpinelInterface::RxFrameBuffer             TestRxFrameBuffer;
+typedef Spinel::FrameBuffer<2 * SPINEL_FRAME_MAX_SIZE + 8> TestEncodedFrame;
+
+DWT_Type       hostTestDwt;
+CoreDebug_Type hostTestCoreDebug;
+uint32_t       SystemCoreClock = 1000000U;
+
+static pthread_mutex_t             sCriticalSection = PTHREAD_MUTEX_INITIALIZER;
+static platform_hdlc_rx_callback_t sHdlcRxCallback;
+static void                       *sHdlcRxCallbackParam;
+static std::atomic<bool>           sRxFlowStopped(false);
+static std::atomic<bool>           sProducerDone(false);
+static std::atomic<uint32_t>       sProducedBytes(0);
+static uint16_t                    sFrameMinLength;
+static uint16_t                    sFrameMaxLength;
+static bool                        sObeyFlowControl;
+static bool                        sCorruptFrames;
+static uint32_t                    sNextSeq;
+static uint32_t                    sReceivedCount;
+static uint32_t                    sBenchBytes;
+static bool                        sBenchVerify;
+static Url::Url                    sRadioUrl;
+static TestRxFrameBuffer           sRxFrameBuffer;
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void)
+{
+    return &sCriticalSection;
+}
+
+void vPortEnterCritical(void)
+{
+    pthread_mutex_lock(&sCriticalSection);
+}
+
+void vPortExitCritical(void)
+{
+    pthread_mutex_unlock(&sCriticalSection);
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void)
+{
+    return &sCriticalSection;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t xSemaphore, TickType_t xBlockTime)
+{
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t xSemaphore)
+{
+    return pdTRUE;
+}
+
+EventGroupHandle_t xEventGroupCreate(void)
+{
+    return &sCriticalSection;
+}
+
+EventBits_t xEventGroupSetBits(EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet)
+{
+    return uxBitsToSet;
+}
+
+EventBits_t xEventGroupWaitBits(EventGroupHandle_t xEventGroup,
+                                const EventBits_t  uxBitsToWaitFor,
+                                const BaseType_t   xClearOnExit,
+                                const BaseType_t   xWaitForAllBits,
+                                TickType_t         xTicksToWait)
+{
+    return 0;
+}
+
+int PLATFORM_InitHdlcInterface(platform_hdlc_rx_callback_t callback, void *param)
+{
+    sHdlcRxCallback      = callback;
+    sHdlcRxCallbackParam = param;
+    return 0;
+}
+
+int PLATFORM_TerminateHdlcInterface(void)
+{
+    sHdlcRxCallback = NULL;
+    return 0;
+}
+
+int PLATFORM_SendHdlcMessage(uint8_t *msg, uint32_t len)
+{
+    return 0;
+}
+
+void otSysEventSetPending(otSysEvent aEvent)
+{
+}
+
+void otTaskletsSignalPending(otInstance *aInstance)
+{
+}
+
+void otPlatSpinelHdlcRxFlowControl(bool aStop)
+{
+    sRxFlowStopped.store(aStop);
+}
+
+static uint16_t testFrameLength(uint32_t aSeq)
+{
+    return (uint16_t)(sFrameMinLength + ((aSeq * 2654435761U) >> 8) % (sFrameMaxLength - sFrameMinLength + 1U));
+}
+
+/* The frames carry their sequence number, their content and length are derived from it */
+static void testFillFrame(uint8_t *aFrame, uint32_t aSeq)
+{
+    uint16_t length = testFrameLength(aSeq);
+
+    aFrame[0] = SPINEL_HEADER_FLAG;
+    memcpy(&aFrame[1], &aSeq, sizeof(aSeq));
+    for (uint16_t i = 1 + sizeof(aSeq); i < length; i++)
+    {
+        aFrame[i] = (uint8_t)(aSeq + i * 7U);
+    }
+}
+
+static uint32_t testVerifyFrame(const uint8_t *aFrame, uint16_t aLength)
+{
+    uint8_t  expected[SPINEL_FRAME_MAX_SIZE];
+    uint32_t seq;
+
+    HOST_TEST_VERIFY(aLength >= 1 + sizeof(seq));
+    memcpy(&seq, &aFrame[1], sizeof(seq));
+    HOST_TEST_VERIFY(aLength == testFrameLength(seq));
+    testFillFrame(expected, seq);
+    HOST_TEST_VERIFY(memcmp(aFrame, expected, aLength) == 0);
+
+    return seq;
+}
+
+static void testEncodeFrame(TestEncodedFrame &aEncoded, uint32_t aSeq)
+{
+    Hdlc::Encoder encoder(aEncoded);
+    uint8_t       frame[SPINEL_FRAME_MAX_SIZE];
+
+    testFillFrame(frame, aSeq);
+    aEncoded.Clear();
+    HOST_TEST_VERIFY(encoder.BeginFrame() == OT_ERROR_NONE);
+    HOST_TEST_VERIFY(encoder.Encode(frame, testFrameLength(aSeq)) == OT_ERROR_NONE);
+    HOST_TEST_VERIFY(encoder.EndFrame() == OT_ERROR_NONE);
+}
+
+static bool testIsCorrupted(uint32_t aSeq)
+{
+    return sCorruptFrames && (aSeq % TEST_CORRUPT_PERIOD == TEST_CORRUPT_PERIOD - 1);
+}
+
+static void *testRingProducer(void *aArg)
+{
+    RxFrameRing *ring = static_cast<RxFrameRing *>(aArg);
+    uint8_t      frame[SPINEL_FRAME_MAX_SIZE];
+    uint32_t     seq = 0;
+
+    while (seq < TEST_RING_FRAMES)
+    {
+        uint16_t length = testFrameLength(seq);
+        uint16_t i;
+
+        testFillFrame(frame, seq);
+        ring->PrepareFrame();
+        for (i = 0; (i < length) && (ring->WriteByte(frame[i]) == OT_ERROR_NONE); i++)
+        {
+        }
+
+        if (i == length)
+        {
+            ring->SaveFrame(seq++);
+        }
+        else
+        {
+            /* The ring is full, as the HDLC decoder does the frame is dropped and sent again */
+            ring->DiscardFrame();
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+/* Frames up to the max spinel frame size through the bare ring, the ones which don't fit are retried */
+static void testRingStress(void)
+{
+    static RxFrameRing ring;
+    pthread_t          producer;
+    const uint8_t     *lastFrame = NULL;
+    uint32_t           wraps     = 0;
+    uint32_t           seq       = 0;
+
+    sFrameMinLength = TEST_RX_MIN_LENGTH;
+    sFrameMaxLength = SPINEL_FRAME_MAX_SIZE;
+    ring.Clear();
+
+    HOST_TEST_VERIFY(pthread_create(&producer, NULL, testRingProducer, &ring) == 0);
+
+    while (seq < TEST_RING_FRAMES)
+    {
+        const uint8_t *frame;
+        uint16_t       length;
+        uint32_t       timestamp;
+
+        HOST_TEST_VERIFY(ring.GetFillLevel() < RxFrameRing::GetSize());
+
+        if (ring.PeekFrame(frame, length, timestamp) != OT_ERROR_NONE)
+        {
+            sched_yield();
+            continue;
+        }
+
+        HOST_TEST_VERIFY(timestamp == seq);
+        HOST_TEST_VERIFY(testVerifyFrame(frame, length) == seq);
+        HOST_TEST_VERIFY(frame + length <= lastFrame || frame > lastFrame);
+        wraps += (frame < lastFrame) ? 1 : 0;
+        lastFrame = frame;
+        ring.ReleaseFrame();
+        seq++;
+    }
+
+    HOST_TEST_VERIFY(pthread_join(producer, NULL) == 0);
+
+    {
+        const uint8_t *frame;
+        uint16_t       length;
+        uint32_t       timestamp;
+
+        HOST_TEST_VERIFY(ring.PeekFrame(frame, length, timestamp) == OT_ERROR_NOT_FOUND);
+    }
+    HOST_TEST_VERIFY(ring.GetFillLevel() == 0);
+    HOST_TEST_VERIFY(wraps > 0);
+}
+
+static void testHandleReceivedFrame(void *aContext)
+{
+    TestRxFrameBuffer *rxFrameBuffer = static_cast<TestRxFrameBuffer *>(aContext);
+    uint32_t           seq           = testVerifyFrame(rxFrameBuffer->GetFrame(), rxFrameBuffer->GetLength());
+
+    HOST_TEST_VERIFY(seq >= sNextSeq);
+    for (uint32_t skipped = sNextSeq; sObeyFlowControl && (skipped < seq); skipped++)
+    {
+        HOST_TEST_VERIFY(testIsCorrupted(skipped));
+    }
+
+    sNextSeq = seq + 1;
+    sReceivedCount++;
+
+    /* As RadioSpinel does once it has processed the frame */
+    rxFrameBuffer->Clear();
+}
+
+static void *testRxProducer(void *aArg)
+{
+    static TestEncodedFrame encoded;
+    unsigned int            seed = 1;
+
+    for (uint32_t seq = 0; seq < TEST_RX_FRAMES; seq++)
+    {
+        uint16_t length;
+
+        testEncodeFrame(encoded, seq);
+        length = encoded.GetLength();
+
+        if (testIsCorrupted(seq))
+        {
+            /* The spinel header is never escaped, flipping a bit of it only breaks the FCS */
+            encoded.GetFrame()[1] ^= 1;
+        }
+
+        /* The frames are split in random chunks as the UART driver does */
+        for (uint16_t offset = 0, chunk; offset < length; offset += chunk)
+        {
+            chunk = (uint16_t)(1 + rand_r(&seed) % TEST_RX_MAX_CHUNK);
+            if (chunk > length - offset)
+            {
+                chunk = length - offset;
+            }
+
+            while (sObeyFlowControl && sRxFlowStopped.load())
+            {
+                sched_yield();
+            }
+
+            sHdlcRxCallback(encoded.GetFrame() + offset, chunk, sHdlcRxCallbackParam);
+            sProducedBytes.fetch_add(chunk);
+        }
+    }
+
+    sProducerDone.store(true);
+
+    return NULL;
+}
+
+/* Stall the consumer until the producer stops on the flow control, or has fed several times the ring size */
+static void testStallConsumer(void)
+{
+    uint32_t start = sProducedBytes.load();
+
+    while (!sProducerDone.load() && (sObeyFlowControl ? !sRxFlowStopped.load()
+                                                      : (sProducedBytes.load() - start < 3 * RxFrameRing::GetSize())))
+    {
+        sched_yield();
+    }
+}
+
+/* The producer decodes the HDLC chunks while the consumer, regularly stalled, runs the ot task processing */
+static void testRxPath(bool aObeyFlowControl)
+{
+    HdlcInterface *interface = new HdlcInterface(sRadioUrl);
+    pthread_t      producer;
+    uint32_t       corrupted = 0;
+
+    sFrameMinLength  = TEST_RX_MIN_LENGTH;
+    sFrameMaxLength  = TEST_RX_MAX_LENGTH;
+    sObeyFlowControl = aObeyFlowControl;
+    sCorruptFrames   = aObeyFlowControl;
+    sNextSeq         = 0;
+    sReceivedCount   = 0;
+    sRxFlowStopped.store(false);
+    sProducerDone.store(false);
+    sProducedBytes.store(0);
+    sRxFrameBuffer.Clear();
+
+    HOST_TEST_VERIFY(interface->Init(testHandleReceivedFrame, &sRxFrameBuffer, sRxFrameBuffer) == OT_ERROR_NONE);
+    HOST_TEST_VERIFY(pthread_create(&producer, NULL, testRxProducer, NULL) == 0);
+
+    for (uint32_t loops = 1; !sProducerDone.load(); loops++)
+    {
+        interface->Process(NULL);
+        if (loops % 64 == 0)
+        {
+            testStallConsumer();
+        }
+    }
+
+    HOST_TEST_VERIFY(pthread_join(producer, NULL) == 0);
+    interface->Process(NULL);
+
+    for (uint32_t seq = 0; seq < TEST_RX_FRAMES; seq++)
+    {
+        corrupted += testIsCorrupted(seq) ? 1 : 0;
+    }
+
+    if (aObeyFlowControl)
+    {
+        HOST_TEST_VERIFY(interface->GetRxStats().mOverrunCount == 0);
+        HOST_TEST_VERIFY(interface->GetRxStats().mHighWatermarkCount > 0);
+        HOST_TEST_VERIFY(sReceivedCount == TEST_RX_FRAMES - corrupted);
+        HOST_TEST_VERIFY(!sRxFlowStopped.load());
+    }
+    else
+    {
+        HOST_TEST_VERIFY(interface->GetRxStats().mOverrunCount > 0);
+        HOST_TEST_VERIFY(sReceivedCount + interface->GetRxStats().mOverrunCount == TEST_RX_FRAMES);
+    }
+    HOST_TEST_VERIFY(interface->GetRxStats().mMaxFillLevel < RxFrameRing::GetSize());
+
+    fprintf(stderr, "flow control %s: %u frames received, %u overruns, %u high watermarks, max fill level %u\n",
+            aObeyFlowControl ? "obeyed" : "ignored", (unsigned)sReceivedCount,
+            (unsigned)interface->GetRxStats().mOverrunCount, (unsigned)interface->GetRxStats().mHighWatermarkCount,
+            (unsigned)interface->GetRxStats().mMaxFillLevel);
+
+    interface->Deinit();
+    delete interface;
+}
+
+static RxFrameRing            sRefRing;
+static Hdlc::Decoder          sRefDecoder;
+static SpinelRoundTripTracker sRefRoundTrip;
+static LatencyHistogram       sRefRxToCallbackLatency;
+
+static void testHandleBenchFrame(void *aContext)
+{
+    TestRxFrameBuffer *rxFrameBuffer = static_cast<TestRxFrameBuffer *>(aContext);
+
+    if (sBenchVerify)
+    {
+        HOST_TEST_VERIFY(testVerifyFrame(rxFrameBuffer->GetFrame(), rxFrameBuffer->GetLength()) == sNextSeq++);
+    }
+
+    sBenchBytes += rxFrameBuffer->GetLength();
+    rxFrameBuffer->Clear();
+}
+
+static void testRefHandleHdlcFrame(void *aContext, otError aError)
+{
+    HOST_TEST_VERIFY(aError == OT_ERROR_NONE);
+    sRefRing.SaveFrame(LatencyHistogram::GetTimestamp());
+}
+
+/* Copy of TryReadAndDecode with the byte per byte copy to the RX frame buffer it used before */
+static uint32_t testByteCopyReadAndDecode(TestRxFrameBuffer &aRxFrameBuffer)
+{
+    uint32_t       totalBytesRead = 0;
+    const uint8_t *frame;
+    uint16_t       frameLen;
+    uint32_t       frameTimestamp;
+
+    while (sRefRing.PeekFrame(frame, frameLen, frameTimestamp) == OT_ERROR_NONE)
+    {
+        uint16_t i;
+
+        sRefRoundTrip.HandleFrameReceived(frame, frameLen, frameTimestamp);
+
+        for (i = 0; i < frameLen; i++)
+        {
+            if (aRxFrameBuffer.WriteByte(frame[i]) != OT_ERROR_NONE)
+            {
+                aRxFrameBuffer.UndoLastWrites(i);
+                break;
+            }
+        }
+        if (i < frameLen)
+        {
+            break;
+        }
+
+        sRefRing.ReleaseFrame();
+        totalBytesRead += frameLen;
+        sRefRxToCallbackLatency.RecordSince(frameTimestamp);
+        testHandleBenchFrame(&aRxFrameBuffer);
+    }
+
+    return totalBytesRead;
+}
+
+static double testElapsedNs(const struct timespec &aStart, const struct timespec &aEnd)
+{
+    return (double)(aEnd.tv_sec - aStart.tv_sec) * 1e9 + (double)(aEnd.tv_nsec - aStart.tv_nsec);
+}
+
+/* Only the hand-over of the decoded frames from the ring to the RX frame buffer is timed */
+static void testBenchmark(uint16_t aMinLength, uint16_t aMaxLength)
+{
+    static uint8_t          batch[2 * TEST_BENCH_BATCH_SIZE + 2 * SPINEL_FRAME_MAX_SIZE];
+    static TestEncodedFrame encoded;
+    HdlcInterface          *interface  = new HdlcInterface(sRadioUrl);
+    uint16_t                batchLength = 0;
+    uint32_t                frames      = 0;
+    uint32_t                decoded     = 0;
+    double                  blockNs     = 0;
+    double                  byteNs      = 0;
+    uint32_t                blockBytes;
+
+    sFrameMinLength = aMinLength;
+    sFrameMaxLength = aMaxLength;
+
+    /* As many frames as fit in half of the ring, so that the flow control never kicks in */
+    while (decoded + testFrameLength(frames) <= TEST_BENCH_BATCH_SIZE)
+    {
+        testEncodeFrame(encoded, frames);
+        memcpy(&batch[batchLength], encoded.GetFrame(), encoded.GetLength());
+        batchLength += encoded.GetLength();
+        decoded += testFrameLength(frames++);
+    }
+
+    sRxFrameBuffer.Clear();
+    HOST_TEST_VERIFY(interface->Init(testHandleBenchFrame, &sRxFrameBuffer, sRxFrameBuffer) == OT_ERROR_NONE);
+    sRefRing.Clear();
+    sRefDecoder.Init(sRefRing, testRefHandleHdlcFrame, NULL);
+
+    sBenchBytes = 0;
+    for (uint32_t round = 0; round < TEST_BENCH_ROUNDS; round++)
+    {
+        struct timespec start;
+        struct timespec end;
+
+        sBenchVerify = (round == 0);
+        sNextSeq     = 0;
+
+        interface->ProcessRxData(batch, batchLength);
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        interface->Process(NULL);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        blockNs += testElapsedNs(start, end);
+
+        HOST_TEST_VERIFY(!sBenchVerify || sNextSeq == frames);
+    }
+    blockBytes = sBenchBytes;
+
+    sBenchBytes = 0;
+    for (uint32_t round = 0; round < TEST_BENCH_ROUNDS; round++)
+    {
+        struct timespec start;
+        struct timespec end;
+
+        sBenchVerify = (round == 0);
+        sNextSeq     = 0;
+
+        sRefRing.PrepareFrame();
+        sRefDecoder.Decode(batch, batchLength);
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        testByteCopyReadAndDecode(sRxFrameBuffer);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        byteNs += testElapsedNs(start, end);
+
+        HOST_TEST_VERIFY(!sBenchVerify || sNextSeq == frames);
+    }
+
+    HOST_TEST_VERIFY(blockBytes == decoded * TEST_BENCH_ROUNDS);
+    HOST_TEST_VERIFY(sBenchBytes == blockBytes);
+    HOST_TEST_VERIFY(interface->GetRxStats().mOverrunCount == 0);
+
+    printf("%u-%u byte frames: byte copy %6.2f bytes/ns, block copy %6.2f bytes/ns\n", (unsigned)aMinLength,
+           (unsigned)aMaxLength, blockBytes / byteNs, blockBytes / blockNs);
+
+    interface->Deinit();
+    delete interface;
+}
+
+int main(void)
+{
+    srand(1);
+
+    testRingStress();
+    testRxPath(true);
+    testRxPath(false);
+    testBenchmark(TEST_RX_MIN_LENGTH, 127);
+    testBenchmark(1000, SPINEL_FRAME_MAX_SIZE);
+
+    printf("spinel hdlc: ok\n");
+    return 0;
+}
@@ -0,0 +1,232 @@
+/*
+ *  Copyright (c) 2025, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the OpenThread and SDK framework APIs used by the platform code under test.
+ */
+
+#include "host_test.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fsl_component_generic_list.h"
+
+#include <openthread/cli.h>
+#include <openthread/ip6.h>
+#include <openthread/platform/memory.h>
+
+/* Largest message, an IPv6 datagram with room for a translated IPv4 header */
+#define HOST_MESSAGE_CAPACITY 1300
+
+struct otMessage
+{
+    uint16_t mLength;
+    uint8_t  mData[HOST_MESSAGE_CAPACITY];
+};
+
+static unsigned sMessageCount;
+static unsigned sCAllocCount;
+
+void otCliOutputFormat(const char *aFmt, ...)
+{
+    va_list args;
+
+    va_start(args, aFmt);
+    vprintf(aFmt, args);
+    va_end(args);
+}
+
+void *otPlatCAlloc(size_t aNum, size_t aSize)
+{
+    void *ptr = calloc(aNum, aSize);
+
+    if (ptr != NULL)
+    {
+        sCAllocCount++;
+    }
+
+    return ptr;
+}
+
+void otPlatFree(void *aPtr)
+{
+    if (aPtr != NULL)
+    {
+        free(aPtr);
+        sCAllocCount--;
+    }
+}
+
+unsigned hostTestCAllocCount(void)
+{
+    return sCAllocCount;
+}
+
+unsigned hostTestMessageCount(void)
+{
+    return sMessageCount;
+}
+
+otMessage *otIp6NewMessage(otInstance *aInstance, const otMessageSettings *aSettings)
+{
+    otMessage *message = (otMessage *)calloc(1, sizeof(otMessage));
+
+    OT_UNUSED_VARIABLE(aInstance);
+    OT_UNUSED_VARIABLE(aSettings);
+
+    HOST_TEST_VERIFY(message != NULL);
+    sMessageCount++;
+
+    return message;
+}
+
+void otMessageFree(otMessage *aMessage)
+{
+    if (aMessage != NULL)
+    {
+        free(aMessage);
+        sMessageCount--;
+    }
+}
+
+uint16_t otMessageGetLength(const otMessage *aMessage)
+{
+    return aMessage->mLength;
+}
+
+otError otMessageSetLength(otMessage *aMessage, uint16_t aLength)
+{
+    otError error = OT_ERROR_NO_BUFS;
+
+    if (aLength <= HOST_MESSAGE_CAPACITY)
+    {
+        aMessage->mLength = aLength;
+        error             = OT_ERROR_NONE;
+    }
+
+    return error;
+}
+
+otError otMessageAppend(otMessage *aMessage, const void *aBuf, uint16_t aLength)
+{
+    uint16_t offset = aMessage->mLength;
+    otError  error  = otMessageSetLength(aMessage, (uint16_t)(offset + aLength));
+
+    if (error == OT_ERROR_NONE)
+    {
+        memcpy(&aMessage->mData[offset], aBuf, aLength);
+    }
+
+    return error;
+}
+
+uint16_t otMessageRead(const otMessage *aMessage, uint16_t aOffset, void *aBuf, uint16_t aLength)
+{
+    uint16_t length = 0;
+
+    if (aOffset < aMessage->mLength)
+    {
+        length = (uint16_t)(aMessage->mLength - aOffset);
+        length = (aLength < length) ? aLength : length;
+        memcpy(aBuf, &aMessage->mData[aOffset], length);
+    }
+
+    return length;
+}
+
+int otMessageWrite(otMessage *aMessage, uint16_t aOffset, const void *aBuf, uint16_t aLength)
+{
+    HOST_TEST_VERIFY((uint32_t)aOffset + aLength <= aMessage->mLength);
+    memcpy(&aMessage->mData[aOffset], aBuf, aLength);
+
+    return aLength;
+}
+
+bool otIp6IsAddressUnspecified(const otIp6Address *aAddress)
+{
+    static const otIp6Address kUnspecified = {{{0}}};
+
+    return memcmp(aAddress, &kUnspecified, sizeof(kUnspecified)) == 0;
+}
+
+void LIST_Init(list_handle_t list, uint32_t max)
+{
+    memset(list, 0, sizeof(*list));
+    list->max = max;
+}
+
+list_status_t LIST_AddTail(list_handle_t list, list_element_handle_t element)
+{
+    list_status_t status = kLIST_Full;
+
+    if ((list->max == 0) || (list->size < list->max))
+    {
+        element->next = NULL;
+        element->prev = list->tail;
+        element->list = list;
+        if (list->tail == NULL)
+        {
+            list->head = element;
+        }
+        else
+        {
+            list->tail->next = element;
+        }
+        list->tail = element;
+        list->size++;
+        status = kLIST_Ok;
+    }
+
+    return status;
+}
+
+list_element_handle_t LIST_RemoveHead(list_handle_t list)
+{
+    list_element_handle_t element = list->head;
+
+    if (element != NULL)
+    {
+        list->head = element->next;
+        if (list->head == NULL)
+        {
+            list->tail = NULL;
+        }
+        else
+        {
+            list->head->prev = NULL;
+        }
+        element->list = NULL;
+        list->size--;
+    }
+
+    return element;
+}
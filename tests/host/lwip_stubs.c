@@ -0,0 +1,365 @@
+/*
+ *  Copyright (c) 2025, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the lwIP APIs used by the platform code under test.
+ *
+ *   The pbufs are allocated from the heap and counted, so that a test can check that the code under test frees all
+ *   of them. A PBUF_POOL pbuf larger than PBUF_POOL_BUFSIZE is a chain, as with the lwIP pool.
+ */
+
+#include "host_test.h"
+
+#include <string.h>
+
+#include "common/code_utils.hpp"
+#include "lwip/ip.h"
+#include "lwip/memp.h"
+#include "lwip/mld6.h"
+#include "lwip/tcpip.h"
+#include "lwip/udp.h"
+
+struct netif     *netif_list;
+struct ip_globals ip_data;
+
+static unsigned sPbufCount;
+static u8_t     sNetifCount;
+
+static struct pbuf *allocSegment(u16_t length, pbuf_type type)
+{
+    struct pbuf *p = (struct pbuf *)calloc(1, sizeof(struct pbuf) + length);
+
+    HOST_TEST_VERIFY(p != NULL);
+    p->payload       = (uint8_t *)(p + 1);
+    p->len           = length;
+    p->tot_len       = length;
+    p->type_internal = (u8_t)type;
+    p->ref           = 1;
+    sPbufCount++;
+
+    return p;
+}
+
+unsigned hostTestPbufCount(void)
+{
+    return sPbufCount;
+}
+
+struct pbuf *pbuf_alloc(pbuf_layer layer, u16_t length, pbuf_type type)
+{
+    struct pbuf *head = NULL;
+    struct pbuf *tail = NULL;
+    u16_t        remaining;
+
+    LWIP_UNUSED_ARG(layer);
+
+    if (type != PBUF_POOL)
+    {
+        return allocSegment(length, type);
+    }
+
+    remaining = length;
+    do
+    {
+        u16_t        segmentLength = (remaining > PBUF_POOL_BUFSIZE) ? PBUF_POOL_BUFSIZE : remaining;
+        struct pbuf *segment       = allocSegment(segmentLength, type);
+
+        segment->tot_len = remaining;
+        if (tail == NULL)
+        {
+            head = segment;
+        }
+        else
+        {
+            tail->next = segment;
+        }
+        tail = segment;
+        remaining -= segmentLength;
+    } while (remaining > 0);
+
+    return head;
+}
+
+u8_t pbuf_free(struct pbuf *p)
+{
+    u8_t count = 0;
+
+    while (p != NULL)
+    {
+        struct pbuf *next = p->next;
+
+        HOST_TEST_VERIFY(p->ref > 0);
+        if (--p->ref > 0)
+        {
+            break;
+        }
+        free(p);
+        sPbufCount--;
+        count++;
+        p = next;
+    }
+
+    return count;
+}
+
+void pbuf_ref(struct pbuf *p)
+{
+    p->ref++;
+}
+
+struct pbuf *pbuf_clone(pbuf_layer l, pbuf_type type, struct pbuf *p)
+{
+    struct pbuf *q = pbuf_alloc(l, p->tot_len, type);
+
+    pbuf_copy_partial(p, q->payload, p->tot_len, 0);
+
+    return q;
+}
+
+u16_t pbuf_copy_partial(const struct pbuf *p, void *dataptr, u16_t len, u16_t offset)
+{
+    u16_t copied = 0;
+
+    for (; (p != NULL) && (copied < len); p = p->next)
+    {
+        u16_t segmentLength;
+
+        if (offset >= p->len)
+        {
+            offset -= p->len;
+            continue;
+        }
+
+        segmentLength = (u16_t)(p->len - offset);
+        if (segmentLength > len - copied)
+        {
+            segmentLength = (u16_t)(len - copied);
+        }
+        memcpy((uint8_t *)dataptr + copied, (const uint8_t *)p->payload + offset, segmentLength);
+        copied += segmentLength;
+        offset = 0;
+    }
+
+    return copied;
+}
+
+err_t pbuf_take(struct pbuf *buf, const void *dataptr, u16_t len)
+{
+    u16_t copied = 0;
+
+    if (buf->tot_len < len)
+    {
+        return ERR_ARG;
+    }
+
+    for (struct pbuf *p = buf; copied < len; p = p->next)
+    {
+        u16_t segmentLength = (p->len > len - copied) ? (u16_t)(len - copied) : p->len;
+
+        memcpy(p->payload, (const uint8_t *)dataptr + copied, segmentLength);
+        copied += segmentLength;
+    }
+
+    return ERR_OK;
+}
+
+struct netif *netif_add(struct netif  *netif,
+                        const void    *ipaddr,
+                        const void    *netmask,
+                        const void    *gw,
+                        void          *state,
+                        netif_init_fn  init,
+                        netif_input_fn input)
+{
+    memset(netif, 0, sizeof(*netif));
+    netif->input = input;
+    VerifyOrExit(init(netif) == ERR_OK, netif = NULL);
+
+    netif->num  = sNetifCount++;
+    netif->next = netif_list;
+    netif_list  = netif;
+
+exit:
+    return netif;
+}
+
+struct netif *netif_get_by_index(u8_t idx)
+{
+    struct netif *netif = netif_list;
+
+    while ((netif != NULL) && (netif_get_index(netif) != idx))
+    {
+        netif = netif->next;
+    }
+
+    return netif;
+}
+
+void netif_set_link_up(struct netif *netif)
+{
+    netif->flags |= NETIF_FLAG_LINK_UP;
+}
+
+void netif_set_link_down(struct netif *netif)
+{
+    netif->flags &= (u8_t)~NETIF_FLAG_LINK_UP;
+}
+
+void netif_ip6_addr_set(struct netif *netif, s8_t addr_idx, const ip6_addr_t *addr6)
+{
+    netif->ip6_addr[addr_idx] = *addr6;
+}
+
+void netif_ip6_addr_set_state(struct netif *netif, s8_t addr_idx, u8_t state)
+{
+    netif->ip6_addr_state[addr_idx] = state;
+}
+
+err_t netif_add_ip6_address(struct netif *netif, const ip6_addr_t *ip6addr, s8_t *chosen_idx)
+{
+    for (s8_t i = 1; i < LWIP_IPV6_NUM_ADDRESSES; i++)
+    {
+        if (netif->ip6_addr_state[i] == IP6_ADDR_INVALID)
+        {
+            netif->ip6_addr[i] = *ip6addr;
+            *chosen_idx        = i;
+            return ERR_OK;
+        }
+    }
+
+    return ERR_VAL;
+}
+
+err_t tcpip_input(struct pbuf *p, struct netif *inp)
+{
+    LWIP_UNUSED_ARG(inp);
+    pbuf_free(p);
+
+    return ERR_OK;
+}
+
+void memp_init_pool(const struct memp_desc *desc)
+{
+    *desc->tab = NULL;
+    for (u16_t i = 0; i < desc->num; i++)
+    {
+        struct memp *memp = (struct memp *)(desc->base + (size_t)i * desc->size);
+
+        memp->next = *desc->tab;
+        *desc->tab = memp;
+    }
+}
+
+void *memp_malloc_pool(const struct memp_desc *desc)
+{
+    struct memp *memp = *desc->tab;
+
+    if (memp != NULL)
+    {
+        *desc->tab = memp->next;
+    }
+
+    return memp;
+}
+
+void memp_free_pool(const struct memp_desc *desc, void *mem)
+{
+    struct memp *memp = (struct memp *)mem;
+
+    HOST_TEST_VERIFY(((u8_t *)mem >= desc->base) && ((u8_t *)mem < desc->base + (size_t)desc->num * desc->size));
+    HOST_TEST_VERIFY((((u8_t *)mem - desc->base) % desc->size) == 0);
+
+    memp->next = *desc->tab;
+    *desc->tab = memp;
+}
+
+struct udp_pcb *udp_new(void)
+{
+    struct udp_pcb *pcb = (struct udp_pcb *)calloc(1, sizeof(struct udp_pcb));
+
+    if (pcb != NULL)
+    {
+        pcb->ttl = UDP_TTL;
+    }
+
+    return pcb;
+}
+
+void udp_remove(struct udp_pcb *pcb)
+{
+    free(pcb);
+}
+
+err_t udp_bind(struct udp_pcb *pcb, const ip_addr_t *ipaddr, u16_t port)
+{
+    pcb->local_ip   = *ipaddr;
+    pcb->local_port = port;
+
+    return ERR_OK;
+}
+
+void udp_bind_netif(struct udp_pcb *pcb, const struct netif *netif)
+{
+    pcb->netif_idx = (netif != NULL) ? netif_get_index(netif) : NETIF_NO_INDEX;
+}
+
+err_t udp_connect(struct udp_pcb *pcb, const ip_addr_t *ipaddr, u16_t port)
+{
+    pcb->remote_ip   = *ipaddr;
+    pcb->remote_port = port;
+
+    return ERR_OK;
+}
+
+void udp_disconnect(struct udp_pcb *pcb)
+{
+    memset(&pcb->remote_ip, 0, sizeof(pcb->remote_ip));
+    pcb->remote_port = 0;
+    pcb->netif_idx   = NETIF_NO_INDEX;
+}
+
+void udp_recv(struct udp_pcb *pcb, udp_recv_fn recv, void *recv_arg)
+{
+    pcb->recv     = recv;
+    pcb->recv_arg = recv_arg;
+}
+
+err_t mld6_joingroup_netif(struct netif *netif, const ip6_addr_t *groupaddr)
+{
+    LWIP_UNUSED_ARG(groupaddr);
+
+    return (netif != NULL) ? ERR_OK : ERR_VAL;
+}
+
+err_t mld6_leavegroup_netif(struct netif *netif, const ip6_addr_t *groupaddr)
+{
+    LWIP_UNUSED_ARG(groupaddr);
+
+    return (netif != NULL) ? ERR_OK : ERR_VAL;
+}
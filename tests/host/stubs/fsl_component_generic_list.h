@@ -0,0 +1,65 @@
+/*
+ *  Copyright (c) 2025, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* Host test stub of the SDK generic list */
+
+#ifndef GENERIC_LIST_H_
+#define GENERIC_LIST_H_
+
+#include <stdint.h>
+
+typedef enum list_status
+{
+    kLIST_Ok = 0,
+    kLIST_DuplicateError,
+    kLIST_Full,
+    kLIST_Empty,
+    kLIST_OrphanElement,
+    kLIST_NotSupport,
+} list_status_t;
+
+typedef struct list_label
+{
+    struct list_element_tag *head;
+    struct list_element_tag *tail;
+    uint32_t                 size;
+    uint32_t                 max;
+} list_label_t, *list_handle_t;
+
+typedef struct list_element_tag
+{
+    struct list_element_tag *next;
+    struct list_element_tag *prev;
+    struct list_label       *list;
+} list_element_t, *list_element_handle_t;
+
+void                  LIST_Init(list_handle_t list, uint32_t max);
+list_status_t         LIST_AddTail(list_handle_t list, list_element_handle_t element);
+list_element_handle_t LIST_RemoveHead(list_handle_t list);
+
+#endif /* GENERIC_LIST_H_ */
@@ -0,0 +1,59 @@
+/*
+ *  Copyright (c) 2025, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* Host test stub of the OS abstraction, the tests are single threaded */
+
+#ifndef FSL_OS_ABSTRACTION_H_
+#define FSL_OS_ABSTRACTION_H_
+
+#include <stdint.h>
+
+#include "event_groups.h"
+
+typedef void   *osa_mutex_handle_t;
+typedef void   *osaMutexId_t;
+typedef uint8_t bool_t;
+
+#define TRUE 1
+#define FALSE 0
+
+#define osaWaitForever_c 0xFFFFFFFFU
+
+typedef enum _osa_status
+{
+    KOSA_StatusSuccess = 0,
+    KOSA_StatusError   = 1,
+    KOSA_StatusTimeout = 2,
+} osa_status_t;
+
+#define OSA_MUTEX_HANDLE_DEFINE(name) uint32_t name[1]
+#define OSA_MutexCreate(handle) ((void)(handle), KOSA_StatusSuccess)
+#define OSA_MutexLock(handle, timeout) ((void)(handle), (void)(timeout), 0)
+#define OSA_MutexUnlock(handle) ((void)(handle), 0)
+
+#endif /* FSL_OS_ABSTRACTION_H_ */
@@ -0,0 +1,268 @@
+/*
+ *  Copyright (c) 2025, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* Host test stub of the OpenThread HDLC-lite encoder and decoder, following the same framing and FCS */
+
+#ifndef OT_LIB_HDLC_HPP_
+#define OT_LIB_HDLC_HPP_
+
+#include <stdint.h>
+
+#include <openthread/error.h>
+
+#include "lib/spinel/multi_frame_buffer.hpp"
+#include "lib/utils/utils.hpp"
+
+namespace ot {
+namespace Hdlc {
+
+enum
+{
+    kFlagSequence   = 0x7e,
+    kEscapeSequence = 0x7d,
+    kFlagXOn        = 0x11,
+    kFlagXOff       = 0x13,
+    kFlagSpecial    = 0xf8,
+    kEscapeXor      = 0x20,
+    kInitFcs        = 0xffff,
+    kGoodFcs        = 0xf0b8,
+    kFcsSize        = 2,
+};
+
+/* FCS-16 of RFC 1662, one table entry per byte value */
+class FcsTable
+{
+public:
+    FcsTable(void)
+    {
+        for (uint16_t value = 0; value < 256; value++)
+        {
+            uint16_t fcs = value;
+
+            for (uint8_t i = 0; i < 8; i++)
+            {
+                fcs = (fcs & 1) ? static_cast<uint16_t>((fcs >> 1) ^ 0x8408) : static_cast<uint16_t>(fcs >> 1);
+            }
+            mTable[value] = fcs;
+        }
+    }
+
+    uint16_t Update(uint16_t aFcs, uint8_t aByte) const
+    {
+        return static_cast<uint16_t>((aFcs >> 8) ^ mTable[(aFcs ^ aByte) & 0xff]);
+    }
+
+private:
+    uint16_t mTable[256];
+};
+
+inline uint16_t UpdateFcs(uint16_t aFcs, uint8_t aByte)
+{
+    static const FcsTable sFcsTable;
+
+    return sFcsTable.Update(aFcs, aByte);
+}
+
+class Encoder
+{
+public:
+    explicit Encoder(Spinel::FrameWritePointer &aWritePointer)
+        : mWritePointer(aWritePointer)
+        , mFcs(kInitFcs)
+    {
+    }
+
+    otError BeginFrame(void)
+    {
+        mFcs = kInitFcs;
+        return mWritePointer.WriteByte(kFlagSequence);
+    }
+
+    otError Encode(const uint8_t *aData, uint16_t aLength)
+    {
+        otError error = OT_ERROR_NONE;
+
+        for (uint16_t i = 0; (i < aLength) && (error == OT_ERROR_NONE); i++)
+        {
+            mFcs  = UpdateFcs(mFcs, aData[i]);
+            error = EncodeByte(aData[i]);
+        }
+
+        return error;
+    }
+
+    otError EndFrame(void)
+    {
+        otError  error = OT_ERROR_NONE;
+        uint16_t fcs   = mFcs ^ 0xffff;
+
+        EXPECT_NO_ERROR(error = EncodeByte(fcs & 0xff));
+        EXPECT_NO_ERROR(error = EncodeByte(fcs >> 8));
+        error = mWritePointer.WriteByte(kFlagSequence);
+
+    exit:
+        return error;
+    }
+
+private:
+    otError EncodeByte(uint8_t aByte)
+    {
+        otError error = OT_ERROR_NONE;
+
+        if ((aByte == kFlagSequence) || (aByte == kEscapeSequence) || (aByte == kFlagXOn) || (aByte == kFlagXOff) ||
+            (aByte == kFlagSpecial))
+        {
+            EXPECT(mWritePointer.CanWrite(2), error = OT_ERROR_NO_BUFS);
+            IgnoreError(mWritePointer.WriteByte(kEscapeSequence));
+            aByte ^= kEscapeXor;
+        }
+
+        error = mWritePointer.WriteByte(aByte);
+
+    exit:
+        return error;
+    }
+
+    Spinel::FrameWritePointer &mWritePointer;
+    uint16_t                   mFcs;
+};
+
+class Decoder
+{
+public:
+    typedef void (*FrameHandler)(void *aContext, otError aError);
+
+    Decoder(void)
+        : mState(kStateNoSync)
+        , mWritePointer(nullptr)
+        , mFrameHandler(nullptr)
+        , mContext(nullptr)
+        , mFcs(0)
+        , mDecodedLength(0)
+    {
+    }
+
+    void Init(Spinel::FrameWritePointer &aFrameWritePointer, FrameHandler aFrameHandler, void *aContext)
+    {
+        mState        = kStateNoSync;
+        mWritePointer = &aFrameWritePointer;
+        mFrameHandler = aFrameHandler;
+        mContext      = aContext;
+    }
+
+    void Reset(void) { mState = kStateNoSync; }
+
+    void Decode(const uint8_t *aData, uint16_t aLength)
+    {
+        while (aLength--)
+        {
+            uint8_t byte = *aData++;
+
+            switch (mState)
+            {
+            case kStateNoSync:
+                if (byte == kFlagSequence)
+                {
+                    mState         = kStateSync;
+                    mDecodedLength = 0;
+                    mFcs           = kInitFcs;
+                }
+                break;
+
+            case kStateSync:
+                if (byte == kEscapeSequence)
+                {
+                    mState = kStateEscaped;
+                }
+                else if (byte == kFlagSequence)
+                {
+                    if (mDecodedLength > 0)
+                    {
+                        otError error = OT_ERROR_PARSE;
+
+                        if ((mDecodedLength >= kFcsSize) && (mFcs == kGoodFcs))
+                        {
+                            mWritePointer->UndoLastWrites(kFcsSize);
+                            error = OT_ERROR_NONE;
+                        }
+
+                        mFrameHandler(mContext, error);
+                    }
+
+                    mDecodedLength = 0;
+                    mFcs           = kInitFcs;
+                }
+                else
+                {
+                    DecodeByte(byte);
+                }
+                break;
+
+            case kStateEscaped:
+                mState = kStateSync;
+                DecodeByte(byte ^ kEscapeXor);
+                break;
+            }
+        }
+    }
+
+private:
+    enum State
+    {
+        kStateNoSync,
+        kStateSync,
+        kStateEscaped,
+    };
+
+    void DecodeByte(uint8_t aByte)
+    {
+        if (mWritePointer->CanWrite(sizeof(uint8_t)))
+        {
+            mFcs = UpdateFcs(mFcs, aByte);
+            IgnoreError(mWritePointer->WriteByte(aByte));
+            mDecodedLength++;
+        }
+        else
+        {
+            mFrameHandler(mContext, OT_ERROR_NO_BUFS);
+            mState = kStateNoSync;
+        }
+    }
+
+    State                      mState;
+    Spinel::FrameWritePointer *mWritePointer;
+    FrameHandler               mFrameHandler;
+    void                      *mContext;
+    uint16_t                   mFcs;
+    uint16_t                   mDecodedLength;
+};
+
+} // namespace Hdlc
+} // namespace ot
+
+#endif // OT_LIB_HDLC_HPP_
@@ -0,0 +1,124 @@
+/*
+ *  Copyright (c) 2025, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* Host test stub of the OpenThread spinel frame buffers, reduced to a single frame in the multi frame buffer */
+
+#ifndef SPINEL_MULTI_FRAME_BUFFER_HPP_
+#define SPINEL_MULTI_FRAME_BUFFER_HPP_
+
+#include <stdint.h>
+
+#include <openthread/error.h>
+
+namespace ot {
+namespace Spinel {
+
+class FrameWritePointer
+{
+public:
+    bool CanWrite(uint16_t aWriteLength) const { return (mRemainingLength >= aWriteLength); }
+
+    otError WriteByte(uint8_t aByte)
+    {
+        return CanWrite(sizeof(uint8_t)) ? ((*mWritePointer++ = aByte), mRemainingLength--, OT_ERROR_NONE)
+                                         : OT_ERROR_NO_BUFS;
+    }
+
+    void UndoLastWrites(uint16_t aUndoLength)
+    {
+        mWritePointer -= aUndoLength;
+        mRemainingLength += aUndoLength;
+    }
+
+protected:
+    FrameWritePointer(void)
+        : mWritePointer(nullptr)
+        , mRemainingLength(0)
+    {
+    }
+
+    uint8_t *mWritePointer;
+    uint16_t mRemainingLength;
+};
+
+template <uint16_t kSize> class FrameBuffer : public FrameWritePointer
+{
+public:
+    FrameBuffer(void) { Clear(); }
+
+    void Clear(void)
+    {
+        mWritePointer    = mBuffer;
+        mRemainingLength = sizeof(mBuffer);
+    }
+
+    bool     IsEmpty(void) const { return (mWritePointer == mBuffer); }
+    uint16_t GetLength(void) const { return static_cast<uint16_t>(mWritePointer - mBuffer); }
+    uint8_t *GetFrame(void) { return mBuffer; }
+
+private:
+    uint8_t mBuffer[kSize];
+};
+
+template <uint16_t kSize> class MultiFrameBuffer : public FrameWritePointer
+{
+public:
+    MultiFrameBuffer(void) { Clear(); }
+
+    void Clear(void)
+    {
+        mWritePointer    = mBuffer;
+        mRemainingLength = sizeof(mBuffer);
+    }
+
+    uint8_t *GetFrame(void) const { return const_cast<uint8_t *>(mBuffer); }
+    uint16_t GetFrameMaxLength(void) const { return kSize; }
+    uint16_t GetLength(void) const { return static_cast<uint16_t>(mWritePointer - mBuffer); }
+
+    otError SetLength(uint16_t aLength)
+    {
+        otError error = OT_ERROR_NO_BUFS;
+
+        if (aLength <= kSize)
+        {
+            mWritePointer    = mBuffer + aLength;
+            mRemainingLength = static_cast<uint16_t>(kSize - aLength);
+            error            = OT_ERROR_NONE;
+        }
+
+        return error;
+    }
+
+private:
+    uint8_t mBuffer[kSize];
+};
+
+} // namespace Spinel
+} // namespace ot
+
+#endif // SPINEL_MULTI_FRAME_BUFFER_HPP_
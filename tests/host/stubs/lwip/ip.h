@@ -0,0 +1,63 @@
+/*
+ *  Copyright (c) 2025, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* Host test stub of the lwIP header */
+
+#ifndef LWIP_HDR_IP_H
+#define LWIP_HDR_IP_H
+
+#include "lwip/ip_addr.h"
+#include "lwip/netif.h"
+#include "lwip/prot/ip4.h"
+#include "lwip/prot/ip6.h"
+
+/* Header of the packet being processed by the lwIP input functions, set by the tests before calling a receive
+ * callback */
+struct ip_globals
+{
+    struct netif         *current_netif;
+    struct netif         *current_input_netif;
+    const struct ip_hdr  *current_ip4_header;
+    const struct ip6_hdr *current_ip6_header;
+    u16_t                 current_ip_header_tot_len;
+    ip_addr_t             current_iphdr_src;
+    ip_addr_t             current_iphdr_dest;
+};
+
+extern struct ip_globals ip_data;
+
+#define ip_current_netif() (ip_data.current_netif)
+#define ip_current_input_netif() (ip_data.current_input_netif)
+#define ip4_current_header() ip_data.current_ip4_header
+#define ip6_current_header() ((const struct ip6_hdr *)(ip_data.current_ip6_header))
+#define ip_current_src_addr() (&ip_data.current_iphdr_src)
+#define ip_current_dest_addr() (&ip_data.current_iphdr_dest)
+#define ip6_current_src_addr() (ip_2_ip6(&ip_data.current_iphdr_src))
+#define ip6_current_dest_addr() (ip_2_ip6(&ip_data.current_iphdr_dest))
+
+#endif /* LWIP_HDR_IP_H */
@@ -0,0 +1,77 @@
+/*
+ *  Copyright (c) 2025, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* Host test stub of the lwIP header */
+
+#ifndef LWIP_HDR_IP6_ADDR_H
+#define LWIP_HDR_IP6_ADDR_H
+
+#include "lwip/arch.h"
+
+typedef struct ip6_addr
+{
+    u32_t addr[4];
+    u8_t  zone;
+} ip6_addr_t;
+
+typedef struct ip4_addr
+{
+    u32_t addr;
+} ip4_addr_t;
+
+#define IP6_NO_ZONE 0
+
+enum lwip_ipv6_scope_type
+{
+    IP6_UNKNOWN   = 0,
+    IP6_UNICAST   = 1,
+    IP6_MULTICAST = 2,
+};
+
+#define ip6_addr_isany(ip6addr)                                                                               \
+    (((ip6addr) == NULL) ||                                                                                   \
+     (((ip6addr)->addr[0] == 0) && ((ip6addr)->addr[1] == 0) && ((ip6addr)->addr[2] == 0) && ((ip6addr)->addr[3] == 0)))
+
+#define ip6_addr_islinklocal(ip6addr) (((ip6addr)->addr[0] & PP_HTONL(0xffc00000UL)) == PP_HTONL(0xfe800000UL))
+#define ip6_addr_ismulticast(ip6addr) (((ip6addr)->addr[0] & PP_HTONL(0xff000000UL)) == PP_HTONL(0xff000000UL))
+#define ip6_addr_multicast_scope(ip6addr) ((lwip_htonl((ip6addr)->addr[0]) >> 16) & 0xf)
+
+#define IP6_MULTICAST_SCOPE_INTERFACE_LOCAL 0x1
+#define IP6_MULTICAST_SCOPE_LINK_LOCAL 0x2
+#define IP6_MULTICAST_SCOPE_ADMIN_LOCAL 0x4
+
+/* Link-local unicast and interface or link-local multicast addresses are bound to the index of their netif */
+#define ip6_addr_has_scope(ip6addr, type)                                                     \
+    (ip6_addr_islinklocal(ip6addr) || (((type) != IP6_UNICAST) && ip6_addr_ismulticast(ip6addr) && \
+                                       (ip6_addr_multicast_scope(ip6addr) <= IP6_MULTICAST_SCOPE_LINK_LOCAL)))
+
+/* netif_get_index comes from lwip/netif.h */
+#define ip6_addr_assign_zone(ip6addr, type, netif) \
+    ((ip6addr)->zone = ip6_addr_has_scope((ip6addr), (type)) ? netif_get_index(netif) : IP6_NO_ZONE)
+
+#endif /* LWIP_HDR_IP6_ADDR_H */
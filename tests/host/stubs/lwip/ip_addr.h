@@ -0,0 +1,92 @@
+/*
+ *  Copyright (c) 2025, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* Host test stub of the lwIP header */
+
+#ifndef LWIP_HDR_IP_ADDR_H
+#define LWIP_HDR_IP_ADDR_H
+
+#include "lwip/ip6_addr.h"
+#include "lwip/opt.h"
+
+enum lwip_ip_addr_type
+{
+    IPADDR_TYPE_V4  = 0U,
+    IPADDR_TYPE_V6  = 6U,
+    IPADDR_TYPE_ANY = 46U,
+};
+
+typedef struct ip_addr
+{
+    union
+    {
+        ip6_addr_t ip6;
+        ip4_addr_t ip4;
+    } u_addr;
+    u8_t type;
+} ip_addr_t;
+
+#define IP_IS_V4_VAL(ipaddr) ((ipaddr).type == IPADDR_TYPE_V4)
+#define IP_IS_V6_VAL(ipaddr) ((ipaddr).type == IPADDR_TYPE_V6)
+#define IP_IS_V6(ipaddr) (((ipaddr) != NULL) && IP_IS_V6_VAL(*(ipaddr)))
+#define ip_2_ip6(ipaddr) (&((ipaddr)->u_addr.ip6))
+#define ip_2_ip4(ipaddr) (&((ipaddr)->u_addr.ip4))
+
+#define ip_addr_copy_from_ip6_packed(dest, src)                                       \
+    do                                                                                \
+    {                                                                                 \
+        memcpy(ip_2_ip6(&(dest))->addr, (src).addr, sizeof(ip_2_ip6(&(dest))->addr)); \
+        ip_2_ip6(&(dest))->zone = IP6_NO_ZONE;                                        \
+        (dest).type             = IPADDR_TYPE_V6;                                     \
+    } while (0)
+
+#define ip4_addr_isany_val(addr4) ((addr4).addr == 0)
+#define ip4_addr_ismulticast(addr4) (((addr4)->addr & PP_HTONL(0xf0000000UL)) == PP_HTONL(0xe0000000UL))
+
+#define ip_addr_isany(ipaddr)    \
+    (((ipaddr) == NULL) ||       \
+     (IP_IS_V6(ipaddr) ? ip6_addr_isany(ip_2_ip6(ipaddr)) : ip4_addr_isany_val(*ip_2_ip4(ipaddr))))
+#define ip_addr_ismulticast(ipaddr) \
+    (IP_IS_V6(ipaddr) ? ip6_addr_ismulticast(ip_2_ip6(ipaddr)) : ip4_addr_ismulticast(ip_2_ip4(ipaddr)))
+
+#define ip6_addr_isipv4mappedipv6(ip6addr) \
+    (((ip6addr)->addr[0] == 0) && ((ip6addr)->addr[1] == 0) && ((ip6addr)->addr[2] == PP_HTONL(0x0000FFFFUL)))
+
+#define unmap_ipv4_mapped_ipv6(ip4addr, ip6addr) (ip4addr)->addr = (ip6addr)->addr[3]
+
+#define ip4_2_ipv4_mapped_ipv6(ip6addr, ip4addr)     \
+    do                                               \
+    {                                                \
+        (ip6addr)->addr[3] = (ip4addr)->addr;        \
+        (ip6addr)->addr[2] = PP_HTONL(0x0000FFFFUL); \
+        (ip6addr)->addr[1] = 0;                      \
+        (ip6addr)->addr[0] = 0;                      \
+        (ip6addr)->zone    = IP6_NO_ZONE;            \
+    } while (0)
+
+#endif /* LWIP_HDR_IP_ADDR_H */
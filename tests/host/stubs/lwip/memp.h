@@ -0,0 +1,66 @@
+/*
+ *  Copyright (c) 2025, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* Host test stub of the lwIP header, the pools are static arrays with a free list as in lwIP */
+
+#ifndef LWIP_HDR_MEMP_H
+#define LWIP_HDR_MEMP_H
+
+#include "lwip/arch.h"
+
+#define MEMP_ALIGN_SIZE(x) (((x) + sizeof(void *) - 1U) & ~(sizeof(void *) - 1U))
+
+struct memp
+{
+    struct memp *next;
+};
+
+struct memp_desc
+{
+    const char   *desc;
+    u16_t         size;
+    u16_t         num;
+    u8_t         *base;
+    struct memp **tab;
+};
+
+#define LWIP_MEMPOOL_DECLARE(name, num, size, desc)                                                                 \
+    static void *memp_memory_##name##_base[((num) * MEMP_ALIGN_SIZE(size) + sizeof(void *) - 1U) / sizeof(void *)]; \
+    static struct memp *memp_tab_##name;                                                                            \
+    static const struct memp_desc memp_##name = {(desc), (u16_t)MEMP_ALIGN_SIZE(size), (num),                       \
+                                                 (u8_t *)memp_memory_##name##_base, &memp_tab_##name}
+
+#define LWIP_MEMPOOL_INIT(name) memp_init_pool(&memp_##name)
+#define LWIP_MEMPOOL_ALLOC(name) memp_malloc_pool(&memp_##name)
+#define LWIP_MEMPOOL_FREE(name, x) memp_free_pool(&memp_##name, (x))
+
+void  memp_init_pool(const struct memp_desc *desc);
+void *memp_malloc_pool(const struct memp_desc *desc);
+void  memp_free_pool(const struct memp_desc *desc, void *mem);
+
+#endif /* LWIP_HDR_MEMP_H */
@@ -0,0 +1,95 @@
+/*
+ *  Copyright (c) 2025, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* Host test stub of the OpenThread public header */
+
+#ifndef OPENTHREAD_IP6_H_
+#define OPENTHREAD_IP6_H_
+
+#include <openthread/message.h>
+
+#define OT_IP6_ADDRESS_SIZE 16
+#define OT_IP6_PREFIX_SIZE 8
+
+typedef struct otIp6Address
+{
+    union
+    {
+        uint8_t  m8[OT_IP6_ADDRESS_SIZE];
+        uint16_t m16[OT_IP6_ADDRESS_SIZE / sizeof(uint16_t)];
+        uint32_t m32[OT_IP6_ADDRESS_SIZE / sizeof(uint32_t)];
+    } mFields;
+} otIp6Address;
+
+typedef struct otIp6NetworkPrefix
+{
+    uint8_t m8[OT_IP6_PREFIX_SIZE];
+} otIp6NetworkPrefix;
+
+typedef otIp6NetworkPrefix otMeshLocalPrefix;
+
+typedef struct otIp6Prefix
+{
+    otIp6Address mPrefix;
+    uint8_t      mLength;
+} otIp6Prefix;
+
+enum
+{
+    OT_ADDRESS_ORIGIN_THREAD = 0,
+    OT_ADDRESS_ORIGIN_SLAAC  = 1,
+    OT_ADDRESS_ORIGIN_DHCPV6 = 2,
+    OT_ADDRESS_ORIGIN_MANUAL = 3,
+};
+
+typedef struct otNetifAddress
+{
+    otIp6Address                 mAddress;
+    uint8_t                      mPrefixLength;
+    uint8_t                      mAddressOrigin;
+    bool                         mPreferred : 1;
+    bool                         mValid : 1;
+    bool                         mScopeOverrideValid : 1;
+    unsigned int                 mScopeOverride : 4;
+    bool                         mRloc : 1;
+    bool                         mMeshLocal : 1;
+    bool                         mSrpRegistered : 1;
+    const struct otNetifAddress *mNext;
+} otNetifAddress;
+
+typedef void (*otIp6ReceiveCallback)(otMessage *aMessage, void *aContext);
+
+bool                  otIp6IsAddressUnspecified(const otIp6Address *aAddress);
+bool                  otIp6IsEnabled(otInstance *aInstance);
+const otNetifAddress *otIp6GetUnicastAddresses(otInstance *aInstance);
+otMessage            *otIp6NewMessage(otInstance *aInstance, const otMessageSettings *aSettings);
+otError               otIp6Send(otInstance *aInstance, otMessage *aMessage);
+void                  otIp6SetReceiveCallback(otInstance *aInstance, otIp6ReceiveCallback aCallback, void *aContext);
+void                  otIp6SetReceiveFilterEnabled(otInstance *aInstance, bool aEnabled);
+
+#endif /* OPENTHREAD_IP6_H_ */
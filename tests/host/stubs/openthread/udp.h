@@ -0,0 +1,76 @@
+/*
+ *  Copyright (c) 2025, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* Host test stub of the OpenThread public header */
+
+#ifndef OPENTHREAD_UDP_H_
+#define OPENTHREAD_UDP_H_
+
+#include <openthread/ip6.h>
+
+typedef struct otSockAddr
+{
+    otIp6Address mAddress;
+    uint16_t     mPort;
+} otSockAddr;
+
+typedef struct otMessageInfo
+{
+    otIp6Address mSockAddr;
+    otIp6Address mPeerAddr;
+    uint16_t     mSockPort;
+    uint16_t     mPeerPort;
+    uint8_t      mHopLimit;
+    uint8_t      mEcn : 2;
+    bool         mIsHostInterface : 1;
+    bool         mAllowZeroHopLimit : 1;
+    bool         mMulticastLoop : 1;
+} otMessageInfo;
+
+typedef void (*otUdpReceive)(void *aContext, otMessage *aMessage, const otMessageInfo *aMessageInfo);
+
+typedef struct otUdpSocket
+{
+    otSockAddr          mSockName;
+    otSockAddr          mPeerName;
+    otUdpReceive        mHandler;
+    void               *mContext;
+    void               *mHandle;
+    struct otUdpSocket *mNext;
+} otUdpSocket;
+
+typedef enum otNetifIdentifier
+{
+    OT_NETIF_UNSPECIFIED = 0,
+    OT_NETIF_THREAD,
+    OT_NETIF_BACKBONE,
+} otNetifIdentifier;
+
+otMessage *otUdpNewMessage(otInstance *aInstance, const otMessageSettings *aSettings);
+
+#endif /* OPENTHREAD_UDP_H_ */
@@ -0,0 +1,239 @@
+/*
+ *  Copyright (c) 2025, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file tests the alarms on a hardware counter (alarm_hw_counter.c) with a simulated counter.
+ *
+ *   The counter is advanced tick by tick and the compare interrupt is raised when it equals the compare value, as
+ *   the GPT and CTIMER do, so a compare written too late is missed as on the hardware.
+ */
+
+#include "host_test.h"
+
+#include <openthread/platform/alarm-micro.h>
+#include <openthread/platform/alarm-milli.h>
+#include <openthread/platform/time.h>
+
+#include "ot_platform_common.h"
+
+static uint32_t sCounter;
+static uint32_t sCompare;
+static uint32_t sCompareWriteTicks; ///< Ticks elapsed while the compare value is written.
+static unsigned sMilliFired;
+static unsigned sMicroFired;
+static uint64_t sFiredAt;
+
+void alarmCounterIsr(void);
+
+void alarmSimCounterInit(void)
+{
+}
+
+void alarmSimCounterDeinit(void)
+{
+}
+
+uint32_t alarmSimCounterRead(void)
+{
+    return sCounter;
+}
+
+void alarmSimCounterSetCompare(uint32_t aCompare)
+{
+    sCompare = aCompare;
+    sCounter += sCompareWriteTicks;
+}
+
+void otSysEventSetPending(otSysEvent aEvent)
+{
+    OT_UNUSED_VARIABLE(aEvent);
+}
+
+void otSysEventSignalPending(void)
+{
+}
+
+void otTaskletsSignalPending(otInstance *aInstance)
+{
+    OT_UNUSED_VARIABLE(aInstance);
+}
+
+void otPlatAlarmMilliFired(otInstance *aInstance)
+{
+    OT_UNUSED_VARIABLE(aInstance);
+    sMilliFired++;
+    sFiredAt = otPlatTimeGet();
+}
+
+void otPlatAlarmMicroFired(otInstance *aInstance)
+{
+    OT_UNUSED_VARIABLE(aInstance);
+    sMicroFired++;
+    sFiredAt = otPlatTimeGet();
+}
+
+#include "alarm_hw_counter.c"
+
+/* Advance the counter tick by tick */
+static void testAdvance(uint64_t aTicks)
+{
+    while (aTicks-- > 0)
+    {
+        if (++sCounter == sCompare)
+        {
+            alarmCounterIsr();
+        }
+    }
+}
+
+/* Advance the counter to the compare value at once */
+static void testAdvanceFast(uint64_t aTicks)
+{
+    while (aTicks > 0)
+    {
+        uint32_t toCompare = (sCompare != sCounter) ? sCompare - sCounter : UINT32_MAX;
+
+        if (toCompare > aTicks)
+        {
+            sCounter += (uint32_t)aTicks;
+            break;
+        }
+        sCounter += toCompare;
+        aTicks -= toCompare;
+        alarmCounterIsr();
+    }
+}
+
+/* A micro alarm fires at its deadline, up to one tick late, never early */
+static void testMicroJitter(void)
+{
+    uint32_t maxLateness = 0;
+
+    for (int i = 0; i < 2000; i++)
+    {
+        uint32_t now      = otPlatAlarmMicroGetNow();
+        uint32_t t0       = now - (uint32_t)(rand() % 50);
+        uint32_t dt       = (uint32_t)(rand() % 5000);
+        uint32_t deadline = ((int32_t)(t0 + dt - now) > 0) ? t0 + dt : now;
+        uint32_t lateness;
+
+        sMicroFired = 0;
+        otPlatAlarmMicroStartAt(NULL, t0, dt);
+        for (int ticks = 0; sMicroFired == 0; ticks++)
+        {
+            HOST_TEST_VERIFY(ticks < 10000);
+            testAdvance(1);
+            otPlatAlarmProcess(NULL);
+        }
+
+        lateness = (uint32_t)sFiredAt - deadline;
+        HOST_TEST_VERIFY((int32_t)lateness >= 0);
+        maxLateness = (lateness > maxLateness) ? lateness : maxLateness;
+    }
+
+    HOST_TEST_VERIFY(maxLateness <= 1);
+}
+
+/* Millisecond alarms longer than a counter period across its wraps */
+static void testMilliWrap(void)
+{
+    for (int i = 0; i < 6; i++)
+    {
+        uint32_t now = otPlatAlarmMilliGetNow();
+
+        sMilliFired = 0;
+        otPlatAlarmMilliStartAt(NULL, now, 1500000);
+        testAdvanceFast(1499999000ULL);
+        otPlatAlarmProcess(NULL);
+        HOST_TEST_VERIFY(sMilliFired == 0);
+        testAdvanceFast(1000);
+        otPlatAlarmProcess(NULL);
+        HOST_TEST_VERIFY(sMilliFired == 1);
+        HOST_TEST_VERIFY(otPlatAlarmMilliGetNow() - now == 1500000);
+    }
+}
+
+static void testPastAndMissedDeadlines(void)
+{
+    uint32_t now;
+
+    /* A deadline in the past fires on the next process */
+    sMicroFired = 0;
+    otPlatAlarmMicroStartAt(NULL, otPlatAlarmMicroGetNow() - 100, 10);
+    otPlatAlarmProcess(NULL);
+    HOST_TEST_VERIFY(sMicroFired == 1);
+
+    /* The counter passes the compare value while it is written */
+    sMicroFired        = 0;
+    sCompareWriteTicks = 3;
+    otPlatAlarmMicroStartAt(NULL, otPlatAlarmMicroGetNow(), 2);
+    otPlatAlarmProcess(NULL);
+    HOST_TEST_VERIFY(sMicroFired == 1);
+    sCompareWriteTicks = 0;
+
+    /* A reference time in the future */
+    sMicroFired = 0;
+    now         = otPlatAlarmMicroGetNow();
+    otPlatAlarmMicroStartAt(NULL, now + 100, 50);
+    testAdvance(149);
+    otPlatAlarmProcess(NULL);
+    HOST_TEST_VERIFY(sMicroFired == 0);
+    testAdvance(1);
+    otPlatAlarmProcess(NULL);
+    HOST_TEST_VERIFY(sMicroFired == 1);
+}
+
+static void testIdleTicks(void)
+{
+    uint32_t idleTicks;
+
+    otPlatAlarmMilliStartAt(NULL, otPlatAlarmMilliGetNow(), 25);
+    idleTicks = otPlatAlarmGetIdleTicks(1000);
+    HOST_TEST_VERIFY(idleTicks == 24 || idleTicks == 25);
+    HOST_TEST_VERIFY(otPlatAlarmGetIdleTicks(3) == 3);
+
+    otPlatAlarmMilliStop(NULL);
+    otPlatAlarmMicroStop(NULL);
+    HOST_TEST_VERIFY(otPlatAlarmGetIdleTicks(1000) == 1000);
+}
+
+int main(void)
+{
+    srand(1);
+    otPlatAlarmInit();
+
+    testMicroJitter();
+    testMilliWrap();
+    testPastAndMissedDeadlines();
+    testIdleTicks();
+
+    printf("alarm hw counter: ok\n");
+
+    return 0;
+}
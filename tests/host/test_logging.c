@@ -0,0 +1,288 @@
+/*
+ *  Copyright (c) 2025, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file stress tests the lock-free log ring buffer of the platform logging (logging.c).
+ *
+ *   Several producer threads log in bursts at the same time, as OpenThread tasks and interrupts do on the target, while
+ *   the dump task runs in its own thread and is regularly paused so that the ring fills up and logs are dropped. Every
+ *   log printed must be complete and come in order for its producer, and the printed, dropped and reported counts must
+ *   match what was logged.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "host_test.h"
+
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+
+/* Included by the target configuration of OpenThread */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "logging.c"
+
+#define TEST_PRODUCERS 8U
+#define TEST_LOGS_PER_PRODUCER 100000U
+#define TEST_MAX_PADDING 300U
+#define TEST_BURST_LENGTH 16U       /* Number of logs of a producer between two pauses */
+#define TEST_DUMP_PAUSE_PERIOD 4096U /* Number of logs printed between two pauses of the dump task */
+#define TEST_PAUSE_NS 100000L
+
+/* Longest log text kept by otPlatLogImpl, without the end of line characters */
+#define TEST_MAX_TEXT_LENGTH (LOG_BUFFER_SIZE - EOL_CHARS_LEN - 1)
+
+static pthread_t         sDumpThread;
+static pthread_mutex_t   sNotifyMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t    sNotifyCond  = PTHREAD_COND_INITIALIZER;
+static uint32_t          sNotifyCount;
+static bool              sStopping;
+static pthread_barrier_t sStartBarrier;
+
+static uint32_t sPrinted[TEST_PRODUCERS];
+static uint32_t sLastSequence[TEST_PRODUCERS];
+static uint32_t sPrintedTotal;
+static uint32_t sReportedDropped;
+
+static char testPaddingChar(uint32_t aSequence)
+{
+    return (char)('a' + aSequence % 26U);
+}
+
+static uint32_t testPaddingLength(uint32_t aProducer, uint32_t aSequence)
+{
+    return (aSequence * 7U + aProducer * 13U) % TEST_MAX_PADDING;
+}
+
+static void testPause(void)
+{
+    struct timespec pause = {0, TEST_PAUSE_NS};
+
+    nanosleep(&pause, NULL);
+}
+
+static void testCheckLog(const char *aText)
+{
+    size_t   length = strlen(aText);
+    unsigned producer;
+    unsigned sequence;
+    unsigned dropped;
+    int      headerLength = 0;
+    size_t   expected;
+
+    HOST_TEST_VERIFY(length >= 2 && strcmp(&aText[length - 2], "\r\n") == 0);
+    length -= 2;
+
+    if (sscanf(aText, "[%u logs dropped]", &dropped) == 1)
+    {
+        HOST_TEST_VERIFY(dropped > 0);
+        sReportedDropped += dropped;
+        return;
+    }
+
+    HOST_TEST_VERIFY(sscanf(aText, "P%u %u%n", &producer, &sequence, &headerLength) == 2 && headerLength > 0);
+    HOST_TEST_VERIFY(aText[headerLength++] == ' ');
+    HOST_TEST_VERIFY(producer < TEST_PRODUCERS);
+    HOST_TEST_VERIFY(sequence < TEST_LOGS_PER_PRODUCER);
+    HOST_TEST_VERIFY(sPrinted[producer] == 0 || sequence > sLastSequence[producer]);
+
+    /* A log longer than the format buffer is truncated, but still printed */
+    expected = (size_t)headerLength + testPaddingLength(producer, sequence);
+    expected = (expected < TEST_MAX_TEXT_LENGTH) ? expected : TEST_MAX_TEXT_LENGTH;
+    HOST_TEST_VERIFY(length == expected);
+
+    for (size_t i = (size_t)headerLength; i < length; i++)
+    {
+        HOST_TEST_VERIFY(aText[i] == testPaddingChar(sequence));
+    }
+
+    sLastSequence[producer] = sequence;
+    sPrinted[producer]++;
+    sPrintedTotal++;
+
+    if (sPrintedTotal % TEST_DUMP_PAUSE_PERIOD == 0)
+    {
+        testPause();
+    }
+}
+
+/* Only called by the dump task, as PRINTF("%s", log) */
+int DbgConsole_Printf(const char *fmt_s, ...)
+{
+    va_list     ap;
+    const char *text;
+
+    HOST_TEST_VERIFY(strcmp(fmt_s, "%s") == 0);
+
+    va_start(ap, fmt_s);
+    text = va_arg(ap, const char *);
+    va_end(ap);
+
+    testCheckLog(text);
+
+    return (int)strlen(text);
+}
+
+static void *testDumpThread(void *aArg)
+{
+    otPlatLogDumpTask(aArg);
+    return NULL;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t               pxTaskCode,
+                       const char *const            pcName,
+                       const configSTACK_DEPTH_TYPE usStackDepth,
+                       void *const                  pvParameters,
+                       UBaseType_t                  uxPriority,
+                       TaskHandle_t *const          pxCreatedTask)
+{
+    HOST_TEST_VERIFY(pxTaskCode == otPlatLogDumpTask);
+    HOST_TEST_VERIFY(pthread_create(&sDumpThread, NULL, testDumpThread, pvParameters) == 0);
+    *pxCreatedTask = &sDumpThread;
+
+    return pdTRUE;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t xTaskToNotify)
+{
+    HOST_TEST_VERIFY(xTaskToNotify == &sDumpThread);
+
+    pthread_mutex_lock(&sNotifyMutex);
+    sNotifyCount++;
+    pthread_cond_signal(&sNotifyCond);
+    pthread_mutex_unlock(&sNotifyMutex);
+
+    return pdTRUE;
+}
+
+/* Blocks the dump task until it is notified, and ends it once the test is stopping and all notifications are taken */
+uint32_t ulTaskNotifyTake(BaseType_t xClearCountOnExit, TickType_t xTicksToWait)
+{
+    uint32_t count;
+
+    HOST_TEST_VERIFY(xClearCountOnExit == pdTRUE && xTicksToWait == portMAX_DELAY);
+
+    pthread_mutex_lock(&sNotifyMutex);
+    while (sNotifyCount == 0 && !sStopping)
+    {
+        pthread_cond_wait(&sNotifyCond, &sNotifyMutex);
+    }
+    count        = sNotifyCount;
+    sNotifyCount = 0;
+    pthread_mutex_unlock(&sNotifyMutex);
+
+    if (count == 0)
+    {
+        pthread_exit(NULL);
+    }
+
+    return count;
+}
+
+static void *testProducer(void *aArg)
+{
+    uint32_t producer = (uint32_t)(uintptr_t)aArg;
+    char     padding[TEST_MAX_PADDING];
+
+    pthread_barrier_wait(&sStartBarrier);
+
+    for (uint32_t sequence = 0; sequence < TEST_LOGS_PER_PRODUCER; sequence++)
+    {
+        memset(padding, testPaddingChar(sequence), sizeof(padding));
+        otPlatLog(OT_LOG_LEVEL_INFO, OT_LOG_REGION_PLATFORM, "P%u %u %.*s", (unsigned)producer, (unsigned)sequence,
+                  (int)testPaddingLength(producer, sequence), padding);
+
+        if ((sequence + 1) % TEST_BURST_LENGTH == 0)
+        {
+            testPause();
+        }
+    }
+
+    return NULL;
+}
+
+static void testConcurrentProducers(void)
+{
+    pthread_t producers[TEST_PRODUCERS];
+    uint32_t  dropped;
+
+    otPlatLogInit();
+    HOST_TEST_VERIFY(pthread_barrier_init(&sStartBarrier, NULL, TEST_PRODUCERS) == 0);
+
+    for (uint32_t i = 0; i < TEST_PRODUCERS; i++)
+    {
+        HOST_TEST_VERIFY(pthread_create(&producers[i], NULL, testProducer, (void *)(uintptr_t)i) == 0);
+    }
+
+    for (uint32_t i = 0; i < TEST_PRODUCERS; i++)
+    {
+        HOST_TEST_VERIFY(pthread_join(producers[i], NULL) == 0);
+    }
+
+    /* Let the dump task print the last logs and report the last drops before it ends */
+    xTaskNotifyGive(dump_task_handle);
+    pthread_mutex_lock(&sNotifyMutex);
+    sStopping = true;
+    pthread_cond_signal(&sNotifyCond);
+    pthread_mutex_unlock(&sNotifyMutex);
+    HOST_TEST_VERIFY(pthread_join(sDumpThread, NULL) == 0);
+    pthread_barrier_destroy(&sStartBarrier);
+
+    dropped = otPlatLogGetDroppedCount();
+    HOST_TEST_VERIFY(sPrintedTotal + dropped == TEST_PRODUCERS * TEST_LOGS_PER_PRODUCER);
+    HOST_TEST_VERIFY(sReportedDropped == dropped);
+
+    for (uint32_t i = 0; i < TEST_PRODUCERS; i++)
+    {
+        HOST_TEST_VERIFY(sPrinted[i] > 0);
+    }
+
+    /* The pauses of the dump task must have filled the ring, and every consumed record must have been cleared */
+    HOST_TEST_VERIFY(dropped > 0);
+    HOST_TEST_VERIFY(logRingBuffer.head == logRingBuffer.tail);
+
+    for (uint32_t i = 0; i < LOG_RING_BUFFER_SIZE; i++)
+    {
+        HOST_TEST_VERIFY(logRingBuffer.buffer[i] == 0);
+    }
+
+    fprintf(stderr, "%u logs printed, %u dropped\n", (unsigned)sPrintedTotal, (unsigned)dropped);
+}
+
+int main(void)
+{
+    testConcurrentProducers();
+
+    printf("logging: ok\n");
+    return 0;
+}
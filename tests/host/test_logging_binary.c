@@ -0,0 +1,339 @@
+/*
+ *  Copyright (c) 2025, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file tests the binary log mode of the platform logging (logging.c).
+ *
+ *   Logs are encoded as otPlatLog does and converted back to text as the dump task does. Expanded on target, the text
+ *   must match what vsnprintf prints, except for the truncated strings and the arguments dropped from a full record.
+ *   Encoded in hexadecimal for script/decode-binary-log, the text must hold the record as it is stored in the ring.
+ */
+
+#include "host_test.h"
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <string.h>
+
+/* Included by the target configuration of OpenThread */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "logging.c"
+
+#define TEST_TIMESTAMP 123456U
+#define TEST_LONG_STRING_LENGTH 300U
+
+/* Header of a record: the address of the format string and the timestamp */
+#define TEST_RECORD_HEADER_SIZE (sizeof(const char *) + sizeof(uint32_t))
+
+static uint32_t sNotifyCount;
+static char     sLongString[TEST_LONG_STRING_LENGTH + 1];
+
+TickType_t xTaskGetTickCount(void)
+{
+    return TEST_TIMESTAMP;
+}
+
+/* The dump task is not run, the ring is consumed by the test */
+BaseType_t xTaskCreate(TaskFunction_t               pxTaskCode,
+                       const char *const            pcName,
+                       const configSTACK_DEPTH_TYPE usStackDepth,
+                       void *const                  pvParameters,
+                       UBaseType_t                  uxPriority,
+                       TaskHandle_t *const          pxCreatedTask)
+{
+    HOST_TEST_VERIFY(false);
+    return pdFALSE;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t xClearCountOnExit, TickType_t xTicksToWait)
+{
+    HOST_TEST_VERIFY(false);
+    return 0;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t xTaskToNotify)
+{
+    sNotifyCount++;
+    return pdTRUE;
+}
+
+int DbgConsole_Printf(const char *fmt_s, ...)
+{
+    HOST_TEST_VERIFY(false);
+    return 0;
+}
+
+/* Encode a log in a record of aRecordSize bytes and convert it to text, return the length of the record */
+static uint16_t testEncode(uint8_t    *aRecord,
+                           uint16_t    aRecordSize,
+                           char       *aText,
+                           uint16_t   *aTextLen,
+                           const char *aFormat,
+                           va_list     ap)
+{
+    uint16_t len = LogBinaryEncode(aRecord, aRecordSize, aFormat, ap);
+
+    HOST_TEST_VERIFY(len <= aRecordSize);
+    *aTextLen = LogBinaryToText(aRecord, len, aText, LOG_TEXT_BUFFER_SIZE);
+    HOST_TEST_VERIFY(*aTextLen <= LOG_TEXT_BUFFER_SIZE);
+    HOST_TEST_VERIFY(memcmp(&aText[*aTextLen - EOL_CHARS_LEN], EOL_CHARS, EOL_CHARS_LEN) == 0);
+
+    return len;
+}
+
+#ifdef LOG_BINARY_EXPAND_ON_TARGET
+
+/* Check that a log expanded on target reads as aExpected, without the timestamp and the end of line characters */
+static void testExpect(const char *aExpected, const char *aFormat, ...) __attribute__((format(printf, 2, 3)));
+static void testExpect(const char *aExpected, const char *aFormat, ...)
+{
+    uint8_t  record[LOG_BUFFER_SIZE];
+    char     text[LOG_TEXT_BUFFER_SIZE];
+    char     expected[LOG_TEXT_BUFFER_SIZE];
+    uint16_t textLen;
+    int      len;
+    va_list  ap;
+
+    len = snprintf(expected, sizeof(expected), "[%u]", TEST_TIMESTAMP);
+    if (aExpected == NULL)
+    {
+        va_start(ap, aFormat);
+        len += vsnprintf(&expected[len], sizeof(expected) - len, aFormat, ap);
+        va_end(ap);
+    }
+    else
+    {
+        len += snprintf(&expected[len], sizeof(expected) - len, "%s", aExpected);
+    }
+    HOST_TEST_VERIFY(len + EOL_CHARS_LEN <= (int)sizeof(expected));
+    memcpy(&expected[len], EOL_CHARS, EOL_CHARS_LEN);
+
+    va_start(ap, aFormat);
+    testEncode(record, sizeof(record), text, &textLen, aFormat, ap);
+    va_end(ap);
+
+    if (textLen != len + EOL_CHARS_LEN || memcmp(text, expected, textLen) != 0)
+    {
+        fprintf(stderr, "format \"%s\"\n  expected \"%s\"\n  expanded \"%.*s\"\n", aFormat, expected,
+                (int)textLen - EOL_CHARS_LEN, text);
+        HOST_TEST_VERIFY(false);
+    }
+}
+
+/* Check the logs which are expanded as vsnprintf prints them */
+static void testExpandAsPrintf(void)
+{
+    const char *volatile nullString = NULL;
+    int                  local;
+
+    testExpect(NULL, "no argument");
+    testExpect(NULL, "%d %i %u %x %X %o", -42, 42, 3000000000U, 0xbeefU, 0xCAFEU, 0755U);
+    testExpect(NULL, "%ld %lu %lld %llx %zu %td", -123456789L, 123456789UL, -1234567890123LL, 0x123456789abcULL,
+               (size_t)-1, (ptrdiff_t)-3);
+    testExpect(NULL, "%hd %hu %hhd %hhx %c%c", (short)-2, (unsigned short)65535, (signed char)-1, (unsigned char)0xab,
+               'o', 'k');
+    testExpect(NULL, "[%5d|%-5d|%05d|%+d|% d|%#x]", 1, 2, 3, 4, 5, 0x6U);
+    testExpect(NULL, "[%*d|%-*d|%.*d|%*.*d]", 6, 7, 6, 8, 3, 9, 6, 3, 10);
+    testExpect(NULL, "[%s|%8s|%-8s|%.3s|%.*s|%*.*s]", "str", "right", "left", "precision", 2, "star", 6, 4, "width");
+    testExpect(NULL, "%s", "");
+    testExpect("(null)", "%s", nullString);
+    testExpect(NULL, "%p", (void *)&local);
+    testExpect(NULL, "100%% %d%%", 50);
+    testExpect(NULL, "%f %.3e %g %10.2f %Lf", 3.25, -1.5e10, 0.0001, 2.5, (long double)1.75);
+    testExpect(NULL, "%s %s %s %d", "three", "strings", "then", 4);
+}
+
+/* Check that the strings too long for a record are marked, and that the arguments which do not fit are dropped */
+static void testExpandTruncated(void)
+{
+    char expected[LOG_TEXT_BUFFER_SIZE];
+    int  len;
+
+    /* A string which is not the last argument is limited to LOG_BINARY_MAX_STRING_SIZE characters */
+    snprintf(expected, sizeof(expected), "<%.*s...> %d", LOG_BINARY_MAX_STRING_SIZE, sLongString, 42);
+    testExpect(expected, "<%s> %d", sLongString, 42);
+
+    /* The last one fills the rest of the record */
+    snprintf(expected, sizeof(expected), "line: %.*s...",
+             (int)(LOG_BUFFER_SIZE - TEST_RECORD_HEADER_SIZE - 2U), sLongString);
+    testExpect(expected, "line: %s", sLongString);
+
+    /* The precision still applies to a truncated string */
+    snprintf(expected, sizeof(expected), "%.10s...", sLongString);
+    testExpect(expected, "%.10s", sLongString);
+
+    /* An argument which does not fit in the record is printed as "?", and the rest of the log is dropped */
+    len = 0;
+    for (unsigned i = 0; i < (LOG_BUFFER_SIZE - TEST_RECORD_HEADER_SIZE) / sizeof(long long); i++)
+    {
+        len += snprintf(&expected[len], sizeof(expected) - len, "%lld ", (long long)i);
+    }
+    snprintf(&expected[len], sizeof(expected) - len, "?");
+    testExpect(expected,
+               "%lld %lld %lld %lld %lld %lld %lld %lld %lld %lld %lld %lld %lld %lld %lld %lld "
+               "%lld %lld %lld %lld %lld %lld %lld %lld %lld %lld %lld %lld %lld %lld %lld %lld end",
+               0LL, 1LL, 2LL, 3LL, 4LL, 5LL, 6LL, 7LL, 8LL, 9LL, 10LL, 11LL, 12LL, 13LL, 14LL, 15LL, 16LL, 17LL, 18LL,
+               19LL, 20LL, 21LL, 22LL, 23LL, 24LL, 25LL, 26LL, 27LL, 28LL, 29LL, 30LL, 31LL);
+}
+
+#else /* LOG_BINARY_EXPAND_ON_TARGET */
+
+static uint8_t testHexValue(char aDigit)
+{
+    HOST_TEST_VERIFY((aDigit >= '0' && aDigit <= '9') || (aDigit >= 'a' && aDigit <= 'f'));
+    return (uint8_t)((aDigit <= '9') ? aDigit - '0' : aDigit - 'a' + 10);
+}
+
+/* Encode a log and check that its text is the record in hexadecimal, return the record */
+static uint16_t testHex(uint8_t *aRecord, const char *aFormat, ...)
+{
+    char     text[LOG_TEXT_BUFFER_SIZE];
+    uint16_t textLen;
+    uint16_t len;
+    va_list  ap;
+
+    va_start(ap, aFormat);
+    len = testEncode(aRecord, LOG_BUFFER_SIZE, text, &textLen, aFormat, ap);
+    va_end(ap);
+
+    HOST_TEST_VERIFY(len >= TEST_RECORD_HEADER_SIZE);
+    HOST_TEST_VERIFY(textLen == sizeof(LOG_BINARY_PREFIX) - 1 + 2 * len + EOL_CHARS_LEN);
+    HOST_TEST_VERIFY(memcmp(text, LOG_BINARY_PREFIX, sizeof(LOG_BINARY_PREFIX) - 1) == 0);
+
+    for (uint16_t i = 0; i < len; i++)
+    {
+        const char *digits = &text[sizeof(LOG_BINARY_PREFIX) - 1 + 2 * i];
+
+        HOST_TEST_VERIFY(((testHexValue(digits[0]) << 4) | testHexValue(digits[1])) == aRecord[i]);
+    }
+
+    return len;
+}
+
+/* Check the layout of the records read by script/decode-binary-log */
+static void testHexRecord(void)
+{
+    static const char kFormat[] = "%d %s %lld %s";
+    uint8_t           record[LOG_BUFFER_SIZE];
+    uint16_t          len    = testHex(record, kFormat, -7, "abc", 0x0102030405060708LL, sLongString);
+    uint16_t          offset = 0;
+    const char       *format;
+    uint32_t          timestamp;
+    int               intValue;
+    long long         longLongValue;
+
+    memcpy(&format, &record[offset], sizeof(format));
+    offset += sizeof(format);
+    HOST_TEST_VERIFY(format == kFormat);
+    memcpy(&timestamp, &record[offset], sizeof(timestamp));
+    offset += sizeof(timestamp);
+    HOST_TEST_VERIFY(timestamp == TEST_TIMESTAMP);
+
+    memcpy(&intValue, &record[offset], sizeof(intValue));
+    offset += sizeof(intValue);
+    HOST_TEST_VERIFY(intValue == -7);
+
+    HOST_TEST_VERIFY(record[offset++] == 3);
+    HOST_TEST_VERIFY(memcmp(&record[offset], "abc", 3) == 0);
+    offset += 3;
+
+    memcpy(&longLongValue, &record[offset], sizeof(longLongValue));
+    offset += sizeof(longLongValue);
+    HOST_TEST_VERIFY(longLongValue == 0x0102030405060708LL);
+
+    /* The last string fills the record and is marked as truncated */
+    HOST_TEST_VERIFY(record[offset++] == LOG_BINARY_STRING_TRUNCATED);
+    HOST_TEST_VERIFY(record[offset] == LOG_BUFFER_SIZE - offset - 1);
+    offset++;
+    HOST_TEST_VERIFY(memcmp(&record[offset], sLongString, LOG_BUFFER_SIZE - offset) == 0);
+    HOST_TEST_VERIFY(len == LOG_BUFFER_SIZE);
+}
+
+#endif /* LOG_BINARY_EXPAND_ON_TARGET */
+
+/* Encode a log as otPlatLog does, return the length of the record */
+static uint16_t testEncodeRecord(uint8_t *aRecord, const char *aFormat, ...)
+{
+    uint16_t len;
+    va_list  ap;
+
+    va_start(ap, aFormat);
+    len = LogBinaryEncode(aRecord, LOG_BUFFER_SIZE, aFormat, ap);
+    va_end(ap);
+
+    return len;
+}
+
+/* Check that otPlatLog stores the binary records in the ring, as the dump task reads them */
+static void testRing(void)
+{
+    static const char kFormat[] = "ring %u %s";
+    uint8_t           expected[LOG_BUFFER_SIZE];
+    uint8_t           record[LOG_BUFFER_SIZE];
+    uint16_t          expectedLen;
+
+    RingInit(&logRingBuffer);
+    sNotifyCount = 0;
+
+    for (unsigned i = 0; i < 3; i++)
+    {
+        otPlatLog(OT_LOG_LEVEL_INFO, OT_LOG_REGION_PLATFORM, kFormat, i, (i == 1) ? sLongString : "short");
+    }
+    HOST_TEST_VERIFY(sNotifyCount == 3);
+
+    for (unsigned i = 0; i < 3; i++)
+    {
+        expectedLen = testEncodeRecord(expected, kFormat, i, (i == 1) ? sLongString : "short");
+        HOST_TEST_VERIFY(RingLogConsume(&logRingBuffer, record, sizeof(record)) == expectedLen);
+        HOST_TEST_VERIFY(memcmp(record, expected, expectedLen) == 0);
+    }
+    HOST_TEST_VERIFY(RingLogConsume(&logRingBuffer, record, sizeof(record)) == 0);
+    HOST_TEST_VERIFY(otPlatLogGetDroppedCount() == 0);
+}
+
+int main(void)
+{
+    memset(sLongString, 'x', TEST_LONG_STRING_LENGTH);
+    for (unsigned i = 0; i < TEST_LONG_STRING_LENGTH; i += 10)
+    {
+        sLongString[i] = (char)('0' + (i / 10) % 10);
+    }
+
+#ifdef LOG_BINARY_EXPAND_ON_TARGET
+    testExpandAsPrintf();
+    testExpandTruncated();
+#else
+    testHexRecord();
+#endif
+    testRing();
+
+    return 0;
+}
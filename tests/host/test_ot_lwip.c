@@ -0,0 +1,488 @@
+/*
+ *  Copyright (c) 2025, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file tests the queue of the lwIP packets sent to the Thread interface (ot_lwip.c).
+ *
+ *   A bulk flow and a few small interactive flows are sent over a simulated 250 kbit/s Thread link. The OpenThread
+ *   task sends one queued packet each time the link is idle, so the order of the packets on air is the one chosen by
+ *   the deficit round robin. The latency of the small packets is printed, and checked to stay within the airtime of
+ *   two bulk packets when the packets are spread in flows. Built with a single flow, the queue is a FIFO and the small
+ *   packets wait behind the whole bulk backlog.
+ *
+ *   Packets of all sizes are also looped from pbuf chains to OpenThread messages and back. Each direction must copy
+ *   every byte exactly once, and the packets per second of the loopback and the bytes copied per packet are printed.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "host_test.h"
+
+#include <string.h>
+#include <time.h>
+
+#include "lwip/ot_lwip.c"
+
+#define TEST_LINK_US_PER_BYTE 32U /* 250 kbit/s */
+#define TEST_BULK_LENGTH 1280U
+#define TEST_BULK_PERIOD_US 10000U
+#define TEST_SMALL_LENGTH 100U
+#define TEST_SMALL_PERIOD_US 100000U
+#define TEST_SMALL_JITTER_US 20000U
+#define TEST_SMALL_FLOWS 3U
+#define TEST_DURATION_US 600000000ULL
+#define TEST_MAX_SMALL_PACKETS ((TEST_DURATION_US / TEST_SMALL_PERIOD_US + 1U) * TEST_SMALL_FLOWS)
+#define TEST_LOOPBACK_PACKETS 200000U
+
+/* Payload of the simulated packets, after the IPv6 header */
+typedef struct TestPacketInfo
+{
+    uint64_t mOfferedAt;
+    uint32_t mSequence;
+    uint8_t  mSource;
+} TestPacketInfo;
+
+static otInstance *sTestInstance = (otInstance *)&sTestInstance;
+static uint64_t    sNow;
+static uint64_t    sLinkFreeAt;
+static uint32_t    sSentSequence;
+static bool        sSentInOrder;
+static uint32_t    sSentBytes[1 + TEST_SMALL_FLOWS];
+static uint32_t    sSentPackets[1 + TEST_SMALL_FLOWS];
+static uint32_t   *sSmallLatencies;
+static uint32_t    sSmallLatencyCount;
+static uint8_t     sDestinations[1 + TEST_SMALL_FLOWS][OT_IP6_ADDRESS_SIZE];
+
+static void testLockTask(bool aLock)
+{
+    OT_UNUSED_VARIABLE(aLock);
+}
+
+void otSysEventSetPending(otSysEvent aEvent)
+{
+    OT_UNUSED_VARIABLE(aEvent);
+}
+
+void otTaskletsSignalPending(otInstance *aInstance)
+{
+    OT_UNUSED_VARIABLE(aInstance);
+}
+
+void otIp6SetReceiveCallback(otInstance *aInstance, otIp6ReceiveCallback aCallback, void *aContext)
+{
+    OT_UNUSED_VARIABLE(aInstance);
+    OT_UNUSED_VARIABLE(aCallback);
+    OT_UNUSED_VARIABLE(aContext);
+}
+
+void otIp6SetReceiveFilterEnabled(otInstance *aInstance, bool aEnabled)
+{
+    OT_UNUSED_VARIABLE(aInstance);
+    OT_UNUSED_VARIABLE(aEnabled);
+}
+
+void otIcmp6SetEchoMode(otInstance *aInstance, otIcmp6EchoMode aMode)
+{
+    OT_UNUSED_VARIABLE(aInstance);
+    OT_UNUSED_VARIABLE(aMode);
+}
+
+bool otIp6IsEnabled(otInstance *aInstance)
+{
+    OT_UNUSED_VARIABLE(aInstance);
+    return true;
+}
+
+const otNetifAddress *otIp6GetUnicastAddresses(otInstance *aInstance)
+{
+    OT_UNUSED_VARIABLE(aInstance);
+    return NULL;
+}
+
+/* The message is sent on air from now, the link is busy until it is sent */
+otError otIp6Send(otInstance *aInstance, otMessage *aMessage)
+{
+    TestPacketInfo info;
+    uint16_t       length = otMessageGetLength(aMessage);
+
+    HOST_TEST_VERIFY(aInstance == sTestInstance);
+    HOST_TEST_VERIFY(sLinkFreeAt <= sNow);
+    HOST_TEST_VERIFY(otMessageRead(aMessage, IP6_HLEN, &info, sizeof(info)) == sizeof(info));
+
+    if (info.mSequence < sSentSequence)
+    {
+        sSentInOrder = false;
+    }
+    sSentSequence = info.mSequence;
+    sSentBytes[info.mSource] += length;
+    sSentPackets[info.mSource]++;
+
+    if ((info.mSource > 0) && (sSmallLatencies != NULL))
+    {
+        HOST_TEST_VERIFY(sSmallLatencyCount < TEST_MAX_SMALL_PACKETS);
+        sSmallLatencies[sSmallLatencyCount++] = (uint32_t)(sNow - info.mOfferedAt);
+    }
+
+    sLinkFreeAt = sNow + (uint64_t)length * TEST_LINK_US_PER_BYTE;
+    otMessageFree(aMessage);
+
+    return OT_ERROR_NONE;
+}
+
+static void testSetDestination(struct pbuf *aPkt, const uint8_t *aDestination)
+{
+    struct ip6_hdr *header = (struct ip6_hdr *)aPkt->payload;
+
+    memset(header, 0, IP6_HLEN);
+    header->_v_tc_fl = lwip_htonl(6UL << 28);
+    memcpy(&header->dest, aDestination, OT_IP6_ADDRESS_SIZE);
+}
+
+/* Pick destinations which are hashed to different flows */
+static void testInitDestinations(void)
+{
+    struct pbuf *pkt      = pbuf_alloc(PBUF_TRANSPORT, IP6_HLEN, PBUF_RAM);
+    uint8_t      used     = 0;
+    uint8_t      assigned = 0;
+
+    for (uint16_t host = 1; assigned < 1 + TEST_SMALL_FLOWS; host++)
+    {
+        uint8_t destination[OT_IP6_ADDRESS_SIZE] = {0xfd, 0x00, 0x0d, 0xb8};
+        uint8_t flow;
+
+        HOST_TEST_VERIFY(host < 1000);
+        destination[14] = (uint8_t)(host >> 8);
+        destination[15] = (uint8_t)host;
+        testSetDestination(pkt, destination);
+        flow = otPlatLwipGetFlowIndex(pkt);
+
+        if ((OT_LWIP_INGRESS_FLOWS >= 1 + TEST_SMALL_FLOWS) && (used & (1U << flow)))
+        {
+            continue;
+        }
+        used |= (uint8_t)(1U << flow);
+        memcpy(sDestinations[assigned++], destination, sizeof(destination));
+    }
+
+    pbuf_free(pkt);
+}
+
+/* Send a packet from lwIP to the Thread interface, lwIP then frees its own reference */
+static err_t testOffer(uint8_t aSource, uint16_t aLength, uint32_t aSequence)
+{
+    struct pbuf   *pkt  = pbuf_alloc(PBUF_TRANSPORT, aLength, PBUF_RAM);
+    TestPacketInfo info = {sNow, aSequence, aSource};
+    struct netif  *netif;
+    err_t          error;
+
+    testSetDestination(pkt, sDestinations[aSource]);
+    memcpy((uint8_t *)pkt->payload + IP6_HLEN, &info, sizeof(info));
+
+    netif = otPlatLwipGetOtNetif();
+    error = netif->output_ip6(netif, pkt, NULL);
+    pbuf_free(pkt);
+
+    return error;
+}
+
+static void testResetCounters(void)
+{
+    sNow          = 0;
+    sLinkFreeAt   = 0;
+    sSentSequence = 0;
+    sSentInOrder  = true;
+    memset(sSentBytes, 0, sizeof(sSentBytes));
+    memset(sSentPackets, 0, sizeof(sSentPackets));
+}
+
+static void testDrain(void)
+{
+    while (sIngressCount > 0)
+    {
+        sNow = sLinkFreeAt;
+        otPlatLwipProcess();
+    }
+
+    HOST_TEST_VERIFY(sActiveCount == 0);
+    HOST_TEST_VERIFY(hostTestPbufCount() == 0);
+    HOST_TEST_VERIFY(hostTestMessageCount() == 0);
+}
+
+static int testCompareLatency(const void *aFirst, const void *aSecond)
+{
+    uint32_t first  = *(const uint32_t *)aFirst;
+    uint32_t second = *(const uint32_t *)aSecond;
+
+    return (first > second) - (first < second);
+}
+
+static uint32_t testPercentile(unsigned aPercent)
+{
+    return sSmallLatencies[((uint64_t)(sSmallLatencyCount - 1) * aPercent) / 100U];
+}
+
+/* Two backlogged flows get the same share of the link bytes, whatever the size of their packets */
+static void testByteFairness(void)
+{
+    const uint32_t rounds = 20000;
+
+    testResetCounters();
+
+    for (uint32_t i = 0; i < rounds; i++)
+    {
+        while (testOffer(0, TEST_BULK_LENGTH, 0) == ERR_OK)
+        {
+        }
+        while (testOffer(1, TEST_SMALL_LENGTH, 0) == ERR_OK)
+        {
+        }
+        sNow = sLinkFreeAt;
+        otPlatLwipProcess();
+    }
+
+    printf("byte fairness: bulk %u bytes, small %u bytes\n", (unsigned)sSentBytes[0], (unsigned)sSentBytes[1]);
+
+#if OT_LWIP_INGRESS_FLOWS >= 2
+    {
+        uint32_t difference =
+            (sSentBytes[0] > sSentBytes[1]) ? sSentBytes[0] - sSentBytes[1] : sSentBytes[1] - sSentBytes[0];
+
+        HOST_TEST_VERIFY(difference <= TEST_BULK_LENGTH + OT_LWIP_INGRESS_FLOW_QUANTUM);
+    }
+#endif
+
+    testDrain();
+}
+
+/* Small flows sent while a bulk flow keeps the queue full */
+static void testSmallFlowLatency(void)
+{
+    const uint32_t bulkAirtime  = TEST_BULK_LENGTH * TEST_LINK_US_PER_BYTE;
+    const uint32_t smallAirtime = TEST_SMALL_LENGTH * TEST_LINK_US_PER_BYTE;
+    uint64_t       nextBulk     = 0;
+    uint64_t       nextSmall[TEST_SMALL_FLOWS];
+    uint32_t       sequence     = 0;
+    uint32_t       smallDropped = 0;
+    uint32_t       offered[1 + TEST_SMALL_FLOWS];
+    uint64_t       busyTime = 0;
+
+    testResetCounters();
+    memset(offered, 0, sizeof(offered));
+    sSmallLatencies    = (uint32_t *)calloc(TEST_MAX_SMALL_PACKETS, sizeof(uint32_t));
+    sSmallLatencyCount = 0;
+    HOST_TEST_VERIFY(sSmallLatencies != NULL);
+
+    for (uint8_t i = 0; i < TEST_SMALL_FLOWS; i++)
+    {
+        nextSmall[i] = (uint64_t)rand() % TEST_SMALL_PERIOD_US;
+    }
+
+    while (sNow < TEST_DURATION_US)
+    {
+        uint64_t next = nextBulk;
+
+        if (nextBulk <= sNow)
+        {
+            testOffer(0, TEST_BULK_LENGTH, sequence++);
+            offered[0]++;
+            nextBulk += TEST_BULK_PERIOD_US;
+        }
+
+        for (uint8_t i = 0; i < TEST_SMALL_FLOWS; i++)
+        {
+            if (nextSmall[i] <= sNow)
+            {
+                if (testOffer(1 + i, TEST_SMALL_LENGTH, sequence++) != ERR_OK)
+                {
+                    smallDropped++;
+                }
+                offered[1 + i]++;
+                nextSmall[i] += TEST_SMALL_PERIOD_US + (uint64_t)rand() % TEST_SMALL_JITTER_US;
+            }
+            next = (nextSmall[i] < next) ? nextSmall[i] : next;
+        }
+
+        if ((sLinkFreeAt <= sNow) && (sIngressCount > 0))
+        {
+            uint64_t sentFrom = sNow;
+
+            otPlatLwipProcess();
+            busyTime += sLinkFreeAt - sentFrom;
+        }
+
+        if ((sLinkFreeAt > sNow) && (sLinkFreeAt < next))
+        {
+            next = sLinkFreeAt;
+        }
+        sNow = next;
+    }
+
+    qsort(sSmallLatencies, sSmallLatencyCount, sizeof(uint32_t), testCompareLatency);
+    printf("flows %u: small packets p50 %u us, p99 %u us, max %u us, %u dropped; bulk %u sent of %u; link busy %u%%\n",
+           (unsigned)OT_LWIP_INGRESS_FLOWS, (unsigned)testPercentile(50), (unsigned)testPercentile(99),
+           (unsigned)sSmallLatencies[sSmallLatencyCount - 1], (unsigned)smallDropped, (unsigned)sSentPackets[0],
+           (unsigned)offered[0], (unsigned)((busyTime * 100U) / sNow));
+
+    HOST_TEST_VERIFY(busyTime * 100U >= sNow * 95U);
+
+#if OT_LWIP_INGRESS_FLOWS >= 1 + TEST_SMALL_FLOWS
+    /* A small packet waits at most for the bulk packet on air, one more bulk packet and the other small flows */
+    HOST_TEST_VERIFY(smallDropped == 0);
+    HOST_TEST_VERIFY(sSmallLatencies[sSmallLatencyCount - 1] <= 2U * bulkAirtime + TEST_SMALL_FLOWS * smallAirtime);
+#else
+    /* A single flow is a FIFO */
+    HOST_TEST_VERIFY(sSentInOrder);
+    OT_UNUSED_VARIABLE(bulkAirtime);
+    OT_UNUSED_VARIABLE(smallAirtime);
+#endif
+
+    free(sSmallLatencies);
+    sSmallLatencies = NULL;
+
+    testDrain();
+
+    {
+        otPlatLwipIngressStats ingressStats;
+        uint32_t               enqueued = 0;
+        uint32_t               dropped  = 0;
+
+        otPlatLwipGetIngressStats(&ingressStats);
+        for (uint8_t i = 0; i < OT_LWIP_INGRESS_FLOWS; i++)
+        {
+            otPlatLwipFlowStats flowStats;
+
+            HOST_TEST_VERIFY(otPlatLwipGetFlowStats(i, &flowStats));
+            HOST_TEST_VERIFY(flowStats.mEnqueued == flowStats.mSentPackets);
+            enqueued += flowStats.mEnqueued;
+            dropped += flowStats.mDropped;
+        }
+        HOST_TEST_VERIFY(!otPlatLwipGetFlowStats(OT_LWIP_INGRESS_FLOWS, NULL));
+        HOST_TEST_VERIFY(enqueued == ingressStats.mEnqueued);
+        HOST_TEST_VERIFY(dropped == ingressStats.mDropped);
+        HOST_TEST_VERIFY(ingressStats.mSendFailed == 0);
+        HOST_TEST_VERIFY(ingressStats.mMaxDepth <= OT_LWIP_INGRESS_QUEUE_SIZE);
+    }
+}
+
+static void testFillPattern(struct pbuf *aPkt, uint32_t aSeed)
+{
+    uint16_t offset = 0;
+
+    for (struct pbuf *segment = aPkt; segment != NULL; segment = segment->next)
+    {
+        for (uint16_t i = 0; i < segment->len; i++, offset++)
+        {
+            ((uint8_t *)segment->payload)[i] = (uint8_t)(aSeed + offset * 7U);
+        }
+    }
+}
+
+static void testCheckPattern(const struct pbuf *aPkt, uint32_t aSeed)
+{
+    uint16_t offset = 0;
+
+    for (const struct pbuf *segment = aPkt; segment != NULL; segment = segment->next)
+    {
+        for (uint16_t i = 0; i < segment->len; i++, offset++)
+        {
+            HOST_TEST_VERIFY(((const uint8_t *)segment->payload)[i] == (uint8_t)(aSeed + offset * 7U));
+        }
+    }
+    HOST_TEST_VERIFY(offset == aPkt->tot_len);
+}
+
+/* pbuf chain to message and back, as a packet forwarded between the infrastructure and the Thread interface */
+static void testLoopbackCopies(void)
+{
+    otPlatLwipCopyStats before;
+    otPlatLwipCopyStats after;
+    uint32_t            bytes = 0;
+    struct timespec     start;
+    struct timespec     end;
+    double              seconds;
+
+    otPlatLwipGetCopyStats(&before);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for (uint32_t i = 0; i < TEST_LOOPBACK_PACKETS; i++)
+    {
+        uint16_t     length = (uint16_t)(IP6_HLEN + i % (OPENTHREAD_CONFIG_IP6_MAX_DATAGRAM_LENGTH - IP6_HLEN + 1));
+        struct pbuf *pkt    = pbuf_alloc(PBUF_RAW, length, PBUF_POOL);
+        otMessage   *message;
+
+        HOST_TEST_VERIFY(pkt != NULL);
+        testFillPattern(pkt, i);
+
+        message = otPlatLwipConvertToOtMsg(pkt);
+        HOST_TEST_VERIFY(message != NULL && otMessageGetLength(message) == length);
+        pbuf_free(pkt);
+
+        /* Alternate the pool chains of received packets and the RAM pbufs of transport packets */
+        pkt = otPlatLwipConvertToLwipMsg(message, (i % 2) != 0);
+        HOST_TEST_VERIFY(pkt != NULL && pkt->tot_len == length);
+        otMessageFree(message);
+
+        testCheckPattern(pkt, i);
+        pbuf_free(pkt);
+        bytes += length;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    otPlatLwipGetCopyStats(&after);
+
+    HOST_TEST_VERIFY(after.mToOtPackets - before.mToOtPackets == TEST_LOOPBACK_PACKETS);
+    HOST_TEST_VERIFY(after.mToLwipPackets - before.mToLwipPackets == TEST_LOOPBACK_PACKETS);
+    HOST_TEST_VERIFY(after.mToOtBytes - before.mToOtBytes == bytes);
+    HOST_TEST_VERIFY(after.mToLwipBytes - before.mToLwipBytes == bytes);
+    HOST_TEST_VERIFY(hostTestPbufCount() == 0);
+    HOST_TEST_VERIFY(hostTestMessageCount() == 0);
+
+    seconds = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+    printf("loopback: %.0f packets/s, %.1f bytes copied per packet of %.1f bytes\n", TEST_LOOPBACK_PACKETS / seconds,
+           (double)(after.mToOtBytes - before.mToOtBytes + after.mToLwipBytes - before.mToLwipBytes) /
+               TEST_LOOPBACK_PACKETS,
+           (double)bytes / TEST_LOOPBACK_PACKETS);
+}
+
+int main(void)
+{
+    srand(1);
+
+    otPlatLwipInit(testLockTask);
+    otPlatLwipSetOtInstance(sTestInstance);
+    otPlatLwipAddThreadInterface();
+    testInitDestinations();
+
+    testByteFairness();
+    testSmallFlowLatency();
+    testLoopbackCopies();
+
+    printf("ot lwip: ok\n");
+    return 0;
+}
@@ -0,0 +1,447 @@
+/*
+ *  Copyright (c) 2025, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file tests the records of the RAM buffer used by the PDM settings (ram_storage.c).
+ *
+ *   The deleted records stay in place until the buffer is compacted. The RAM buffer is compared with a reference
+ *   model after every random operation, without padding at the end of the backend regions, with the deleted dummy
+ *   entries of the current padding, and with the plain kRamBufferDummyKey entries of older images.
+ */
+
+#include "host_test.h"
+
+#include <stdbool.h>
+#include <string.h>
+
+#include <openthread/platform/memory.h>
+#include <openthread/platform/toolchain.h>
+
+#include "ram_storage.h"
+
+#define TEST_REGION_SIZE 256
+#define TEST_BUFFER_SIZE 600
+#define TEST_KEY_COUNT 12
+#define TEST_VALUE_MAX_SIZE 64
+#define TEST_MAX_RECORDS 300
+
+typedef enum
+{
+    kTestNoPadding,
+    kTestPadding,
+    kTestLegacyPadding,
+} testPadding_t;
+
+typedef struct
+{
+    uint16_t key;
+    uint16_t length;
+    uint8_t  value[TEST_VALUE_MAX_SIZE];
+} testRecord_t;
+
+static testPadding_t sPadding;
+static testRecord_t  sRecords[TEST_MAX_RECORDS];
+static unsigned      sRecordCount;
+static uint8_t       sBuffer[TEST_BUFFER_SIZE];
+#if PDM_SAVE_IDLE
+static uint8_t sSaved[TEST_BUFFER_SIZE];
+#endif
+
+/* Pad the end of the current region as the PDM glue would, with a deleted dummy entry or as older images did */
+rsError ramStorageEnsureBlockConsistency(ramBufferDescriptor *pBuffer, uint16_t aValueLength)
+{
+    uint16_t             blockLength = sizeof(struct settingsBlock) + aValueLength;
+    uint16_t             regionEnd   = (pBuffer->header.length / TEST_REGION_SIZE + 1) * TEST_REGION_SIZE;
+    uint16_t             padLength   = regionEnd - pBuffer->header.length;
+    struct settingsBlock dummy;
+
+    if ((sPadding == kTestNoPadding) || (pBuffer->header.length + blockLength <= regionEnd))
+    {
+        return RS_ERROR_NONE;
+    }
+
+    if ((padLength < sizeof(struct settingsBlock)) || (regionEnd > pBuffer->header.maxLength))
+    {
+        return RS_ERROR_NO_BUFS;
+    }
+
+    dummy.key    = kRamBufferDummyKey;
+    dummy.length = padLength - sizeof(dummy);
+    if (sPadding == kTestPadding)
+    {
+        dummy.length |= kRamBufferDeletedFlag;
+    }
+    memcpy(&pBuffer->buffer[pBuffer->header.length], &dummy, sizeof(dummy));
+    memset(&pBuffer->buffer[pBuffer->header.length + sizeof(dummy)], 0xAA, padLength - sizeof(dummy));
+    pBuffer->header.length = regionEnd;
+
+    return RS_ERROR_NONE;
+}
+
+static void testInitBuffer(ramBufferDescriptor *aDescr)
+{
+    memset(aDescr, 0, sizeof(*aDescr));
+    memset(sBuffer, 0, sizeof(sBuffer));
+    aDescr->buffer                   = sBuffer;
+    aDescr->header.maxLength         = TEST_BUFFER_SIZE;
+    aDescr->header.extendedSearch    = TRUE;
+    aDescr->header.backendRegionSize = TEST_REGION_SIZE;
+    sRecordCount                     = 0;
+}
+
+static void testDeinitBuffer(ramBufferDescriptor *aDescr)
+{
+#if RAM_STORAGE_INDEX
+    otPlatFree(aDescr->header.index);
+    aDescr->header.index = NULL;
+#else
+    OT_UNUSED_VARIABLE(aDescr);
+#endif
+}
+
+static uint16_t testAppendRaw(uint16_t aOffset, uint16_t aKey, const char *aValue)
+{
+    struct settingsBlock block = {aKey, (uint16_t)strlen(aValue)};
+
+    memcpy(&sBuffer[aOffset], &block, sizeof(block));
+    memcpy(&sBuffer[aOffset + sizeof(block)], aValue, block.length);
+
+    return aOffset + sizeof(block) + block.length;
+}
+
+static void testVerifyValue(ramBufferDescriptor *aDescr, uint16_t aKey, int aIndex, const char *aValue)
+{
+    uint8_t  value[TEST_VALUE_MAX_SIZE];
+    uint16_t length = sizeof(value);
+
+    HOST_TEST_VERIFY(ramStorageGet(aDescr, aKey, aIndex, value, &length) == RS_ERROR_NONE);
+    HOST_TEST_VERIFY(length == strlen(aValue) && memcmp(value, aValue, length) == 0);
+}
+
+/* A record of key kRamBufferDummyKey in an image written before the deleted records is still a record */
+static void testLegacyDummyKeyRecord(void)
+{
+    ramBufferDescriptor descr = {0};
+    uint16_t            length;
+
+    testInitBuffer(&descr);
+    length = testAppendRaw(0, 1, "first");
+    length = testAppendRaw(length, kRamBufferDummyKey, "legacy");
+    length = testAppendRaw(length, 2, "last");
+
+    descr.header.length = length;
+    ramStorageMarkDirty(&descr, 0, length);
+
+    testVerifyValue(&descr, kRamBufferDummyKey, 0, "legacy");
+    HOST_TEST_VERIFY(ramStorageDelete(&descr, 1, -1) == RS_ERROR_NONE);
+    HOST_TEST_VERIFY(descr.header.length == length);
+    testVerifyValue(&descr, kRamBufferDummyKey, 0, "legacy");
+
+    HOST_TEST_VERIFY(ramStorageCompact(&descr) == sizeof(struct settingsBlock) + strlen("first"));
+    testVerifyValue(&descr, kRamBufferDummyKey, 0, "legacy");
+    testVerifyValue(&descr, 2, 0, "last");
+    HOST_TEST_VERIFY(ramStorageGet(&descr, 1, 0, NULL, NULL) == RS_ERROR_NOT_FOUND);
+
+    testDeinitBuffer(&descr);
+}
+
+#if RAM_STORAGE_LEGACY_DUMMY_PADDING
+/* A kRamBufferDummyKey entry padding a region in an older image is reclaimed, a record ending at a boundary is not */
+static void testLegacyDummyPadding(void)
+{
+    ramBufferDescriptor descr = {0};
+    char                first[TEST_REGION_SIZE];
+    char                legacy[TEST_REGION_SIZE];
+    uint16_t            length;
+
+    /* Region 0: a record and the padding in front of a record which does not fit in its 6 bytes */
+    memset(first, 'f', sizeof(first));
+    first[TEST_REGION_SIZE - 6 - sizeof(struct settingsBlock)] = '\0';
+    /* Region 1: a kRamBufferDummyKey record up to the boundary, followed by a shorter record */
+    memset(legacy, 'l', sizeof(legacy));
+    legacy[TEST_REGION_SIZE - 3 * sizeof(struct settingsBlock) - strlen("next") - strlen("0123456789")] = '\0';
+
+    sPadding = kTestNoPadding;
+    testInitBuffer(&descr);
+    length = testAppendRaw(0, 1, first);
+    length = testAppendRaw(length, kRamBufferDummyKey, "pa");
+    HOST_TEST_VERIFY(length == TEST_REGION_SIZE);
+    length = testAppendRaw(length, 2, "next");
+    length = testAppendRaw(length, 3, "0123456789");
+    length = testAppendRaw(length, kRamBufferDummyKey, legacy);
+    HOST_TEST_VERIFY(length == 2 * TEST_REGION_SIZE);
+    length = testAppendRaw(length, 4, "x");
+
+    descr.header.length = length;
+    ramStorageMarkDirty(&descr, 0, length);
+
+    HOST_TEST_VERIFY(ramStorageDelete(&descr, 1, 0) == RS_ERROR_NONE);
+    HOST_TEST_VERIFY(ramStorageCompact(&descr) == TEST_REGION_SIZE);
+    HOST_TEST_VERIFY(descr.header.length == length - TEST_REGION_SIZE);
+    testVerifyValue(&descr, 2, 0, "next");
+    testVerifyValue(&descr, 3, 0, "0123456789");
+    testVerifyValue(&descr, 4, 0, "x");
+    HOST_TEST_VERIFY(ramStorageGet(&descr, kRamBufferDummyKey, 0, NULL, &length) == RS_ERROR_NONE);
+    HOST_TEST_VERIFY(length == strlen(legacy));
+    HOST_TEST_VERIFY(ramStorageGet(&descr, kRamBufferDummyKey, 1, NULL, NULL) == RS_ERROR_NOT_FOUND);
+
+    testDeinitBuffer(&descr);
+}
+#endif
+
+/* Deleting a record only rewrites its length, the following records do not move */
+static void testDeleteInPlace(void)
+{
+    ramBufferDescriptor  descr = {0};
+    struct settingsBlock block;
+    uint16_t             length;
+
+    testInitBuffer(&descr);
+    HOST_TEST_VERIFY(ramStorageAdd(&descr, 3, (const uint8_t *)"abc", 3) == RS_ERROR_NONE);
+    HOST_TEST_VERIFY(ramStorageAdd(&descr, 4, (const uint8_t *)"defg", 4) == RS_ERROR_NONE);
+    HOST_TEST_VERIFY(ramStorageAdd(&descr, 3, (const uint8_t *)"hi", 2) == RS_ERROR_NONE);
+    length = descr.header.length;
+
+#if PDM_SAVE_IDLE
+    descr.header.dirtySegments = 0;
+#endif
+    HOST_TEST_VERIFY(ramStorageDelete(&descr, 3, 0) == RS_ERROR_NONE);
+    HOST_TEST_VERIFY(descr.header.length == length);
+#if PDM_SAVE_IDLE
+    HOST_TEST_VERIFY(descr.header.dirtySegments == 1);
+#endif
+
+    memcpy(&block, sBuffer, sizeof(block));
+    HOST_TEST_VERIFY(block.key == 3 && block.length == (3 | kRamBufferDeletedFlag));
+    testVerifyValue(&descr, 3, 0, "hi");
+    testVerifyValue(&descr, 4, 0, "defg");
+
+    /* The last record is dropped */
+    HOST_TEST_VERIFY(ramStorageDelete(&descr, 3, 0) == RS_ERROR_NONE);
+    HOST_TEST_VERIFY(descr.header.length == length - sizeof(struct settingsBlock) - 2);
+
+    HOST_TEST_VERIFY(ramStorageAdd(&descr, 5, NULL, kRamBufferMaxLength) == RS_ERROR_NO_BUFS);
+
+    testDeinitBuffer(&descr);
+}
+
+static void testModelAdd(uint16_t aKey, const uint8_t *aValue, uint16_t aLength)
+{
+    HOST_TEST_VERIFY(sRecordCount < TEST_MAX_RECORDS);
+    sRecords[sRecordCount].key    = aKey;
+    sRecords[sRecordCount].length = aLength;
+    memcpy(sRecords[sRecordCount].value, aValue, aLength);
+    sRecordCount++;
+}
+
+/* Remove the aIndex-th record of aKey, or all of them if aIndex is -1 */
+static void testModelDelete(uint16_t aKey, int aIndex)
+{
+    unsigned kept  = 0;
+    int      index = 0;
+
+    for (unsigned i = 0; i < sRecordCount; i++)
+    {
+        if ((sRecords[i].key == aKey) && ((aIndex == -1) || (index++ == aIndex)))
+        {
+            continue;
+        }
+        sRecords[kept++] = sRecords[i];
+    }
+    sRecordCount = kept;
+}
+
+static void testVerifyModel(ramBufferDescriptor *aDescr, const uint16_t *aKeys)
+{
+    for (unsigned k = 0; k < TEST_KEY_COUNT; k++)
+    {
+        uint8_t  value[TEST_VALUE_MAX_SIZE];
+        uint16_t length;
+        int      index = 0;
+
+        for (unsigned i = 0; i < sRecordCount; i++)
+        {
+            if (sRecords[i].key == aKeys[k])
+            {
+                length = sizeof(value);
+                HOST_TEST_VERIFY(ramStorageGet(aDescr, aKeys[k], index++, value, &length) == RS_ERROR_NONE);
+                HOST_TEST_VERIFY(length == sRecords[i].length);
+                HOST_TEST_VERIFY(memcmp(value, sRecords[i].value, length) == 0);
+            }
+        }
+
+        length = sizeof(value);
+        HOST_TEST_VERIFY(ramStorageGet(aDescr, aKeys[k], index, value, &length) == RS_ERROR_NOT_FOUND);
+        HOST_TEST_VERIFY(length == 0);
+    }
+
+#if PDM_SAVE_IDLE
+    /* The regions not marked dirty must be as they were last saved */
+    for (uint16_t segment = 0; segment * TEST_REGION_SIZE < aDescr->header.length; segment++)
+    {
+        uint16_t offset = segment * TEST_REGION_SIZE;
+        uint16_t length = aDescr->header.length - offset;
+
+        length = (length > TEST_REGION_SIZE) ? TEST_REGION_SIZE : length;
+        if ((aDescr->header.dirtySegments & RAM_STORAGE_SEGMENT_BIT(segment)) == 0)
+        {
+            HOST_TEST_VERIFY(memcmp(&sBuffer[offset], &sSaved[offset], length) == 0);
+        }
+    }
+
+    if (rand() % 3 == 0)
+    {
+        memcpy(sSaved, sBuffer, sizeof(sSaved));
+        aDescr->header.dirtySegments = 0;
+    }
+#endif
+}
+
+/* Random operations compared with the reference model, kRamBufferDummyKey is a regular key when it is not padding */
+static void testRandomOperations(testPadding_t aPadding, unsigned aOperations)
+{
+    ramBufferDescriptor descr = {0};
+    uint16_t            keys[TEST_KEY_COUNT];
+    unsigned            noBufs = 0;
+
+    for (unsigned k = 0; k < TEST_KEY_COUNT; k++)
+    {
+        keys[k] = (uint16_t)k;
+    }
+    if ((aPadding == kTestNoPadding) && !RAM_STORAGE_LEGACY_DUMMY_PADDING)
+    {
+        keys[TEST_KEY_COUNT - 1] = kRamBufferDummyKey;
+    }
+
+    sPadding = aPadding;
+    testInitBuffer(&descr);
+#if PDM_SAVE_IDLE
+    memset(sSaved, 0, sizeof(sSaved));
+#endif
+
+    for (unsigned op = 0; op < aOperations; op++)
+    {
+        uint16_t key    = keys[rand() % TEST_KEY_COUNT];
+        uint16_t length = (uint16_t)(rand() % ((aPadding != kTestNoPadding) ? 40 : TEST_VALUE_MAX_SIZE));
+        uint8_t  value[TEST_VALUE_MAX_SIZE];
+        int      action = rand() % 10;
+        int      count  = 0;
+        int      first  = -1;
+
+        for (uint16_t i = 0; i < length; i++)
+        {
+            value[i] = (uint8_t)rand();
+        }
+
+        for (unsigned i = 0; i < sRecordCount; i++)
+        {
+            if (sRecords[i].key == key)
+            {
+                first = (first == -1) ? (int)i : first;
+                count++;
+            }
+        }
+
+        if (action < 3)
+        {
+            if (ramStorageAdd(&descr, key, value, length) == RS_ERROR_NONE)
+            {
+                testModelAdd(key, value, length);
+            }
+            else
+            {
+                noBufs++;
+            }
+        }
+        else if (action < 6)
+        {
+            rsError error = ramStorageSet(&descr, key, value, length);
+
+            if ((first != -1) && (sRecords[first].length == length))
+            {
+                HOST_TEST_VERIFY(error == RS_ERROR_NONE);
+                memcpy(sRecords[first].value, value, length);
+            }
+            else
+            {
+                testModelDelete(key, -1);
+                if (error == RS_ERROR_NONE)
+                {
+                    testModelAdd(key, value, length);
+                }
+                else
+                {
+                    noBufs++;
+                }
+            }
+        }
+        else if (action < 8)
+        {
+            int     index = (rand() % 4 == 0) ? -1 : rand() % 3;
+            rsError error = ramStorageDelete(&descr, key, index);
+
+            HOST_TEST_VERIFY((error == RS_ERROR_NONE) == ((index == -1) ? (count > 0) : (index < count)));
+            testModelDelete(key, index);
+        }
+        else if (action == 8)
+        {
+            (void)ramStorageCompact(&descr);
+        }
+        else
+        {
+            /* The buffer written directly, as done when it is loaded */
+            ramStorageMarkDirty(&descr, 0, 0);
+        }
+
+        testVerifyModel(&descr, keys);
+    }
+
+    /* The random lengths fill the buffer at times */
+    HOST_TEST_VERIFY(noBufs > 0);
+
+    testDeinitBuffer(&descr);
+}
+
+int main(void)
+{
+    srand(1);
+
+    testLegacyDummyKeyRecord();
+    testDeleteInPlace();
+    testRandomOperations(kTestNoPadding, 100000);
+    testRandomOperations(kTestPadding, 100000);
+#if RAM_STORAGE_LEGACY_DUMMY_PADDING
+    testLegacyDummyPadding();
+    testRandomOperations(kTestLegacyPadding, 100000);
+#endif
+
+    printf("ram storage: ok\n");
+
+    return 0;
+}
@@ -0,0 +1,342 @@
+/*
+ *  Copyright (c) 2025, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file tests the crash consistency of the settings journal (settings_buffer.c), saved with the file system
+ *   of flash_littlefs.c or flash_fsa.c.
+ *
+ *   The file system is emulated in RAM. Every file write or deletion is a step where the device can reset, and file
+ *   deletions and writes fail at random. After a reset at any step, the settings must reload either as they were
+ *   before the save or as they are after it, and a completed save must always reload as the saved settings.
+ */
+
+#include "host_test.h"
+
+#include <string.h>
+
+#if defined(TEST_FLASH_FSA)
+#include "flash_fsa.c"
+#define TEST_FS(aName) FSA_##aName
+#else
+#include "flash_littlefs.c"
+#define TEST_FS(aName) FS_##aName
+#endif
+
+#define TEST_FILE_MAX_SIZE 2048
+#define TEST_MAX_STEPS 8
+#define TEST_KEY_COUNT 24
+#define TEST_VALUE_MAX_SIZE 40
+
+typedef struct
+{
+    bool     exists;
+    uint32_t length;
+    uint8_t  data[TEST_FILE_MAX_SIZE];
+} testFile_t;
+
+typedef struct
+{
+    testFile_t settings;
+    testFile_t journal;
+} testFlash_t;
+
+static testFlash_t sFlash;
+static testFlash_t sSteps[TEST_MAX_STEPS];
+static uint8_t     sStepCount;
+static unsigned    sWriteFailureRate;
+static unsigned    sDeleteFailureRate;
+static unsigned    sSettingsFileWrites;
+
+static testFile_t *testGetFile(const char *aName)
+{
+    return (strcmp(aName, otSettingsFileOps.settingsFileName) == 0) ? &sFlash.settings : &sFlash.journal;
+}
+
+static bool testFails(unsigned aRate)
+{
+    return (aRate != 0) && ((unsigned)rand() % aRate == 0);
+}
+
+static void testStep(void)
+{
+    HOST_TEST_VERIFY(sStepCount < TEST_MAX_STEPS);
+    sSteps[sStepCount++] = sFlash;
+}
+
+void TEST_FS(Init)(void)
+{
+}
+
+void TEST_FS(DeInit)(void)
+{
+}
+
+int TEST_FS(ReadBufferFromFile)(const char *file_name, uint8_t *buffer, uint32_t buf_length)
+{
+    testFile_t *file = testGetFile(file_name);
+    uint32_t    length;
+
+    if (!file->exists)
+    {
+        return 0;
+    }
+
+    length = (file->length < buf_length) ? file->length : buf_length;
+    memcpy(buffer, file->data, length);
+
+    return (int)length;
+}
+
+int TEST_FS(WriteBufferToFile)(const char *file_name, const uint8_t *buffer, uint32_t buf_length)
+{
+    testFile_t *file = testGetFile(file_name);
+
+    HOST_TEST_VERIFY(buf_length <= TEST_FILE_MAX_SIZE);
+
+    if (testFails(sWriteFailureRate))
+    {
+        return -1;
+    }
+
+    /* File writes are atomic, as with littlefs */
+    sSettingsFileWrites += (file == &sFlash.settings);
+    file->exists = true;
+    file->length = buf_length;
+    memcpy(file->data, buffer, buf_length);
+    testStep();
+
+    return 0;
+}
+
+int TEST_FS(DeleteFile)(const char *file_name)
+{
+    testFile_t *file = testGetFile(file_name);
+
+    if (!file->exists || testFails(sDeleteFailureRate))
+    {
+        return -1;
+    }
+
+    file->exists = false;
+    testStep();
+
+    return 0;
+}
+
+/* Reset the device with aFlash as the flash content and load the settings */
+static void testReboot(const testFlash_t *aFlash)
+{
+    sFlash = *aFlash;
+
+    isInitialized = false;
+
+    otPlatSettingsInit(NULL, NULL, 0);
+}
+
+static bool testSameSettings(const otSettingsBuffer_t *aBuffer, const otSettingsIndex_t *aIndex)
+{
+    for (uint16_t key = 0; key < TEST_KEY_COUNT; key++)
+    {
+        for (int index = 0;; index++)
+        {
+            uint8_t  expected[TEST_VALUE_MAX_SIZE];
+            uint8_t  value[TEST_VALUE_MAX_SIZE];
+            uint16_t expectedLength = sizeof(expected);
+            uint16_t valueLength    = sizeof(value);
+            otError  expectedError  = settingsBufferGet(aBuffer, aIndex, key, index, expected, &expectedLength);
+            otError  error          = otPlatSettingsGet(NULL, key, index, value, &valueLength);
+
+            if (error != expectedError)
+            {
+                return false;
+            }
+            if (error != OT_ERROR_NONE)
+            {
+                break;
+            }
+            if (valueLength != expectedLength || memcmp(value, expected, valueLength) != 0)
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+static void testRandomUpdates(void)
+{
+    int updates = rand() % 4 + 1;
+
+    for (int i = 0; i < updates; i++)
+    {
+        uint16_t key = (uint16_t)(rand() % TEST_KEY_COUNT);
+        uint8_t  value[TEST_VALUE_MAX_SIZE];
+        uint16_t length = (uint16_t)(rand() % TEST_VALUE_MAX_SIZE);
+        int      op     = rand() % 100;
+
+        for (uint16_t j = 0; j < length; j++)
+        {
+            value[j] = (uint8_t)rand();
+        }
+
+        if (op < 60)
+        {
+            (void)otPlatSettingsSet(NULL, key, value, length);
+        }
+        else if (op < 80)
+        {
+            (void)otPlatSettingsAdd(NULL, key, value, length);
+        }
+        else if (op < 97)
+        {
+            (void)otPlatSettingsDelete(NULL, key, -1);
+        }
+        else
+        {
+            otPlatSettingsWipe(NULL);
+        }
+    }
+}
+
+/* A factory reset must not bring back settings journaled on top of an empty settings file */
+static void testWipeDoesNotReplayJournal(void)
+{
+    static const testFlash_t empty;
+    const uint8_t            secret[] = {1, 2, 3, 4};
+    uint8_t                  value[sizeof(secret)];
+    uint16_t                 length;
+
+    for (int failDelete = 0; failDelete < 2; failDelete++)
+    {
+        testReboot(&empty);
+        HOST_TEST_VERIFY(otPlatSettingsSet(NULL, 1, secret, sizeof(secret)) == OT_ERROR_NONE);
+        otPlatSaveSettingsIdle();
+        HOST_TEST_VERIFY(sFlash.journal.exists);
+
+        otPlatSettingsWipe(NULL);
+        sStepCount         = 0;
+        sDeleteFailureRate = failDelete;
+        otPlatSaveSettingsIdle();
+        sDeleteFailureRate = 0;
+
+        /* Reset after each step of the save, and after a failed journal deletion */
+        for (uint8_t step = 0; step < sStepCount; step++)
+        {
+            testReboot(&sSteps[step]);
+            length = sizeof(value);
+            HOST_TEST_VERIFY(otPlatSettingsGet(NULL, 1, 0, value, &length) == OT_ERROR_NOT_FOUND);
+        }
+    }
+}
+
+/* A settings file with more keys than the index tracks is loaded up to the key limit and reported */
+static void testLoadKeyLimit(void)
+{
+    static otSettingsBuffer_t buffer;
+    static otSettingsIndex_t  index;
+    const uint16_t            recordSize = OT_SETTINGS_TLV_HEADER_SIZE + 1;
+    uint16_t                  length     = 0;
+
+    for (uint16_t key = 0; key <= OT_SETTINGS_INDEX_MAX_KEYS; key++)
+    {
+        const uint16_t header[] = {key, 1};
+
+        memcpy(&buffer.buffer[length], header, sizeof(header));
+        buffer.buffer[length + OT_SETTINGS_TLV_HEADER_SIZE] = (uint8_t)key;
+        length += recordSize;
+    }
+
+    HOST_TEST_VERIFY(settingsBufferLoad(&buffer, &index, length) == OT_ERROR_NO_BUFS);
+    HOST_TEST_VERIFY(index.keyCount == OT_SETTINGS_INDEX_MAX_KEYS);
+    HOST_TEST_VERIFY(buffer.recordLen == length - recordSize);
+
+    HOST_TEST_VERIFY(settingsBufferLoad(&buffer, &index, length - recordSize) == OT_ERROR_NONE);
+    HOST_TEST_VERIFY(settingsBufferLoad(&buffer, &index, length - recordSize - 1) == OT_ERROR_PARSE);
+    HOST_TEST_VERIFY(buffer.recordLen == length - 2 * recordSize);
+}
+
+static void testRandomResets(long aIterations)
+{
+    static const testFlash_t empty;
+    static otSettingsBuffer_t before;
+    static otSettingsBuffer_t after;
+    static otSettingsIndex_t  beforeIndex;
+    static otSettingsIndex_t  afterIndex;
+    testFlash_t               saved;
+
+    testReboot(&empty);
+
+    for (long i = 0; i < aIterations; i++)
+    {
+        before      = otSettingsStore.buffer;
+        beforeIndex = otSettingsStore.index;
+
+        testRandomUpdates();
+
+        after      = otSettingsStore.buffer;
+        afterIndex = otSettingsStore.index;
+
+        sStepCount         = 0;
+        sWriteFailureRate  = 16;
+        sDeleteFailureRate = 4;
+        /* Retry the failed writes, as the idle task does */
+        for (int retry = 0; retry < 8 && otSettingsStore.saveRequired; retry++)
+        {
+            otPlatSaveSettingsIdle();
+        }
+        sWriteFailureRate  = 0;
+        sDeleteFailureRate = 0;
+        otPlatSaveSettingsIdle();
+        saved = sFlash;
+
+        for (uint8_t step = 0; step < sStepCount; step++)
+        {
+            testReboot(&sSteps[step]);
+            HOST_TEST_VERIFY(testSameSettings(&after, &afterIndex) || testSameSettings(&before, &beforeIndex));
+        }
+
+        testReboot(&saved);
+        HOST_TEST_VERIFY(testSameSettings(&after, &afterIndex));
+        otPlatSaveSettingsIdle();
+    }
+}
+
+int main(void)
+{
+    srand(1);
+
+    testLoadKeyLimit();
+    testWipeDoesNotReplayJournal();
+    testRandomResets(20000);
+
+    printf("settings journal: ok, %u settings file writes\n", sSettingsFileWrites);
+
+    return 0;
+}
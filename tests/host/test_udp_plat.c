@@ -0,0 +1,491 @@
+/*
+ *  Copyright (c) 2025, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file stress tests the pools of the UDP platform send and receive contexts (udp_plat.c).
+ *
+ *   Millions of datagrams are sent and received in random bursts, while the LwIP thread and the OpenThread task run
+ *   at random times, so that both pools are regularly exhausted. A model of the pool occupancy predicts every drop,
+ *   the content of every datagram is checked, and no heap block, pbuf or message may be left once the queues are
+ *   drained.
+ */
+
+#include "host_test.h"
+
+#include <string.h>
+
+#include <openthread/platform/udp.h>
+
+#include "lwip/tcpip.h"
+#include "lwip/udp.h"
+#include "lwip_tx_batch.h"
+#include "ot_platform_common.h"
+#include "udp_plat.h"
+
+#ifndef OT_UDP_PLAT_SEND_POOL_SIZE
+#define OT_UDP_PLAT_SEND_POOL_SIZE 8
+#endif
+
+#ifndef OT_UDP_PLAT_RECEIVE_POOL_SIZE
+#define OT_UDP_PLAT_RECEIVE_POOL_SIZE 16
+#endif
+
+#define TEST_DATAGRAMS 1000000U
+#define TEST_MAX_LENGTH 1200U
+#define TEST_PEER_PORT 49152U
+#define TEST_SOCKET_PORT 5683U
+
+/* Kinds of peer address, each getting a different zone or address type in lwIP */
+enum
+{
+    kTestPeerGlobal,
+    kTestPeerLinkLocal,
+    kTestPeerMulticast,
+    kTestPeerIp4Mapped,
+    kTestPeerKinds,
+};
+
+/* Start of the payload of the test datagrams, the rest is a pattern derived from the sequence number */
+typedef struct TestHeader
+{
+    uint32_t mSequence;
+    uint8_t  mPeerKind;
+    uint8_t  mHostInterface;
+} TestHeader;
+
+struct tcpip_callback_msg
+{
+    tcpip_callback_fn mFunction;
+    void             *mContext;
+};
+
+static otInstance               *sTestInstance = (otInstance *)&sTestInstance;
+static struct netif              sBackboneNetif;
+static struct netif              sThreadNetif;
+static otUdpSocket               sSocket;
+static struct tcpip_callback_msg sCallbackMsg;
+static bool                      sCallbackPosted;
+static bool                      sFailNextPost;
+static bool                      sFailNextNewMessage;
+static uint32_t                  sSent;
+static uint32_t                  sReceived;
+static uint32_t                  sNextReceived;
+static uint8_t                   sBuffer[TEST_MAX_LENGTH];
+static uint8_t                   sRamp[256 + TEST_MAX_LENGTH];
+
+static err_t testNetifInit(struct netif *netif)
+{
+    LWIP_UNUSED_ARG(netif);
+    return ERR_OK;
+}
+
+void otSysEventSetPending(otSysEvent aEvent)
+{
+    OT_UNUSED_VARIABLE(aEvent);
+}
+
+void otTaskletsSignalPending(otInstance *aInstance)
+{
+    OT_UNUSED_VARIABLE(aInstance);
+}
+
+otMessage *otUdpNewMessage(otInstance *aInstance, const otMessageSettings *aSettings)
+{
+    otMessage *message = NULL;
+
+    HOST_TEST_VERIFY(aInstance == sTestInstance);
+    if (!sFailNextNewMessage)
+    {
+        message = otIp6NewMessage(aInstance, aSettings);
+    }
+    sFailNextNewMessage = false;
+
+    return message;
+}
+
+struct tcpip_callback_msg *tcpip_callbackmsg_new(tcpip_callback_fn function, void *ctx)
+{
+    sCallbackMsg.mFunction = function;
+    sCallbackMsg.mContext  = ctx;
+
+    return &sCallbackMsg;
+}
+
+void tcpip_callbackmsg_delete(struct tcpip_callback_msg *msg)
+{
+    LWIP_UNUSED_ARG(msg);
+}
+
+err_t tcpip_callbackmsg_trycallback(struct tcpip_callback_msg *msg)
+{
+    err_t error = ERR_MEM;
+
+    HOST_TEST_VERIFY(msg == &sCallbackMsg);
+    HOST_TEST_VERIFY(!sCallbackPosted);
+
+    if (!sFailNextPost)
+    {
+        sCallbackPosted = true;
+        error           = ERR_OK;
+    }
+    sFailNextPost = false;
+
+    return error;
+}
+
+/* Byte i of the payload after the header is (sequence + i) modulo 256, copied from sRamp */
+static void testFillPayload(uint8_t *aPayload, uint16_t aLength, const TestHeader *aHeader)
+{
+    memcpy(aPayload, aHeader, sizeof(*aHeader));
+    memcpy(&aPayload[sizeof(*aHeader)], &sRamp[(uint8_t)aHeader->mSequence + sizeof(*aHeader)],
+           aLength - sizeof(*aHeader));
+}
+
+static void testCheckPayload(const uint8_t *aPayload, uint16_t aLength, TestHeader *aHeader)
+{
+    HOST_TEST_VERIFY(aLength >= sizeof(*aHeader));
+    memcpy(aHeader, aPayload, sizeof(*aHeader));
+    HOST_TEST_VERIFY(memcmp(&aPayload[sizeof(*aHeader)], &sRamp[(uint8_t)aHeader->mSequence + sizeof(*aHeader)],
+                            aLength - sizeof(*aHeader)) == 0);
+}
+
+static void testSetPeerAddress(otIp6Address *aAddress, uint8_t aPeerKind)
+{
+    static const uint8_t kPrefixes[kTestPeerKinds][4] = {
+        {0xfd, 0x00, 0x0d, 0xb8}, {0xfe, 0x80, 0x00, 0x00}, {0xff, 0x02, 0x00, 0x00}, {0x00, 0x00, 0x00, 0x00}};
+
+    memset(aAddress, 0, sizeof(*aAddress));
+    memcpy(aAddress->mFields.m8, kPrefixes[aPeerKind], sizeof(kPrefixes[aPeerKind]));
+    if (aPeerKind == kTestPeerIp4Mapped)
+    {
+        aAddress->mFields.m8[10] = 0xff;
+        aAddress->mFields.m8[11] = 0xff;
+        aAddress->mFields.m8[12] = 192;
+        aAddress->mFields.m8[14] = 2;
+    }
+    aAddress->mFields.m8[15] = 1;
+}
+
+/* Hop limit and multicast loop of a sent datagram, different for the datagrams of a batch */
+static uint8_t testHopLimit(uint32_t aSequence)
+{
+    return (uint8_t)(1 + aSequence % 255U);
+}
+
+static bool testMulticastLoop(uint32_t aSequence)
+{
+    return (aSequence % 3U) == 0;
+}
+
+/* The datagram reaches lwIP with the zone of the interface chosen by the OpenThread message info */
+err_t udp_sendto(struct udp_pcb *pcb, struct pbuf *p, const ip_addr_t *dst_ip, u16_t dst_port)
+{
+    TestHeader header;
+    u8_t       zone;
+
+    HOST_TEST_VERIFY(pcb == sSocket.mHandle);
+    HOST_TEST_VERIFY(p->next == NULL);
+    HOST_TEST_VERIFY(dst_port == TEST_PEER_PORT);
+    HOST_TEST_VERIFY(pcb->local_port == TEST_SOCKET_PORT);
+    testCheckPayload((const uint8_t *)p->payload, p->len, &header);
+    HOST_TEST_VERIFY(header.mSequence == sSent);
+
+    /* Set on the shared pcb for each datagram, not by the last one queued in the batch */
+    HOST_TEST_VERIFY(pcb->ttl == testHopLimit(header.mSequence));
+    HOST_TEST_VERIFY(((pcb->flags & UDP_FLAGS_MULTICAST_LOOP) != 0) == testMulticastLoop(header.mSequence));
+
+    zone = netif_get_index(header.mHostInterface ? &sBackboneNetif : &sThreadNetif);
+    switch (header.mPeerKind)
+    {
+    case kTestPeerGlobal:
+        HOST_TEST_VERIFY(IP_IS_V6_VAL(*dst_ip) && (dst_ip->u_addr.ip6.zone == IP6_NO_ZONE));
+        break;
+    case kTestPeerLinkLocal:
+    case kTestPeerMulticast:
+        HOST_TEST_VERIFY(IP_IS_V6_VAL(*dst_ip) && (dst_ip->u_addr.ip6.zone == zone));
+        break;
+    default:
+        HOST_TEST_VERIFY(IP_IS_V4_VAL(*dst_ip) && (dst_ip->u_addr.ip4.addr == PP_HTONL(0xc0000201UL)));
+        break;
+    }
+
+    sSent++;
+
+    return ERR_OK;
+}
+
+static void testReceive(void *aContext, otMessage *aMessage, const otMessageInfo *aMessageInfo)
+{
+    TestHeader header;
+    uint16_t   length = otMessageGetLength(aMessage);
+
+    HOST_TEST_VERIFY(aContext == &sSocket);
+    HOST_TEST_VERIFY(otMessageRead(aMessage, 0, sBuffer, sizeof(sBuffer)) == length);
+    testCheckPayload(sBuffer, length, &header);
+
+    /* Datagrams are dropped, never reordered */
+    HOST_TEST_VERIFY(header.mSequence >= sNextReceived);
+    sNextReceived = header.mSequence + 1;
+
+    HOST_TEST_VERIFY(aMessageInfo->mPeerPort == TEST_PEER_PORT);
+    HOST_TEST_VERIFY(aMessageInfo->mIsHostInterface == (bool)header.mHostInterface);
+    HOST_TEST_VERIFY(aMessageInfo->mHopLimit == (uint8_t)header.mSequence);
+    if (header.mPeerKind == kTestPeerIp4Mapped)
+    {
+        HOST_TEST_VERIFY(aMessageInfo->mPeerAddr.mFields.m8[11] == 0xff);
+        HOST_TEST_VERIFY(aMessageInfo->mPeerAddr.mFields.m8[12] == 192);
+    }
+
+    sReceived++;
+}
+
+/* The LwIP thread runs the posted callback */
+static void testRunLwip(void)
+{
+    if (sCallbackPosted)
+    {
+        sCallbackPosted = false;
+        sCallbackMsg.mFunction(sCallbackMsg.mContext);
+    }
+}
+
+static void testCheckDrained(void)
+{
+    HOST_TEST_VERIFY(!sCallbackPosted);
+    HOST_TEST_VERIFY(hostTestCAllocCount() == 0);
+    HOST_TEST_VERIFY(hostTestPbufCount() == 0);
+    HOST_TEST_VERIFY(hostTestMessageCount() == 0);
+}
+
+static void testPools(void)
+{
+    uint32_t         sendSequence     = 0;
+    uint32_t         receiveSequence  = 0;
+    uint32_t         pendingSends     = 0;
+    uint32_t         pendingReceives  = 0;
+    uint32_t         accepted         = 0;
+    uint32_t         sendExhausted    = 0;
+    uint32_t         postFailed       = 0;
+    uint32_t         receiveExhausted = 0;
+    uint32_t         noMessage        = 0;
+    ip6_addr_t       destination;
+    struct ip6_hdr   ip6Header;
+    struct ip_hdr    ip4Header;
+    udpPlatPoolStats poolStats;
+    lwipTxBatchStats batchStats;
+
+    memset(&destination, 0, sizeof(destination));
+    memset(&ip6Header, 0, sizeof(ip6Header));
+    memset(&ip4Header, 0, sizeof(ip4Header));
+
+    while ((sendSequence < TEST_DATAGRAMS) || (receiveSequence < TEST_DATAGRAMS))
+    {
+        uint32_t burst;
+
+        switch (rand() % 4)
+        {
+        case 0:
+            /* Bursts of up to a pool, two bursts in a row may exhaust it */
+            burst = 1 + (uint32_t)rand() % OT_UDP_PLAT_SEND_POOL_SIZE;
+            for (uint32_t i = 0; (i < burst) && (sendSequence < TEST_DATAGRAMS); i++)
+            {
+                otMessage    *message = otIp6NewMessage(sTestInstance, NULL);
+                otMessageInfo messageInfo;
+                TestHeader    header;
+                uint16_t      length = sizeof(header) + (uint16_t)(rand() % (TEST_MAX_LENGTH - sizeof(header)));
+                bool          failPost;
+                otError       error;
+
+                memset(&header, 0, sizeof(header));
+                header.mSequence      = sendSequence++;
+                header.mPeerKind      = (uint8_t)(rand() % kTestPeerKinds);
+                header.mHostInterface = (uint8_t)(rand() % 2);
+                testFillPayload(sBuffer, length, &header);
+                HOST_TEST_VERIFY(otMessageAppend(message, sBuffer, length) == OT_ERROR_NONE);
+
+                memset(&messageInfo, 0, sizeof(messageInfo));
+                testSetPeerAddress(&messageInfo.mPeerAddr, header.mPeerKind);
+                messageInfo.mPeerPort        = TEST_PEER_PORT;
+                messageInfo.mSockPort        = TEST_SOCKET_PORT;
+                messageInfo.mIsHostInterface = header.mHostInterface;
+                messageInfo.mHopLimit        = testHopLimit(header.mSequence);
+                messageInfo.mMulticastLoop   = testMulticastLoop(header.mSequence);
+
+                failPost      = ((rand() % 64) == 0);
+                sFailNextPost = failPost;
+                error         = otPlatUdpSend(&sSocket, message, &messageInfo);
+
+                if (pendingSends == OT_UDP_PLAT_SEND_POOL_SIZE)
+                {
+                    HOST_TEST_VERIFY(error == OT_ERROR_NO_BUFS);
+                    sendExhausted++;
+                }
+                else if ((pendingSends == 0) && failPost)
+                {
+                    /* The first datagram of a batch could not be posted and was released */
+                    HOST_TEST_VERIFY(error == OT_ERROR_FAILED);
+                    postFailed++;
+                }
+                else
+                {
+                    HOST_TEST_VERIFY(error == OT_ERROR_NONE);
+                    pendingSends++;
+                    accepted++;
+                }
+                sFailNextPost = false;
+
+                /* The datagrams which are not sent do not keep their sequence number */
+                if (error != OT_ERROR_NONE)
+                {
+                    sendSequence--;
+                }
+            }
+            break;
+
+        case 1:
+            burst = 1 + (uint32_t)rand() % OT_UDP_PLAT_RECEIVE_POOL_SIZE;
+            for (uint32_t i = 0; (i < burst) && (receiveSequence < TEST_DATAGRAMS); i++)
+            {
+                struct udp_pcb *pcb = (struct udp_pcb *)sSocket.mHandle;
+                TestHeader      header;
+                ip_addr_t       source;
+                uint16_t        length = sizeof(header) + (uint16_t)(rand() % (TEST_MAX_LENGTH - sizeof(header)));
+                struct pbuf    *p      = pbuf_alloc(PBUF_TRANSPORT, length, PBUF_POOL);
+
+                memset(&header, 0, sizeof(header));
+                header.mSequence      = receiveSequence++;
+                header.mPeerKind      = (rand() % 4 == 0) ? kTestPeerIp4Mapped : kTestPeerGlobal;
+                header.mHostInterface = (uint8_t)(rand() % 2);
+                testFillPayload(sBuffer, length, &header);
+                HOST_TEST_VERIFY(pbuf_take(p, sBuffer, length) == ERR_OK);
+
+                memset(&source, 0, sizeof(source));
+                if (header.mPeerKind == kTestPeerIp4Mapped)
+                {
+                    source.type                       = IPADDR_TYPE_V4;
+                    source.u_addr.ip4.addr            = PP_HTONL(0xc0000201UL);
+                    ip_data.current_iphdr_dest.type   = IPADDR_TYPE_V4;
+                    ip_data.current_iphdr_dest.u_addr = source.u_addr;
+                    ip4Header._ttl                    = (uint8_t)header.mSequence;
+                }
+                else
+                {
+                    source.type = IPADDR_TYPE_V6;
+                    testSetPeerAddress((otIp6Address *)source.u_addr.ip6.addr, header.mPeerKind);
+                    ip_data.current_iphdr_dest.type       = IPADDR_TYPE_V6;
+                    ip_data.current_iphdr_dest.u_addr.ip6 = destination;
+                    ip6Header._hoplim                     = (uint8_t)header.mSequence;
+                }
+                ip_data.current_netif      = header.mHostInterface ? &sBackboneNetif : &sThreadNetif;
+                ip_data.current_ip4_header = &ip4Header;
+                ip_data.current_ip6_header = &ip6Header;
+
+                sFailNextNewMessage = ((rand() % 64) == 0);
+                if (pendingReceives == OT_UDP_PLAT_RECEIVE_POOL_SIZE)
+                {
+                    receiveExhausted++;
+                }
+                else if (sFailNextNewMessage)
+                {
+                    noMessage++;
+                }
+                else
+                {
+                    pendingReceives++;
+                }
+
+                /* lwIP gives the pbuf to the receive callback */
+                pcb->recv(pcb->recv_arg, pcb, p, &source, TEST_PEER_PORT);
+                sFailNextNewMessage = false;
+            }
+            break;
+
+        case 2:
+            testRunLwip();
+            pendingSends = 0;
+            break;
+
+        default:
+            otPlatUdpProcess();
+            pendingReceives = 0;
+            break;
+        }
+
+        HOST_TEST_VERIFY(hostTestCAllocCount() == 0);
+        HOST_TEST_VERIFY(hostTestPbufCount() <= OT_UDP_PLAT_SEND_POOL_SIZE);
+        HOST_TEST_VERIFY(hostTestMessageCount() <= OT_UDP_PLAT_RECEIVE_POOL_SIZE);
+    }
+
+    testRunLwip();
+    otPlatUdpProcess();
+    testCheckDrained();
+
+    UdpPlatGetPoolStats(&poolStats);
+    lwipTxBatchGetStats(&batchStats);
+    printf("sent %u, send pool exhausted %u, post failed %u; received %u, receive pool exhausted %u, no message %u\n",
+           (unsigned)sSent, (unsigned)poolStats.mSendPoolExhausted, (unsigned)batchStats.mDropped, (unsigned)sReceived,
+           (unsigned)poolStats.mReceivePoolExhausted, (unsigned)noMessage);
+
+    HOST_TEST_VERIFY(sSent == accepted);
+    HOST_TEST_VERIFY(sSent == TEST_DATAGRAMS);
+    HOST_TEST_VERIFY(poolStats.mSendPoolExhausted == sendExhausted);
+    HOST_TEST_VERIFY(batchStats.mPostFailed == postFailed);
+    HOST_TEST_VERIFY(batchStats.mDropped == postFailed);
+    HOST_TEST_VERIFY(sReceived + receiveExhausted + noMessage == TEST_DATAGRAMS);
+    HOST_TEST_VERIFY(poolStats.mReceivePoolExhausted == receiveExhausted);
+    HOST_TEST_VERIFY(sendExhausted > 0);
+    HOST_TEST_VERIFY(receiveExhausted > 0);
+}
+
+int main(void)
+{
+    srand(1);
+
+    for (uint16_t i = 0; i < sizeof(sRamp); i++)
+    {
+        sRamp[i] = (uint8_t)i;
+    }
+
+    HOST_TEST_VERIFY(netif_add(&sBackboneNetif, NULL, NULL, NULL, NULL, testNetifInit, tcpip_input) != NULL);
+    HOST_TEST_VERIFY(netif_add(&sThreadNetif, NULL, NULL, NULL, NULL, testNetifInit, tcpip_input) != NULL);
+    UdpPlatInit(sTestInstance, &sBackboneNetif, &sThreadNetif);
+
+    sSocket.mHandler        = testReceive;
+    sSocket.mContext        = &sSocket;
+    sSocket.mSockName.mPort = TEST_SOCKET_PORT;
+    HOST_TEST_VERIFY(otPlatUdpSocket(&sSocket) == OT_ERROR_NONE);
+    HOST_TEST_VERIFY(otPlatUdpBind(&sSocket) == OT_ERROR_NONE);
+
+    testPools();
+
+    HOST_TEST_VERIFY(otPlatUdpClose(&sSocket) == OT_ERROR_NONE);
+
+    printf("udp plat: ok\n");
+    return 0;
+}